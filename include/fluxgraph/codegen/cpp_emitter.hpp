@@ -0,0 +1,44 @@
+#pragma once
+
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fluxgraph::codegen {
+
+struct CppEmitOptions {
+  /// Recorded in the file header (e.g. the input graph path)
+  std::string source_label;
+
+  /// Edges (and models) per generated member function; keeps functions of
+  /// large graphs small enough for the optimizer
+  size_t components_per_function = 512;
+};
+
+struct CppEmitResult {
+  std::string source;
+  uint64_t layout_hash = 0;
+  size_t folded_edges = 0;   ///< Stateless transform inlined with constants
+  size_t direct_edges = 0;   ///< Built-in stateful transform, direct call
+  size_t virtual_edges = 0;  ///< Unknown transform type, ITransform call
+  size_t direct_models = 0;  ///< Built-in model, direct call
+  size_t virtual_models = 0; ///< Unknown model type, IModel call
+};
+
+/// Emit a self-contained translation unit with a GeneratedProgram for
+/// program and a static registration under its layout hash.
+///
+/// The edge schedule is unrolled in execution order with signal values held
+/// in struct fields; linear, saturation, deadband and unit_convert edges are
+/// folded to constants, and the bind step checks those constants against
+/// the loaded program. Signal ids are baked in, so the host must compile the
+/// same spec into a namespace that interns paths in the same order (e.g. a
+/// fresh one).
+/// @param signal_ns Namespace program was compiled with (for names)
+CppEmitResult emit_cpp(const CompiledProgram &program,
+                       const SignalNamespace &signal_ns,
+                       const CppEmitOptions &options = {});
+
+} // namespace fluxgraph::codegen
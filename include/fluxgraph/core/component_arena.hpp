@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Bump allocator for the transforms and models of one CompiledProgram.
+///
+/// Components are placed back to back in construction order (the compiler
+/// constructs them in execution order), so a tick walks memory linearly.
+/// Blocks are cache-line aligned and objects larger than a line start on a
+/// line boundary; smaller ones are packed at their natural alignment.
+/// Memory is released only when the arena is destroyed; destroying the
+/// objects is left to their ComponentPtr.
+class ComponentArena {
+public:
+  static constexpr std::size_t kCacheLine = 64;
+
+  ComponentArena() = default;
+  ComponentArena(ComponentArena &&) noexcept = default;
+  ComponentArena &operator=(ComponentArena &&) noexcept = default;
+  ComponentArena(const ComponentArena &) = delete;
+  ComponentArena &operator=(const ComponentArena &) = delete;
+
+  /// Size of the next block; later blocks grow geometrically from it
+  void reserve(std::size_t bytes);
+
+  /// Uninitialized storage for size bytes at alignment align
+  void *allocate(std::size_t size, std::size_t align);
+
+  template <typename T, typename... Args> T *create(Args &&...args) {
+    static_assert(alignof(T) <= kCacheLine,
+                  "ComponentArena: over-aligned component type");
+    void *memory = allocate(sizeof(T), alignof(T));
+    return ::new (memory) T(std::forward<Args>(args)...);
+  }
+
+  /// Bytes handed out, including alignment padding
+  std::size_t bytes_used() const { return used_; }
+
+  /// Bytes held in blocks
+  std::size_t bytes_reserved() const { return reserved_; }
+
+  std::size_t block_count() const { return blocks_.size(); }
+  std::size_t object_count() const { return objects_; }
+
+private:
+  struct AlignedDelete {
+    void operator()(std::byte *block) const {
+      ::operator delete[](block, std::align_val_t(kCacheLine));
+    }
+  };
+
+  std::vector<std::unique_ptr<std::byte[], AlignedDelete>> blocks_;
+  std::size_t cursor_ = 0;   // Offset into blocks_.back()
+  std::size_t capacity_ = 0; // Size of blocks_.back()
+  std::size_t next_block_ = 4096;
+  std::size_t used_ = 0;
+  std::size_t reserved_ = 0;
+  std::size_t objects_ = 0;
+};
+
+/// Owning pointer to a component that may live in a ComponentArena: arena
+/// objects are only destroyed (the arena owns their memory), heap objects
+/// are deleted. The arena flag is kept in the pointer's low bit, so a
+/// ComponentPtr is as small as a raw pointer. Converts from std::unique_ptr,
+/// so factories that return one still work.
+template <typename T> class ComponentPtr {
+public:
+  ComponentPtr() noexcept = default;
+  ComponentPtr(std::nullptr_t) noexcept {} // NOLINT
+
+  /// Take ownership of a heap object
+  explicit ComponentPtr(T *object) noexcept : ComponentPtr(object, false) {}
+
+  ComponentPtr(T *object, bool in_arena) noexcept
+      : bits_(reinterpret_cast<std::uintptr_t>(object) |
+              (in_arena ? kArenaBit : 0U)) {
+    static_assert(alignof(T) > 1, "ComponentPtr: needs a spare pointer bit");
+  }
+
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+  ComponentPtr(std::unique_ptr<U> &&other) noexcept // NOLINT
+      : ComponentPtr(other.release(), false) {}
+
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+  ComponentPtr(ComponentPtr<U> &&other) noexcept // NOLINT
+      : ComponentPtr(other.get(), other.in_arena()) {
+    other.bits_ = 0;
+  }
+
+  ComponentPtr(ComponentPtr &&other) noexcept : bits_(other.bits_) {
+    other.bits_ = 0;
+  }
+
+  ComponentPtr &operator=(ComponentPtr &&other) noexcept {
+    if (this != &other) {
+      reset();
+      bits_ = other.bits_;
+      other.bits_ = 0;
+    }
+    return *this;
+  }
+
+  ComponentPtr(const ComponentPtr &) = delete;
+  ComponentPtr &operator=(const ComponentPtr &) = delete;
+
+  ~ComponentPtr() { reset(); }
+
+  T *get() const noexcept {
+    return reinterpret_cast<T *>(bits_ & ~kArenaBit);
+  }
+  T *operator->() const noexcept { return get(); }
+  T &operator*() const noexcept { return *get(); }
+  explicit operator bool() const noexcept { return bits_ != 0; }
+
+  /// True when the object's memory belongs to a ComponentArena
+  bool in_arena() const noexcept { return (bits_ & kArenaBit) != 0; }
+
+  /// Give up ownership. Only heap objects may then be deleted; arena
+  /// objects must be destroyed before their arena.
+  T *release() noexcept {
+    T *object = get();
+    bits_ = 0;
+    return object;
+  }
+
+  void reset() noexcept {
+    T *object = get();
+    if (object == nullptr) {
+      return;
+    }
+    if (in_arena()) {
+      object->~T();
+    } else {
+      delete object;
+    }
+    bits_ = 0;
+  }
+
+  friend bool operator==(const ComponentPtr &ptr, std::nullptr_t) noexcept {
+    return !ptr;
+  }
+  friend bool operator!=(const ComponentPtr &ptr, std::nullptr_t) noexcept {
+    return static_cast<bool>(ptr);
+  }
+
+private:
+  template <typename U> friend class ComponentPtr;
+
+  static constexpr std::uintptr_t kArenaBit = 1U;
+
+  std::uintptr_t bits_ = 0;
+};
+
+/// Construct T in arena, or on the heap when arena is null
+template <typename T, typename... Args>
+ComponentPtr<T> make_component(ComponentArena *arena, Args &&...args) {
+  if (arena == nullptr) {
+    return ComponentPtr<T>(new T(std::forward<Args>(args)...));
+  }
+  return ComponentPtr<T>(arena->create<T>(std::forward<Args>(args)...), true);
+}
+
+} // namespace fluxgraph
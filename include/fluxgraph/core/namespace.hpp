@@ -1,43 +1,93 @@
 #pragma once
 
+#include "fluxgraph/core/path_index.hpp"
 #include "fluxgraph/core/types.hpp"
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace fluxgraph {
 
 /// Maps signal paths (e.g., "tempctl0/chamber/temperature") to SignalIds
 /// Design: Compile-time (intern) vs runtime (resolve) separation
+///
+/// Paths are copied once into a chunked character arena that never moves,
+/// so ids map to string_views through a dense vector. Path -> id is an
+/// open-addressing table (linear probing, power-of-two capacity) that keeps
+/// each path's hash next to its id: a resolve() is one hash over the path
+/// plus, typically, a single probe and memcmp.
 class SignalNamespace {
 public:
   SignalNamespace();
   ~SignalNamespace();
 
+  /// Copies re-intern every path in id order, so ids are preserved
+  SignalNamespace(const SignalNamespace &other);
+  SignalNamespace &operator=(const SignalNamespace &other);
+  SignalNamespace(SignalNamespace &&) noexcept = default;
+  SignalNamespace &operator=(SignalNamespace &&) noexcept = default;
+
   /// Compile-time: Create a new ID for a path (or return existing)
   /// Used during graph compilation
-  SignalId intern(const std::string &path);
+  SignalId intern(std::string_view path);
 
   /// Runtime: Resolve an existing path (returns INVALID_SIGNAL if unknown)
-  /// Used during command processing
-  SignalId resolve(const std::string &path) const;
+  /// Used during command processing; accepts any contiguous string without
+  /// building a std::string
+  SignalId resolve(std::string_view path) const;
 
-  /// Reverse lookup: Get path from ID
-  std::string lookup(SignalId id) const;
+  /// Reverse lookup: Get path from ID (empty view for unknown IDs).
+  /// The view stays valid until clear() or destruction.
+  std::string_view lookup(SignalId id) const;
 
   /// Get total number of interned paths
   size_t size() const;
 
-  /// Get all interned paths
+  /// Get all interned paths, sorted
   std::vector<std::string> all_paths() const;
 
+  /// Heap bytes held: path arena blocks, slot table, id vectors and path
+  /// index. Constant time; nothing is copied.
+  size_t memory_bytes() const;
+
+  /// IDs of all paths starting with prefix, in path order. Walks only the
+  /// matching subtree of the path index.
+  std::vector<SignalId> find_prefix(std::string_view prefix) const;
+
+  /// IDs of all paths matching a glob pattern, in path order (syntax in
+  /// PathIndex)
+  std::vector<SignalId> find_glob(std::string_view pattern) const;
+
+  /// Pre-size the table and id vector for count paths
+  void reserve(size_t count);
+
   /// Clear all mappings
   void clear();
 
+  /// Path hash used by the table (exposed for benchmarks and tests)
+  static uint64_t hash_path(std::string_view path);
+
 private:
-  std::map<std::string, SignalId> path_to_id_;
-  std::map<SignalId, std::string> id_to_path_;
-  SignalId next_id_ = 0;
+  struct Slot {
+    uint64_t hash = 0;
+    SignalId id = INVALID_SIGNAL; ///< INVALID_SIGNAL marks an empty slot
+  };
+
+  size_t find_slot(std::string_view path, uint64_t hash) const;
+  void rehash(size_t slot_count);
+  std::string_view store_path(std::string_view path);
+
+  std::vector<Slot> slots_;
+  std::vector<std::string_view> id_to_path_;
+  std::vector<uint64_t> id_to_hash_;
+  std::vector<std::unique_ptr<char[]>> arena_blocks_;
+  size_t arena_used_ = 0;     ///< Bytes used in arena_blocks_.back()
+  size_t arena_capacity_ = 0; ///< Size of arena_blocks_.back()
+  size_t arena_reserved_ = 0; ///< Sum of all arena block sizes
+  PathIndex path_index_;      ///< Labels view into arena_blocks_
 };
 
 /// Maps device/function names to IDs for command routing
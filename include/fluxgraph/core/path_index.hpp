@@ -0,0 +1,81 @@
+#pragma once
+
+#include "fluxgraph/core/types.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Radix tree over signal paths for prefix and glob queries.
+///
+/// Edges are labelled with byte strings and siblings are kept in byte order,
+/// so every query yields ids in lexicographic path order. Labels are views
+/// into the inserted paths: the caller (SignalNamespace) guarantees those
+/// outlive the index.
+///
+/// Glob syntax:
+///   `*`  any run of characters except the separators '/' and '.'
+///   `**` any run of characters, separators included
+///   `?`  any single character except a separator
+/// A query walks only the subtree under the pattern's literal prefix (the
+/// part before its first wildcard). Matching simulates the pattern as an
+/// NFA, so it costs O(pattern x path) however many wildcards there are, and
+/// a subtree is skipped as soon as no pattern position survives its label.
+class PathIndex {
+public:
+  PathIndex();
+
+  /// Add a path; re-inserting a path overwrites its id
+  void insert(std::string_view path, SignalId id);
+
+  /// Append ids of all paths starting with prefix ("" = every path)
+  void find_prefix(std::string_view prefix, std::vector<SignalId> &out) const;
+
+  /// Append ids of all paths matching pattern
+  void find_glob(std::string_view pattern, std::vector<SignalId> &out) const;
+
+  /// True if the pattern contains a glob wildcard
+  static bool is_glob(std::string_view pattern);
+
+  /// Match a single path against a glob pattern
+  static bool glob_match(std::string_view pattern, std::string_view path);
+
+  size_t node_count() const { return nodes_.size(); }
+
+  /// Heap bytes held by the node vector (labels view into the caller's
+  /// storage)
+  size_t memory_bytes() const { return nodes_.capacity() * sizeof(Node); }
+
+  void clear();
+
+private:
+  static constexpr uint32_t kNoNode = 0xFFFFFFFF;
+
+  struct Node {
+    std::string_view label;
+    uint32_t first_child = kNoNode;
+    uint32_t next_sibling = kNoNode;
+    SignalId id = INVALID_SIGNAL; ///< Set when a path ends here
+  };
+
+  /// Node whose subtree holds every path starting with prefix (kNoNode if
+  /// none); path_to_node receives the full path spelled by that node
+  uint32_t find_subtree(std::string_view prefix, std::string *path_to_node)
+      const;
+  void collect(uint32_t node, std::vector<SignalId> &out) const;
+
+  /// Compiled glob pattern (path_index.cpp)
+  struct Glob;
+
+  /// states[depth] holds the live pattern positions after node's path
+  void collect_glob(uint32_t node, const Glob &glob, size_t depth,
+                    std::vector<std::vector<uint8_t>> &states,
+                    std::vector<uint8_t> &scratch,
+                    std::vector<SignalId> &out) const;
+
+  std::vector<Node> nodes_;
+};
+
+} // namespace fluxgraph
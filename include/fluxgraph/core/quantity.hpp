@@ -0,0 +1,250 @@
+#pragma once
+
+#include "fluxgraph/core/types.hpp"
+#include <ratio>
+#include <type_traits>
+
+namespace fluxgraph {
+
+/// Compile-time base-dimension exponents (M, L, T, I, Theta, N, J), the
+/// type-level counterpart of DimensionVector.
+template <int M, int L, int T, int I, int Theta, int N, int J>
+struct Dimension {
+  static constexpr DimensionVector vector() {
+    return DimensionVector{M, L, T, I, Theta, N, J};
+  }
+};
+
+template <typename A, typename B> struct dimension_product;
+template <int M1, int L1, int T1, int I1, int Th1, int N1, int J1, int M2,
+          int L2, int T2, int I2, int Th2, int N2, int J2>
+struct dimension_product<Dimension<M1, L1, T1, I1, Th1, N1, J1>,
+                         Dimension<M2, L2, T2, I2, Th2, N2, J2>> {
+  using type = Dimension<M1 + M2, L1 + L2, T1 + T2, I1 + I2, Th1 + Th2,
+                         N1 + N2, J1 + J2>;
+};
+
+template <typename A, typename B> struct dimension_quotient;
+template <int M1, int L1, int T1, int I1, int Th1, int N1, int J1, int M2,
+          int L2, int T2, int I2, int Th2, int N2, int J2>
+struct dimension_quotient<Dimension<M1, L1, T1, I1, Th1, N1, J1>,
+                          Dimension<M2, L2, T2, I2, Th2, N2, J2>> {
+  using type = Dimension<M1 - M2, L1 - L2, T1 - T2, I1 - I2, Th1 - Th2,
+                         N1 - N2, J1 - J2>;
+};
+
+namespace dimensions {
+using none = Dimension<0, 0, 0, 0, 0, 0, 0>;
+using mass = Dimension<1, 0, 0, 0, 0, 0, 0>;
+using length = Dimension<0, 1, 0, 0, 0, 0, 0>;
+using time = Dimension<0, 0, 1, 0, 0, 0, 0>;
+using current = Dimension<0, 0, 0, 1, 0, 0, 0>;
+using temperature = Dimension<0, 0, 0, 0, 1, 0, 0>;
+using amount = Dimension<0, 0, 0, 0, 0, 1, 0>;
+using luminosity = Dimension<0, 0, 0, 0, 0, 0, 1>;
+} // namespace dimensions
+
+/// Compile-time unit: SI value = value * Scale + Offset (the UnitDef
+/// scale_to_si/offset_to_si convention, as exact ratios).
+template <typename Dim, typename Scale = std::ratio<1>,
+          typename Offset = std::ratio<0>, UnitKind Kind = UnitKind::generic>
+struct Unit {
+  using dimension = Dim;
+  using scale = Scale;
+  using offset = Offset;
+  static constexpr UnitKind kind = Kind;
+  static constexpr double scale_to_si =
+      static_cast<double>(Scale::num) / static_cast<double>(Scale::den);
+  static constexpr double offset_to_si =
+      static_cast<double>(Offset::num) / static_cast<double>(Offset::den);
+};
+
+/// Same conversion rules as UnitRegistry::resolve_conversion: dimensions
+/// must match and absolute/delta temperatures never mix.
+template <typename From, typename To>
+inline constexpr bool is_unit_convertible_v =
+    std::is_same_v<typename From::dimension, typename To::dimension> &&
+    From::kind == To::kind;
+
+/// y = x * scale + offset, folded at compile time
+template <typename From, typename To> struct unit_conversion {
+  static_assert(is_unit_convertible_v<From, To>,
+                "incompatible units: dimension or temperature kind differs");
+  static constexpr double scale = From::scale_to_si / To::scale_to_si;
+  static constexpr double offset =
+      (From::offset_to_si - To::offset_to_si) / To::scale_to_si;
+};
+
+/// A double tagged with its unit. Same size and layout as double; mixing
+/// dimensions is a compile error and conversions between compatible units
+/// are constexpr.
+template <typename U> class Quantity {
+public:
+  using unit = U;
+
+  constexpr Quantity() = default;
+  constexpr explicit Quantity(double value) : value_(value) {}
+
+  /// Implicit conversion from any compatible unit
+  template <typename From,
+            typename = std::enable_if_t<!std::is_same_v<From, U> &&
+                                        is_unit_convertible_v<From, U>>>
+  constexpr Quantity(Quantity<From> other)
+      : value_(other.value() * unit_conversion<From, U>::scale +
+               unit_conversion<From, U>::offset) {}
+
+  constexpr double value() const { return value_; }
+
+  constexpr Quantity operator-() const { return Quantity(-value_); }
+  constexpr Quantity &operator+=(Quantity rhs) {
+    value_ += rhs.value_;
+    return *this;
+  }
+  constexpr Quantity &operator-=(Quantity rhs) {
+    value_ -= rhs.value_;
+    return *this;
+  }
+  constexpr Quantity &operator*=(double factor) {
+    value_ *= factor;
+    return *this;
+  }
+  constexpr Quantity &operator/=(double divisor) {
+    value_ /= divisor;
+    return *this;
+  }
+
+private:
+  double value_ = 0.0;
+};
+
+/// Explicit spelling of the implicit conversion
+template <typename To, typename From>
+constexpr Quantity<To> quantity_cast(Quantity<From> q) {
+  return Quantity<To>(q);
+}
+
+template <typename U>
+constexpr Quantity<U> operator+(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs += rhs;
+}
+template <typename U>
+constexpr Quantity<U> operator-(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs -= rhs;
+}
+template <typename U>
+constexpr Quantity<U> operator*(Quantity<U> q, double factor) {
+  return q *= factor;
+}
+template <typename U>
+constexpr Quantity<U> operator*(double factor, Quantity<U> q) {
+  return q *= factor;
+}
+template <typename U>
+constexpr Quantity<U> operator/(Quantity<U> q, double divisor) {
+  return q /= divisor;
+}
+
+template <typename A, typename B>
+using unit_product_t =
+    Unit<typename dimension_product<typename A::dimension,
+                                    typename B::dimension>::type,
+         std::ratio_multiply<typename A::scale, typename B::scale>>;
+template <typename A, typename B>
+using unit_quotient_t =
+    Unit<typename dimension_quotient<typename A::dimension,
+                                     typename B::dimension>::type,
+         std::ratio_divide<typename A::scale, typename B::scale>>;
+
+/// Products and quotients are defined for offset-free (generic) units only;
+/// convert temperatures to a delta or K first.
+template <typename A, typename B>
+constexpr Quantity<unit_product_t<A, B>> operator*(Quantity<A> lhs,
+                                                   Quantity<B> rhs) {
+  static_assert(A::kind == UnitKind::generic && B::kind == UnitKind::generic,
+                "multiply temperatures as delta_K/K quantities");
+  return Quantity<unit_product_t<A, B>>(lhs.value() * rhs.value());
+}
+template <typename A, typename B>
+constexpr Quantity<unit_quotient_t<A, B>> operator/(Quantity<A> lhs,
+                                                    Quantity<B> rhs) {
+  static_assert(A::kind == UnitKind::generic && B::kind == UnitKind::generic,
+                "divide temperatures as delta_K/K quantities");
+  return Quantity<unit_quotient_t<A, B>>(lhs.value() / rhs.value());
+}
+
+template <typename U>
+constexpr bool operator==(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() == rhs.value();
+}
+template <typename U>
+constexpr bool operator!=(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() != rhs.value();
+}
+template <typename U>
+constexpr bool operator<(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() < rhs.value();
+}
+template <typename U>
+constexpr bool operator<=(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() <= rhs.value();
+}
+template <typename U>
+constexpr bool operator>(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() > rhs.value();
+}
+template <typename U>
+constexpr bool operator>=(Quantity<U> lhs, Quantity<U> rhs) {
+  return lhs.value() >= rhs.value();
+}
+
+/// Named units mirroring the curated UnitRegistry entries. `symbol` is the
+/// registry key, so typed and string-based code share signal contracts.
+namespace units {
+
+#define FLUXGRAPH_DEFINE_UNIT(name, sym, ...)                                  \
+  struct name : Unit<__VA_ARGS__> {                                            \
+    static constexpr const char *symbol = sym;                                 \
+  }
+
+FLUXGRAPH_DEFINE_UNIT(dimensionless, "dimensionless", dimensions::none);
+FLUXGRAPH_DEFINE_UNIT(rad, "rad", dimensions::none);
+FLUXGRAPH_DEFINE_UNIT(s, "s", dimensions::time);
+FLUXGRAPH_DEFINE_UNIT(per_s, "1/s", Dimension<0, 0, -1, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(rad_per_s, "rad/s", Dimension<0, 0, -1, 0, 0, 0, 0>);
+
+FLUXGRAPH_DEFINE_UNIT(m, "m", dimensions::length);
+FLUXGRAPH_DEFINE_UNIT(m_per_s, "m/s", Dimension<0, 1, -1, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(kg, "kg", dimensions::mass);
+FLUXGRAPH_DEFINE_UNIT(kg_m2, "kg*m^2", Dimension<1, 2, 0, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N, "N", Dimension<1, 1, -2, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N_per_m, "N/m", Dimension<1, 0, -2, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N_s_per_m, "N*s/m", Dimension<1, 0, -1, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N_m, "N*m", Dimension<1, 2, -2, 0, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N_m_s_per_rad, "N*m*s/rad",
+                      Dimension<1, 2, -1, 0, 0, 0, 0>);
+
+FLUXGRAPH_DEFINE_UNIT(A, "A", dimensions::current);
+FLUXGRAPH_DEFINE_UNIT(V, "V", Dimension<1, 2, -3, -1, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(Ohm, "Ohm", Dimension<1, 2, -3, -2, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(H, "H", Dimension<1, 2, -2, -2, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(N_m_per_A, "N*m/A", Dimension<1, 2, -2, -1, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(V_s_per_rad, "V*s/rad",
+                      Dimension<1, 2, -2, -1, 0, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(W, "W", Dimension<1, 2, -3, 0, 0, 0, 0>);
+
+FLUXGRAPH_DEFINE_UNIT(K, "K", dimensions::temperature, std::ratio<1>,
+                      std::ratio<0>, UnitKind::absolute_temp);
+FLUXGRAPH_DEFINE_UNIT(degC, "degC", dimensions::temperature, std::ratio<1>,
+                      std::ratio<27315, 100>, UnitKind::absolute_temp);
+FLUXGRAPH_DEFINE_UNIT(delta_K, "delta_K", dimensions::temperature,
+                      std::ratio<1>, std::ratio<0>, UnitKind::delta_temp);
+FLUXGRAPH_DEFINE_UNIT(delta_degC, "delta_degC", dimensions::temperature,
+                      std::ratio<1>, std::ratio<0>, UnitKind::delta_temp);
+FLUXGRAPH_DEFINE_UNIT(J_per_K, "J/K", Dimension<1, 2, -2, 0, -1, 0, 0>);
+FLUXGRAPH_DEFINE_UNIT(W_per_K, "W/K", Dimension<1, 2, -3, 0, -1, 0, 0>);
+
+#undef FLUXGRAPH_DEFINE_UNIT
+
+} // namespace units
+
+} // namespace fluxgraph
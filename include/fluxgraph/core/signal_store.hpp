@@ -1,8 +1,11 @@
 #pragma once
 
+#include "fluxgraph/core/state_hash.hpp"
 #include "fluxgraph/core/types.hpp"
+#include "fluxgraph/core/units.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -18,6 +21,15 @@ struct Signal {
       : value(v), unit(u) {}
 };
 
+/// Receives every successful SignalStore::write (see set_write_observer)
+class SignalWriteObserver {
+public:
+  virtual ~SignalWriteObserver() = default;
+
+  /// @param unit Normalized unit actually stored
+  virtual void on_write(SignalId id, double value, const std::string &unit) = 0;
+};
+
 /// Central storage for all signal values and metadata
 /// Single-writer by design - no internal synchronization
 class SignalStore {
@@ -25,10 +37,18 @@ public:
   SignalStore();
   ~SignalStore();
 
-  /// Write a signal value with unit metadata
+  /// Write a signal value with unit metadata.
+  /// A unit differing from the declared one throws, unless unit conversion
+  /// is enabled and the registry can convert it (then the converted value
+  /// is stored under the declared unit).
   void write(SignalId id, double value,
              const std::string &unit = "dimensionless");
 
+  /// Convert external writes in a compatible unit to the declared unit
+  /// (e.g. K written to a degC signal) instead of throwing. Off by default.
+  void set_unit_conversion(bool enabled) { convert_units_ = enabled; }
+  bool unit_conversion() const { return convert_units_; }
+
   /// Write value to target signal using unit metadata from source signal.
   /// Falls back to "dimensionless" when source is invalid/unwritten.
   void write_with_source_unit(SignalId target, double value, SignalId source);
@@ -37,15 +57,42 @@ public:
   /// This is used for internal edge propagation to avoid source-unit copying.
   void write_with_contract_unit(SignalId id, double value);
 
+  /// Store a value whose unit was checked when its handle was bound (see
+  /// TypedSignal): the declared unit is assumed, so once the slot has been
+  /// written this is a plain double store plus the observer notification.
+  void write_prevalidated(SignalId id, double value) {
+    const size_t index = static_cast<size_t>(id);
+    if (index >= values_.size() || has_signal_[index] == 0U) {
+      write_with_contract_unit(id, value);
+      return;
+    }
+    values_[index] = value;
+    if (write_observer_ != nullptr) {
+      write_observer_->on_write(id, value, units_[index]);
+    }
+  }
+
   /// Read a signal (value + unit)
   Signal read(SignalId id) const;
 
   /// Read only the value (convenience method)
   double read_value(SignalId id) const;
 
+  /// Read many values at once (read_value semantics for each id)
+  /// @param out Receives count values, out[i] for ids[i]
+  void gather_values(const SignalId *ids, size_t count, double *out) const;
+
+  /// Feed every slot's value bits into hasher in SignalId order (unwritten
+  /// slots hash as a fixed marker; trailing unwritten slots are skipped so
+  /// reserve() history does not change the digest)
+  void hash_values(StateHasher &hasher) const;
+
   /// Read only the unit (convenience method)
   const std::string &read_unit(SignalId id) const;
 
+  /// True once the signal has been written
+  bool is_written(SignalId id) const;
+
   /// Check if a signal is driven by physics simulation
   bool is_physics_driven(SignalId id) const;
 
@@ -53,9 +100,17 @@ public:
   void mark_physics_driven(SignalId id, bool driven);
 
   /// Declare expected unit for a signal (enforced on write)
+  /// Re-declaring the same unit is a no-op.
   void declare_unit(SignalId id, const std::string &expected_unit);
 
-  /// Validate that a unit matches the declared unit for a signal
+  /// Process-unique id of this store's unit contracts. Engine::tick uses it
+  /// to declare a program's contracts once per store. Copies get a fresh
+  /// id, since the source may gain contracts the copy never sees; a moved-to
+  /// store takes over the source's id along with its contracts.
+  uint64_t contract_set_id() const { return contract_set_id_.value; }
+
+  /// Validate that a unit matches the declared unit for a signal (or, with
+  /// unit conversion enabled, converts to it)
   /// Throws std::runtime_error if mismatch
   void validate_unit(SignalId id, const std::string &unit) const;
 
@@ -74,16 +129,47 @@ public:
   /// Clear all signals
   void clear();
 
+  /// Observe external writes (nullptr to detach). Engine::tick detaches the
+  /// observer while it runs, so only writes made between ticks are seen.
+  void set_write_observer(SignalWriteObserver *observer) {
+    write_observer_ = observer;
+  }
+  SignalWriteObserver *write_observer() const { return write_observer_; }
+
 private:
   void ensure_index(SignalId id);
+  void set_declared_unit(size_t index, const std::string &unit,
+                         UnitIndex unit_index);
+  UnitIndex write_unit_index(const std::string &unit);
+  std::optional<UnitConversion>
+  conversion_to_declared(const std::string &unit, size_t index,
+                         UnitIndex unit_index) const;
   static const std::string &dimensionless_unit();
 
-  std::vector<Signal> signals_;
+  // Copying issues a new id; moving hands the id over and re-issues the
+  // source's, so no two live stores share one
+  struct ContractSetId {
+    ContractSetId();
+    ContractSetId(const ContractSetId &other);
+    ContractSetId(ContractSetId &&other) noexcept;
+    ContractSetId &operator=(const ContractSetId &other);
+    ContractSetId &operator=(ContractSetId &&other) noexcept;
+    uint64_t value;
+  };
+
+  std::vector<double> values_;     ///< Unwritten slots hold a marker NaN
+  std::vector<std::string> units_; ///< Valid where has_signal_ is set
   std::vector<uint8_t> has_signal_;
   std::vector<uint8_t> physics_driven_;
   std::vector<std::string> declared_units_;
   std::vector<uint8_t> has_declared_unit_;
+  std::vector<UnitIndex> declared_unit_index_;
+  ContractSetId contract_set_id_;
   size_t signal_count_ = 0;
+  bool convert_units_ = false;
+  std::string last_write_unit_; ///< One-entry symbol -> index cache
+  UnitIndex last_write_unit_index_ = INVALID_UNIT_INDEX;
+  SignalWriteObserver *write_observer_ = nullptr;
 };
 
 } // namespace fluxgraph
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fluxgraph {
+
+/// Streaming 64-bit digest of simulation state.
+///
+/// Words are spread round-robin over four independent multiply-rotate lanes
+/// (the XXH64 round), so consecutive values carry no serial dependency and
+/// add(const double *, size_t) vectorizes. Hashing is bitwise: -0.0 and 0.0,
+/// or NaNs with different payloads, produce different digests. The digest
+/// depends on the order of additions.
+class StateHasher {
+public:
+  explicit StateHasher(uint64_t seed = 0)
+      : lanes_{seed + kPrime1 + kPrime2, seed + kPrime2, seed,
+               seed - kPrime1} {}
+
+  void add(uint64_t word) {
+    uint64_t &lane = lanes_[count_ & 3U];
+    lane = round(lane, word);
+    ++count_;
+  }
+
+  void add(double value) { add(to_bits(value)); }
+
+  void add(const double *values, size_t count) {
+    size_t i = 0;
+    for (; i < count && (count_ & 3U) != 0; ++i) {
+      add(values[i]);
+    }
+    for (; i + 4 <= count; i += 4) {
+      for (size_t lane = 0; lane < 4; ++lane) {
+        lanes_[lane] = round(lanes_[lane], to_bits(values[i + lane]));
+      }
+      count_ += 4;
+    }
+    for (; i < count; ++i) {
+      add(values[i]);
+    }
+  }
+
+  /// Digest of everything added so far (the hasher stays usable)
+  uint64_t digest() const {
+    uint64_t hash = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) +
+                    rotl(lanes_[2], 12) + rotl(lanes_[3], 18);
+    for (uint64_t lane : lanes_) {
+      hash ^= round(0, lane);
+      hash = hash * kPrime1 + kPrime4;
+    }
+    hash += count_;
+
+    hash ^= hash >> 33U;
+    hash *= kPrime2;
+    hash ^= hash >> 29U;
+    hash *= kPrime3;
+    hash ^= hash >> 32U;
+    return hash;
+  }
+
+private:
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+  static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+
+  static uint64_t rotl(uint64_t value, unsigned bits) {
+    return (value << bits) | (value >> (64U - bits));
+  }
+
+  static uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    acc = rotl(acc, 31);
+    return acc * kPrime1;
+  }
+
+  static uint64_t to_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  std::array<uint64_t, 4> lanes_;
+  uint64_t count_ = 0;
+};
+
+} // namespace fluxgraph
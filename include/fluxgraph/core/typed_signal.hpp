@@ -0,0 +1,91 @@
+#pragma once
+
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/core/quantity.hpp"
+#include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/core/units.hpp"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace fluxgraph {
+
+/// Signal handle whose unit is part of its type.
+///
+/// bind() checks the unit once at runtime (registry definition, declared
+/// contract, current slot unit) and declares it on the store. After that,
+/// write() accepts any Quantity convertible to U - mismatched dimensions
+/// fail to compile - and stores the converted double without string
+/// compares; read() returns the raw value tagged as Quantity<U>.
+///
+/// Model code can bind handles once (e.g. on the first tick) and use them
+/// on the hot path:
+///
+///   auto temp = TypedSignal<units::degC>::bind(store, temp_id);
+///   temp.write(store, Quantity<units::K>(300.0)); // stored as 26.85 degC
+template <typename U> class TypedSignal {
+public:
+  TypedSignal() = default;
+
+  /// @throws std::runtime_error if U disagrees with the UnitRegistry entry
+  ///         for U::symbol or the signal declares another unit
+  static TypedSignal bind(SignalStore &store, SignalId id) {
+    if (id == INVALID_SIGNAL) {
+      throw std::runtime_error("TypedSignal: invalid signal id");
+    }
+    check_registry();
+    const std::string symbol = U::symbol;
+    if (store.has_declared_unit(id) && store.declared_unit(id) != symbol) {
+      throw std::runtime_error("TypedSignal: signal " + std::to_string(id) +
+                               " declares unit '" + store.declared_unit(id) +
+                               "', handle is '" + symbol + "'");
+    }
+    store.declare_unit(id, symbol);
+    if (store.is_written(id) && store.read_unit(id) != symbol) {
+      // Written as dimensionless before any contract existed: relabel, as
+      // a string write in the declared unit would
+      store.write_with_contract_unit(id, store.read_value(id));
+    }
+    return TypedSignal(id);
+  }
+
+  /// @throws std::invalid_argument if path is not interned
+  static TypedSignal bind(SignalStore &store, const SignalNamespace &ns,
+                          std::string_view path) {
+    const SignalId id = ns.resolve(path);
+    if (id == INVALID_SIGNAL) {
+      throw std::invalid_argument("TypedSignal: unknown signal path '" +
+                                  std::string(path) + "'");
+    }
+    return bind(store, id);
+  }
+
+  SignalId id() const { return id_; }
+  bool valid() const { return id_ != INVALID_SIGNAL; }
+
+  void write(SignalStore &store, Quantity<U> quantity) const {
+    store.write_prevalidated(id_, quantity.value());
+  }
+
+  Quantity<U> read(const SignalStore &store) const {
+    return Quantity<U>(store.read_value(id_));
+  }
+
+private:
+  explicit TypedSignal(SignalId id) : id_(id) {}
+
+  static void check_registry() {
+    const UnitDef *def = UnitRegistry::instance().find(U::symbol);
+    if (def == nullptr || def->dimension != U::dimension::vector() ||
+        def->kind != U::kind || def->scale_to_si != U::scale_to_si ||
+        def->offset_to_si != U::offset_to_si) {
+      throw std::runtime_error(std::string("TypedSignal: unit '") +
+                               U::symbol +
+                               "' does not match the unit registry");
+    }
+  }
+
+  SignalId id_ = INVALID_SIGNAL;
+};
+
+} // namespace fluxgraph
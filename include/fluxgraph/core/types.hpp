@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -77,8 +78,32 @@ class ParamValue;
 using ParamArray = std::vector<ParamValue>;
 using ParamObject = std::map<std::string, ParamValue>;
 using ParamScalar = std::variant<double, int64_t, bool, std::string>;
-using ParamVariant =
-    std::variant<double, int64_t, bool, std::string, ParamArray, ParamObject>;
+
+/// Packed numeric array: a vector (columns == 0) or a rectangular row-major
+/// matrix (columns == row length) in one contiguous allocation. Loaders
+/// produce it for arrays whose leaves are all numbers; read it through
+/// param::as_numbers(), which also accepts the equivalent nested ParamArray.
+struct ParamNumbers {
+  std::vector<double> values;
+  size_t columns = 0;
+  bool integral = false; ///< Every element was an integer in the source
+
+  size_t rank() const { return columns == 0 ? 1 : 2; }
+  size_t rows() const {
+    return columns == 0 ? values.size() : values.size() / columns;
+  }
+};
+
+inline bool operator==(const ParamNumbers &lhs, const ParamNumbers &rhs) {
+  return lhs.columns == rhs.columns && lhs.integral == rhs.integral &&
+         lhs.values == rhs.values;
+}
+inline bool operator!=(const ParamNumbers &lhs, const ParamNumbers &rhs) {
+  return !(lhs == rhs);
+}
+
+using ParamVariant = std::variant<double, int64_t, bool, std::string,
+                                  ParamArray, ParamObject, ParamNumbers>;
 
 /// Structured parameter value used for graph model/transform parameters.
 /// Command transport continues to use `Variant`.
@@ -1,20 +1,72 @@
 #pragma once
 
 #include "fluxgraph/core/types.hpp"
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace fluxgraph {
 
-/// Curated unit registry with dimensional and conversion semantics.
+/// Dense index of a unit in the registry
+using UnitIndex = uint16_t;
+constexpr UnitIndex INVALID_UNIT_INDEX = 0xFFFF;
+
+/// Unit registry with dimensional and conversion semantics.
+///
+/// Starts with a curated set of units; more can be registered at runtime,
+/// and compound expressions over known units are parsed on first use:
+/// `kg*m^2/s^2`, `L/min`, `kPa`, `mbar`. Terms are unit symbols with an
+/// optional SI prefix (T G M k h da d c m u n p) and an optional integer
+/// exponent (`^2`, `^-1`), joined left to right by `*` and `/`; `1` is
+/// allowed as a term (`1/s`). Offset units (degC) are only valid on their
+/// own. Expressions parsed by find()/index_of() are registered under their
+/// spelling, so the next lookup is a single hash probe, and unparseable
+/// spellings are cached as unknown (up to a fixed count). Per-sample paths
+/// use lookup() and the symbol overload of conversion(), which parse
+/// without registering, so arbitrary provider units cannot grow the
+/// registry.
+///
+/// Units get dense indices and every (from, to) pair among the first 256
+/// is resolved into a conversion table, so hot paths that already hold
+/// indices convert with one array lookup and an FMA. All members are safe
+/// to call concurrently; lookups take a shared lock, registration and
+/// parsing an exclusive one.
 class UnitRegistry {
 public:
-  static const UnitRegistry &instance();
+  static UnitRegistry &instance();
 
+  /// Definition for a symbol or parseable expression (nullptr if unknown).
+  /// The pointer stays valid for the registry's lifetime.
   const UnitDef *find(std::string_view symbol) const;
   bool contains(std::string_view symbol) const;
 
+  /// Dense index of a symbol or parseable expression (INVALID_UNIT_INDEX if
+  /// unknown)
+  UnitIndex index_of(std::string_view symbol) const;
+
+  /// Dense index of an already registered symbol; never parses or registers
+  UnitIndex lookup(std::string_view symbol) const;
+
+  /// Unit definition by index (index must be < size())
+  const UnitDef &unit(UnitIndex index) const;
+
+  size_t size() const;
+
+  /// Precomputed conversion, or nullopt when either index is invalid or the
+  /// units are incompatible (see resolve_conversion for the rules)
+  std::optional<UnitConversion> conversion(UnitIndex from, UnitIndex to) const;
+
+  /// Same for symbols or expressions; unregistered expressions are parsed
+  /// for this call only
+  std::optional<UnitConversion> conversion(std::string_view from_symbol,
+                                           std::string_view to_symbol) const;
+
   /// Resolve conversion from `from_symbol` to `to_symbol`.
   /// Throws std::runtime_error when units are missing or incompatible.
   UnitConversion resolve_conversion(const std::string &from_symbol,
@@ -24,10 +76,34 @@ public:
   bool are_dimensionally_compatible(const std::string &lhs_symbol,
                                     const std::string &rhs_symbol) const;
 
+  /// Add a unit usable on its own and as a term in expressions.
+  /// Re-registering an identical definition returns the existing index.
+  /// @throws std::invalid_argument on an empty symbol, a symbol containing
+  ///         `*`, `/` or `^`, or a conflicting existing definition
+  UnitIndex register_unit(const UnitDef &def);
+
+  /// Parse an expression without registering it (std::nullopt if invalid)
+  std::optional<UnitDef> parse(std::string_view expression) const;
+
 private:
   UnitRegistry();
 
-  std::unordered_map<std::string, UnitDef> units_;
+  UnitIndex find_locked(std::string_view symbol) const;
+  UnitIndex find_or_parse(std::string_view symbol) const;
+  std::optional<UnitDef> parse_locked(std::string_view expression) const;
+  UnitIndex add_locked(UnitDef def, bool term) const;
+  void fill_conversions_locked(size_t index) const;
+
+  // Parsed expressions are added from const lookups, so storage is mutable
+  // and guarded by mutex_. A deque keeps UnitDef addresses stable.
+  mutable std::shared_mutex mutex_;
+  mutable std::deque<UnitDef> units_;
+  mutable std::vector<uint8_t> is_term_; ///< Usable as a prefixed term
+  mutable std::unordered_map<std::string, UnitIndex> index_;
+  mutable std::unordered_set<std::string> unparseable_;
+  mutable size_t stride_ = 0; ///< Row length of the conversion table
+  mutable std::vector<UnitConversion> conversions_; ///< Row = from
+  mutable std::vector<uint8_t> convertible_;
 };
 
 } // namespace fluxgraph
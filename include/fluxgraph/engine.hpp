@@ -1,14 +1,27 @@
 #pragma once
 
 #include "fluxgraph/command.hpp"
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/generated_program.hpp"
 #include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/profiler.hpp"
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace fluxgraph {
 
+/// Wall-clock cost of one tick's execution stages
+struct TickStageTimes {
+  std::chrono::nanoseconds models{0};
+  std::chrono::nanoseconds edges{0};
+  std::chrono::nanoseconds rules{0};
+};
+
 /// Main simulation engine with five-stage tick execution
 /// Execution model:
 /// 1. Input boundary freeze (external writes before tick begin)
@@ -21,7 +34,9 @@ public:
   Engine();
   ~Engine();
 
-  /// Load a compiled program into the engine
+  /// Load a compiled program into the engine. If generated code registered
+  /// for the program's layout binds (see GeneratedProgram), models and
+  /// edges run through it.
   /// @param program Compiled graph program
   void load(CompiledProgram program);
 
@@ -36,12 +51,77 @@ public:
   /// @return All commands generated since last drain
   std::vector<Command> drain_commands();
 
+  /// Drop queued commands without materializing them (replay/batch runs)
+  /// @return Number of commands dropped
+  size_t discard_commands();
+
   /// Reset all models and transforms to initial state
   void reset();
 
   /// Check if a program is loaded
   bool is_loaded() const { return loaded_; }
 
+  /// Host <-> program id translation of the loaded program (empty unless
+  /// it was compiled with SignalLayout::execution_order over a namespace
+  /// that already held ids)
+  const SignalIdMap &signal_id_map() const { return signal_id_map_; }
+
+  /// Use bound generated code when available (on by default). Turning it off
+  /// runs the interpreted stages against the same components.
+  void set_generated_programs(bool enabled) { use_generated_ = enabled; }
+
+  /// True while ticks run through generated code
+  bool generated_program_active() const {
+    return use_generated_ && generated_ != nullptr;
+  }
+
+  /// Enable per-stage tick timing (off by default; adds three clock reads)
+  void set_stage_timing(bool enabled) { stage_timing_ = enabled; }
+
+  /// Stage costs of the most recent tick (zero while timing is disabled)
+  const TickStageTimes &last_stage_times() const { return stage_times_; }
+
+  /// Compute compute_state_hash() at the end of every tick (off by default)
+  void set_state_hashing(bool enabled);
+  bool state_hashing() const { return state_hashing_; }
+
+  /// Digest after the most recent tick (0 while hashing is disabled or
+  /// before the first hashed tick)
+  uint64_t last_state_hash() const { return state_hash_; }
+
+  /// 64-bit digest of the store's value plane followed by each model's and
+  /// then each edge transform's internal state in program order. Bitwise,
+  /// so redundant instances fed identical inputs agree exactly until they
+  /// diverge.
+  uint64_t compute_state_hash(const SignalStore &store) const;
+
+  /// Enable sampled per-stage/per-component profiling. Replaces any active
+  /// profile; survives load() with accumulators resized to the new program.
+  /// Disabled profiling costs one pointer test per tick.
+  void enable_profiling(ProfilerOptions options = {});
+
+  /// Disable profiling and discard collected data
+  void disable_profiling();
+
+  /// Active profiler (nullptr while profiling is disabled)
+  const TickProfiler *profiler() const { return profiler_.get(); }
+
+  /// Top-N component costs labelled by model describe(), edge signal paths
+  /// ("source -> target") and rule id
+  /// @param ns Namespace used to compile the loaded program. With
+  ///        keep_external_ids it holds host ids; edge endpoints are
+  ///        translated through signal_id_map() before lookup.
+  /// @param top_n Maximum entries (0 = all)
+  /// @param component_only Exclude whole-tick and stage entries
+  std::vector<ProfileEntry> profile_report(const SignalNamespace &ns,
+                                           size_t top_n = 10,
+                                           bool component_only = true) const;
+
+  /// Chrome trace / Perfetto JSON for the retained window of sampled ticks
+  /// @param ns Namespace used to compile the loaded program (as for
+  ///        profile_report())
+  std::string export_chrome_trace(const SignalNamespace &ns) const;
+
 private:
   struct PendingCommand {
     DeviceId device = INVALID_DEVICE;
@@ -53,10 +133,33 @@ private:
   size_t required_signal_capacity_ = 0;
   size_t required_command_capacity_ = 0;
   std::vector<std::pair<SignalId, std::string>> signal_unit_contracts_;
+  uint64_t contracts_declared_on_ = 0; ///< SignalStore::contract_set_id()
+  SignalIdMap signal_id_map_;
+  ComponentArena arena_; // Must outlive edges_ and models_
   std::vector<CompiledEdge> edges_;
-  std::vector<std::unique_ptr<IModel>> models_;
+  std::vector<ModelPtr> models_;
   std::vector<CompiledRule> rules_;
   std::vector<PendingCommand> pending_commands_;
+  std::unique_ptr<GeneratedProgram> generated_;
+  bool use_generated_ = true;
+  bool stage_timing_ = false;
+  TickStageTimes stage_times_;
+  std::unique_ptr<TickProfiler> profiler_;
+  bool state_hashing_ = false;
+  uint64_t state_hash_ = 0;
+
+  // Stages 2-5 with per-stage timing into stage_times_
+  void tick_timed(double dt, SignalStore &store);
+
+  // Stages 2-5 with per-component spans recorded into profiler_
+  void tick_profiled(double dt, SignalStore &store);
+
+  std::string profile_label(ProfileComponent component, size_t index,
+                            const SignalNamespace &ns) const;
+
+  // Single-component bodies shared by the plain and profiled stage loops
+  void apply_edge(CompiledEdge &edge, double dt, SignalStore &store);
+  void evaluate_rule(const CompiledRule &rule, const SignalStore &store);
 
   // Five-stage tick implementation
   void process_edges(double dt, SignalStore &store);
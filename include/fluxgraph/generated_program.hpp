@@ -0,0 +1,59 @@
+#pragma once
+
+#include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Ahead-of-time replacement for the model and edge stages of one program.
+///
+/// fluxgraph-codegen emits a subclass per graph: the edge schedule is
+/// unrolled, stateless transforms are folded to constants, and the remaining
+/// transforms and models are called without virtual dispatch. A generated
+/// program works on the transform and model objects owned by the Engine, so
+/// reset(), state hashing and profiled ticks (which stay interpreted) see the
+/// same state either way.
+class GeneratedProgram {
+public:
+  virtual ~GeneratedProgram() = default;
+
+  /// Stage 2: same effect as the Engine's model loop
+  virtual void update_models(double dt, SignalStore &store) = 0;
+
+  /// Stage 3: same effect as the Engine's edge loop
+  virtual void process_edges(double dt, SignalStore &store) = 0;
+};
+
+/// Binds generated code to a loaded program's components. Returns nullptr
+/// when their types or folded parameters differ from what was generated.
+using GeneratedProgramFactory = std::unique_ptr<GeneratedProgram> (*)(
+    std::vector<CompiledEdge> &edges,
+    std::vector<ModelPtr> &models);
+
+/// Digest of a program's schedule: edge endpoints and delay flags in
+/// execution order, model describe() strings and unit contracts. Transform
+/// parameters are not included; factories check the ones they fold.
+uint64_t program_layout_hash(
+    const std::vector<CompiledEdge> &edges,
+    const std::vector<ModelPtr> &models,
+    const std::vector<std::pair<SignalId, std::string>> &unit_contracts);
+
+uint64_t program_layout_hash(const CompiledProgram &program);
+
+/// Register generated code for programs with layout_hash. Generated
+/// translation units call this during static initialization.
+/// @return true (so it can initialize a namespace-scope constant)
+bool register_generated_program(uint64_t layout_hash,
+                                GeneratedProgramFactory factory);
+
+/// First registered factory for layout_hash that binds, or nullptr
+std::unique_ptr<GeneratedProgram>
+bind_generated_program(uint64_t layout_hash, std::vector<CompiledEdge> &edges,
+                       std::vector<ModelPtr> &models);
+
+} // namespace fluxgraph
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fluxgraph/core/component_arena.hpp"
 #include "fluxgraph/core/namespace.hpp"
 #include "fluxgraph/graph/spec.hpp"
 #include "fluxgraph/model/interface.hpp"
@@ -19,6 +20,16 @@ enum class DimensionalPolicy {
   strict = 1,
 };
 
+/// How SignalIds are assigned to a compiled graph's signals
+enum class SignalLayout {
+  /// In the order paths are first interned (spec order)
+  interning_order = 0,
+  /// Renumbered in the order a tick first touches each signal: each model's
+  /// signals together, then delay edges, then every edge source followed
+  /// by its targets in schedule order
+  execution_order = 1,
+};
+
 struct TransformSignature {
   enum class Contract {
     preserve,
@@ -98,17 +109,76 @@ struct CompilationOptions {
   double expected_dt = -1.0;
   DimensionalPolicy dimensional_policy = DimensionalPolicy::permissive;
   std::function<void(const std::string &)> warning_handler;
+
+  /// Construct built-in transforms and models in the program's arena (in
+  /// execution order) instead of one heap allocation each
+  bool component_arena = true;
+
+  SignalLayout signal_layout = SignalLayout::interning_order;
+
+  /// With SignalLayout::execution_order: leave ids already in the namespace
+  /// unchanged and translate through CompiledProgram::signal_id_map instead
+  /// of renumbering the namespace
+  bool keep_external_ids = false;
+};
+
+/// Translation between the SignalIds a host holds and the ids a program
+/// uses after SignalLayout::execution_order. Empty when they are the same.
+/// - Renumbered namespace: maps ids interned before compile (now stale) to
+///   their new ids.
+/// - keep_external_ids: maps namespace ids to program ids; the SignalStore
+///   is indexed by program ids.
+struct SignalIdMap {
+  std::vector<SignalId> to_program; ///< Indexed by host id
+  std::vector<SignalId> to_host;    ///< Indexed by program id
+  bool external_ids = false;        ///< Compiled with keep_external_ids
+
+  bool empty() const { return to_program.empty() && to_host.empty(); }
+
+  /// INVALID_SIGNAL when unmapped; host_id itself when empty()
+  SignalId program_id(SignalId host_id) const {
+    if (empty()) {
+      return host_id;
+    }
+    return host_id < to_program.size() ? to_program[host_id] : INVALID_SIGNAL;
+  }
+
+  /// INVALID_SIGNAL when unmapped; program_id itself when empty()
+  SignalId host_id(SignalId program_id) const {
+    if (empty()) {
+      return program_id;
+    }
+    return program_id < to_host.size() ? to_host[program_id] : INVALID_SIGNAL;
+  }
+
+  /// Id of a program signal in the namespace passed to compile(): the host
+  /// id with keep_external_ids, otherwise the program id (the namespace was
+  /// renumbered to match)
+  SignalId namespace_id(SignalId program_id) const {
+    return external_ids ? host_id(program_id) : program_id;
+  }
+
+  /// Inverse of namespace_id()
+  SignalId program_id_from_namespace(SignalId namespace_id) const {
+    return external_ids ? program_id(namespace_id) : namespace_id;
+  }
 };
 
+/// Owning pointers to components; see ComponentArena
+using TransformPtr = ComponentPtr<ITransform>;
+using ModelPtr = ComponentPtr<IModel>;
+
 /// Compiled edge with resolved signal IDs and instantiated transform
 struct CompiledEdge {
   SignalId source;
   SignalId target;
-  std::unique_ptr<ITransform> transform;
+  TransformPtr transform;
   bool is_delay;
 
   CompiledEdge(SignalId src, SignalId tgt, ITransform *tf, bool delay)
       : source(src), target(tgt), transform(tf), is_delay(delay) {}
+  CompiledEdge(SignalId src, SignalId tgt, TransformPtr tf, bool delay)
+      : source(src), target(tgt), transform(std::move(tf)), is_delay(delay) {}
 };
 
 /// Compiled rule with condition evaluator
@@ -122,12 +192,16 @@ struct CompiledRule {
 
 /// Compiled program ready for execution
 struct CompiledProgram {
+  /// Storage for built-in components; declared first so it outlives them.
+  /// Whoever takes edges and models must keep the arena alive as long.
+  ComponentArena arena;
   std::vector<CompiledEdge> edges;
-  std::vector<std::unique_ptr<IModel>> models;
+  std::vector<ModelPtr> models;
   std::vector<CompiledRule> rules;
   std::vector<std::pair<SignalId, std::string>> signal_unit_contracts;
   size_t required_signal_capacity = 0;
   size_t required_command_capacity = 0;
+  SignalIdMap signal_id_map;
 };
 
 /// Compiles GraphSpec into executable CompiledProgram
@@ -169,7 +243,8 @@ public:
   static bool is_model_registered(const std::string &type);
 
   /// Compile a graph specification
-  /// @param spec Graph specification (POD)
+  /// @param spec Graph specification (POD); template instances are expanded
+  /// first (see expand_templates)
   /// @param signal_ns Signal namespace for interning paths
   /// @param func_ns Function namespace for device/function IDs
   /// @param expected_dt Optional expected runtime timestep; if > 0, model
@@ -190,10 +265,16 @@ public:
   IModel *parse_model(const ModelSpec &spec, SignalNamespace &ns);
 
 private:
+  CompiledProgram compile_execution_layout(const GraphSpec &spec,
+                                           SignalNamespace &signal_ns,
+                                           FunctionNamespace &func_ns,
+                                           const CompilationOptions &options);
+
   // Scientific rigor: Graph validation
-  void topological_sort(std::vector<CompiledEdge> &edges);
+  /// @return Original index of each edge in the sorted order
+  std::vector<size_t> topological_sort(std::vector<CompiledEdge> &edges);
   void detect_cycles(const std::vector<CompiledEdge> &edges);
-  void validate_stability(const std::vector<std::unique_ptr<IModel>> &models,
+  void validate_stability(const std::vector<ModelPtr> &models,
                           double expected_dt);
 };
 
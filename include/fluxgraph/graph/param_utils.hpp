@@ -14,4 +14,12 @@ std::string as_string(const ParamValue &value, const std::string &path);
 const ParamArray &as_array(const ParamValue &value, const std::string &path);
 const ParamObject &as_object(const ParamValue &value, const std::string &path);
 
+/// Numeric vector (rank 1) or rectangular matrix (rank 2) as contiguous
+/// row-major doubles. A packed ParamNumbers is returned in place; a nested
+/// ParamArray (e.g. built in C++) is flattened into scratch. Integers are
+/// converted like as_double(). Arrays may be empty.
+/// @throws std::runtime_error naming the offending element or row
+const ParamNumbers &as_numbers(const ParamValue &value, const std::string &path,
+                               size_t rank, ParamNumbers &scratch);
+
 } // namespace fluxgraph::param
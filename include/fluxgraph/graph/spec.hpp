@@ -48,12 +48,37 @@ struct RuleSpec {
   std::string on_error;            // e.g., "log_and_continue"
 };
 
+/// Reusable subgraph, stamped out once per TemplateInstanceSpec.
+///
+/// Any string in the body (paths, ids, units, conditions, action fields,
+/// string params) may contain `${prefix}`, replaced by the instance prefix,
+/// and `${name}` for a declared parameter. A param value that is exactly
+/// `${name}` takes the parameter's value and type; inside longer strings
+/// the parameter must be a string. Model and transform types are literal.
+struct GraphTemplateSpec {
+  std::string name;
+  ParamMap params; // Declared parameters with their default values
+  std::vector<SignalSpec> signals;
+  std::vector<ModelSpec> models;
+  std::vector<EdgeSpec> edges;
+  std::vector<RuleSpec> rules;
+};
+
+/// One instantiation of a GraphTemplateSpec
+struct TemplateInstanceSpec {
+  std::string template_name;
+  std::string prefix; // e.g., "zone12"
+  ParamMap params;    // Overrides of the template's declared parameters
+};
+
 /// Complete graph specification (protocol-agnostic POD)
 struct GraphSpec {
   std::vector<SignalSpec> signals;
   std::vector<ModelSpec> models;
   std::vector<EdgeSpec> edges;
   std::vector<RuleSpec> rules;
+  std::vector<GraphTemplateSpec> templates;
+  std::vector<TemplateInstanceSpec> instances;
 };
 
 } // namespace fluxgraph
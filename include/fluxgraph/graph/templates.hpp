@@ -0,0 +1,20 @@
+#pragma once
+
+#include "fluxgraph/graph/spec.hpp"
+
+namespace fluxgraph {
+
+/// Stamp out spec.instances into plain signals/models/edges/rules.
+///
+/// Each template is validated once (unique name, well-formed and declared
+/// placeholders) before any instance is expanded. Expanded entries follow
+/// the spec's own entries, instance by instance in declaration order. The
+/// result has no templates or instances. GraphCompiler::compile calls this
+/// itself; it is public for tooling that wants to inspect the flat graph.
+///
+/// @throws std::runtime_error on unknown templates, duplicate template names
+///         or instance prefixes, undeclared placeholders or parameters, and
+///         non-string parameters used inside longer strings
+GraphSpec expand_templates(const GraphSpec &spec);
+
+} // namespace fluxgraph
@@ -6,27 +6,48 @@
 #endif
 
 #include "fluxgraph/graph/spec.hpp"
+#include <cstddef>
 #include <string>
 
 namespace fluxgraph::loaders {
 
+/// Parallel loading of large documents.
+///
+/// A block-style document whose top level holds only `signals`, `models`,
+/// `edges`, `rules`, `templates` and `instances` is split at section and
+/// list-item boundaries, and the pieces are parsed concurrently. Results
+/// are identical to a sequential load. Any error (or a layout the splitter
+/// does not handle: flow style, directives, other top-level keys) falls back
+/// to parsing the whole document, so diagnostics and line numbers are
+/// unchanged.
+struct YamlLoadOptions {
+  /// Worker threads (0 = std::thread::hardware_concurrency, 1 = sequential)
+  unsigned threads = 0;
+  /// Documents smaller than this are always parsed sequentially
+  size_t parallel_min_bytes = 256 * 1024;
+};
+
 /**
  * Load GraphSpec from YAML file.
  *
  * @param path Path to YAML file
+ * @param options Parallel loading options
  * @return GraphSpec Parsed graph specification
  * @throws std::runtime_error If file cannot be read or YAML is invalid
  * (includes line numbers)
  */
-GraphSpec load_yaml_file(const std::string &path);
+GraphSpec load_yaml_file(const std::string &path,
+                         const YamlLoadOptions &options = {});
 
 /**
  * Load GraphSpec from YAML string.
  *
  * @param yaml_content YAML string content
+ * @param options Parallel loading options
  * @return GraphSpec Parsed graph specification
  * @throws std::runtime_error If YAML is invalid (includes line numbers)
  */
-GraphSpec load_yaml_string(const std::string &yaml_content);
+GraphSpec load_yaml_string(const std::string &yaml_content,
+                           const YamlLoadOptions &options = {});
 
 } // namespace fluxgraph::loaders
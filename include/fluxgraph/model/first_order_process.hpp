@@ -29,10 +29,39 @@ public:
   double compute_stability_limit() const override;
   std::string describe() const override;
   std::vector<SignalId> output_signal_ids() const override;
+  void hash_state(StateHasher &hasher) const override;
 
-private:
-  double derivative(double y, double u) const;
+  /// One integration step with u held over dt, in Real arithmetic (shared
+  /// with the static graph layer and its precision policies)
+  /// @return Output after dt
+  template <typename Real>
+  static Real step(Real y, Real u, Real gain, Real tau_s, Real dt,
+                   IntegrationMethod method) {
+    const auto derivative = [&](Real state) {
+      return (gain * u - state) / tau_s;
+    };
+    if (method == IntegrationMethod::ForwardEuler) {
+      return y + derivative(y) * dt;
+    }
+    const Real half = Real(0.5);
+    const Real two = Real(2);
+    const Real k1 = derivative(y);
+    const Real k2 = derivative(y + half * dt * k1);
+    const Real k3 = derivative(y + half * dt * k2);
+    const Real k4 = derivative(y + dt * k3);
+    return y + (dt / Real(6)) * (k1 + two * k2 + two * k3 + k4);
+  }
+
+  /// Largest stable dt for lambda = -1 / tau_s under method
+  static constexpr double stability_limit(double tau_s,
+                                          IntegrationMethod method) {
+    const double limit = method == IntegrationMethod::Rk4
+                             ? kRk4NegativeRealAxisStabilityLimit
+                             : 2.0;
+    return limit / (1.0 / tau_s);
+  }
 
+private:
   std::string id_;
   SignalId output_signal_;
   SignalId input_signal_;
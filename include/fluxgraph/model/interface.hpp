@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/core/state_hash.hpp"
 #include <string>
 #include <vector>
 
@@ -31,6 +32,11 @@ public:
   /// Return all signals written by this model during tick().
   /// Used by compile-time ownership checks to enforce single-writer semantics.
   virtual std::vector<SignalId> output_signal_ids() const = 0;
+
+  /// Feed internal integration state into a determinism digest
+  /// (Engine::compute_state_hash). Models whose state is fully visible in
+  /// their output signals may keep the default no-op.
+  virtual void hash_state(StateHasher &hasher) const { (void)hasher; }
 };
 
 } // namespace fluxgraph
@@ -36,6 +36,7 @@ public:
   double compute_stability_limit() const override;
   std::string describe() const override;
   std::vector<SignalId> output_signal_ids() const override;
+  void hash_state(StateHasher &hasher) const override;
 
 private:
   struct Derivative {
@@ -27,11 +27,21 @@ public:
                               const std::string &input_signal_path,
                               SignalNamespace &ns);
 
+  /// Same model with A_d given as a row-major state_dim x state_dim array
+  StateSpaceSisoDiscreteModel(const std::string &id, std::size_t state_dim,
+                              std::vector<double> a_d_row_major,
+                              std::vector<double> b_d, std::vector<double> c,
+                              double d, std::vector<double> x0,
+                              const std::string &output_signal_path,
+                              const std::string &input_signal_path,
+                              SignalNamespace &ns);
+
   void tick(double dt, SignalStore &store) override;
   void reset() override;
   double compute_stability_limit() const override;
   std::string describe() const override;
   std::vector<SignalId> output_signal_ids() const override;
+  void hash_state(StateHasher &hasher) const override;
 
 private:
   static bool is_finite(double value);
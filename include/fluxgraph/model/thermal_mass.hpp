@@ -46,6 +46,42 @@ public:
 
   std::string describe() const override;
   std::vector<SignalId> output_signal_ids() const override;
+  void hash_state(StateHasher &hasher) const override;
+
+  /// One integration step with inputs held over dt, in Real arithmetic
+  /// (shared with the static graph layer and its precision policies)
+  /// @return Temperature after dt (degC)
+  template <typename Real>
+  static Real step(Real temperature, Real net_power, Real ambient,
+                   Real thermal_mass, Real heat_transfer_coeff, Real dt,
+                   ThermalIntegrationMethod method) {
+    const auto derivative = [&](Real temp) {
+      const Real heat_loss = heat_transfer_coeff * (temp - ambient);
+      return (net_power - heat_loss) / thermal_mass;
+    };
+    if (method == ThermalIntegrationMethod::ForwardEuler) {
+      // Forward Euler integration: T += dT/dt * dt
+      return temperature + derivative(temperature) * dt;
+    }
+    // Classic RK4 with fixed inputs over the tick interval.
+    const Real half = Real(0.5);
+    const Real two = Real(2);
+    const Real k1 = derivative(temperature);
+    const Real k2 = derivative(temperature + half * dt * k1);
+    const Real k3 = derivative(temperature + half * dt * k2);
+    const Real k4 = derivative(temperature + dt * k3);
+    return temperature + (dt / Real(6)) * (k1 + two * k2 + two * k3 + k4);
+  }
+
+  /// Largest stable dt for tau = C / h under method
+  static constexpr double stability_limit(double thermal_mass,
+                                          double heat_transfer_coeff,
+                                          ThermalIntegrationMethod method) {
+    const double tau = thermal_mass / heat_transfer_coeff;
+    return method == ThermalIntegrationMethod::ForwardEuler
+               ? 2.0 * tau
+               : kRk4NegativeRealAxisStabilityLimit * tau;
+  }
 
 private:
   std::string id_;
@@ -57,8 +93,6 @@ private:
   double temperature_;         // Current temp (degC)
   double initial_temp_;        // Initial temp for reset (degC)
   ThermalIntegrationMethod integration_method_;
-
-  double derivative(double temperature, double net_power, double ambient) const;
 };
 
 } // namespace fluxgraph
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Profiled unit of tick work
+enum class ProfileComponent : uint8_t {
+  tick,  ///< Whole sampled tick
+  stage, ///< Engine stage (0 = models, 1 = edges + commit, 2 = rules)
+  model, ///< One model update (index into program models)
+  edge,  ///< One edge transform (index into topological edge order)
+  rule,  ///< One rule evaluation including command emission
+};
+
+/// Returns "tick", "stage", "model", "edge" or "rule"
+const char *to_string(ProfileComponent component);
+
+/// Profiling configuration
+struct ProfilerOptions {
+  /// Profile one tick in every sample_interval (1 = every tick). Unsampled
+  /// ticks take the uninstrumented path.
+  uint32_t sample_interval = 1;
+
+  /// Most recent sampled ticks retained for Chrome trace export (0 = none)
+  size_t trace_window = 0;
+};
+
+/// Aggregated cost of one component across sampled ticks
+struct ProfileEntry {
+  ProfileComponent component = ProfileComponent::tick;
+  size_t index = 0;
+  std::string label;
+  uint64_t samples = 0;
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds max{0};
+
+  std::chrono::nanoseconds mean() const {
+    return samples == 0 ? std::chrono::nanoseconds(0)
+                        : total / static_cast<int64_t>(samples);
+  }
+};
+
+/// Sampled per-stage and per-component tick profiler.
+///
+/// Owned by Engine (see Engine::enable_profiling). Accumulators and the trace
+/// ring are sized when the program is loaded, so sampled ticks do not
+/// allocate.
+class TickProfiler {
+public:
+  using clock = std::chrono::steady_clock;
+  using Labeler = std::function<std::string(ProfileComponent, size_t)>;
+
+  TickProfiler(ProfilerOptions options, size_t model_count, size_t edge_count,
+               size_t rule_count);
+
+  /// Advance the tick counter; true when this tick should be profiled
+  bool sample_next_tick() {
+    const bool sample = ticks_seen_ % options_.sample_interval == 0;
+    ++ticks_seen_;
+    return sample;
+  }
+
+  /// Open a sampled tick (starts a new trace frame when tracing)
+  void begin_tick();
+
+  /// Record one component span of the current sampled tick
+  void record(ProfileComponent component, size_t index,
+              clock::time_point start, clock::time_point end);
+
+  const ProfilerOptions &options() const { return options_; }
+  uint64_t ticks_seen() const { return ticks_seen_; }
+  uint64_t sampled_ticks() const { return sampled_ticks_; }
+
+  /// Entries sorted by total cost (descending), ties by component/index.
+  /// @param top_n Maximum entries (0 = all)
+  /// @param component_only Restrict to models/edges/rules (skip tick/stage)
+  std::vector<ProfileEntry> report(const Labeler &label, size_t top_n,
+                                   bool component_only) const;
+
+  /// Chrome trace / Perfetto JSON ("traceEvents", complete "X" events) for
+  /// the retained window of sampled ticks
+  std::string chrome_trace_json(const Labeler &label) const;
+
+  /// Clear accumulators and the trace window
+  void reset();
+
+private:
+  struct Accumulator {
+    uint64_t samples = 0;
+    int64_t total_ns = 0;
+    int64_t max_ns = 0;
+  };
+
+  struct TraceEvent {
+    ProfileComponent component;
+    uint32_t index;
+    int64_t start_ns; // Relative to epoch_
+    int64_t duration_ns;
+  };
+
+  struct TraceFrame {
+    uint64_t tick = 0;
+    std::vector<TraceEvent> events;
+  };
+
+  std::vector<Accumulator> &accumulators(ProfileComponent component);
+  const std::vector<Accumulator> &
+  accumulators(ProfileComponent component) const;
+
+  ProfilerOptions options_;
+  clock::time_point epoch_;
+  uint64_t ticks_seen_ = 0;
+  uint64_t sampled_ticks_ = 0;
+
+  std::vector<Accumulator> tick_;
+  std::vector<Accumulator> stages_;
+  std::vector<Accumulator> models_;
+  std::vector<Accumulator> edges_;
+  std::vector<Accumulator> rules_;
+
+  std::vector<TraceFrame> frames_; // Ring of trace_window frames
+  size_t next_frame_ = 0;
+  TraceFrame *current_frame_ = nullptr;
+};
+
+} // namespace fluxgraph
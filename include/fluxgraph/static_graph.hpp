@@ -0,0 +1,520 @@
+#pragma once
+
+#include "fluxgraph/core/quantity.hpp"
+#include "fluxgraph/model/first_order_process.hpp"
+#include "fluxgraph/model/thermal_mass.hpp"
+#include "fluxgraph/transform/deadband.hpp"
+#include "fluxgraph/transform/first_order_lag.hpp"
+#include "fluxgraph/transform/linear.hpp"
+#include "fluxgraph/transform/noise.hpp"
+#include "fluxgraph/transform/rate_limiter.hpp"
+#include "fluxgraph/transform/saturation.hpp"
+#include "fluxgraph/transform/unit_convert.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// Header-only graphs declared as types, for targets without a heap.
+///
+/// A graph is a list of Edge<> and Model<> components over SignalSlot<>
+/// indices. Ordering and cycle checks run at compile time with the same
+/// rules as GraphCompiler (delay edges first, then non-delay edges in
+/// topological order with ties broken by signal id; cycles need a delay
+/// edge). Signal values live in a std::array, component state in a
+/// std::tuple; nothing is allocated and nothing is looked up by string.
+///
+///   using namespace fluxgraph::static_graph;
+///   using Power = SignalSlot<0>;
+///   using Ambient = SignalSlot<1>;
+///   using Temp = SignalSlot<2>;
+///   using Reading = SignalSlot<3>;
+///   using Plant = Graph<
+///       Model<ThermalMass<Temp, Power, Ambient, std::ratio<1000>,
+///                         std::ratio<10>, std::ratio<25>>>,
+///       Edge<Temp, Reading, FirstOrderLag<std::ratio<1, 2>>>>;
+///   static_assert(Plant::supports_dt(0.1));
+///
+///   Plant plant;
+///   plant.write<Power>(100.0);
+///   plant.tick(0.1);
+///   double reading = plant.read<Reading>();
+///
+/// Parameters are types: std::ratio, or any type with a static constexpr
+/// double `value`. Transforms and models reuse the runtime classes' math,
+/// so a static graph and the Engine running the equivalent GraphSpec
+/// produce the same values.
+namespace fluxgraph::static_graph {
+
+/// Compile-time parameter value
+template <typename T> inline constexpr double value_v = T::value;
+template <std::intmax_t N, std::intmax_t D>
+inline constexpr double value_v<std::ratio<N, D>> =
+    static_cast<double>(N) / static_cast<double>(D);
+
+/// Positive infinity as a parameter type (e.g. an open clamp bound)
+struct Infinity {
+  static constexpr double value = std::numeric_limits<double>::infinity();
+};
+struct NegativeInfinity {
+  static constexpr double value = -std::numeric_limits<double>::infinity();
+};
+
+/// Index into the graph's value array
+template <std::size_t Id> struct SignalSlot {
+  static constexpr std::size_t id = Id;
+};
+
+// --- Transforms --------------------------------------------------------------
+
+template <typename Scale, typename Offset = std::ratio<0>,
+          typename ClampMin = NegativeInfinity,
+          typename ClampMax = Infinity>
+struct Linear {
+  using type = LinearTransform;
+  static constexpr bool is_delay = false;
+  static type make() {
+    return type(value_v<Scale>, value_v<Offset>, value_v<ClampMin>,
+                value_v<ClampMax>);
+  }
+};
+
+template <typename Min, typename Max> struct Saturation {
+  using type = SaturationTransform;
+  static constexpr bool is_delay = false;
+  static type make() { return type(value_v<Min>, value_v<Max>); }
+};
+
+template <typename Threshold> struct Deadband {
+  using type = DeadbandTransform;
+  static constexpr bool is_delay = false;
+  static type make() { return type(value_v<Threshold>); }
+};
+
+/// Conversion between compile-time units (see quantity.hpp)
+template <typename From, typename To> struct UnitConvert {
+  using type = UnitConvertTransform;
+  static constexpr bool is_delay = false;
+  static type make() {
+    return type(unit_conversion<From, To>::scale,
+                unit_conversion<From, To>::offset);
+  }
+};
+
+template <typename TauSec> struct FirstOrderLag {
+  using type = FirstOrderLagTransform;
+  static constexpr bool is_delay = false;
+  static type make() { return type(value_v<TauSec>); }
+};
+
+template <typename MaxRatePerSec> struct RateLimiter {
+  using type = RateLimiterTransform;
+  static constexpr bool is_delay = false;
+  static type make() { return type(value_v<MaxRatePerSec>); }
+};
+
+template <typename Amplitude, std::uint32_t Seed = 0U> struct Noise {
+  using type = NoiseTransform;
+  static constexpr bool is_delay = false;
+  static type make() { return type(value_v<Amplitude>, Seed); }
+};
+
+/// DelayTransform semantics over a fixed ring of Capacity samples. Delays
+/// longer than Capacity ticks are cut to Capacity; check supports_dt().
+template <std::size_t Capacity> class FixedDelay {
+public:
+  static_assert(Capacity > 0, "FixedDelay: Capacity must be positive");
+
+  explicit FixedDelay(double delay_sec) : delay_sec_(delay_sec) {}
+
+  double apply(double input, double dt) {
+    if (delay_sec_ <= 0.0) {
+      return input;
+    }
+
+    std::size_t required = required_samples(delay_sec_, dt);
+    if (required > Capacity) {
+      required = Capacity;
+    }
+
+    buffer_[(head_ + size_) % kSlots] = input;
+    ++size_;
+
+    const double front = buffer_[head_];
+    if (size_ > required) {
+      head_ = (head_ + 1) % kSlots;
+      --size_;
+    }
+    return front;
+  }
+
+  void reset() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  static constexpr std::size_t required_samples(double delay_sec,
+                                                double dt) {
+    const auto samples = static_cast<std::size_t>(delay_sec / dt + 0.5);
+    return samples == 0 ? 1 : samples;
+  }
+
+private:
+  // One extra slot: a sample is pushed before the oldest is dropped
+  static constexpr std::size_t kSlots = Capacity + 1;
+
+  double delay_sec_;
+  std::array<double, kSlots> buffer_{};
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+template <typename DelaySec, std::size_t Capacity> struct Delay {
+  using type = FixedDelay<Capacity>;
+  static constexpr bool is_delay = true;
+  static type make() { return type(value_v<DelaySec>); }
+  static constexpr bool supports_dt(double dt) {
+    return value_v<DelaySec> <= 0.0 ||
+           type::required_samples(value_v<DelaySec>, dt) <= Capacity;
+  }
+};
+
+/// MovingAverageTransform semantics over a fixed window
+template <std::size_t Window> class FixedMovingAverage {
+public:
+  static_assert(Window > 0, "FixedMovingAverage: Window must be positive");
+
+  double apply(double input, double) {
+    if (size_ == Window) {
+      samples_[head_] = input;
+      head_ = (head_ + 1) % Window;
+    } else {
+      samples_[(head_ + size_) % Window] = input;
+      ++size_;
+    }
+
+    // Oldest to newest, the order std::accumulate sees in the deque
+    double sum = 0.0;
+    for (std::size_t i = 0; i < size_; ++i) {
+      sum += samples_[(head_ + i) % Window];
+    }
+    return sum / static_cast<double>(size_);
+  }
+
+  void reset() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+private:
+  std::array<double, Window> samples_{};
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+template <std::size_t Window> struct MovingAverage {
+  using type = FixedMovingAverage<Window>;
+  static constexpr bool is_delay = false;
+  static type make() { return type(); }
+};
+
+// --- Models ------------------------------------------------------------------
+
+/// ThermalMassModel on fixed slots (temperature in degC, power in W)
+template <typename Temp, typename Power, typename Ambient,
+          typename ThermalMass_JperK, typename HeatTransfer_WperK,
+          typename InitialTemp_degC,
+          ThermalIntegrationMethod Method =
+              ThermalIntegrationMethod::ForwardEuler>
+class ThermalMass {
+public:
+  static_assert(value_v<ThermalMass_JperK> > 0.0,
+                "ThermalMass: thermal mass must be > 0");
+  static_assert(value_v<HeatTransfer_WperK> > 0.0,
+                "ThermalMass: heat transfer coefficient must be > 0");
+
+  static constexpr std::size_t signals[] = {Temp::id, Power::id,
+                                            Ambient::id};
+
+  template <std::size_t N> void tick(double dt, std::array<double, N> &values) {
+    temperature_ = ThermalMassModel::step(
+        temperature_, values[Power::id], values[Ambient::id],
+        value_v<ThermalMass_JperK>, value_v<HeatTransfer_WperK>, dt, Method);
+    values[Temp::id] = temperature_;
+  }
+
+  void reset() { temperature_ = value_v<InitialTemp_degC>; }
+
+  static constexpr double stability_limit() {
+    return ThermalMassModel::stability_limit(
+        value_v<ThermalMass_JperK>, value_v<HeatTransfer_WperK>, Method);
+  }
+
+  double temperature() const { return temperature_; }
+
+private:
+  double temperature_ = value_v<InitialTemp_degC>;
+};
+
+/// FirstOrderProcessModel on fixed slots: dy/dt = (gain * u - y) / tau
+template <typename Output, typename Input, typename Gain, typename TauSec,
+          typename InitialOutput = std::ratio<0>,
+          IntegrationMethod Method = IntegrationMethod::ForwardEuler>
+class FirstOrderProcess {
+public:
+  static_assert(value_v<TauSec> > 0.0, "FirstOrderProcess: tau must be > 0");
+
+  static constexpr std::size_t signals[] = {Output::id, Input::id};
+
+  template <std::size_t N> void tick(double dt, std::array<double, N> &values) {
+    output_ = FirstOrderProcessModel::step(output_, values[Input::id],
+                                           value_v<Gain>, value_v<TauSec>,
+                                           dt, Method);
+    values[Output::id] = output_;
+  }
+
+  void reset() { output_ = value_v<InitialOutput>; }
+
+  static constexpr double stability_limit() {
+    return FirstOrderProcessModel::stability_limit(value_v<TauSec>, Method);
+  }
+
+  double output() const { return output_; }
+
+private:
+  double output_ = value_v<InitialOutput>;
+};
+
+// --- Components --------------------------------------------------------------
+
+/// Src -> Dst through transform T (one of the transform types above)
+template <typename Src, typename Dst, typename T> struct Edge {
+  static constexpr bool is_edge = true;
+  static constexpr std::size_t source = Src::id;
+  static constexpr std::size_t target = Dst::id;
+  static constexpr bool is_delay = T::is_delay;
+  static constexpr std::size_t max_signal =
+      Src::id > Dst::id ? Src::id : Dst::id;
+  using transform = T;
+  using state_type = typename T::type;
+  static state_type make() { return T::make(); }
+  static constexpr bool supports_dt(double dt) {
+    if constexpr (T::is_delay) {
+      return T::supports_dt(dt);
+    } else {
+      (void)dt;
+      return true;
+    }
+  }
+};
+
+/// Model M ticked before edges, in declaration order. M provides
+/// `signals[]`, `tick(dt, values)`, `reset()` and `stability_limit()`.
+template <typename M> struct Model {
+  static constexpr bool is_edge = false;
+  static constexpr std::size_t source = 0;
+  static constexpr std::size_t target = 0;
+  static constexpr bool is_delay = false;
+  static constexpr std::size_t max_signal = [] {
+    std::size_t max = 0;
+    for (std::size_t id : M::signals) {
+      max = id > max ? id : max;
+    }
+    return max;
+  }();
+  using model = M;
+  using state_type = M;
+  static state_type make() { return M(); }
+  static constexpr bool supports_dt(double dt) {
+    return dt <= M::stability_limit();
+  }
+};
+
+namespace detail {
+
+template <std::size_t ComponentCount, std::size_t EdgeCount> struct Schedule {
+  std::array<std::size_t, EdgeCount> edges{}; ///< Component indices, in order
+  std::size_t scheduled = 0; ///< < EdgeCount: non-delay cycle
+};
+
+/// Same order as compiler_internal::topological_sort_edges
+template <std::size_t ComponentCount, std::size_t EdgeCount,
+          std::size_t SignalCount>
+constexpr Schedule<ComponentCount, EdgeCount>
+schedule_edges(const std::array<bool, ComponentCount> &is_edge,
+               const std::array<bool, ComponentCount> &is_delay,
+               const std::array<std::size_t, ComponentCount> &source,
+               const std::array<std::size_t, ComponentCount> &target) {
+  Schedule<ComponentCount, EdgeCount> out{};
+  std::array<bool, ComponentCount> immediate{};
+  std::array<bool, SignalCount> present{};
+  std::array<std::size_t, SignalCount> in_degree{};
+  std::size_t immediate_count = 0;
+
+  for (std::size_t c = 0; c < ComponentCount; ++c) {
+    if (!is_edge[c]) {
+      continue;
+    }
+    if (is_delay[c]) {
+      out.edges[out.scheduled++] = c;
+    } else {
+      immediate[c] = true;
+      ++immediate_count;
+      present[source[c]] = true;
+      present[target[c]] = true;
+      ++in_degree[target[c]];
+    }
+  }
+
+  std::array<bool, SignalCount> ready{};
+  for (std::size_t s = 0; s < SignalCount; ++s) {
+    ready[s] = present[s] && in_degree[s] == 0;
+  }
+
+  std::size_t sorted = 0;
+  for (;;) {
+    std::size_t sig = SignalCount;
+    for (std::size_t s = 0; s < SignalCount; ++s) {
+      if (ready[s]) {
+        sig = s;
+        break;
+      }
+    }
+    if (sig == SignalCount) {
+      break;
+    }
+    ready[sig] = false;
+    for (std::size_t c = 0; c < ComponentCount; ++c) {
+      if (immediate[c] && source[c] == sig) {
+        immediate[c] = false;
+        out.edges[out.scheduled++] = c;
+        ++sorted;
+        if (--in_degree[target[c]] == 0) {
+          ready[target[c]] = true;
+        }
+      }
+    }
+  }
+
+  if (sorted != immediate_count) {
+    out.scheduled = EdgeCount + 1;
+  }
+  return out;
+}
+
+} // namespace detail
+
+/// Compile-time edge schedule of a component list
+template <typename... Components> struct schedule_of {
+  static constexpr std::size_t component_count = sizeof...(Components);
+  static constexpr std::size_t edge_count =
+      (std::size_t{0} + ... + (Components::is_edge ? 1 : 0));
+  static constexpr std::size_t signal_count =
+      component_count == 0
+          ? 0
+          : std::max({std::size_t{0}, Components::max_signal...}) + 1;
+
+  static constexpr detail::Schedule<component_count, edge_count> value =
+      detail::schedule_edges<component_count, edge_count, signal_count>(
+          {Components::is_edge...}, {Components::is_delay...},
+          {Components::source...}, {Components::target...});
+
+  static constexpr bool acyclic = value.scheduled == edge_count;
+};
+
+/// True when the non-delay edges among Components form a DAG
+template <typename... Components>
+inline constexpr bool is_acyclic_v = schedule_of<Components...>::acyclic;
+
+/// Graph over Components (Edge<> and Model<> in any order). Models tick in
+/// declaration order, then edges run in schedule order, matching
+/// Engine::tick; rules are not part of the static layer.
+template <typename... Components> class Graph {
+  using Schedule = schedule_of<Components...>;
+
+public:
+  static_assert(sizeof...(Components) > 0, "Graph: no components");
+  static_assert(Schedule::acyclic,
+                "Graph: cycle in non-delay edges. Add a delay edge in the "
+                "feedback path.");
+
+  static constexpr std::size_t signal_count = Schedule::signal_count;
+  static constexpr std::size_t edge_count = Schedule::edge_count;
+  static constexpr std::size_t model_count =
+      sizeof...(Components) - edge_count;
+
+  /// Component indices of the edges in execution order
+  static constexpr std::array<std::size_t, edge_count> edge_order =
+      Schedule::value.edges;
+
+  /// True when every model is stable at dt and every delay fits its buffer
+  static constexpr bool supports_dt(double dt) {
+    return dt > 0.0 && (... && Components::supports_dt(dt));
+  }
+
+  Graph() : components_(Components::make()...) {}
+
+  void tick(double dt) {
+    tick_models(dt, std::index_sequence_for<Components...>{});
+    tick_edges(dt, std::make_index_sequence<edge_count>{});
+  }
+
+  /// Reset transforms and models; signal values are kept (as Engine::reset)
+  void reset() {
+    std::apply([](auto &...component) { (component.reset(), ...); },
+               components_);
+  }
+
+  template <typename Slot> void write(double value) {
+    static_assert(Slot::id < signal_count, "Graph: slot out of range");
+    values_[Slot::id] = value;
+  }
+
+  template <typename Slot> double read() const {
+    static_assert(Slot::id < signal_count, "Graph: slot out of range");
+    return values_[Slot::id];
+  }
+
+  const std::array<double, signal_count> &values() const { return values_; }
+  std::array<double, signal_count> &values() { return values_; }
+
+  /// State of component I (transform or model object)
+  template <std::size_t I> auto &component() {
+    return std::get<I>(components_);
+  }
+
+private:
+  using Types = std::tuple<Components...>;
+
+  template <std::size_t... I>
+  void tick_models(double dt, std::index_sequence<I...>) {
+    (tick_model<I>(dt), ...);
+  }
+
+  template <std::size_t I> void tick_model(double dt) {
+    if constexpr (!std::tuple_element_t<I, Types>::is_edge) {
+      std::get<I>(components_).tick(dt, values_);
+    }
+  }
+
+  template <std::size_t... K>
+  void tick_edges([[maybe_unused]] double dt, std::index_sequence<K...>) {
+    (apply_edge<edge_order[K]>(dt), ...);
+  }
+
+  template <std::size_t I> void apply_edge(double dt) {
+    using E = std::tuple_element_t<I, Types>;
+    values_[E::target] =
+        std::get<I>(components_).apply(values_[E::source], dt);
+  }
+
+  std::tuple<typename Components::state_type...> components_;
+  std::array<double, signal_count> values_{};
+};
+
+} // namespace fluxgraph::static_graph
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/core/state_hash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fluxgraph {
+
+struct SignalIdMap;
+
+/// One external write captured between ticks
+struct JournalWrite {
+  SignalId id = INVALID_SIGNAL;
+  uint32_t unit = 0; ///< Index into InputJournal::units()
+  double value = 0.0;
+};
+
+/// One journaled tick: the writes that preceded it and its output digest
+struct JournalTick {
+  double dt = 0.0;
+  uint64_t first_write = 0; ///< Index into InputJournal::writes()
+  uint32_t write_count = 0;
+  uint64_t output_hash = 0; ///< hash_signal_values over output_ids()
+};
+
+/// StateHasher digest of the given signals' current values (read_value
+/// semantics, so unwritten signals hash as 0.0). Order-sensitive.
+uint64_t hash_signal_values(const SignalStore &store,
+                            const std::vector<SignalId> &ids);
+
+/// Records the externally written inputs of a run, tick by tick, for
+/// deterministic replay (see replay_journal()).
+///
+/// Attach with SignalStore::set_write_observer before the first provider
+/// write. Engine::tick hides its own writes from the observer, so the
+/// journal sees exactly the writes made between ticks. Call end_tick()
+/// after each Engine::tick to close the tick and stamp the digest of the
+/// output signals.
+class InputJournal : public SignalWriteObserver {
+public:
+  /// @param output_paths Signals hashed after every tick (empty = every
+  ///        path interned in ns that the program uses)
+  /// @param id_map Engine::signal_id_map() when the store's ids differ from
+  ///        ns (keep_external_ids); nullptr when they are the same
+  /// @throws std::invalid_argument on unknown paths
+  InputJournal(const SignalNamespace &ns,
+               const std::vector<std::string> &output_paths = {},
+               const SignalIdMap *id_map = nullptr);
+
+  void on_write(SignalId id, double value, const std::string &unit) override;
+
+  /// Close the current tick: assign pending writes to it and record dt and
+  /// the hash of the output signals
+  void end_tick(double dt, const SignalStore &store);
+
+  /// Pre-size storage to keep recording allocation-free
+  void reserve(size_t ticks, size_t writes);
+
+  size_t tick_count() const { return ticks_.size(); }
+  const std::vector<JournalTick> &ticks() const { return ticks_; }
+  const std::vector<JournalWrite> &writes() const { return writes_; }
+  const std::vector<std::string> &units() const { return units_; }
+  const std::vector<SignalId> &output_ids() const { return output_ids_; }
+
+  /// Writes made since the last end_tick() (not part of any tick yet)
+  size_t pending_writes() const { return writes_.size() - tick_first_write_; }
+
+  /// Save ticks and writes; signals are stored by path so the journal can
+  /// be replayed against a separately compiled namespace
+  /// @param id_map As for the constructor
+  /// @throws std::runtime_error on I/O failure
+  void save(const std::string &file_path, const SignalNamespace &ns,
+            const SignalIdMap *id_map = nullptr) const;
+
+  /// Load a saved journal, remapping signal paths through ns (and id_map,
+  /// as for save())
+  /// @throws std::runtime_error on I/O failure, malformed files or paths
+  ///         missing from ns
+  static InputJournal load(const std::string &file_path,
+                           const SignalNamespace &ns,
+                           const SignalIdMap *id_map = nullptr);
+
+private:
+  InputJournal() = default;
+
+  uint32_t intern_unit(const std::string &unit);
+
+  std::vector<SignalId> output_ids_;
+  std::vector<std::string> units_;
+  uint32_t last_unit_ = 0;
+  std::vector<JournalWrite> writes_;
+  std::vector<JournalTick> ticks_;
+  size_t tick_first_write_ = 0;
+};
+
+} // namespace fluxgraph
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "fluxgraph/core/types.hpp"
+#include "fluxgraph/trace/recorder.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Decoded contents of a trace file written by TraceRecorder
+struct TraceData {
+  TraceCompression compression = TraceCompression::none;
+  std::vector<SignalId> signal_ids;
+  std::vector<std::string> signal_paths;
+  std::vector<double> times;                // One entry per frame
+  std::vector<std::vector<double>> columns; // One column per signal
+
+  size_t frame_count() const { return times.size(); }
+};
+
+/// Load a trace file into memory
+/// @throws std::runtime_error if the file is missing, truncated or malformed
+TraceData read_trace(const std::string &file_path);
+
+} // namespace fluxgraph
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/core/signal_store.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fluxgraph {
+
+/// Column encoding used in trace files
+enum class TraceCompression : uint32_t {
+  none = 0,      ///< Raw doubles
+  xor_delta = 1, ///< XOR with previous value, zero bytes elided
+};
+
+/// Trace recorder configuration
+struct TraceRecorderOptions {
+  /// Frames (ticks) per block handed to the writer thread
+  size_t block_frames = 256;
+
+  /// Preallocated blocks in the ring (>= 2 so capture and write overlap)
+  size_t ring_blocks = 4;
+
+  TraceCompression compression = TraceCompression::none;
+
+  /// When every block is waiting on the writer: drop frames (true) or block
+  /// capture() until the writer frees a block (false)
+  bool drop_when_full = false;
+};
+
+/// Records selected signal values after each tick into a columnar binary
+/// trace file (read back with read_trace()).
+///
+/// capture() copies one frame into a preallocated ring of blocks; full
+/// blocks are encoded and written by a background thread. Capture never
+/// allocates and only synchronizes when a block fills.
+///
+/// Single-producer: call capture()/flush()/close() from the thread that
+/// ticks the engine.
+class TraceRecorder {
+public:
+  /// Open file_path and start the writer thread.
+  /// @param signal_paths Signals to record (must already be interned in ns)
+  /// @throws std::invalid_argument on unknown paths or invalid options
+  /// @throws std::runtime_error if the file cannot be opened
+  TraceRecorder(const std::string &file_path, const SignalNamespace &ns,
+                const std::vector<std::string> &signal_paths,
+                TraceRecorderOptions options = {});
+
+  /// Flushes and closes; write errors are swallowed (call close() to see them)
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+  /// Record the current value of every selected signal
+  /// @param time Simulation time stamped on the frame
+  void capture(const SignalStore &store, double time);
+
+  /// Hand the partial block to the writer and wait until all captured
+  /// frames are on disk
+  /// @throws std::runtime_error if a write failed
+  void flush();
+
+  /// Flush, stop the writer thread and close the file (idempotent)
+  /// @throws std::runtime_error if a write failed
+  void close();
+
+  size_t signal_count() const { return signal_ids_.size(); }
+  uint64_t frames_captured() const { return frames_captured_; }
+  uint64_t frames_dropped() const { return frames_dropped_; }
+  uint64_t blocks_written() const {
+    return blocks_written_.load(std::memory_order_acquire);
+  }
+
+private:
+  struct Block {
+    size_t frame_count = 0;
+    std::vector<double> times;  // block_frames
+    std::vector<double> values; // block_frames x signal_count, frame-major
+  };
+
+  void write_header(const std::vector<std::string> &signal_paths);
+  void submit_current_block();
+  bool acquire_next_block();
+  void writer_loop();
+  void write_block(const Block &block);
+
+  TraceRecorderOptions options_;
+  std::vector<SignalId> signal_ids_;
+  std::FILE *file_ = nullptr;
+  bool closed_ = false;
+
+  std::vector<Block> ring_;
+  Block *current_ = nullptr;
+  uint64_t next_sequence_ = 0; // Sequence of current_ (slot = seq % ring)
+  uint64_t frames_captured_ = 0;
+  uint64_t frames_dropped_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable submitted_cv_; // Writer waits for blocks
+  std::condition_variable written_cv_;   // Producer waits for free blocks
+  uint64_t blocks_submitted_ = 0;        // Guarded by mutex_
+  std::atomic<uint64_t> blocks_written_{0};
+  bool stopping_ = false;
+  std::atomic<bool> write_failed_{false};
+  std::vector<uint8_t> encode_buffer_; // Writer thread only
+  std::thread writer_;
+};
+
+} // namespace fluxgraph
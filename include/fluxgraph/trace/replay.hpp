@@ -0,0 +1,41 @@
+#pragma once
+
+#include "fluxgraph/engine.hpp"
+#include "fluxgraph/trace/journal.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace fluxgraph {
+
+/// Replay configuration
+struct ReplayOptions {
+  /// Stop at the first tick whose output hash differs from the journal
+  bool stop_on_divergence = true;
+};
+
+/// Outcome of replay_journal()
+struct ReplayResult {
+  uint64_t ticks_replayed = 0;
+  uint64_t divergent_ticks = 0;
+  bool deterministic() const { return divergent_ticks == 0; }
+
+  /// First divergent tick (valid when !deterministic())
+  uint64_t first_divergent_tick = 0;
+  uint64_t expected_hash = 0; ///< Journal digest at first_divergent_tick
+  uint64_t actual_hash = 0;   ///< Replayed digest at first_divergent_tick
+
+  uint64_t commands_discarded = 0;
+  std::chrono::nanoseconds elapsed{0};
+};
+
+/// Feed a journal into an engine as fast as it will tick.
+///
+/// For every journaled tick: re-apply the recorded external writes, tick
+/// with the recorded dt, and compare hash_signal_values() over the
+/// journal's outputs bitwise against the recorded digest. Commands are
+/// discarded each tick. engine and store must start in the state the
+/// recording started from (freshly loaded or reset, empty store).
+ReplayResult replay_journal(const InputJournal &journal, Engine &engine,
+                            SignalStore &store, ReplayOptions options = {});
+
+} // namespace fluxgraph
@@ -26,6 +26,8 @@ public:
     return new DeadbandTransform(threshold_);
   }
 
+  double threshold() const { return threshold_; }
+
 private:
   double threshold_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fluxgraph/transform/interface.hpp"
+#include <cstddef>
 #include <deque>
 
 namespace fluxgraph {
@@ -48,6 +49,14 @@ public:
     return copy;
   }
 
+  void hash_state(StateHasher &hasher) const override {
+    hasher.add(static_cast<uint64_t>(buffer_.size()));
+    for (double sample : buffer_) {
+      hasher.add(sample);
+    }
+    hasher.add(time_accumulated_);
+  }
+
 private:
   double delay_sec_;
   std::deque<double> buffer_;
@@ -43,6 +43,11 @@ public:
     return copy;
   }
 
+  void hash_state(StateHasher &hasher) const override {
+    hasher.add(static_cast<uint64_t>(initialized_ ? 1U : 0U));
+    hasher.add(output_);
+  }
+
 private:
   double tau_s_;
   double output_;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "fluxgraph/core/state_hash.hpp"
+
 namespace fluxgraph {
 
 /// Base interface for all signal transforms
@@ -19,6 +21,10 @@ public:
 
   /// Create a deep copy of this transform (including state)
   virtual ITransform *clone() const = 0;
+
+  /// Feed state carried between apply() calls into a determinism digest.
+  /// Stateless transforms keep the default no-op.
+  virtual void hash_state(StateHasher &hasher) const { (void)hasher; }
 };
 
 } // namespace fluxgraph
@@ -30,6 +30,11 @@ public:
     return new LinearTransform(scale_, offset_, clamp_min_, clamp_max_);
   }
 
+  double scale() const { return scale_; }
+  double offset() const { return offset_; }
+  double clamp_min() const { return clamp_min_; }
+  double clamp_max() const { return clamp_max_; }
+
 private:
   double scale_;
   double offset_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fluxgraph/transform/interface.hpp"
+#include <cstddef>
 #include <deque>
 #include <numeric>
 
@@ -39,6 +40,13 @@ public:
     return copy;
   }
 
+  void hash_state(StateHasher &hasher) const override {
+    hasher.add(static_cast<uint64_t>(samples_.size()));
+    for (double sample : samples_) {
+      hasher.add(sample);
+    }
+  }
+
 private:
   size_t window_size_;
   std::deque<double> samples_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fluxgraph/transform/interface.hpp"
+#include <cstdint>
 #include <random>
 
 namespace fluxgraph {
@@ -20,25 +21,37 @@ public:
     if (amplitude_ <= 0.0) {
       return input; // No noise
     }
+    ++draws_;
     return input + dist_(rng_);
   }
 
   void reset() override {
     rng_.seed(seed_); // Reset to initial seed
     dist_.reset();
+    draws_ = 0;
   }
 
   ITransform *clone() const override {
     auto *copy = new NoiseTransform(amplitude_, seed_);
     copy->rng_ = rng_; // Copy RNG state
+    copy->dist_ = dist_;
+    copy->draws_ = draws_;
     return copy;
   }
 
+  /// The generator state follows from the seed and the number of draws, so
+  /// those stand in for the 624-word Mersenne Twister state
+  void hash_state(StateHasher &hasher) const override {
+    hasher.add(static_cast<uint64_t>(seed_));
+    hasher.add(draws_);
+  }
+
 private:
   double amplitude_;
   uint32_t seed_;
   std::mt19937 rng_;
   std::normal_distribution<double> dist_;
+  uint64_t draws_ = 0;
 };
 
 } // namespace fluxgraph
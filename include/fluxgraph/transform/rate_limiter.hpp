@@ -47,6 +47,11 @@ public:
     return copy;
   }
 
+  void hash_state(StateHasher &hasher) const override {
+    hasher.add(static_cast<uint64_t>(initialized_ ? 1U : 0U));
+    hasher.add(last_output_);
+  }
+
 private:
   double max_rate_;
   double last_output_;
@@ -24,6 +24,9 @@ public:
     return new SaturationTransform(min_, max_);
   }
 
+  double min_value() const { return min_; }
+  double max_value() const { return max_; }
+
 private:
   double min_;
   double max_;
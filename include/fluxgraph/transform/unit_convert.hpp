@@ -21,6 +21,9 @@ public:
     return new UnitConvertTransform(scale_, offset_);
   }
 
+  double scale() const { return scale_; }
+  double offset() const { return offset_; }
+
 private:
   double scale_ = 1.0;
   double offset_ = 0.0;
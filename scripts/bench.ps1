@@ -1,7 +1,7 @@
 # FluxGraph benchmark wrapper (preset-first)
 # Usage:
 #   .\scripts\bench.ps1 [-Preset <name>] [-Config <cfg>] [-OutputDir <path>] [-IncludeOptional]
-#                      [-NoBuild] [-FailOnStatus] [-PolicyProfile <name>] [-PolicyFile <path>]
+#                      [-IncludeGraph] [-NoBuild] [-FailOnStatus] [-PolicyProfile <name>] [-PolicyFile <path>]
 #                      [-Baseline <path>] [-NoEvaluate]
 
 param(
@@ -9,6 +9,7 @@ param(
     [string]$Config = "",
     [string]$OutputDir = "",
     [switch]$IncludeOptional,
+    [switch]$IncludeGraph,
     [switch]$NoBuild,
     [switch]$FailOnStatus,
     [string]$PolicyProfile = "local",
@@ -64,6 +65,9 @@ $Args += @("--output-dir", $OutputDir)
 if ($IncludeOptional) {
     $Args += "--include-optional"
 }
+if ($IncludeGraph) {
+    $Args += "--include-graph"
+}
 if ($NoBuild) {
     $Args += "--no-build"
 }
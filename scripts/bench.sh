@@ -2,7 +2,7 @@
 # FluxGraph benchmark wrapper (preset-first)
 # Usage:
 #   ./scripts/bench.sh [--preset <name>] [--config <cfg>] [--output-dir <path>] [--include-optional]
-#                     [--no-build] [--fail-on-status] [--policy-profile <name>]
+#                     [--include-graph] [--no-build] [--fail-on-status] [--policy-profile <name>]
 #                     [--policy-file <path>] [--baseline <path>] [--no-evaluate]
 
 set -euo pipefail
@@ -33,7 +33,7 @@ while [[ $# -gt 0 ]]; do
       OUTPUT_DIR="$2"
       shift 2
       ;;
-    --include-optional|--no-build|--fail-on-status)
+    --include-optional|--include-graph|--no-build|--fail-on-status)
       EXTRA_ARGS+=("$1")
       shift
       ;;
@@ -54,7 +54,7 @@ while [[ $# -gt 0 ]]; do
       shift
       ;;
     -h|--help)
-      echo "Usage: $0 [--preset <name>] [--config <cfg>] [--output-dir <path>] [--include-optional] [--no-build] [--fail-on-status] [--policy-profile <name>] [--policy-file <path>] [--baseline <path>] [--no-evaluate]"
+      echo "Usage: $0 [--preset <name>] [--config <cfg>] [--output-dir <path>] [--include-optional] [--include-graph] [--no-build] [--fail-on-status] [--policy-profile <name>] [--policy-file <path>] [--baseline <path>] [--no-evaluate]"
       exit 0
       ;;
     *)
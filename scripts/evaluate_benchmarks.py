@@ -4,6 +4,7 @@
 from __future__ import annotations
 
 import argparse
+import fnmatch
 import json
 from pathlib import Path
 from typing import Dict, List, Tuple
@@ -113,6 +114,99 @@ def add_issue(
     issues.append(entry)
 
 
+def check_regression(
+    issues: List[Dict[str, object]],
+    check: str,
+    label: str,
+    cfg: Dict[str, object],
+    result_metrics: Dict[str, float],
+    baseline_metrics: Dict[str, float],
+) -> None:
+    """Compare metric_keys against the baseline; higher values are regressions."""
+    warn_pct = float(cfg.get("warn_pct", 20.0))
+    fail_pct = float(cfg.get("fail_pct", 50.0))
+    require_baseline = bool(cfg.get("require_baseline", False))
+    enforce_fail_threshold = bool(cfg.get("enforce_fail_threshold", False))
+    missing_metric_severity = str(cfg.get("missing_metric_severity", "error"))
+    missing_baseline_metric_severity = str(
+        cfg.get(
+            "missing_baseline_metric_severity",
+            "error" if require_baseline else "warning",
+        )
+    )
+    metric_keys = cfg.get("metric_keys", [])
+    if not isinstance(metric_keys, list):
+        metric_keys = []
+
+    if not baseline_metrics:
+        add_issue(
+            issues,
+            severity="error" if require_baseline else "warning",
+            check=check,
+            message=f"No baseline metrics provided for {label.lower()} regression check.",
+        )
+    else:
+        for key in metric_keys:
+            if not isinstance(key, str):
+                continue
+            if key not in result_metrics:
+                add_issue(
+                    issues,
+                    severity=missing_metric_severity,
+                    check=check,
+                    metric_key=key,
+                    message="Metric not found in benchmark results.",
+                )
+                continue
+            if key not in baseline_metrics:
+                add_issue(
+                    issues,
+                    severity=missing_baseline_metric_severity,
+                    check=check,
+                    metric_key=key,
+                    message="Metric not found in baseline data.",
+                )
+                continue
+
+            actual = float(result_metrics[key])
+            baseline = float(baseline_metrics[key])
+            if baseline <= 0:
+                invalid_baseline_severity = "error" if require_baseline or enforce_fail_threshold else "warning"
+                add_issue(
+                    issues,
+                    severity=invalid_baseline_severity,
+                    check=check,
+                    metric_key=key,
+                    actual=actual,
+                    expected=baseline,
+                    message="Baseline metric is non-positive; cannot compute regression percentage.",
+                )
+                continue
+
+            delta_pct = ((actual - baseline) / baseline) * 100.0
+            if delta_pct > fail_pct:
+                sev = "error" if enforce_fail_threshold else "warning"
+                add_issue(
+                    issues,
+                    severity=sev,
+                    check=check,
+                    metric_key=key,
+                    actual=actual,
+                    expected=baseline,
+                    message=(f"{label} regression {delta_pct:.2f}% exceeds fail threshold {fail_pct:.2f}%"),
+                )
+            elif delta_pct > warn_pct:
+                add_issue(
+                    issues,
+                    severity="warning",
+                    check=check,
+                    metric_key=key,
+                    actual=actual,
+                    expected=baseline,
+                    message=(f"{label} regression {delta_pct:.2f}% exceeds warning threshold {warn_pct:.2f}%"),
+                )
+
+
 def evaluate(
     results_doc: Dict[str, object],
     result_metrics: Dict[str, float],
@@ -145,8 +239,19 @@ def evaluate(
         metric_keys = alloc_cfg.get("metric_keys", [])
         if not isinstance(metric_keys, list):
             metric_keys = []
-
-        for key in metric_keys:
+        # Globs cover sweeps whose scenarios depend on the run (e.g. graph
+        # sizes); unlike metric_keys, a glob matching nothing is not an issue.
+        metric_globs = alloc_cfg.get("metric_globs", [])
+        if not isinstance(metric_globs, list):
+            metric_globs = []
+        globbed = [
+            key
+            for key in sorted(result_metrics)
+            if key not in metric_keys
+            and any(isinstance(g, str) and fnmatch.fnmatchcase(key, g) for g in metric_globs)
+        ]
+
+        for key in [*metric_keys, *globbed]:
             if not isinstance(key, str):
                 continue
             if key not in result_metrics:
@@ -173,88 +278,14 @@ def evaluate(
     # Check: latency regression against baseline
     latency_cfg = checks.get("latency_regression", {})
     if isinstance(latency_cfg, dict) and latency_cfg.get("enabled", False):
-        warn_pct = float(latency_cfg.get("warn_pct", 20.0))
-        fail_pct = float(latency_cfg.get("fail_pct", 50.0))
-        require_baseline = bool(latency_cfg.get("require_baseline", False))
-        enforce_fail_threshold = bool(latency_cfg.get("enforce_fail_threshold", False))
-        missing_metric_severity = str(latency_cfg.get("missing_metric_severity", "error"))
-        missing_baseline_metric_severity = str(
-            latency_cfg.get(
-                "missing_baseline_metric_severity",
-                "error" if require_baseline else "warning",
-            )
-        )
-        metric_keys = latency_cfg.get("metric_keys", [])
-        if not isinstance(metric_keys, list):
-            metric_keys = []
-
-        if not baseline_metrics:
-            add_issue(
-                issues,
-                severity="error" if require_baseline else "warning",
-                check="latency_regression",
-                message="No baseline metrics provided for latency regression check.",
-            )
-        else:
-            for key in metric_keys:
-                if not isinstance(key, str):
-                    continue
-                if key not in result_metrics:
-                    add_issue(
-                        issues,
-                        severity=missing_metric_severity,
-                        check="latency_regression",
-                        metric_key=key,
-                        message="Metric not found in benchmark results.",
-                    )
-                    continue
-                if key not in baseline_metrics:
-                    add_issue(
-                        issues,
-                        severity=missing_baseline_metric_severity,
-                        check="latency_regression",
-                        metric_key=key,
-                        message="Metric not found in baseline data.",
-                    )
-                    continue
-
-                actual = float(result_metrics[key])
-                baseline = float(baseline_metrics[key])
-                if baseline <= 0:
-                    invalid_baseline_severity = "error" if require_baseline or enforce_fail_threshold else "warning"
-                    add_issue(
-                        issues,
-                        severity=invalid_baseline_severity,
-                        check="latency_regression",
-                        metric_key=key,
-                        actual=actual,
-                        expected=baseline,
-                        message="Baseline metric is non-positive; cannot compute regression percentage.",
-                    )
-                    continue
-
-                delta_pct = ((actual - baseline) / baseline) * 100.0
-                if delta_pct > fail_pct:
-                    sev = "error" if enforce_fail_threshold else "warning"
-                    add_issue(
-                        issues,
-                        severity=sev,
-                        check="latency_regression",
-                        metric_key=key,
-                        actual=actual,
-                        expected=baseline,
-                        message=(f"Latency regression {delta_pct:.2f}% exceeds fail threshold {fail_pct:.2f}%"),
-                    )
-                elif delta_pct > warn_pct:
-                    add_issue(
-                        issues,
-                        severity="warning",
-                        check="latency_regression",
-                        metric_key=key,
-                        actual=actual,
-                        expected=baseline,
-                        message=(f"Latency regression {delta_pct:.2f}% exceeds warning threshold {warn_pct:.2f}%"),
-                    )
+        check_regression(issues, "latency_regression", "Latency", latency_cfg, result_metrics, baseline_metrics)
+
+    # Check: hardware-counter regression against baseline. Instruction counts
+    # do not depend on clock speed or co-tenants, so tight thresholds are
+    # usable on hosts where wall-clock latency is too noisy to gate on.
+    counter_cfg = checks.get("counter_regression", {})
+    if isinstance(counter_cfg, dict) and counter_cfg.get("enabled", False):
+        check_regression(issues, "counter_regression", "Counter", counter_cfg, result_metrics, baseline_metrics)
 
     errors = [i for i in issues if i.get("severity") == "error"]
     warnings = [i for i in issues if i.get("severity") == "warning"]
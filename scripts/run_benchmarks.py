@@ -4,6 +4,7 @@
 Usage examples:
   python scripts/run_benchmarks.py --preset dev-release
   python scripts/run_benchmarks.py --preset dev-windows-release --config Release
+  python scripts/run_benchmarks.py --include-graph --graph-max-edges 1000000
 """
 
 from __future__ import annotations
@@ -34,6 +35,42 @@ OPTIONAL_TARGETS = [
     "yaml_loader_bench",
 ]
 
+# Google Benchmark targets; results are read from --benchmark_out JSON
+GRAPH_TARGETS = [
+    "benchmark_graph",
+]
+
+# Hardware counter lines printed by benchmarks using support/perf_counters.hpp
+PERF_COUNTER_LABELS = {
+    "Instructions": "instructions_per_tick",
+    "Cycles": "cycles_per_tick",
+    "L1D misses": "l1d_misses_per_tick",
+    "LLC misses": "llc_misses_per_tick",
+    "Branch misses": "branch_misses_per_tick",
+}
+
+_TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+# Google Benchmark report fields that are not user counters
+_GBENCH_FIELDS = {
+    "name",
+    "family_index",
+    "per_family_instance_index",
+    "run_name",
+    "run_type",
+    "repetitions",
+    "repetition_index",
+    "threads",
+    "iterations",
+    "real_time",
+    "cpu_time",
+    "time_unit",
+    "aggregate_name",
+    "aggregate_unit",
+    "error_occurred",
+    "error_message",
+}
+
 
 def _coerce_text(value: object) -> str:
     if isinstance(value, str):
@@ -115,6 +152,30 @@ def parse_status(stdout_text: str) -> Dict[str, object]:
     return {"status": overall, "status_lines": lines}
 
 
+def parse_perf_counters(section_text: str) -> Dict[str, float]:
+    """Per-tick hardware counters from "  <Label>/tick: <value>" lines."""
+    counters: Dict[str, float] = {}
+    for label, key in PERF_COUNTER_LABELS.items():
+        match = re.search(
+            rf"^\s*{re.escape(label)}/tick:\s*([0-9.]+)\s*$",
+            section_text,
+            flags=re.MULTILINE,
+        )
+        if match:
+            counters[key] = float(match.group(1))
+    return counters
+
+
+def parse_perf_status(stdout_text: str) -> Optional[Dict[str, object]]:
+    """Whether the benchmark could open hardware counters (None if it does not use them)."""
+    unavailable = re.search(r"^\s*Perf counters: unavailable \((.*)\)\s*$", stdout_text, flags=re.MULTILINE)
+    if unavailable:
+        return {"available": False, "reason": unavailable.group(1)}
+    if any(re.search(rf"^\s*{re.escape(label)}/tick:", stdout_text, flags=re.MULTILINE) for label in PERF_COUNTER_LABELS):
+        return {"available": True}
+    return None
+
+
 def parse_metrics(target: str, stdout_text: str) -> Dict[str, float]:
     metrics: Dict[str, float] = {}
 
@@ -145,10 +206,24 @@ def parse_metrics(target: str, stdout_text: str) -> Dict[str, float]:
             stdout_text,
             flags=re.DOTALL,
         )
+        intern_1m_match = re.search(
+            r"Namespace Intern \(1M\):.*?Duration:\s*([0-9]+)\s*ms",
+            stdout_text,
+            flags=re.DOTALL,
+        )
+        resolve_1m_match = re.search(
+            r"Namespace Resolve \(1M\):.*?Duration:\s*([0-9]+)\s*ms",
+            stdout_text,
+            flags=re.DOTALL,
+        )
         if intern_match:
             metrics["intern_duration_ms"] = float(intern_match.group(1))
         if resolve_match:
             metrics["resolve_duration_ms"] = float(resolve_match.group(1))
+        if intern_1m_match:
+            metrics["intern_1m_duration_ms"] = float(intern_1m_match.group(1))
+        if resolve_1m_match:
+            metrics["resolve_1m_duration_ms"] = float(resolve_1m_match.group(1))
 
     elif target == "benchmark_tick":
         simple_match = re.search(
@@ -165,6 +240,23 @@ def parse_metrics(target: str, stdout_text: str) -> Dict[str, float]:
             stdout_text,
             flags=re.DOTALL,
         )
+        locality_match = re.search(
+            r"Component Locality.*?Arena:.*?Avg/tick:\s*([0-9.]+)\s*us.*?"
+            r"Footprint:\s*([0-9]+)\s*bytes.*?"
+            r"Component span:\s*([0-9]+)\s*bytes.*?"
+            r"Heap.*?Avg/tick:\s*([0-9.]+)\s*us.*?"
+            r"Component span:\s*([0-9]+)\s*bytes",
+            stdout_text,
+            flags=re.DOTALL,
+        )
+        layout_match = re.search(
+            r"Signal Layout.*?interning_order:.*?Avg/tick:\s*([0-9.]+)\s*us.*?"
+            r"Signal stride:\s*([0-9.]+)\s*ids.*?"
+            r"execution_order:.*?Avg/tick:\s*([0-9.]+)\s*us.*?"
+            r"Signal stride:\s*([0-9.]+)\s*ids",
+            stdout_text,
+            flags=re.DOTALL,
+        )
         if simple_match:
             metrics["simple_avg_tick_us"] = float(simple_match.group(1))
             metrics["simple_allocations"] = float(simple_match.group(2))
@@ -173,6 +265,23 @@ def parse_metrics(target: str, stdout_text: str) -> Dict[str, float]:
             metrics["complex_avg_tick_us"] = float(complex_match.group(1))
             metrics["complex_allocations"] = float(complex_match.group(2))
             metrics["complex_alloc_per_tick"] = float(complex_match.group(3))
+        if locality_match:
+            metrics["locality_arena_avg_tick_us"] = float(locality_match.group(1))
+            metrics["locality_footprint_bytes"] = float(locality_match.group(2))
+            metrics["locality_arena_span_bytes"] = float(locality_match.group(3))
+            metrics["locality_heap_avg_tick_us"] = float(locality_match.group(4))
+            metrics["locality_heap_span_bytes"] = float(locality_match.group(5))
+        if layout_match:
+            metrics["layout_interning_avg_tick_us"] = float(layout_match.group(1))
+            metrics["layout_interning_stride"] = float(layout_match.group(2))
+            metrics["layout_execution_avg_tick_us"] = float(layout_match.group(3))
+            metrics["layout_execution_stride"] = float(layout_match.group(4))
+
+        simple_text, _, complex_text = stdout_text.partition("Complex Graph")
+        complex_text = complex_text.partition("Component Locality")[0]
+        for prefix, section in (("simple", simple_text), ("complex", complex_text)):
+            for key, value in parse_perf_counters(section).items():
+                metrics[f"{prefix}_{key}"] = value
 
     return metrics
 
@@ -210,6 +319,20 @@ def build_scenarios(target: str, metrics: Dict[str, float]) -> List[Dict[str, ob
                     "metrics": {"duration_ms": float(metrics["resolve_duration_ms"])},
                 }
             )
+        if "intern_1m_duration_ms" in metrics:
+            scenarios.append(
+                {
+                    "id": "namespace.intern_1m.v1",
+                    "metrics": {"duration_ms": float(metrics["intern_1m_duration_ms"])},
+                }
+            )
+        if "resolve_1m_duration_ms" in metrics:
+            scenarios.append(
+                {
+                    "id": "namespace.resolve_1m.v1",
+                    "metrics": {"duration_ms": float(metrics["resolve_1m_duration_ms"])},
+                }
+            )
     elif target == "benchmark_tick":
         if "simple_avg_tick_us" in metrics:
             scenarios.append(
@@ -219,6 +342,11 @@ def build_scenarios(target: str, metrics: Dict[str, float]) -> List[Dict[str, ob
                         "avg_tick_us": float(metrics["simple_avg_tick_us"]),
                         "allocations": float(metrics.get("simple_allocations", 0.0)),
                         "alloc_per_tick": float(metrics.get("simple_alloc_per_tick", 0.0)),
+                        **{
+                            key: float(metrics[f"simple_{key}"])
+                            for key in PERF_COUNTER_LABELS.values()
+                            if f"simple_{key}" in metrics
+                        },
                     },
                 }
             )
@@ -230,6 +358,42 @@ def build_scenarios(target: str, metrics: Dict[str, float]) -> List[Dict[str, ob
                         "avg_tick_us": float(metrics["complex_avg_tick_us"]),
                         "allocations": float(metrics.get("complex_allocations", 0.0)),
                         "alloc_per_tick": float(metrics.get("complex_alloc_per_tick", 0.0)),
+                        **{
+                            key: float(metrics[f"complex_{key}"])
+                            for key in PERF_COUNTER_LABELS.values()
+                            if f"complex_{key}" in metrics
+                        },
+                    },
+                }
+            )
+        if "locality_arena_avg_tick_us" in metrics:
+            scenarios.append(
+                {
+                    "id": "tick.component_locality.v1",
+                    "metrics": {
+                        "avg_tick_us": float(metrics["locality_arena_avg_tick_us"]),
+                        "heap_avg_tick_us": float(metrics["locality_heap_avg_tick_us"]),
+                        "footprint_bytes": float(metrics["locality_footprint_bytes"]),
+                        "component_span_bytes": float(metrics["locality_arena_span_bytes"]),
+                        "heap_component_span_bytes": float(
+                            metrics["locality_heap_span_bytes"]
+                        ),
+                    },
+                }
+            )
+        if "layout_execution_avg_tick_us" in metrics:
+            scenarios.append(
+                {
+                    "id": "tick.signal_layout.v1",
+                    "metrics": {
+                        "avg_tick_us": float(metrics["layout_execution_avg_tick_us"]),
+                        "interning_avg_tick_us": float(
+                            metrics["layout_interning_avg_tick_us"]
+                        ),
+                        "signal_stride": float(metrics["layout_execution_stride"]),
+                        "interning_signal_stride": float(
+                            metrics["layout_interning_stride"]
+                        ),
                     },
                 }
             )
@@ -237,6 +401,43 @@ def build_scenarios(target: str, metrics: Dict[str, float]) -> List[Dict[str, ob
     return scenarios
 
 
+def build_graph_scenarios(report_path: Path) -> List[Dict[str, object]]:
+    """Scenarios from a Google Benchmark JSON report.
+
+    tick/<shape>/edges:<N> becomes graph.<shape>.e<N>.v1. Times are
+    normalized to nanoseconds; per_edge (seconds) becomes ns_per_edge and
+    other numeric counters pass through unchanged.
+    """
+    if not report_path.is_file():
+        return []
+    report = json.loads(report_path.read_text(encoding="utf-8"))
+
+    scenarios: List[Dict[str, object]] = []
+    for entry in report.get("benchmarks", []):
+        if entry.get("run_type", "iteration") != "iteration" or entry.get("error_occurred"):
+            continue
+        match = re.fullmatch(r"tick/(\w+)/edges:(\d+)", str(entry.get("name", "")))
+        if not match:
+            continue
+        scale = _TIME_UNIT_NS.get(str(entry.get("time_unit", "ns")), 1.0)
+        metrics: Dict[str, float] = {
+            "ns_per_tick": float(entry["real_time"]) * scale,
+            "cpu_ns_per_tick": float(entry["cpu_time"]) * scale,
+            "iterations": float(entry.get("iterations", 0)),
+        }
+        for key, value in entry.items():
+            if key in _GBENCH_FIELDS or isinstance(value, bool) or not isinstance(value, (int, float)):
+                continue
+            if key == "per_edge":
+                metrics["ns_per_edge"] = float(value) * 1e9
+            elif key == "allocs_per_tick":
+                metrics["alloc_per_tick"] = float(value)
+            else:
+                metrics[key] = float(value)
+        scenarios.append({"id": f"graph.{match.group(1)}.e{match.group(2)}.v1", "metrics": metrics})
+    return scenarios
+
+
 def git_metadata(repo_root: Path) -> Dict[str, object]:
     commit = run_cmd(["git", "rev-parse", "HEAD"], cwd=repo_root)
     short = run_cmd(["git", "rev-parse", "--short", "HEAD"], cwd=repo_root)
@@ -267,6 +468,17 @@ def main() -> int:
     parser.add_argument("--output-dir", default=None, help="Artifact output directory")
     parser.add_argument("--no-build", action="store_true", help="Skip configure/build and run existing binaries")
     parser.add_argument("--include-optional", action="store_true", help="Attempt optional loader benchmarks too")
+    parser.add_argument(
+        "--include-graph",
+        action="store_true",
+        help="Attempt the Google Benchmark graph-size sweep (benchmark_graph) too",
+    )
+    parser.add_argument(
+        "--graph-max-edges",
+        type=int,
+        default=100000,
+        help="Largest synthetic graph in the benchmark_graph sweep (default: 100000)",
+    )
     parser.add_argument(
         "--fail-on-status",
         action="store_true",
@@ -293,6 +505,8 @@ def main() -> int:
     targets = list(BENCHMARK_TARGETS)
     if args.include_optional:
         targets.extend(OPTIONAL_TARGETS)
+    if args.include_graph:
+        targets.extend(GRAPH_TARGETS)
 
     build_cmd.extend(["--target", *targets])
 
@@ -326,6 +540,15 @@ def main() -> int:
             continue
 
         cmd = [str(exe)]
+        report_path = output_dir / f"{target}.json"
+        if target in GRAPH_TARGETS:
+            cmd.extend(
+                [
+                    f"--benchmark_out={report_path}",
+                    "--benchmark_out_format=json",
+                    f"--max_edges={args.graph_max_edges}",
+                ]
+            )
         start = time.perf_counter()
         timed_out = False
         try:
@@ -355,23 +578,28 @@ def main() -> int:
 
         status = parse_status(stdout_text)
         metrics = parse_metrics(target, stdout_text)
-        scenarios = build_scenarios(target, metrics)
-        run_records.append(
-            {
-                "target": target,
-                "executable": str(exe),
-                "command": " ".join(shlex.quote(c) for c in cmd),
-                "exit_code": exit_code,
-                "duration_sec": round(duration_sec, 6),
-                "timed_out": timed_out,
-                "stdout_log": out_path.name,
-                "stderr_log": err_path.name,
-                "status": status["status"],
-                "status_lines": status["status_lines"],
-                "metrics": metrics,
-                "scenarios": scenarios,
-            }
-        )
+        if target in GRAPH_TARGETS:
+            scenarios = build_graph_scenarios(report_path)
+        else:
+            scenarios = build_scenarios(target, metrics)
+        record: Dict[str, object] = {
+            "target": target,
+            "executable": str(exe),
+            "command": " ".join(shlex.quote(c) for c in cmd),
+            "exit_code": exit_code,
+            "duration_sec": round(duration_sec, 6),
+            "timed_out": timed_out,
+            "stdout_log": out_path.name,
+            "stderr_log": err_path.name,
+            "status": status["status"],
+            "status_lines": status["status_lines"],
+            "metrics": metrics,
+            "scenarios": scenarios,
+        }
+        perf_status = parse_perf_status(stdout_text)
+        if perf_status is not None:
+            record["perf_counters"] = perf_status
+        run_records.append(record)
 
     metadata = {
         "timestamp_utc": dt.datetime.now(dt.timezone.utc).isoformat(),
@@ -27,6 +27,19 @@ void print_usage(const char *prog_name) {
   std::cout << "  --port PORT        Server port (default: 50051)\n";
   std::cout << "  --config FILE      Preload config file (YAML or JSON)\n";
   std::cout << "  --dt SECONDS       Timestep in seconds (default: 0.1)\n";
+  std::cout << "  --realtime         Free-running ticks paced by wall clock\n";
+  std::cout << "  --rate HZ          Realtime tick rate (default: 1/dt)\n";
+  std::cout << "  --afap             Free-running ticks as fast as possible\n";
+  std::cout << "  --workers N        Scheduler threads shared by free-running "
+               "instances (default: 1)\n";
+  std::cout << "  --max-instances N  Maximum hosted simulation instances "
+               "(default: 64)\n";
+  std::cout << "  --barrier-quorum N Tick once N providers reported (default: "
+               "all)\n";
+  std::cout << "  --barrier-require ID  Provider that must report before a "
+               "quorum tick (repeatable)\n";
+  std::cout << "  --barrier-deadline-ms MS  Tick MS after the first report, "
+               "holding late inputs\n";
   std::cout << "  --help             Show this help message\n";
 }
 
@@ -60,6 +73,12 @@ int main(int argc, char *argv[]) {
   int port = 50051;
   std::string config_path;
   double dt = 0.1;
+  double rate_hz = 0.0;
+  int workers = 1;
+  int max_instances = 64;
+  fluxgraph::server::TickMode tick_mode =
+      fluxgraph::server::TickMode::provider_barrier;
+  fluxgraph::server::BarrierPolicy barrier_policy;
 
   // Parse arguments
   for (int i = 1; i < argc; ++i) {
@@ -85,6 +104,68 @@ int main(int argc, char *argv[]) {
         return 1;
       }
       dt = std::stod(argv[++i]);
+    } else if (arg == "--realtime") {
+      tick_mode = fluxgraph::server::TickMode::realtime;
+    } else if (arg == "--afap") {
+      tick_mode = fluxgraph::server::TickMode::as_fast_as_possible;
+    } else if (arg == "--barrier-quorum") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --barrier-quorum requires an argument\n";
+        return 1;
+      }
+      const int quorum = std::stoi(argv[++i]);
+      if (quorum < 1) {
+        std::cerr << "Error: --barrier-quorum must be at least 1\n";
+        return 1;
+      }
+      barrier_policy.quorum = static_cast<size_t>(quorum);
+    } else if (arg == "--barrier-require") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --barrier-require requires an argument\n";
+        return 1;
+      }
+      barrier_policy.required_providers.insert(argv[++i]);
+    } else if (arg == "--barrier-deadline-ms") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --barrier-deadline-ms requires an argument\n";
+        return 1;
+      }
+      const int deadline_ms = std::stoi(argv[++i]);
+      if (deadline_ms < 1) {
+        std::cerr << "Error: --barrier-deadline-ms must be at least 1\n";
+        return 1;
+      }
+      barrier_policy.deadline = std::chrono::milliseconds(deadline_ms);
+    } else if (arg == "--workers") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --workers requires an argument\n";
+        return 1;
+      }
+      workers = std::stoi(argv[++i]);
+      if (workers < 1) {
+        std::cerr << "Error: --workers must be at least 1\n";
+        return 1;
+      }
+    } else if (arg == "--max-instances") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --max-instances requires an argument\n";
+        return 1;
+      }
+      max_instances = std::stoi(argv[++i]);
+      if (max_instances < 1) {
+        std::cerr << "Error: --max-instances must be at least 1\n";
+        return 1;
+      }
+    } else if (arg == "--rate") {
+      if (i + 1 >= argc) {
+        std::cerr << "Error: --rate requires an argument\n";
+        return 1;
+      }
+      rate_hz = std::stod(argv[++i]);
+      if (rate_hz <= 0.0) {
+        std::cerr << "Error: --rate must be positive\n";
+        return 1;
+      }
     } else {
       std::cerr << "Error: Unknown argument: " << arg << "\n";
       print_usage(argv[0]);
@@ -101,12 +182,28 @@ int main(int argc, char *argv[]) {
     std::cerr << "Error: Timestep must be positive\n";
     return 1;
   }
+  if (rate_hz > 0.0 && tick_mode != fluxgraph::server::TickMode::realtime) {
+    std::cerr << "Error: --rate requires --realtime\n";
+    return 1;
+  }
+  if (rate_hz <= 0.0) {
+    rate_hz = 1.0 / dt;
+  }
 
   std::cout << "=======================================================\n";
   std::cout << "FluxGraph gRPC Server\n";
   std::cout << "=======================================================\n";
   std::cout << "Port:      " << port << "\n";
   std::cout << "Timestep:  " << dt << " sec (" << (1.0 / dt) << " Hz)\n";
+  if (tick_mode == fluxgraph::server::TickMode::realtime) {
+    std::cout << "Tick mode: realtime (" << rate_hz << " Hz, " << workers
+              << " workers)\n";
+  } else if (tick_mode == fluxgraph::server::TickMode::as_fast_as_possible) {
+    std::cout << "Tick mode: as-fast-as-possible (" << workers
+              << " workers)\n";
+  } else {
+    std::cout << "Tick mode: provider barrier\n";
+  }
   if (!config_path.empty()) {
     std::cout << "Config:    " << config_path << "\n";
   }
@@ -116,6 +213,8 @@ int main(int argc, char *argv[]) {
     // Create service implementation
     auto service =
         std::make_unique<fluxgraph::server::FluxGraphServiceImpl>(dt);
+    service->set_barrier_policy(barrier_policy);
+    service->set_max_instances(static_cast<size_t>(max_instances));
 
     // Preload config if provided
     if (!config_path.empty()) {
@@ -168,8 +267,14 @@ int main(int argc, char *argv[]) {
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
 
+    if (tick_mode != fluxgraph::server::TickMode::provider_barrier) {
+      service->start_free_running(tick_mode, rate_hz,
+                                  static_cast<size_t>(workers));
+    }
+
     // Block until shutdown
     g_server->Wait();
+    service->stop_free_running();
 
     std::cout << "[FluxGraph] Server stopped\n";
     return 0;
@@ -0,0 +1,272 @@
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace fluxgraph::server {
+
+namespace {
+
+size_t this_thread_shard() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+  return shard;
+}
+
+void atomic_add(std::atomic<double> &target, double delta) {
+  double current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current, current + delta,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+std::string escape_label_value(const std::string &value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    default:
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+std::string format_double(double value) {
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  std::ostringstream out;
+  out.precision(15);
+  out << value;
+  return out.str();
+}
+
+void render_labels(std::ostringstream &out, const MetricLabels &labels,
+                   const char *extra_key = nullptr,
+                   const std::string &extra_value = {}) {
+  if (labels.empty() && extra_key == nullptr) {
+    return;
+  }
+  out << '{';
+  bool first = true;
+  for (const auto &[key, value] : labels) {
+    out << (first ? "" : ",") << key << "=\"" << escape_label_value(value)
+        << '"';
+    first = false;
+  }
+  if (extra_key != nullptr) {
+    out << (first ? "" : ",") << extra_key << "=\"" << extra_value << '"';
+  }
+  out << '}';
+}
+
+} // namespace
+
+// ============================================================================
+// Counter / Gauge / Histogram
+// ============================================================================
+
+void Counter::add(uint64_t n) {
+  shards_[this_thread_shard()].value.fetch_add(n, std::memory_order_relaxed);
+}
+
+uint64_t Counter::value() const {
+  uint64_t total = 0;
+  for (const auto &shard : shards_) {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void Gauge::add(double delta) { atomic_add(value_, delta); }
+
+Histogram::Histogram(std::vector<double> bounds) : bounds_(std::move(bounds)) {
+  if (!std::is_sorted(bounds_.begin(), bounds_.end()) ||
+      std::adjacent_find(bounds_.begin(), bounds_.end()) != bounds_.end()) {
+    throw std::invalid_argument("Histogram bounds must be strictly increasing");
+  }
+  for (auto &shard : shards_) {
+    shard.buckets =
+        std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1U);
+  }
+}
+
+void Histogram::observe(double value) {
+  const size_t bucket = static_cast<size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) -
+      bounds_.begin());
+  Shard &shard = shards_[this_thread_shard()];
+  shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  atomic_add(shard.sum, value);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+  Snapshot snap;
+  snap.bucket_counts.assign(bounds_.size() + 1U, 0);
+  for (const auto &shard : shards_) {
+    for (size_t i = 0; i < snap.bucket_counts.size(); ++i) {
+      const uint64_t n = shard.buckets[i].load(std::memory_order_relaxed);
+      snap.bucket_counts[i] += n;
+      snap.count += n; // Derived so the +Inf bucket always equals count
+    }
+    snap.sum += shard.sum.load(std::memory_order_relaxed);
+  }
+  return snap;
+}
+
+std::vector<double> Histogram::latency_bounds() {
+  std::vector<double> bounds;
+  for (double bound = 1e-6; bound < 5.0; bound *= 4.0) {
+    bounds.push_back(bound);
+  }
+  return bounds;
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry::Family &
+MetricsRegistry::family_locked(const std::string &name,
+                               const std::string &help, Kind kind) {
+  auto [it, inserted] = families_.try_emplace(name);
+  if (inserted) {
+    it->second.kind = kind;
+    it->second.help = help;
+  } else if (it->second.kind != kind) {
+    throw std::invalid_argument("Metric '" + name +
+                                "' already registered with another type");
+  }
+  return it->second;
+}
+
+std::shared_ptr<Counter> MetricsRegistry::counter(const std::string &name,
+                                                  const std::string &help,
+                                                  const MetricLabels &labels) {
+  std::lock_guard lock(mutex_);
+  auto &slot = family_locked(name, help, Kind::counter).counters[labels];
+  if (!slot) {
+    slot = std::make_shared<Counter>();
+  }
+  return slot;
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string &name,
+                                              const std::string &help,
+                                              const MetricLabels &labels) {
+  std::lock_guard lock(mutex_);
+  auto &slot = family_locked(name, help, Kind::gauge).gauges[labels];
+  if (!slot) {
+    slot = std::make_shared<Gauge>();
+  }
+  return slot;
+}
+
+std::shared_ptr<Histogram>
+MetricsRegistry::histogram(const std::string &name, const std::string &help,
+                           const MetricLabels &labels,
+                           std::vector<double> bounds) {
+  std::lock_guard lock(mutex_);
+  auto &slot = family_locked(name, help, Kind::histogram).histograms[labels];
+  if (!slot) {
+    slot = std::make_shared<Histogram>(std::move(bounds));
+  }
+  return slot;
+}
+
+void MetricsRegistry::remove_series(const std::string &key,
+                                    const std::string &value) {
+  remove_series(MetricLabels{{key, value}});
+}
+
+void MetricsRegistry::remove_series(const MetricLabels &match) {
+  const auto matches = [&match](const MetricLabels &labels) {
+    for (const auto &[key, value] : match) {
+      auto it = labels.find(key);
+      if (it == labels.end() || it->second != value) {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto erase_matching = [&matches](auto &series) {
+    for (auto it = series.begin(); it != series.end();) {
+      it = matches(it->first) ? series.erase(it) : std::next(it);
+    }
+  };
+
+  std::lock_guard lock(mutex_);
+  for (auto &[name, family] : families_) {
+    (void)name;
+    erase_matching(family.counters);
+    erase_matching(family.gauges);
+    erase_matching(family.histograms);
+  }
+}
+
+std::string MetricsRegistry::render_prometheus() const {
+  std::ostringstream out;
+  std::lock_guard lock(mutex_);
+
+  for (const auto &[name, family] : families_) {
+    out << "# HELP " << name << ' ' << family.help << '\n';
+    switch (family.kind) {
+    case Kind::counter:
+      out << "# TYPE " << name << " counter\n";
+      for (const auto &[labels, counter] : family.counters) {
+        out << name;
+        render_labels(out, labels);
+        out << ' ' << counter->value() << '\n';
+      }
+      break;
+    case Kind::gauge:
+      out << "# TYPE " << name << " gauge\n";
+      for (const auto &[labels, gauge] : family.gauges) {
+        out << name;
+        render_labels(out, labels);
+        out << ' ' << format_double(gauge->value()) << '\n';
+      }
+      break;
+    case Kind::histogram:
+      out << "# TYPE " << name << " histogram\n";
+      for (const auto &[labels, histogram] : family.histograms) {
+        const Histogram::Snapshot snap = histogram->snapshot();
+        const auto &bounds = histogram->bounds();
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < snap.bucket_counts.size(); ++i) {
+          cumulative += snap.bucket_counts[i];
+          out << name << "_bucket";
+          render_labels(out, labels, "le",
+                        i < bounds.size()
+                            ? format_double(bounds[i])
+                            : std::string("+Inf"));
+          out << ' ' << cumulative << '\n';
+        }
+        out << name << "_sum";
+        render_labels(out, labels);
+        out << ' ' << format_double(snap.sum) << '\n';
+        out << name << "_count";
+        render_labels(out, labels);
+        out << ' ' << snap.count << '\n';
+      }
+      break;
+    }
+  }
+
+  return out.str();
+}
+
+} // namespace fluxgraph::server
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fluxgraph::server {
+
+/// Metric label set (sorted, rendered as {key="value",...})
+using MetricLabels = std::map<std::string, std::string>;
+
+/// Number of per-thread shards for counters and histograms. Threads are
+/// assigned shards round-robin on first use, so hot-path updates are relaxed
+/// atomic adds on a cache line no other thread writes in the common case.
+constexpr size_t kMetricShards = 16;
+
+/// Monotonic counter
+class Counter {
+public:
+  void add(uint64_t n = 1);
+  uint64_t value() const;
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value{0};
+  };
+  std::array<Shard, kMetricShards> shards_;
+};
+
+/// Instantaneous value (last writer wins)
+class Gauge {
+public:
+  void set(double value) { value_.store(value, std::memory_order_relaxed); }
+  void add(double delta);
+  double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> value_{0.0};
+};
+
+/// Cumulative-bucket histogram (Prometheus semantics)
+class Histogram {
+public:
+  /// @param bounds Strictly increasing upper bucket bounds (+Inf is implicit)
+  explicit Histogram(std::vector<double> bounds);
+
+  void observe(double value);
+  void observe(std::chrono::nanoseconds duration) {
+    observe(std::chrono::duration<double>(duration).count());
+  }
+
+  struct Snapshot {
+    std::vector<uint64_t> bucket_counts; // Non-cumulative, last is +Inf
+    uint64_t count = 0;
+    double sum = 0.0;
+  };
+
+  const std::vector<double> &bounds() const { return bounds_; }
+  Snapshot snapshot() const;
+
+  /// Default latency bounds: 1 us .. ~4 s in powers of 4
+  static std::vector<double> latency_bounds();
+
+private:
+  struct alignas(64) Shard {
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::atomic<double> sum{0.0};
+  };
+
+  std::vector<double> bounds_;
+  std::array<Shard, kMetricShards> shards_;
+};
+
+/// Registry of named metric families rendered in Prometheus text format.
+///
+/// Registration takes the registry mutex and returns a shared handle; hot
+/// paths keep the handle and never touch the registry again. Removing a
+/// series only drops the registry's reference, so late updates through an
+/// outstanding handle are harmless.
+class MetricsRegistry {
+public:
+  std::shared_ptr<Counter> counter(const std::string &name,
+                                   const std::string &help,
+                                   const MetricLabels &labels = {});
+
+  std::shared_ptr<Gauge> gauge(const std::string &name,
+                               const std::string &help,
+                               const MetricLabels &labels = {});
+
+  std::shared_ptr<Histogram>
+  histogram(const std::string &name, const std::string &help,
+            const MetricLabels &labels = {},
+            std::vector<double> bounds = Histogram::latency_bounds());
+
+  /// Drop every series carrying label key=value (e.g. a deleted instance)
+  void remove_series(const std::string &key, const std::string &value);
+
+  /// Drop every series carrying all of match's labels (e.g. one provider
+  /// of one instance)
+  void remove_series(const MetricLabels &match);
+
+  /// Render all families in Prometheus text exposition format (0.0.4)
+  std::string render_prometheus() const;
+
+private:
+  enum class Kind { counter, gauge, histogram };
+
+  struct Family {
+    Kind kind = Kind::counter;
+    std::string help;
+    std::map<MetricLabels, std::shared_ptr<Counter>> counters;
+    std::map<MetricLabels, std::shared_ptr<Gauge>> gauges;
+    std::map<MetricLabels, std::shared_ptr<Histogram>> histograms;
+  };
+
+  Family &family_locked(const std::string &name, const std::string &help,
+                        Kind kind);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+};
+
+/// Records elapsed wall time into a histogram on scope exit
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Histogram &histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    histogram_.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_));
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  Histogram &histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace fluxgraph::server
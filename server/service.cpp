@@ -1,14 +1,11 @@
 #include "service.hpp"
 
-#include <algorithm>
-#include <iomanip>
+#include <array>
+#include <chrono>
 #include <iostream>
-#include <random>
-#include <sstream>
-#include <variant>
-
-#include "fluxgraph/loaders/json_loader.hpp"
-#include "fluxgraph/loaders/yaml_loader.hpp"
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace fluxgraph::server {
 
@@ -16,456 +13,523 @@ namespace fluxgraph::server {
 // Constructor / Destructor
 // ============================================================================
 
-FluxGraphServiceImpl::FluxGraphServiceImpl(double dt) : dt_(dt) {
+FluxGraphServiceImpl::FluxGraphServiceImpl(double dt)
+    : dt_(dt), metrics_(std::make_shared<MetricsRegistry>()) {
+  // Indexed by RpcMethod
+  static constexpr std::array<const char *,
+                              static_cast<size_t>(RpcMethod::count)>
+      kMethodNames = {
+          "LoadConfig",    "RegisterProvider", "UnregisterProvider",
+          "UpdateSignals", "ReadSignals",      "Subscribe",
+          "AdvanceTicks",  "Reset",            "ListInstances",
+          "DeleteInstance", "GetMetrics",
+      };
+  for (size_t i = 0; i < kMethodNames.size(); ++i) {
+    const MetricLabels labels{{"method", kMethodNames[i]}};
+    rpc_metrics_[i].latency = metrics_->histogram(
+        "fluxgraph_rpc_duration_seconds", "RPC handler latency", labels);
+    rpc_metrics_[i].failures = metrics_->counter(
+        "fluxgraph_rpc_failures_total", "RPCs returning a non-OK status",
+        labels);
+  }
+
   std::cout << "[FluxGraph] Service initialized (dt=" << dt_ << "s)\n";
 }
 
 FluxGraphServiceImpl::~FluxGraphServiceImpl() {
+  stop_free_running();
+
+  std::lock_guard lock(instances_mutex_);
+  for (auto &[id, instance] : instances_) {
+    (void)id;
+    instance->close();
+  }
   std::cout << "[FluxGraph] Service shutdown\n";
 }
 
 // ============================================================================
-// LoadConfig RPC
+// Metrics
 // ============================================================================
 
-grpc::Status
-FluxGraphServiceImpl::LoadConfig(grpc::ServerContext * /*context*/,
-                                 const fluxgraph::rpc::ConfigRequest *request,
-                                 fluxgraph::rpc::ConfigResponse *response) {
-
-  std::lock_guard lock(state_mutex_);
-
-  try {
-    // Check for no-op (matching hash)
-    if (!request->config_hash().empty() &&
-        request->config_hash() == current_config_hash_) {
-      response->set_success(true);
-      response->set_config_changed(false);
-      std::cout << "[FluxGraph] LoadConfig: no-op (hash matched)\n";
-      return grpc::Status::OK;
-    }
-
-    // Parse config based on format
-    GraphSpec spec;
-    if (request->format() == "yaml") {
-#ifdef FLUXGRAPH_YAML_ENABLED
-      spec = fluxgraph::loaders::load_yaml_string(request->config_content());
-#else
-      response->set_success(false);
-      response->set_error_message(
-          "YAML support not enabled (build with -DFLUXGRAPH_YAML_ENABLED=ON)");
-      return grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
-                          "YAML support not enabled");
-#endif
-    } else if (request->format() == "json") {
-#ifdef FLUXGRAPH_JSON_ENABLED
-      spec = fluxgraph::loaders::load_json_string(request->config_content());
-#else
-      response->set_success(false);
-      response->set_error_message(
-          "JSON support not enabled (build with -DFLUXGRAPH_JSON_ENABLED=ON)");
-      return grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
-                          "JSON support not enabled");
-#endif
-    } else {
-      response->set_success(false);
-      response->set_error_message("Unknown format: " + request->format() +
-                                  " (must be 'yaml' or 'json')");
-      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Unknown format");
-    }
+template <typename Body>
+grpc::Status FluxGraphServiceImpl::instrumented(RpcMethod method,
+                                                Body &&body) {
+  RpcMetrics &rpc = rpc_metrics_[static_cast<size_t>(method)];
+  const auto start = std::chrono::steady_clock::now();
+  grpc::Status status = body();
+  rpc.latency->observe(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start));
+  if (!status.ok()) {
+    rpc.failures->add();
+  }
+  return status;
+}
 
-    // Clear existing namespaces (fresh start)
-    signal_ns_.clear();
-    func_ns_.clear();
-
-    // Compile graph
-    GraphCompiler compiler;
-    auto program = compiler.compile(spec, signal_ns_, func_ns_, dt_);
-
-    // Load into engine
-    engine_.load(std::move(program));
-
-    // Reset simulation state (fresh store to avoid stale declared-unit
-    // carryover across config reloads).
-    store_ = SignalStore();
-    protected_write_signals_.clear();
-    physics_owned_signals_.clear();
-    sim_time_ = 0.0;
-    tick_generation_ = 0;
-    last_completed_generation_ = 0;
-    last_completed_sim_time_ = 0.0;
-    last_completed_commands_.clear();
-    sessions_.clear();
-
-    // Preload declared signal contracts so provider writes are validated
-    // immediately (before first tick).
-    for (const auto &signal_spec : spec.signals) {
-      const SignalId signal_id = signal_ns_.resolve(signal_spec.path);
-      if (signal_id != INVALID_SIGNAL) {
-        store_.declare_unit(signal_id, signal_spec.unit);
-      }
+void FluxGraphServiceImpl::refresh_gauges() {
+  std::vector<std::shared_ptr<SimulationInstance>> instances;
+  {
+    std::lock_guard lock(instances_mutex_);
+    metrics_->gauge("fluxgraph_instances", "Hosted simulation instances")
+        ->set(static_cast<double>(instances_.size()));
+    for (const auto &[id, instance] : instances_) {
+      (void)id;
+      instances.push_back(instance);
     }
+  }
 
-    // Build write-authority map from spec.
-    // - All edge targets are derived outputs and protected from external
-    // writes.
-    // - Model output signals are physics-owned and protected.
-    for (const auto &edge : spec.edges) {
-      const SignalId target_id = signal_ns_.resolve(edge.target_path);
-      if (target_id != INVALID_SIGNAL) {
-        protected_write_signals_.insert(target_id);
-      }
+  // Sizes are sampled at scrape time instead of on every mutation.
+  std::vector<std::pair<std::shared_ptr<SimulationInstance>, InstanceStats>>
+      sampled;
+  sampled.reserve(instances.size());
+  for (const auto &instance : instances) {
+    if (!instance->is_closed()) {
+      sampled.emplace_back(instance, instance->stats());
     }
+  }
 
-    for (const auto &model : spec.models) {
-      if (model.type == "thermal_mass") {
-        const auto temp_it = model.params.find("temp_signal");
-        if (temp_it != model.params.end() &&
-            std::holds_alternative<std::string>(temp_it->second)) {
-          const auto &temp_path = std::get<std::string>(temp_it->second);
-          const SignalId temp_id = signal_ns_.resolve(temp_path);
-          if (temp_id != INVALID_SIGNAL) {
-            protected_write_signals_.insert(temp_id);
-            physics_owned_signals_.insert(temp_id);
-            store_.mark_physics_driven(temp_id, true);
-          }
-        }
-      }
+  // Publish only for instances still registered: DeleteInstance drops the
+  // series under instances_mutex_, so this cannot re-create them
+  std::lock_guard lock(instances_mutex_);
+  for (const auto &[instance, stats] : sampled) {
+    const auto registered = instances_.find(stats.instance_id);
+    if (registered == instances_.end() || registered->second != instance ||
+        instance->is_closed()) {
+      continue;
     }
-
-    // Update config hash
-    current_config_hash_ = request->config_hash();
-    loaded_ = true;
-
-    response->set_success(true);
-    response->set_config_changed(true);
-
-    std::cout << "[FluxGraph] Config loaded: " << spec.models.size()
-              << " models, " << spec.edges.size() << " edges, "
-              << spec.rules.size() << " rules, dt=" << dt_ << "s\n";
-
-    return grpc::Status::OK;
-
-  } catch (const std::exception &e) {
-    response->set_success(false);
-    response->set_error_message(e.what());
-    std::cerr << "[FluxGraph] LoadConfig failed: " << e.what() << "\n";
-    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    const MetricLabels labels{{"instance", stats.instance_id}};
+    const auto set = [this, &labels](const char *name, const char *help,
+                                     double value) {
+      metrics_->gauge(name, help, labels)->set(value);
+    };
+    set("fluxgraph_providers", "Active provider sessions",
+        static_cast<double>(stats.provider_count));
+    set("fluxgraph_store_signals", "Interned signal paths",
+        static_cast<double>(stats.signal_count));
+    set("fluxgraph_memory_bytes", "Approximate instance heap footprint",
+        static_cast<double>(stats.approx_memory_bytes));
+    set("fluxgraph_command_backlog",
+        "Commands queued for providers in free-running modes",
+        static_cast<double>(stats.queued_commands));
+    set("fluxgraph_staged_inputs", "Provider writes awaiting the next tick",
+        static_cast<double>(stats.staged_inputs));
+    set("fluxgraph_sim_time_seconds", "Simulation time", stats.sim_time);
   }
 }
 
 // ============================================================================
-// RegisterProvider RPC
+// Free-Running Scheduling
 // ============================================================================
 
-grpc::Status FluxGraphServiceImpl::RegisterProvider(
-    grpc::ServerContext * /*context*/,
-    const fluxgraph::rpc::ProviderRegistration *request,
-    fluxgraph::rpc::ProviderRegistrationResponse *response) {
-
-  std::lock_guard lock(state_mutex_);
-
-  if (!loaded_) {
-    response->set_success(false);
-    response->set_error_message("Config not loaded - call LoadConfig first");
-    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
-                        "Config not loaded");
+void FluxGraphServiceImpl::start_free_running(TickMode mode, double rate_hz,
+                                              size_t worker_count) {
+  if (mode == TickMode::provider_barrier) {
+    throw std::invalid_argument(
+        "start_free_running requires realtime or as_fast_as_possible mode");
   }
-
-  if (request->provider_id().empty()) {
-    response->set_success(false);
-    response->set_error_message("provider_id must be non-empty");
-    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
-                        "provider_id must be non-empty");
+  if (mode == TickMode::realtime && !(rate_hz > 0.0)) {
+    throw std::invalid_argument("realtime tick rate must be positive");
+  }
+  if (worker_count == 0) {
+    throw std::invalid_argument("scheduler worker count must be positive");
   }
 
-  std::vector<std::string> requested_devices(request->device_ids().begin(),
-                                             request->device_ids().end());
-
-  const auto now = std::chrono::steady_clock::now();
-  prune_stale_sessions_locked("", now);
-
-  // Enforce unique provider identity and device ownership among active
-  // sessions.
-  for (const auto &[existing_session_id, existing_session] : sessions_) {
-    if (existing_session.provider_id == request->provider_id()) {
-      response->set_success(false);
-      response->set_error_message("provider_id already registered: " +
-                                  request->provider_id());
-      return grpc::Status(grpc::StatusCode::ALREADY_EXISTS,
-                          "provider_id already registered");
+  std::vector<std::shared_ptr<SimulationInstance>> instances;
+  {
+    std::lock_guard lock(instances_mutex_);
+    if (scheduler_) {
+      throw std::runtime_error("Free-running scheduler already started");
     }
 
-    for (const auto &device_id : requested_devices) {
-      const auto found =
-          std::find(existing_session.device_ids.begin(),
-                    existing_session.device_ids.end(), device_id);
-      if (found != existing_session.device_ids.end()) {
-        response->set_success(false);
-        response->set_error_message(
-            "device_id already owned by another provider: " + device_id);
-        return grpc::Status(grpc::StatusCode::ALREADY_EXISTS,
-                            "device_id ownership conflict");
-      }
+    tick_mode_ = mode;
+    tick_period_ = mode == TickMode::realtime
+                       ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::duration<double>(1.0 / rate_hz))
+                       : std::chrono::nanoseconds(0);
+    scheduler_ = std::make_unique<TickScheduler>(worker_count);
+
+    for (const auto &[id, instance] : instances_) {
+      (void)id;
+      instances.push_back(instance);
     }
   }
+  schedule_instances(instances);
 
-  // Generate unique session ID
-  std::string session_id = generate_session_id(request->provider_id());
-
-  // Store provider session
-  ProviderSession session;
-  session.provider_id = request->provider_id();
-  session.device_ids = std::move(requested_devices);
-  session.last_update = now;
-  session.last_tick_generation =
-      std::nullopt; // Must submit updates for generation 0
-
-  sessions_[session_id] = std::move(session);
-
-  response->set_success(true);
-  response->set_session_id(session_id);
-
-  std::cout << "[FluxGraph] Provider registered: " << request->provider_id()
-            << " (session: " << session_id << ")\n";
-
-  return grpc::Status::OK;
+  std::cout << "[FluxGraph] Free-running scheduler started ("
+            << (mode == TickMode::realtime ? "realtime"
+                                           : "as-fast-as-possible");
+  if (mode == TickMode::realtime) {
+    std::cout << ", rate=" << rate_hz << " Hz";
+  }
+  std::cout << ", workers=" << worker_count << ")\n";
 }
 
-grpc::Status FluxGraphServiceImpl::UnregisterProvider(
-    grpc::ServerContext * /*context*/,
-    const fluxgraph::rpc::UnregisterRequest *request,
-    fluxgraph::rpc::UnregisterResponse *response) {
-  std::unique_lock<std::mutex> lock(state_mutex_);
-
-  if (request->session_id().empty()) {
-    response->set_success(false);
-    response->set_error_message("session_id must be non-empty");
-    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
-                        "session_id must be non-empty");
+void FluxGraphServiceImpl::stop_free_running() {
+  std::unique_ptr<TickScheduler> scheduler;
+  std::vector<std::shared_ptr<SimulationInstance>> instances;
+  {
+    std::lock_guard lock(instances_mutex_);
+    if (!scheduler_) {
+      return;
+    }
+    scheduler = std::move(scheduler_);
+    tick_mode_ = TickMode::provider_barrier;
+    for (const auto &[id, instance] : instances_) {
+      (void)id;
+      instances.push_back(instance);
+    }
   }
 
-  const auto session_it = sessions_.find(request->session_id());
-  if (session_it == sessions_.end()) {
-    response->set_success(false);
-    response->set_error_message("Unknown session_id");
-    return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
-                        "Unknown session_id");
+  // Join workers outside the registry lock; ticks in flight may still run.
+  scheduler->stop();
+
+  for (const auto &instance : instances) {
+    instance->end_free_running();
+    const TickPacingStats stats = instance->tick_pacing_stats();
+    std::cout << "[FluxGraph:" << instance->id()
+              << "] Free-running stopped (ticks=" << stats.ticks
+              << ", overruns=" << stats.overruns << ", max_lateness_us="
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     stats.max_lateness)
+                     .count()
+              << ")\n";
   }
+}
 
-  const std::string provider_id = session_it->second.provider_id;
-  sessions_.erase(session_it);
+void FluxGraphServiceImpl::schedule_instances(
+    const std::vector<std::shared_ptr<SimulationInstance>> &instances) {
+  TickMode mode = TickMode::provider_barrier;
+  {
+    std::lock_guard lock(instances_mutex_);
+    if (!scheduler_) {
+      return;
+    }
+    mode = tick_mode_;
+  }
 
-  response->set_success(true);
-  std::cout << "[FluxGraph] Provider unregistered: " << provider_id
-            << " (session: " << request->session_id() << ")\n";
+  // begin_free_running waits out an in-flight AdvanceTicks batch, so it
+  // runs without the registry lock that every other tenant's RPC needs
+  std::vector<uint64_t> tokens(instances.size(), 0);
+  for (size_t i = 0; i < instances.size(); ++i) {
+    if (instances[i]->is_loaded()) {
+      tokens[i] = instances[i]->begin_free_running(mode);
+    }
+  }
 
-  lock.unlock();
-  tick_cv_.notify_all();
-  return grpc::Status::OK;
+  std::vector<std::shared_ptr<SimulationInstance>> orphaned;
+  {
+    std::lock_guard lock(instances_mutex_);
+    for (size_t i = 0; i < instances.size(); ++i) {
+      if (tokens[i] == 0) {
+        continue;
+      }
+      if (scheduler_) {
+        scheduler_->schedule(instances[i], tokens[i], tick_period_);
+      } else {
+        orphaned.push_back(instances[i]); // Stopped meanwhile
+      }
+    }
+  }
+  for (const auto &instance : orphaned) {
+    instance->end_free_running();
+  }
 }
 
 // ============================================================================
-// UpdateSignals RPC (Server-Driven Tick)
+// Instance Registry
 // ============================================================================
 
-grpc::Status FluxGraphServiceImpl::UpdateSignals(
-    grpc::ServerContext * /*context*/,
-    const fluxgraph::rpc::SignalUpdates *request,
-    fluxgraph::rpc::TickResponse *response) {
-
-  std::unique_lock<std::mutex> lock(state_mutex_);
-
-  if (!loaded_) {
-    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
-                        "Config not loaded");
+void FluxGraphServiceImpl::set_barrier_policy(BarrierPolicy policy) {
+  std::lock_guard lock(instances_mutex_);
+  barrier_policy_ = std::move(policy);
+  for (auto &[id, instance] : instances_) {
+    (void)id;
+    instance->set_barrier_policy(barrier_policy_);
   }
+}
 
-  // Validate session
-  auto session_it = sessions_.find(request->session_id());
-  if (session_it == sessions_.end()) {
-    return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
-                        "Invalid session_id - call RegisterProvider first");
-  }
+void FluxGraphServiceImpl::set_max_instances(size_t max_instances) {
+  std::lock_guard lock(instances_mutex_);
+  max_instances_ = max_instances;
+}
 
-  const auto now = std::chrono::steady_clock::now();
-  session_it->second.last_update = now;
-  prune_stale_sessions_locked(request->session_id(), now);
+const std::string &
+FluxGraphServiceImpl::normalize_instance_id(const std::string &id) {
+  return id.empty() ? kDefaultInstanceId : id;
+}
 
-  const uint64_t current_generation = tick_generation_;
+std::shared_ptr<SimulationInstance>
+FluxGraphServiceImpl::find_instance(const std::string &id) {
+  std::lock_guard lock(instances_mutex_);
+  auto it = instances_.find(normalize_instance_id(id));
+  return it == instances_.end() ? nullptr : it->second;
+}
 
-  // Write signals from provider to store
-  for (const auto &sig : request->signals()) {
-    SignalId id = signal_ns_.resolve(sig.path());
-    if (id == INVALID_SIGNAL) {
-      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
-                          "Unknown signal: " + sig.path());
-    }
-    if (protected_write_signals_.count(id) > 0) {
-      return grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
-                          "Write denied for protected signal: " + sig.path());
-    }
-    store_.write(id, sig.value(), sig.unit().c_str());
+std::shared_ptr<SimulationInstance>
+FluxGraphServiceImpl::require_instance(const std::string &instance_id,
+                                       grpc::Status *status) {
+  auto instance = find_instance(instance_id);
+  if (!instance) {
+    // An absent default instance is indistinguishable from the
+    // single-tenant "no config yet" state.
+    *status = instance_id.empty()
+                  ? grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                                 "Config not loaded")
+                  : grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                                 "Unknown instance: " + instance_id +
+                                     " - call LoadConfig first");
   }
+  return instance;
+}
 
-  // Mark this provider as updated for CURRENT generation
-  session_it->second.last_tick_generation = current_generation;
+// ============================================================================
+// LoadConfig RPC
+// ============================================================================
 
-  // Check if ALL active providers have updated for this generation
-  bool all_ready = !sessions_.empty();
-  for (const auto &[session_id, session] : sessions_) {
-    if (!session.last_tick_generation.has_value() ||
-        session.last_tick_generation.value() < current_generation) {
-      all_ready = false;
-      break;
+grpc::Status
+FluxGraphServiceImpl::LoadConfig(grpc::ServerContext * /*context*/,
+                                 const fluxgraph::rpc::ConfigRequest *request,
+                                 fluxgraph::rpc::ConfigResponse *response) {
+  return instrumented(RpcMethod::load_config, [&]() -> grpc::Status {
+    const std::string &id = normalize_instance_id(request->instance_id());
+
+    std::shared_ptr<SimulationInstance> instance;
+    bool created = false;
+    {
+      std::lock_guard lock(instances_mutex_);
+      auto it = instances_.find(id);
+      if (it != instances_.end()) {
+        instance = it->second;
+      } else {
+        if (instances_.size() >= max_instances_) {
+          response->set_success(false);
+          response->set_error_message("Instance limit reached (" +
+                                      std::to_string(max_instances_) + ")");
+          return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                              response->error_message());
+        }
+        instance = std::make_shared<SimulationInstance>(id, dt_, metrics_,
+                                                        barrier_policy_);
+        instances_.emplace(id, instance);
+        created = true;
+      }
     }
-  }
 
-  if (all_ready) {
-    // Last provider to arrive: execute one physics tick.
-    engine_.tick(dt_, store_);
-    sim_time_ += dt_;
-
-    // Advance generation for next tick.
-    tick_generation_++;
-
-    // Drain command queue exactly once for this completed tick.
-    last_completed_generation_ = tick_generation_;
-    last_completed_sim_time_ = sim_time_;
-    last_completed_commands_ = engine_.drain_commands();
-
-    // Build response for this session from shared completed-tick snapshot.
-    populate_tick_response_for_session_locked(request->session_id(), response);
-
-    // Log major tick milestones only (reduces output spam)
-    static int last_logged_tick = -1;
-    int current_tick = static_cast<int>(sim_time_ / dt_);
-    if (current_tick == 0 ||
-        (current_tick % 100 == 0 && current_tick != last_logged_tick) ||
-        (current_tick < 10)) {
-      std::cout << "[FluxGraph] Tick " << current_tick << " (t=" << std::fixed
-                << std::setprecision(1) << sim_time_
-                << "s, generation=" << tick_generation_
-                << ", commands=" << response->commands_size() << ")\n";
-      last_logged_tick = current_tick;
+    grpc::Status status = instance->load_config(request, response);
+
+    if (status.ok()) {
+      schedule_instances({instance});
+    } else if (created && !instance->is_loaded()) {
+      // Do not leave an empty tenant behind for a rejected first config.
+      std::lock_guard lock(instances_mutex_);
+      auto it = instances_.find(id);
+      if (it != instances_.end() && it->second == instance) {
+        instances_.erase(it);
+        metrics_->remove_series("instance", id);
+      }
+      instance->close();
     }
+    return status;
+  });
+}
 
-    lock.unlock();
-    tick_cv_.notify_all();
+// ============================================================================
+// Routed RPCs
+// ============================================================================
 
-  } else {
-    // Early provider: wait until current generation completes.
-    const std::string provider_id = session_it->second.provider_id;
-    const auto wait_start = std::chrono::steady_clock::now();
-    bool ticked = tick_cv_.wait_for(
-        lock, std::chrono::milliseconds(2000), [this, current_generation]() {
-          return tick_generation_ > current_generation;
-        });
-
-    const auto wait_duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - wait_start)
-            .count();
-
-    if (ticked) {
-      populate_tick_response_for_session_locked(request->session_id(),
-                                                response);
-    } else {
-      std::cerr << "[FluxGraph] WARNING: " << provider_id
-                << " timed out waiting for tick (generation="
-                << current_generation << ", waited " << wait_duration
-                << "ms)\n";
-      response->set_tick_occurred(false);
-      response->set_sim_time_sec(sim_time_);
+grpc::Status FluxGraphServiceImpl::RegisterProvider(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::ProviderRegistration *request,
+    fluxgraph::rpc::ProviderRegistrationResponse *response) {
+  return instrumented(RpcMethod::register_provider, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      response->set_success(false);
+      response->set_error_message(status.error_message());
+      return status;
     }
-  }
+    return instance->register_provider(request, response);
+  });
+}
 
-  return grpc::Status::OK;
+grpc::Status FluxGraphServiceImpl::UnregisterProvider(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::UnregisterRequest *request,
+    fluxgraph::rpc::UnregisterResponse *response) {
+  return instrumented(RpcMethod::unregister_provider, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      response->set_success(false);
+      response->set_error_message(status.error_message());
+      return status;
+    }
+    return instance->unregister_provider(request, response);
+  });
 }
 
-// ============================================================================
-// ReadSignals RPC
-// ============================================================================
+grpc::Status FluxGraphServiceImpl::UpdateSignals(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::SignalUpdates *request,
+    fluxgraph::rpc::TickResponse *response) {
+  return instrumented(RpcMethod::update_signals, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      return status;
+    }
+    return instance->update_signals(request, response);
+  });
+}
 
 grpc::Status
 FluxGraphServiceImpl::ReadSignals(grpc::ServerContext * /*context*/,
                                   const fluxgraph::rpc::SignalRequest *request,
                                   fluxgraph::rpc::SignalResponse *response) {
-
-  std::lock_guard lock(state_mutex_);
-
-  if (!loaded_) {
-    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
-                        "Config not loaded");
-  }
-
-  for (const auto &path : request->paths()) {
-    SignalId id = signal_ns_.resolve(path);
-    if (id == INVALID_SIGNAL) {
-      // Skip unknown signals (or could return error)
-      continue;
+  return instrumented(RpcMethod::read_signals, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      return status;
     }
+    return instance->read_signals(request, response);
+  });
+}
 
-    auto signal = store_.read(id);
-    auto *val = response->add_signals();
-    val->set_path(path);
-    val->set_value(signal.value);
-    val->set_unit(signal.unit);
-    val->set_physics_driven(store_.is_physics_driven(id));
-  }
-
-  return grpc::Status::OK;
+grpc::Status FluxGraphServiceImpl::Subscribe(
+    grpc::ServerContext *context,
+    const fluxgraph::rpc::SubscribeRequest *request,
+    grpc::ServerWriter<fluxgraph::rpc::SignalBatch> *writer) {
+  return instrumented(RpcMethod::subscribe, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      return status;
+    }
+    return instance->subscribe(context, request, writer);
+  });
 }
 
-// ============================================================================
-// Reset RPC
-// ============================================================================
+grpc::Status FluxGraphServiceImpl::AdvanceTicks(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::AdvanceTicksRequest *request,
+    fluxgraph::rpc::AdvanceTicksResponse *response) {
+  return instrumented(RpcMethod::advance_ticks, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      return status;
+    }
+    return instance->advance_ticks(request, response);
+  });
+}
 
 grpc::Status
 FluxGraphServiceImpl::Reset(grpc::ServerContext * /*context*/,
-                            const fluxgraph::rpc::ResetRequest * /*request*/,
+                            const fluxgraph::rpc::ResetRequest *request,
                             fluxgraph::rpc::ResetResponse *response) {
+  return instrumented(RpcMethod::reset, [&]() -> grpc::Status {
+    grpc::Status status;
+    auto instance = require_instance(request->instance_id(), &status);
+    if (!instance) {
+      response->set_success(false);
+      response->set_error_message(status.error_message());
+      return status;
+    }
+    return instance->reset(request, response);
+  });
+}
 
-  std::lock_guard lock(state_mutex_);
+// ============================================================================
+// Instance Management RPCs
+// ============================================================================
 
-  if (!loaded_) {
-    response->set_success(false);
-    response->set_error_message("Config not loaded");
-    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
-                        "Config not loaded");
-  }
+grpc::Status FluxGraphServiceImpl::ListInstances(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::ListInstancesRequest * /*request*/,
+    fluxgraph::rpc::ListInstancesResponse *response) {
+  return instrumented(RpcMethod::list_instances, [&]() -> grpc::Status {
+    std::vector<std::shared_ptr<SimulationInstance>> instances;
+    {
+      std::lock_guard lock(instances_mutex_);
+      instances.reserve(instances_.size());
+      for (const auto &[id, instance] : instances_) {
+        (void)id;
+        instances.push_back(instance);
+      }
+    }
 
-  try {
-    // Reset engine state
-    engine_.reset();
-    store_.clear();
-    for (SignalId id : physics_owned_signals_) {
-      store_.mark_physics_driven(id, true);
+    // Gather stats without the registry lock so busy tenants do not block it.
+    for (const auto &instance : instances) {
+      const InstanceStats stats = instance->stats();
+      auto *info = response->add_instances();
+      info->set_instance_id(stats.instance_id);
+      info->set_loaded(stats.loaded);
+      info->set_sim_time_sec(stats.sim_time);
+      info->set_tick_generation(stats.tick_generation);
+      info->set_state_hash(stats.state_hash);
+      info->set_provider_count(static_cast<uint32_t>(stats.provider_count));
+      info->set_signal_count(static_cast<uint32_t>(stats.signal_count));
+      info->set_approx_memory_bytes(stats.approx_memory_bytes);
+      info->set_ticks(stats.ticks);
+
+      using us = std::chrono::duration<double, std::micro>;
+      if (stats.ticks > 0) {
+        info->set_mean_tick_time_us(us(stats.total_tick_time).count() /
+                                    static_cast<double>(stats.ticks));
+      }
+      info->set_max_tick_time_us(us(stats.max_tick_time).count());
+      info->set_last_tick_time_us(us(stats.last_tick_time).count());
     }
-    sim_time_ = 0.0;
-
-    // Reset tick/cached state
-    tick_generation_ = 0;
-    last_completed_generation_ = 0;
-    last_completed_sim_time_ = 0.0;
-    last_completed_commands_.clear();
-
-    // Require all providers to resubmit generation 0 updates
-    for (auto &[session_id, session] : sessions_) {
-      (void)session_id;
-      session.last_tick_generation = std::nullopt;
+
+    return grpc::Status::OK;
+  });
+}
+
+grpc::Status FluxGraphServiceImpl::DeleteInstance(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::DeleteInstanceRequest *request,
+    fluxgraph::rpc::DeleteInstanceResponse *response) {
+  return instrumented(RpcMethod::delete_instance, [&]() -> grpc::Status {
+    const std::string &id = normalize_instance_id(request->instance_id());
+
+    std::shared_ptr<SimulationInstance> instance;
+    {
+      std::lock_guard lock(instances_mutex_);
+      auto it = instances_.find(id);
+      if (it == instances_.end()) {
+        response->set_success(false);
+        response->set_error_message("Unknown instance: " + id);
+        return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                            response->error_message());
+      }
+      instance = std::move(it->second);
+      instances_.erase(it);
+      // Under the registry lock so a re-created instance keeps its series.
+      metrics_->remove_series("instance", id);
     }
 
+    // Handlers already inside the instance keep it alive until they return.
+    instance->close();
     response->set_success(true);
-    std::cout << "[FluxGraph] Reset complete\n";
-
+    std::cout << "[FluxGraph] Instance deleted: " << id << "\n";
     return grpc::Status::OK;
+  });
+}
 
-  } catch (const std::exception &e) {
-    response->set_success(false);
-    response->set_error_message(e.what());
-    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
-  }
+// ============================================================================
+// GetMetrics RPC
+// ============================================================================
+
+grpc::Status FluxGraphServiceImpl::GetMetrics(
+    grpc::ServerContext * /*context*/,
+    const fluxgraph::rpc::MetricsRequest * /*request*/,
+    fluxgraph::rpc::MetricsResponse *response) {
+  return instrumented(RpcMethod::get_metrics, [&]() -> grpc::Status {
+    refresh_gauges();
+    response->set_text(metrics_->render_prometheus());
+    return grpc::Status::OK;
+  });
 }
 
 // ============================================================================
@@ -486,109 +550,4 @@ FluxGraphServiceImpl::Check(grpc::ServerContext * /*context*/,
   return grpc::Status::OK;
 }
 
-// ============================================================================
-// Helper Methods
-// ============================================================================
-
-std::string
-FluxGraphServiceImpl::generate_session_id(const std::string &provider_id) {
-  auto now = std::chrono::system_clock::now();
-  auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                       now.time_since_epoch())
-                       .count();
-
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dis(1000, 9999);
-
-  std::ostringstream oss;
-  oss << provider_id << "_" << timestamp << "_" << dis(gen);
-  return oss.str();
-}
-
-void FluxGraphServiceImpl::convert_command(const fluxgraph::Command &cmd,
-                                           fluxgraph::rpc::Command *pb_cmd) {
-
-  pb_cmd->set_device(func_ns_.lookup_device(cmd.device));
-  pb_cmd->set_function(func_ns_.lookup_function(cmd.function));
-
-  for (const auto &[key, variant] : cmd.args) {
-    auto &arg = (*pb_cmd->mutable_args())[key];
-
-    if (std::holds_alternative<double>(variant)) {
-      arg.set_double_val(std::get<double>(variant));
-    } else if (std::holds_alternative<int64_t>(variant)) {
-      arg.set_int_val(std::get<int64_t>(variant));
-    } else if (std::holds_alternative<bool>(variant)) {
-      arg.set_bool_val(std::get<bool>(variant));
-    } else if (std::holds_alternative<std::string>(variant)) {
-      arg.set_string_val(std::get<std::string>(variant));
-    }
-  }
-}
-
-void FluxGraphServiceImpl::prune_stale_sessions_locked(
-    const std::string &active_session_id,
-    std::chrono::steady_clock::time_point now) {
-  for (auto it = sessions_.begin(); it != sessions_.end();) {
-    if (it->first == active_session_id) {
-      ++it;
-      continue;
-    }
-
-    const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - it->second.last_update);
-    if (age > session_timeout_) {
-      std::cerr << "[FluxGraph] Evicting stale provider session: provider_id="
-                << it->second.provider_id << ", session_id=" << it->first
-                << ", age_ms=" << age.count() << "\n";
-      it = sessions_.erase(it);
-    } else {
-      ++it;
-    }
-  }
-}
-
-std::vector<fluxgraph::Command>
-FluxGraphServiceImpl::filter_commands_for_session_locked(
-    const std::string &session_id,
-    const std::vector<fluxgraph::Command> &all_commands) {
-
-  const auto session_it = sessions_.find(session_id);
-  if (session_it == sessions_.end()) {
-    return {};
-  }
-
-  const auto &device_ids = session_it->second.device_ids;
-  if (device_ids.empty()) {
-    return {};
-  }
-
-  std::vector<fluxgraph::Command> filtered;
-  for (const auto &cmd : all_commands) {
-    const std::string device_name = func_ns_.lookup_device(cmd.device);
-    for (const auto &owned_device : device_ids) {
-      if (device_name == owned_device) {
-        filtered.push_back(cmd);
-        break;
-      }
-    }
-  }
-
-  return filtered;
-}
-
-void FluxGraphServiceImpl::populate_tick_response_for_session_locked(
-    const std::string &session_id, fluxgraph::rpc::TickResponse *response) {
-  response->set_tick_occurred(true);
-  response->set_sim_time_sec(last_completed_sim_time_);
-
-  auto provider_commands =
-      filter_commands_for_session_locked(session_id, last_completed_commands_);
-  for (const auto &cmd : provider_commands) {
-    auto *pb_cmd = response->add_commands();
-    convert_command(cmd, pb_cmd);
-  }
-}
-
 } // namespace fluxgraph::server
@@ -2,43 +2,61 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <array>
 #include <chrono>
-#include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <optional>
-#include <set>
 #include <string>
 #include <vector>
 
 #include "fluxgraph.grpc.pb.h"
-#include "fluxgraph/command.hpp"
-#include "fluxgraph/core/namespace.hpp"
-#include "fluxgraph/core/signal_store.hpp"
-#include "fluxgraph/engine.hpp"
-#include "fluxgraph/graph/compiler.hpp"
+#include "metrics.hpp"
+#include "simulation_instance.hpp"
+#include "tick_scheduler.hpp"
 
 namespace fluxgraph::server {
 
-/// Provider session information
-struct ProviderSession {
-  std::string provider_id;
-  std::vector<std::string> device_ids;
-  std::chrono::steady_clock::time_point last_update;
-  std::optional<uint64_t> last_tick_generation; // Last generation this provider
-                                                // submitted updates for
-};
+/// Instance used when a request leaves instance_id empty
+inline const std::string kDefaultInstanceId = "default";
 
 /// FluxGraph gRPC service implementation
 ///
-/// Thread-safety: All RPC handlers are serialized with a single mutex.
-/// Tick coordination: Server waits for all active providers to submit
-/// UpdateSignals for the same generation before advancing one simulation tick.
+/// Hosts many independent SimulationInstances keyed by the instance_id carried
+/// in every request (empty selects "default"). LoadConfig creates instances on
+/// demand; DeleteInstance releases them.
+///
+/// Thread-safety: The instance registry has its own mutex, held only for
+/// lookup/insert/erase. Each instance serializes its own RPCs.
+/// Tick coordination: Barrier-driven instances tick on provider RPC threads.
+/// In free-running modes every loaded instance is advanced by one shared
+/// TickScheduler worker pool.
 class FluxGraphServiceImpl final : public fluxgraph::rpc::FluxGraph::Service {
 public:
   explicit FluxGraphServiceImpl(double dt = 0.1);
   ~FluxGraphServiceImpl() override;
 
+  /// Start free-running ticks for all loaded (and later loaded) instances.
+  /// @param mode realtime or as_fast_as_possible
+  /// @param rate_hz Wall-clock tick rate for realtime mode (ignored otherwise)
+  /// @param worker_count Scheduler worker threads shared by all instances
+  void start_free_running(TickMode mode, double rate_hz, size_t worker_count);
+
+  /// Stop the scheduler and return instances to provider_barrier mode
+  void stop_free_running();
+
+  /// Configure provider_barrier tick policy for current and future instances
+  void set_barrier_policy(BarrierPolicy policy);
+
+  /// Limit the number of hosted instances (default: 64)
+  void set_max_instances(size_t max_instances);
+
+  /// Look up an instance by id (nullptr when unknown)
+  std::shared_ptr<SimulationInstance> find_instance(const std::string &id);
+
+  /// Metrics registry shared by the service and all instances
+  MetricsRegistry &metrics() { return *metrics_; }
+
   // ========================================================================
   // RPC Handlers
   // ========================================================================
@@ -65,70 +83,92 @@ public:
                            const fluxgraph::rpc::SignalRequest *request,
                            fluxgraph::rpc::SignalResponse *response) override;
 
+  grpc::Status
+  Subscribe(grpc::ServerContext *context,
+            const fluxgraph::rpc::SubscribeRequest *request,
+            grpc::ServerWriter<fluxgraph::rpc::SignalBatch> *writer) override;
+
+  grpc::Status
+  AdvanceTicks(grpc::ServerContext *context,
+               const fluxgraph::rpc::AdvanceTicksRequest *request,
+               fluxgraph::rpc::AdvanceTicksResponse *response) override;
+
   grpc::Status Reset(grpc::ServerContext *context,
                      const fluxgraph::rpc::ResetRequest *request,
                      fluxgraph::rpc::ResetResponse *response) override;
 
+  grpc::Status
+  ListInstances(grpc::ServerContext *context,
+                const fluxgraph::rpc::ListInstancesRequest *request,
+                fluxgraph::rpc::ListInstancesResponse *response) override;
+
+  grpc::Status
+  DeleteInstance(grpc::ServerContext *context,
+                 const fluxgraph::rpc::DeleteInstanceRequest *request,
+                 fluxgraph::rpc::DeleteInstanceResponse *response) override;
+
+  grpc::Status GetMetrics(grpc::ServerContext *context,
+                          const fluxgraph::rpc::MetricsRequest *request,
+                          fluxgraph::rpc::MetricsResponse *response) override;
+
   grpc::Status Check(grpc::ServerContext *context,
                      const fluxgraph::rpc::HealthCheckRequest *request,
                      fluxgraph::rpc::HealthCheckResponse *response) override;
 
 private:
-  // ========================================================================
-  // Core State
-  // ========================================================================
-
-  fluxgraph::Engine engine_;
-  fluxgraph::SignalStore store_;
-  fluxgraph::SignalNamespace signal_ns_;
-  fluxgraph::FunctionNamespace func_ns_;
-
-  // Thread safety
-  std::mutex state_mutex_;
-  std::condition_variable tick_cv_; // Notified when tick completes
-  uint64_t tick_generation_ = 0;    // Increments after each tick
-
-  // Last completed tick snapshot (command queue is drained exactly once per
-  // tick)
-  uint64_t last_completed_generation_ = 0;
-  double last_completed_sim_time_ = 0.0;
-  std::vector<fluxgraph::Command> last_completed_commands_;
-
-  // Configuration
-  bool loaded_ = false;
-  std::string current_config_hash_;
-  double dt_; // Runtime timestep in seconds
-  double sim_time_ = 0.0;
-  std::set<SignalId> protected_write_signals_;
-  std::set<SignalId> physics_owned_signals_;
-
-  // Provider tracking
-  std::map<std::string, ProviderSession> sessions_; // session_id -> session
-  std::chrono::milliseconds session_timeout_{5000};
-
-  // ========================================================================
-  // Helper Methods (lock must already be held)
-  // ========================================================================
-
-  // Generate unique session ID for provider
-  std::string generate_session_id(const std::string &provider_id);
-
-  // Convert FluxGraph Command to protobuf Command
-  void convert_command(const fluxgraph::Command &cmd,
-                       fluxgraph::rpc::Command *pb_cmd);
-
-  // Remove stale sessions (except currently active session)
-  void prune_stale_sessions_locked(const std::string &active_session_id,
-                                   std::chrono::steady_clock::time_point now);
-
-  // Filter commands for a specific provider session
-  std::vector<fluxgraph::Command> filter_commands_for_session_locked(
-      const std::string &session_id,
-      const std::vector<fluxgraph::Command> &all_commands);
-
-  // Populate TickResponse from last completed tick snapshot
-  void populate_tick_response_for_session_locked(
-      const std::string &session_id, fluxgraph::rpc::TickResponse *response);
+  double dt_; // Runtime timestep in seconds (shared by all instances)
+  BarrierPolicy barrier_policy_;
+
+  // Instance registry
+  std::mutex instances_mutex_;
+  std::map<std::string, std::shared_ptr<SimulationInstance>> instances_;
+  size_t max_instances_ = 64;
+
+  // Free-running scheduling (guarded by instances_mutex_)
+  TickMode tick_mode_ = TickMode::provider_barrier;
+  std::chrono::nanoseconds tick_period_{0};
+  std::unique_ptr<TickScheduler> scheduler_;
+
+  // Metrics
+  enum class RpcMethod : size_t {
+    load_config,
+    register_provider,
+    unregister_provider,
+    update_signals,
+    read_signals,
+    subscribe,
+    advance_ticks,
+    reset,
+    list_instances,
+    delete_instance,
+    get_metrics,
+    count,
+  };
+  struct RpcMetrics {
+    std::shared_ptr<Histogram> latency;
+    std::shared_ptr<Counter> failures;
+  };
+  std::shared_ptr<MetricsRegistry> metrics_;
+  std::array<RpcMetrics, static_cast<size_t>(RpcMethod::count)> rpc_metrics_;
+
+  // Run an RPC body, recording latency and non-OK status for the method
+  template <typename Body>
+  grpc::Status instrumented(RpcMethod method, Body &&body);
+
+  // Refresh scrape-time gauges (instance count, per-instance sizes)
+  void refresh_gauges();
+
+  // Map empty instance_id to the default instance
+  static const std::string &normalize_instance_id(const std::string &id);
+
+  // Look up an instance for a non-creating RPC; sets FAILED_PRECONDITION
+  std::shared_ptr<SimulationInstance>
+  require_instance(const std::string &instance_id, grpc::Status *status);
+
+  // Queue loaded instances on the scheduler if free-running. Takes
+  // instances_mutex_ itself; must be called without it.
+  void schedule_instances(
+      const std::vector<std::shared_ptr<SimulationInstance>> &instances);
 };
 
 } // namespace fluxgraph::server
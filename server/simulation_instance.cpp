@@ -0,0 +1,1500 @@
+#include "simulation_instance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+
+#include "fluxgraph/graph/templates.hpp"
+#include "fluxgraph/loaders/json_loader.hpp"
+#include "fluxgraph/loaders/yaml_loader.hpp"
+
+namespace fluxgraph::server {
+
+namespace {
+
+std::shared_ptr<const std::vector<SignalId>>
+collect_watched_ids(const std::map<SignalId, size_t> &refs) {
+  if (refs.empty()) {
+    return nullptr;
+  }
+
+  auto ids = std::make_shared<std::vector<SignalId>>();
+  ids->reserve(refs.size());
+  for (const auto &[id, count] : refs) {
+    (void)count;
+    ids->push_back(id);
+  }
+  return ids;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+SimulationInstance::SimulationInstance(
+    std::string instance_id, double dt,
+    std::shared_ptr<MetricsRegistry> metrics, BarrierPolicy barrier_policy)
+    : barrier_policy_(std::move(barrier_policy)),
+      instance_id_(std::move(instance_id)), dt_(dt),
+      metrics_(std::move(metrics)) {
+  const MetricLabels labels{{"instance", instance_id_}};
+  const auto stage = [this](const char *name) {
+    return metrics_->histogram("fluxgraph_tick_stage_seconds",
+                               "Engine tick stage duration",
+                               {{"instance", instance_id_}, {"stage", name}});
+  };
+
+  tick_duration_metric_ = metrics_->histogram(
+      "fluxgraph_tick_duration_seconds",
+      "Engine tick duration (excludes barrier waits)", labels);
+  stage_models_metric_ = stage("models");
+  stage_edges_metric_ = stage("edges");
+  stage_rules_metric_ = stage("rules");
+  ticks_metric_ =
+      metrics_->counter("fluxgraph_ticks_total", "Completed ticks", labels);
+  commands_metric_ = metrics_->counter("fluxgraph_commands_total",
+                                       "Commands emitted by rules", labels);
+  engine_.set_stage_timing(true);
+}
+
+SimulationInstance::~SimulationInstance() = default;
+
+void SimulationInstance::set_barrier_policy(BarrierPolicy policy) {
+  std::lock_guard lock(state_mutex_);
+  barrier_policy_ = std::move(policy);
+}
+
+std::map<std::string, ProviderLatenessStats>
+SimulationInstance::provider_lateness_stats() {
+  std::lock_guard lock(state_mutex_);
+  std::map<std::string, ProviderLatenessStats> stats;
+  for (const auto &[session_id, session] : sessions_) {
+    (void)session_id;
+    stats[session.provider_id] = session.lateness;
+  }
+  return stats;
+}
+
+TickPacingStats SimulationInstance::tick_pacing_stats() {
+  std::lock_guard lock(state_mutex_);
+  return pacing_stats_;
+}
+
+bool SimulationInstance::is_loaded() {
+  std::lock_guard lock(state_mutex_);
+  return loaded_;
+}
+
+InstanceStats SimulationInstance::stats() {
+  std::lock_guard lock(state_mutex_);
+
+  InstanceStats stats;
+  stats.instance_id = instance_id_;
+  stats.loaded = loaded_;
+  stats.sim_time = sim_time_;
+  stats.tick_generation = tick_generation_;
+  stats.state_hash = last_completed_state_hash_;
+  stats.provider_count = sessions_.size();
+  stats.signal_count = signal_ns_.size();
+  stats.ticks = tick_timing_.ticks;
+  stats.total_tick_time = tick_timing_.total;
+  stats.max_tick_time = tick_timing_.max;
+  stats.last_tick_time = tick_timing_.last;
+
+  // Approximate resident state: store planes, interned paths, staging and
+  // queued commands. Model/transform internals are not included.
+  size_t bytes = sizeof(*this) + config_bytes_;
+  bytes += store_.capacity() *
+           (sizeof(Signal) + sizeof(std::string) + 3 * sizeof(uint8_t));
+  bytes += signal_ns_.memory_bytes();
+  bytes += staged_inputs_.capacity() * sizeof(StagedInput);
+  bytes += staged_input_ids_.capacity() * sizeof(SignalId);
+  for (const auto &[session_id, session] : sessions_) {
+    bytes += session_id.capacity() + sizeof(ProviderSession) +
+             session.queued_commands.capacity() * sizeof(fluxgraph::Command);
+  }
+  stats.approx_memory_bytes = bytes;
+  stats.staged_inputs = staged_input_ids_.size();
+  for (const auto &[session_id, session] : sessions_) {
+    (void)session_id;
+    stats.queued_commands += session.queued_commands.size();
+  }
+  return stats;
+}
+
+// ============================================================================
+// Free-Running Scheduling (driven by TickScheduler)
+// ============================================================================
+
+uint64_t SimulationInstance::begin_free_running(TickMode mode) {
+  if (mode == TickMode::provider_barrier) {
+    throw std::invalid_argument(
+        "begin_free_running requires realtime or as_fast_as_possible mode");
+  }
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  wait_for_advance_locked(lock);
+  if (closed_ || tick_mode_ != TickMode::provider_barrier) {
+    return 0; // Deleted, or already scheduled
+  }
+  tick_mode_ = mode;
+  pacing_stats_ = TickPacingStats{};
+  return ++schedule_token_;
+}
+
+void SimulationInstance::end_free_running() {
+  std::lock_guard lock(state_mutex_);
+  tick_mode_ = TickMode::provider_barrier;
+  ++schedule_token_; // Scheduler drops the stale entry on its next pop
+}
+
+void SimulationInstance::close() {
+  closed_ = true; // Before end_free_running, so no new schedule slips in
+  end_free_running();
+  tick_cv_.notify_all();
+  {
+    std::lock_guard lock(subscription_mutex_);
+  }
+  subscription_cv_.notify_all();
+}
+
+std::optional<std::chrono::steady_clock::time_point>
+SimulationInstance::run_scheduled_tick(
+    uint64_t token, std::chrono::steady_clock::time_point deadline,
+    std::chrono::nanoseconds period) {
+  using clock = std::chrono::steady_clock;
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  if (token != schedule_token_ || tick_mode_ == TickMode::provider_barrier ||
+      !loaded_) {
+    return std::nullopt;
+  }
+
+  if (tick_mode_ == TickMode::realtime) {
+    const auto lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - deadline);
+    const auto lateness_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(lateness)
+            .count());
+    size_t bucket = 0;
+    uint64_t bucket_bound_us = 1;
+    while (bucket + 1 < TickPacingStats::kLatenessBuckets &&
+           lateness_us > bucket_bound_us) {
+      bucket_bound_us <<= 1U;
+      ++bucket;
+    }
+    ++pacing_stats_.lateness_histogram[bucket];
+    pacing_stats_.total_lateness += lateness;
+    pacing_stats_.max_lateness = std::max(pacing_stats_.max_lateness, lateness);
+  }
+
+  try {
+    execute_tick_locked();
+    ++pacing_stats_.ticks;
+  } catch (const std::exception &e) {
+    std::cerr << "[FluxGraph:" << instance_id_
+              << "] Free-running tick failed, stopping: " << e.what() << "\n";
+    tick_mode_ = TickMode::provider_barrier;
+    ++schedule_token_;
+    return std::nullopt;
+  }
+
+  const auto finished = clock::now();
+  if (tick_mode_ == TickMode::as_fast_as_possible) {
+    lock.unlock();
+    tick_cv_.notify_all();
+    return finished; // Due immediately; queue order round-robins instances
+  }
+
+  // Absolute deadlines: drift does not accumulate across ticks.
+  auto next_deadline = deadline + period;
+  if (finished > next_deadline) {
+    ++pacing_stats_.overruns;
+    if (finished - next_deadline >= period) {
+      // A full period behind: re-anchor instead of bursting to catch up.
+      next_deadline = finished + period;
+      ++pacing_stats_.schedule_resets;
+    }
+  }
+
+  lock.unlock();
+  tick_cv_.notify_all();
+  return next_deadline;
+}
+
+// ============================================================================
+// LoadConfig RPC
+// ============================================================================
+
+grpc::Status
+SimulationInstance::load_config(const fluxgraph::rpc::ConfigRequest *request,
+                                fluxgraph::rpc::ConfigResponse *response) {
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  wait_for_advance_locked(lock);
+
+  try {
+    // Check for no-op (matching hash)
+    if (!request->config_hash().empty() &&
+        request->config_hash() == current_config_hash_) {
+      engine_.set_state_hashing(request->state_hashing());
+      store_.set_unit_conversion(request->convert_units());
+      response->set_success(true);
+      response->set_config_changed(false);
+      std::cout << "[FluxGraph:" << instance_id_
+                << "] LoadConfig: no-op (hash matched)\n";
+      return grpc::Status::OK;
+    }
+
+    // Parse config based on format
+    GraphSpec spec;
+    if (request->format() == "yaml") {
+#ifdef FLUXGRAPH_YAML_ENABLED
+      spec = fluxgraph::loaders::load_yaml_string(request->config_content());
+#else
+      response->set_success(false);
+      response->set_error_message(
+          "YAML support not enabled (build with -DFLUXGRAPH_YAML_ENABLED=ON)");
+      return grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
+                          "YAML support not enabled");
+#endif
+    } else if (request->format() == "json") {
+#ifdef FLUXGRAPH_JSON_ENABLED
+      spec = fluxgraph::loaders::load_json_string(request->config_content());
+#else
+      response->set_success(false);
+      response->set_error_message(
+          "JSON support not enabled (build with -DFLUXGRAPH_JSON_ENABLED=ON)");
+      return grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
+                          "JSON support not enabled");
+#endif
+    } else {
+      response->set_success(false);
+      response->set_error_message("Unknown format: " + request->format() +
+                                  " (must be 'yaml' or 'json')");
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Unknown format");
+    }
+
+    // Flatten templates once; the contract preload and write-authority maps
+    // below must see the same signals, edges and models as the compiler
+    spec = expand_templates(spec);
+
+    // Clear existing namespaces (fresh start)
+    signal_ns_.clear();
+    func_ns_.clear();
+
+    // Compile graph
+    GraphCompiler compiler;
+    auto program = compiler.compile(spec, signal_ns_, func_ns_, dt_);
+
+    // Load into engine
+    engine_.load(std::move(program));
+    engine_.set_state_hashing(request->state_hashing());
+
+    // Reset simulation state (fresh store to avoid stale declared-unit
+    // carryover across config reloads).
+    store_ = SignalStore();
+    store_.set_unit_conversion(request->convert_units());
+    protected_write_signals_.clear();
+    physics_owned_signals_.clear();
+    sim_time_ = 0.0;
+    tick_generation_ = 0;
+    last_completed_generation_ = 0;
+    last_completed_sim_time_ = 0.0;
+    last_completed_state_hash_ = 0;
+    last_completed_commands_.clear();
+    last_completed_late_providers_.clear();
+    generation_first_report_.reset();
+    while (!sessions_.empty()) {
+      erase_session_locked(sessions_.begin());
+    }
+
+    staged_inputs_.assign(signal_ns_.size(), StagedInput{});
+    staged_input_ids_.clear();
+
+    // Signal IDs are reassigned on reload; end existing subscriptions.
+    watched_signal_refs_.clear();
+    watched_signal_ids_.reset();
+    ++config_epoch_;
+    publish_subscription_snapshot_locked();
+
+    // Preload declared signal contracts so provider writes are validated
+    // immediately (before first tick).
+    for (const auto &signal_spec : spec.signals) {
+      const SignalId signal_id = signal_ns_.resolve(signal_spec.path);
+      if (signal_id != INVALID_SIGNAL) {
+        store_.declare_unit(signal_id, signal_spec.unit);
+      }
+    }
+
+    // Build write-authority map from spec.
+    // - All edge targets are derived outputs and protected from external
+    // writes.
+    // - Model output signals are physics-owned and protected.
+    for (const auto &edge : spec.edges) {
+      const SignalId target_id = signal_ns_.resolve(edge.target_path);
+      if (target_id != INVALID_SIGNAL) {
+        protected_write_signals_.insert(target_id);
+      }
+    }
+
+    for (const auto &model : spec.models) {
+      if (model.type == "thermal_mass") {
+        const auto temp_it = model.params.find("temp_signal");
+        if (temp_it != model.params.end() &&
+            std::holds_alternative<std::string>(temp_it->second)) {
+          const auto &temp_path = std::get<std::string>(temp_it->second);
+          const SignalId temp_id = signal_ns_.resolve(temp_path);
+          if (temp_id != INVALID_SIGNAL) {
+            protected_write_signals_.insert(temp_id);
+            physics_owned_signals_.insert(temp_id);
+            store_.mark_physics_driven(temp_id, true);
+          }
+        }
+      }
+    }
+
+    // Update config hash
+    current_config_hash_ = request->config_hash();
+    config_bytes_ = request->config_content().size();
+    tick_timing_ = TickTiming{};
+    loaded_ = true;
+
+    response->set_success(true);
+    response->set_config_changed(true);
+
+    std::cout << "[FluxGraph:" << instance_id_
+              << "] Config loaded: " << spec.models.size() << " models, "
+              << spec.edges.size() << " edges, "
+              << spec.rules.size() << " rules, dt=" << dt_ << "s\n";
+
+    return grpc::Status::OK;
+
+  } catch (const std::exception &e) {
+    response->set_success(false);
+    response->set_error_message(e.what());
+    std::cerr << "[FluxGraph:" << instance_id_
+              << "] LoadConfig failed: " << e.what() << "\n";
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+  }
+}
+
+// ============================================================================
+// RegisterProvider RPC
+// ============================================================================
+
+grpc::Status SimulationInstance::register_provider(
+    const fluxgraph::rpc::ProviderRegistration *request,
+    fluxgraph::rpc::ProviderRegistrationResponse *response) {
+
+  std::lock_guard lock(state_mutex_);
+
+  if (!loaded_) {
+    response->set_success(false);
+    response->set_error_message("Config not loaded - call LoadConfig first");
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "Config not loaded");
+  }
+
+  if (request->provider_id().empty()) {
+    response->set_success(false);
+    response->set_error_message("provider_id must be non-empty");
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "provider_id must be non-empty");
+  }
+
+  std::vector<std::string> requested_devices(request->device_ids().begin(),
+                                             request->device_ids().end());
+
+  const auto now = std::chrono::steady_clock::now();
+  prune_stale_sessions_locked("", now);
+
+  // Enforce unique provider identity and device ownership among active
+  // sessions.
+  for (const auto &[existing_session_id, existing_session] : sessions_) {
+    if (existing_session.provider_id == request->provider_id()) {
+      response->set_success(false);
+      response->set_error_message("provider_id already registered: " +
+                                  request->provider_id());
+      return grpc::Status(grpc::StatusCode::ALREADY_EXISTS,
+                          "provider_id already registered");
+    }
+
+    for (const auto &device_id : requested_devices) {
+      const auto found =
+          std::find(existing_session.device_ids.begin(),
+                    existing_session.device_ids.end(), device_id);
+      if (found != existing_session.device_ids.end()) {
+        response->set_success(false);
+        response->set_error_message(
+            "device_id already owned by another provider: " + device_id);
+        return grpc::Status(grpc::StatusCode::ALREADY_EXISTS,
+                            "device_id ownership conflict");
+      }
+    }
+  }
+
+  // Generate unique session ID
+  std::string session_id = generate_session_id(request->provider_id());
+
+  // Store provider session
+  ProviderSession session;
+  session.provider_id = request->provider_id();
+  session.device_ids = std::move(requested_devices);
+  session.last_update = now;
+  session.last_tick_generation =
+      std::nullopt; // Must submit updates for generation 0
+  session.barrier_wait = metrics_->histogram(
+      "fluxgraph_barrier_wait_seconds",
+      "Time a provider waited in UpdateSignals for its barrier tick",
+      {{"instance", instance_id_}, {"provider", session.provider_id}});
+
+  sessions_[session_id] = std::move(session);
+
+  response->set_success(true);
+  response->set_session_id(session_id);
+
+  std::cout << "[FluxGraph:" << instance_id_
+            << "] Provider registered: " << request->provider_id()
+            << " (session: " << session_id << ")\n";
+
+  return grpc::Status::OK;
+}
+
+grpc::Status SimulationInstance::unregister_provider(
+    const fluxgraph::rpc::UnregisterRequest *request,
+    fluxgraph::rpc::UnregisterResponse *response) {
+  std::unique_lock<std::mutex> lock(state_mutex_);
+
+  if (request->session_id().empty()) {
+    response->set_success(false);
+    response->set_error_message("session_id must be non-empty");
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "session_id must be non-empty");
+  }
+
+  const auto session_it = sessions_.find(request->session_id());
+  if (session_it == sessions_.end()) {
+    response->set_success(false);
+    response->set_error_message("Unknown session_id");
+    return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
+                        "Unknown session_id");
+  }
+
+  const std::string provider_id = session_it->second.provider_id;
+  erase_session_locked(session_it);
+
+  response->set_success(true);
+  std::cout << "[FluxGraph:" << instance_id_
+            << "] Provider unregistered: " << provider_id
+            << " (session: " << request->session_id() << ")\n";
+
+  lock.unlock();
+  tick_cv_.notify_all();
+  return grpc::Status::OK;
+}
+
+// ============================================================================
+// UpdateSignals RPC (Server-Driven Tick)
+// ============================================================================
+
+grpc::Status
+SimulationInstance::update_signals(const fluxgraph::rpc::SignalUpdates *request,
+                                   fluxgraph::rpc::TickResponse *response) {
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  wait_for_advance_locked(lock);
+
+  if (!loaded_) {
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "Config not loaded");
+  }
+
+  // Validate session
+  auto session_it = sessions_.find(request->session_id());
+  if (session_it == sessions_.end()) {
+    return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
+                        "Invalid session_id - call RegisterProvider first");
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  session_it->second.last_update = now;
+  prune_stale_sessions_locked(request->session_id(), now);
+
+  if (tick_mode_ != TickMode::provider_barrier) {
+    // Free-running: stage writes for the next tick boundary and return
+    // immediately with commands accumulated since this provider's last call.
+    for (const auto &sig : request->signals()) {
+      grpc::Status staged = stage_input_locked(sig);
+      if (!staged.ok()) {
+        return staged;
+      }
+    }
+
+    auto &session = session_it->second;
+    const uint64_t previous_generation =
+        session.last_tick_generation.value_or(0);
+    session.last_tick_generation = tick_generation_;
+
+    response->set_tick_occurred(tick_generation_ > previous_generation);
+    response->set_sim_time_sec(last_completed_sim_time_);
+    response->set_state_hash(last_completed_state_hash_);
+    for (const auto &cmd : session.queued_commands) {
+      convert_command(cmd, response->add_commands());
+    }
+    session.queued_commands.clear();
+    return grpc::Status::OK;
+  }
+
+  const uint64_t current_generation = tick_generation_;
+
+  // Write signals from provider to store
+  for (const auto &sig : request->signals()) {
+    SignalId id = signal_ns_.resolve(sig.path());
+    if (id == INVALID_SIGNAL) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Unknown signal: " + sig.path());
+    }
+    if (protected_write_signals_.count(id) > 0) {
+      return grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                          "Write denied for protected signal: " + sig.path());
+    }
+    store_.write(id, sig.value(), sig.unit().c_str());
+  }
+
+  // Mark this provider as updated for CURRENT generation
+  auto &session = session_it->second;
+  session.last_tick_generation = current_generation;
+
+  // Arrival lag relative to the first provider reporting this generation
+  if (!generation_first_report_.has_value()) {
+    generation_first_report_ = now;
+  }
+  const auto arrival_lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      now - *generation_first_report_);
+  ++session.lateness.arrivals;
+  session.lateness.total_arrival_lag += arrival_lag;
+  session.lateness.max_arrival_lag =
+      std::max(session.lateness.max_arrival_lag, arrival_lag);
+
+  if (barrier_ready_locked(current_generation)) {
+    // Barrier satisfied by this arrival: execute one physics tick.
+    complete_barrier_tick_locked(current_generation);
+
+    // Build response for this session from shared completed-tick snapshot.
+    populate_tick_response_for_session_locked(request->session_id(), response);
+
+    lock.unlock();
+    tick_cv_.notify_all();
+
+  } else {
+    // Early provider: wait until current generation completes, or until the
+    // policy deadline expires and this provider forces the tick itself.
+    const std::string provider_id = session.provider_id;
+    const auto wait_start = std::chrono::steady_clock::now();
+    const bool has_deadline = barrier_policy_.deadline.count() > 0;
+    const auto wait_until = has_deadline
+                                ? *generation_first_report_ +
+                                      barrier_policy_.deadline
+                                : wait_start + std::chrono::milliseconds(2000);
+    bool ticked = tick_cv_.wait_until(
+        lock, wait_until, [this, current_generation]() {
+          return tick_generation_ > current_generation;
+        });
+
+    if (!ticked && advancing_) {
+      // A batch started while this provider waited; it completes the
+      // generation
+      wait_for_advance_locked(lock);
+      ticked = tick_generation_ > current_generation;
+    }
+
+    bool forced = false;
+    if (!ticked && has_deadline && sessions_.count(request->session_id()) > 0) {
+      // Deadline expired: tick with late providers' last values held.
+      complete_barrier_tick_locked(current_generation);
+      ticked = true;
+      forced = true;
+    }
+
+    const auto waited = std::chrono::steady_clock::now() - wait_start;
+    const auto wait_duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(waited).count();
+    auto waiting_session = sessions_.find(request->session_id());
+    if (waiting_session != sessions_.end()) {
+      waiting_session->second.barrier_wait->observe(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(waited));
+    }
+
+    if (ticked) {
+      populate_tick_response_for_session_locked(request->session_id(),
+                                                response);
+      if (forced) {
+        lock.unlock();
+        tick_cv_.notify_all();
+      }
+    } else {
+      std::cerr << "[FluxGraph:" << instance_id_ << "] WARNING: " << provider_id
+                << " timed out waiting for tick (generation="
+                << current_generation << ", waited " << wait_duration
+                << "ms)\n";
+      response->set_tick_occurred(false);
+      response->set_sim_time_sec(sim_time_);
+    }
+  }
+
+  return grpc::Status::OK;
+}
+
+// ============================================================================
+// ReadSignals RPC
+// ============================================================================
+
+grpc::Status
+SimulationInstance::read_signals(const fluxgraph::rpc::SignalRequest *request,
+                                 fluxgraph::rpc::SignalResponse *response) {
+
+  std::lock_guard lock(state_mutex_);
+
+  if (!loaded_) {
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "Config not loaded");
+  }
+
+  auto add_signal = [&](SignalId id, std::string_view path) {
+    auto signal = store_.read(id);
+    auto *val = response->add_signals();
+    val->set_path(path.data(), path.size());
+    val->set_value(signal.value);
+    val->set_unit(signal.unit);
+    val->set_physics_driven(store_.is_physics_driven(id));
+  };
+
+  for (const auto &path : request->paths()) {
+    SignalId id = signal_ns_.resolve(path);
+    if (id == INVALID_SIGNAL) {
+      // Skip unknown signals (or could return error)
+      continue;
+    }
+    add_signal(id, path);
+  }
+
+  // Wildcard reads walk only the path-index subtree under each pattern's
+  // literal prefix
+  for (const auto &pattern : request->patterns()) {
+    for (SignalId id : signal_ns_.find_glob(pattern)) {
+      add_signal(id, signal_ns_.lookup(id));
+    }
+  }
+
+  return grpc::Status::OK;
+}
+
+// ============================================================================
+// Subscribe RPC (Server Push)
+// ============================================================================
+
+grpc::Status SimulationInstance::subscribe(
+    grpc::ServerContext *context,
+    const fluxgraph::rpc::SubscribeRequest *request,
+    grpc::ServerWriter<fluxgraph::rpc::SignalBatch> *writer) {
+
+  std::vector<SignalSubscription> subscriptions;
+  fluxgraph::rpc::SignalBatch initial;
+  uint64_t epoch = 0;
+  uint64_t last_sequence = 0;
+
+  {
+    std::lock_guard lock(state_mutex_);
+
+    if (!loaded_) {
+      return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                          "Config not loaded");
+    }
+    if (request->signals().empty()) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Subscribe requires at least one signal");
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    subscriptions.reserve(static_cast<size_t>(request->signals_size()));
+    for (const auto &requested : request->signals()) {
+      const SignalId id = signal_ns_.resolve(requested.path());
+      if (id == INVALID_SIGNAL) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "Unknown signal: " + requested.path());
+      }
+      if (!(requested.deadband() >= 0.0) || !(requested.max_rate_hz() >= 0.0)) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "deadband and max_rate_hz must be >= 0 for: " +
+                                requested.path());
+      }
+
+      const Signal signal = store_.read(id);
+
+      SignalSubscription sub;
+      sub.path = requested.path();
+      sub.id = id;
+      sub.physics_driven = store_.is_physics_driven(id);
+      sub.deadband = requested.deadband();
+      if (requested.max_rate_hz() > 0.0) {
+        sub.min_interval =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / requested.max_rate_hz()));
+      }
+      sub.last_sent_value = signal.value;
+      sub.last_sent_time = now;
+
+      auto *val = initial.add_signals();
+      val->set_path(sub.path);
+      val->set_value(signal.value);
+      val->set_unit(reported_unit_locked(id));
+      val->set_physics_driven(sub.physics_driven);
+
+      subscriptions.push_back(std::move(sub));
+    }
+
+    watch_signals_locked(subscriptions);
+    epoch = config_epoch_;
+    initial.set_tick_generation(last_completed_generation_);
+    initial.set_sim_time_sec(sim_time_);
+    initial.set_state_hash(last_completed_state_hash_);
+  }
+
+  {
+    std::lock_guard lock(subscription_mutex_);
+    if (subscription_snapshot_) {
+      last_sequence = subscription_snapshot_->sequence;
+    }
+  }
+
+  grpc::Status status = grpc::Status::OK;
+  bool stream_open = writer->Write(initial);
+  std::shared_ptr<const std::vector<SignalId>> layout;
+
+  while (stream_open && !context->IsCancelled()) {
+    std::shared_ptr<const SubscriptionSnapshot> snapshot;
+    {
+      std::unique_lock lock(subscription_mutex_);
+      subscription_cv_.wait_for(
+          lock, std::chrono::milliseconds(100), [this, last_sequence]() {
+            return closed_ || (subscription_snapshot_ &&
+                               subscription_snapshot_->sequence !=
+                                   last_sequence);
+          });
+      snapshot = subscription_snapshot_;
+    }
+
+    if (closed_) {
+      status = grpc::Status(grpc::StatusCode::ABORTED, "Instance deleted");
+      break;
+    }
+
+    if (!snapshot || snapshot->sequence == last_sequence) {
+      continue; // Timed out; re-check cancellation.
+    }
+    last_sequence = snapshot->sequence;
+
+    if (snapshot->config_epoch != epoch) {
+      status = grpc::Status(grpc::StatusCode::ABORTED,
+                            "Config reloaded - resubscribe");
+      break;
+    }
+
+    // Resolve value slots only when the watched-set layout changes.
+    if (snapshot->ids != layout) {
+      layout = snapshot->ids;
+      for (auto &sub : subscriptions) {
+        sub.snapshot_slot = std::numeric_limits<size_t>::max();
+        if (layout) {
+          const auto found =
+              std::lower_bound(layout->begin(), layout->end(), sub.id);
+          if (found != layout->end() && *found == sub.id) {
+            sub.snapshot_slot =
+                static_cast<size_t>(std::distance(layout->begin(), found));
+          }
+        }
+      }
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    fluxgraph::rpc::SignalBatch batch;
+    for (auto &sub : subscriptions) {
+      if (sub.snapshot_slot >= snapshot->values.size()) {
+        continue;
+      }
+
+      const double value = snapshot->values[sub.snapshot_slot];
+      const double delta = std::abs(value - sub.last_sent_value);
+      const bool changed = sub.deadband > 0.0 ? delta >= sub.deadband
+                                              : value != sub.last_sent_value;
+      if (!changed || now - sub.last_sent_time < sub.min_interval) {
+        continue;
+      }
+
+      auto *val = batch.add_signals();
+      val->set_path(sub.path);
+      val->set_value(value);
+      val->set_unit((*snapshot->units)[sub.snapshot_slot]);
+      val->set_physics_driven(sub.physics_driven);
+      sub.last_sent_value = value;
+      sub.last_sent_time = now;
+    }
+
+    if (batch.signals_size() == 0) {
+      continue;
+    }
+
+    batch.set_tick_generation(snapshot->tick_generation);
+    batch.set_sim_time_sec(snapshot->sim_time);
+    batch.set_state_hash(snapshot->state_hash);
+    stream_open = writer->Write(batch);
+  }
+
+  {
+    std::lock_guard lock(state_mutex_);
+    if (epoch == config_epoch_) {
+      unwatch_signals_locked(subscriptions);
+    }
+  }
+
+  return status;
+}
+
+// ============================================================================
+// AdvanceTicks RPC (Batched Offline Advance)
+// ============================================================================
+
+grpc::Status SimulationInstance::advance_ticks(
+    const fluxgraph::rpc::AdvanceTicksRequest *request,
+    fluxgraph::rpc::AdvanceTicksResponse *response) {
+  constexpr uint64_t kMaxAdvanceTicks = 100'000'000;
+  constexpr uint64_t kMaxTraceSamples = 64'000'000; // ~512 MB of doubles
+  // The lock is released between chunks so stats(), GetMetrics and
+  // ListInstances are not stalled for the whole batch
+  constexpr uint64_t kAdvanceChunkTicks = 10'000;
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  wait_for_advance_locked(lock);
+
+  if (!loaded_) {
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "Config not loaded");
+  }
+  if (tick_mode_ != TickMode::provider_barrier) {
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "AdvanceTicks is unavailable while free-running");
+  }
+
+  const uint64_t tick_count = request->tick_count();
+  if (tick_count == 0 || tick_count > kMaxAdvanceTicks) {
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "tick_count must be in [1, " +
+                            std::to_string(kMaxAdvanceTicks) + "]");
+  }
+  const uint64_t decimation = std::max<uint64_t>(1, request->decimation());
+  const uint64_t samples_per_trace = tick_count / decimation;
+  if (samples_per_trace * static_cast<uint64_t>(request->trace_paths_size()) >
+      kMaxTraceSamples) {
+    return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                        "Trace too large - increase decimation or trace "
+                        "fewer signals");
+  }
+
+  // Resolve everything up front so the tick loop touches only ids and values.
+  std::vector<SignalId> trace_ids;
+  trace_ids.reserve(static_cast<size_t>(request->trace_paths_size()));
+  for (const auto &path : request->trace_paths()) {
+    const SignalId id = signal_ns_.resolve(path);
+    if (id == INVALID_SIGNAL) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Unknown signal: " + path);
+    }
+    trace_ids.push_back(id);
+  }
+
+  struct ScheduledWrite {
+    uint64_t tick;
+    SignalId id;
+    double value;
+    const std::string *unit;
+  };
+  std::vector<ScheduledWrite> schedule;
+  schedule.reserve(static_cast<size_t>(request->inputs_size()));
+  for (const auto &input : request->inputs()) {
+    if (input.tick() >= tick_count) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Scheduled input beyond tick_count: " +
+                              input.path());
+    }
+    SignalId id = INVALID_SIGNAL;
+    grpc::Status status =
+        resolve_writable_input_locked(input.path(), input.unit(), &id);
+    if (!status.ok()) {
+      return status;
+    }
+    schedule.push_back({input.tick(), id, input.value(), &input.unit()});
+  }
+  // Stable: same-tick writes to one signal keep request order (last wins).
+  std::stable_sort(schedule.begin(), schedule.end(),
+                   [](const ScheduledWrite &lhs, const ScheduledWrite &rhs) {
+                     return lhs.tick < rhs.tick;
+                   });
+
+  const bool hash_samples = engine_.state_hashing();
+  if (hash_samples) {
+    response->mutable_state_hashes()->Reserve(
+        static_cast<int>(samples_per_trace));
+  }
+
+  std::vector<google::protobuf::RepeatedField<double> *> trace_values;
+  trace_values.reserve(trace_ids.size());
+  for (const auto &path : request->trace_paths()) {
+    auto *trace = response->add_traces();
+    trace->set_path(path);
+    trace->mutable_values()->Reserve(static_cast<int>(samples_per_trace));
+    trace_values.push_back(trace->mutable_values());
+  }
+
+  // Staged free-running writes do not apply here (mode checked above), so
+  // the loop is engine tick + scheduled writes + sampling only.
+  grpc::Status status = grpc::Status::OK;
+  uint64_t executed = 0;
+  size_t next_write = 0;
+  advancing_ = true;
+  const auto batch_start = std::chrono::steady_clock::now();
+  try {
+    for (uint64_t tick = 0; tick < tick_count; ++tick) {
+      if (tick > 0 && tick % kAdvanceChunkTicks == 0) {
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+      }
+      for (; next_write < schedule.size() && schedule[next_write].tick == tick;
+           ++next_write) {
+        const ScheduledWrite &write = schedule[next_write];
+        store_.write(write.id, write.value, *write.unit);
+      }
+
+      engine_.tick(dt_, store_);
+      sim_time_ += dt_;
+      ++executed;
+
+      for (auto &cmd : engine_.drain_commands()) {
+        auto *tick_cmd = response->add_commands();
+        tick_cmd->set_tick(tick);
+        convert_command(cmd, tick_cmd->mutable_command());
+      }
+
+      if ((tick + 1) % decimation == 0) {
+        for (size_t i = 0; i < trace_ids.size(); ++i) {
+          trace_values[i]->AddAlreadyReserved(store_.read_value(trace_ids[i]));
+        }
+        if (hash_samples) {
+          response->mutable_state_hashes()->AddAlreadyReserved(
+              engine_.last_state_hash());
+        }
+      }
+    }
+  } catch (const std::exception &e) {
+    status = grpc::Status(grpc::StatusCode::ABORTED,
+                          "AdvanceTicks stopped after " +
+                              std::to_string(executed) + " ticks: " + e.what());
+  }
+  const auto batch_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - batch_start);
+  advancing_ = false;
+
+  for (size_t i = 0; i < trace_ids.size(); ++i) {
+    response->mutable_traces(static_cast<int>(i))
+        ->set_unit(store_.read_unit(trace_ids[i]));
+  }
+
+  // Batched ticks are accounted at their mean cost.
+  if (executed > 0) {
+    const auto mean_tick =
+        batch_time / static_cast<std::chrono::nanoseconds::rep>(executed);
+    tick_timing_.ticks += executed;
+    tick_timing_.total += batch_time;
+    tick_timing_.max = std::max(tick_timing_.max, mean_tick);
+    tick_timing_.last = mean_tick;
+    ticks_metric_->add(executed);
+    commands_metric_->add(static_cast<uint64_t>(response->commands_size()));
+  }
+
+  // One generation step for the whole batch: barrier waiters are released
+  // and subscribers see the final state once.
+  ++tick_generation_;
+  last_completed_generation_ = tick_generation_;
+  last_completed_sim_time_ = sim_time_;
+  last_completed_state_hash_ = engine_.last_state_hash();
+  last_completed_commands_.clear(); // Returned to the batch caller instead
+  last_completed_late_providers_.clear();
+  generation_first_report_.reset();
+  if (watched_signal_ids_) {
+    publish_subscription_snapshot_locked();
+  }
+
+  response->set_ticks_executed(executed);
+  response->set_sim_time_sec(sim_time_);
+  response->set_state_hash(last_completed_state_hash_);
+
+  std::cout << "[FluxGraph:" << instance_id_ << "] AdvanceTicks: " << executed
+            << " ticks (t=" << std::fixed << std::setprecision(1) << sim_time_
+            << "s, " << response->commands_size() << " commands)\n";
+
+  lock.unlock();
+  tick_cv_.notify_all();
+  return status;
+}
+
+// ============================================================================
+// Reset RPC
+// ============================================================================
+
+grpc::Status
+SimulationInstance::reset(const fluxgraph::rpc::ResetRequest * /*request*/,
+                          fluxgraph::rpc::ResetResponse *response) {
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  wait_for_advance_locked(lock);
+
+  if (!loaded_) {
+    response->set_success(false);
+    response->set_error_message("Config not loaded");
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                        "Config not loaded");
+  }
+
+  try {
+    // Reset engine state
+    engine_.reset();
+    store_.clear();
+    for (SignalId id : physics_owned_signals_) {
+      store_.mark_physics_driven(id, true);
+    }
+    sim_time_ = 0.0;
+
+    // Reset tick/cached state
+    tick_generation_ = 0;
+    last_completed_generation_ = 0;
+    last_completed_sim_time_ = 0.0;
+    last_completed_state_hash_ = 0;
+    last_completed_commands_.clear();
+
+    last_completed_late_providers_.clear();
+    generation_first_report_.reset();
+
+    // Require all providers to resubmit generation 0 updates
+    for (auto &[session_id, session] : sessions_) {
+      (void)session_id;
+      session.last_tick_generation = std::nullopt;
+      session.queued_commands.clear();
+      session.unreported_held_ticks = 0;
+    }
+
+    for (SignalId id : staged_input_ids_) {
+      staged_inputs_[static_cast<size_t>(id)].dirty = false;
+    }
+    staged_input_ids_.clear();
+
+    if (watched_signal_ids_) {
+      publish_subscription_snapshot_locked();
+    }
+
+    response->set_success(true);
+    std::cout << "[FluxGraph:" << instance_id_ << "] Reset complete\n";
+
+    return grpc::Status::OK;
+
+  } catch (const std::exception &e) {
+    response->set_success(false);
+    response->set_error_message(e.what());
+    return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+  }
+}
+
+// ============================================================================
+// Helper Methods
+// ============================================================================
+
+std::string
+SimulationInstance::generate_session_id(const std::string &provider_id) {
+  auto now = std::chrono::system_clock::now();
+  auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       now.time_since_epoch())
+                       .count();
+
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> dis(1000, 9999);
+
+  std::ostringstream oss;
+  oss << provider_id << "_" << timestamp << "_" << dis(gen);
+  return oss.str();
+}
+
+void SimulationInstance::convert_command(const fluxgraph::Command &cmd,
+                                           fluxgraph::rpc::Command *pb_cmd) {
+
+  pb_cmd->set_device(func_ns_.lookup_device(cmd.device));
+  pb_cmd->set_function(func_ns_.lookup_function(cmd.function));
+
+  for (const auto &[key, variant] : cmd.args) {
+    auto &arg = (*pb_cmd->mutable_args())[key];
+
+    if (std::holds_alternative<double>(variant)) {
+      arg.set_double_val(std::get<double>(variant));
+    } else if (std::holds_alternative<int64_t>(variant)) {
+      arg.set_int_val(std::get<int64_t>(variant));
+    } else if (std::holds_alternative<bool>(variant)) {
+      arg.set_bool_val(std::get<bool>(variant));
+    } else if (std::holds_alternative<std::string>(variant)) {
+      arg.set_string_val(std::get<std::string>(variant));
+    }
+  }
+}
+
+std::map<std::string, ProviderSession>::iterator
+SimulationInstance::erase_session_locked(
+    std::map<std::string, ProviderSession>::iterator it) {
+  // Outstanding handles (a waiting UpdateSignals) stay valid; the series is
+  // only dropped from the registry so provider churn does not accumulate
+  metrics_->remove_series(
+      {{"instance", instance_id_}, {"provider", it->second.provider_id}});
+  return sessions_.erase(it);
+}
+
+void SimulationInstance::prune_stale_sessions_locked(
+    const std::string &active_session_id,
+    std::chrono::steady_clock::time_point now) {
+  for (auto it = sessions_.begin(); it != sessions_.end();) {
+    if (it->first == active_session_id) {
+      ++it;
+      continue;
+    }
+
+    const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - it->second.last_update);
+    if (age > session_timeout_) {
+      std::cerr << "[FluxGraph:" << instance_id_
+                << "] Evicting stale provider session: provider_id="
+                << it->second.provider_id << ", session_id=" << it->first
+                << ", age_ms=" << age.count() << "\n";
+      it = erase_session_locked(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::vector<fluxgraph::Command>
+SimulationInstance::filter_commands_for_session_locked(
+    const std::string &session_id,
+    const std::vector<fluxgraph::Command> &all_commands) {
+
+  const auto session_it = sessions_.find(session_id);
+  if (session_it == sessions_.end()) {
+    return {};
+  }
+
+  const auto &device_ids = session_it->second.device_ids;
+  if (device_ids.empty()) {
+    return {};
+  }
+
+  std::vector<fluxgraph::Command> filtered;
+  for (const auto &cmd : all_commands) {
+    const std::string device_name = func_ns_.lookup_device(cmd.device);
+    for (const auto &owned_device : device_ids) {
+      if (device_name == owned_device) {
+        filtered.push_back(cmd);
+        break;
+      }
+    }
+  }
+
+  return filtered;
+}
+
+void SimulationInstance::populate_tick_response_for_session_locked(
+    const std::string &session_id, fluxgraph::rpc::TickResponse *response) {
+  response->set_tick_occurred(true);
+  response->set_sim_time_sec(last_completed_sim_time_);
+  response->set_state_hash(last_completed_state_hash_);
+  for (const auto &late_provider : last_completed_late_providers_) {
+    response->add_late_providers(late_provider);
+  }
+
+  const auto session_it = sessions_.find(session_id);
+  if (session_it != sessions_.end()) {
+    response->set_inputs_held_ticks(session_it->second.unreported_held_ticks);
+    session_it->second.unreported_held_ticks = 0;
+  }
+
+  auto provider_commands =
+      filter_commands_for_session_locked(session_id, last_completed_commands_);
+  for (const auto &cmd : provider_commands) {
+    auto *pb_cmd = response->add_commands();
+    convert_command(cmd, pb_cmd);
+  }
+}
+
+void SimulationInstance::execute_tick_locked() {
+  apply_staged_inputs_locked();
+
+  const auto tick_start = std::chrono::steady_clock::now();
+  engine_.tick(dt_, store_);
+  const auto tick_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - tick_start);
+  ++tick_timing_.ticks;
+  tick_timing_.total += tick_time;
+  tick_timing_.max = std::max(tick_timing_.max, tick_time);
+  tick_timing_.last = tick_time;
+  sim_time_ += dt_;
+
+  const TickStageTimes &stages = engine_.last_stage_times();
+  tick_duration_metric_->observe(tick_time);
+  stage_models_metric_->observe(stages.models);
+  stage_edges_metric_->observe(stages.edges);
+  stage_rules_metric_->observe(stages.rules);
+  ticks_metric_->add();
+
+  // Advance generation for next tick.
+  tick_generation_++;
+
+  // Drain command queue exactly once for this completed tick.
+  last_completed_generation_ = tick_generation_;
+  last_completed_sim_time_ = sim_time_;
+  last_completed_state_hash_ = engine_.last_state_hash();
+  last_completed_commands_ = engine_.drain_commands();
+  commands_metric_->add(last_completed_commands_.size());
+
+  if (tick_mode_ != TickMode::provider_barrier &&
+      !last_completed_commands_.empty()) {
+    // Providers poll asynchronously; hold their commands until next update.
+    constexpr size_t kMaxQueuedCommandsPerSession = 4096;
+    for (auto &[session_id, session] : sessions_) {
+      for (auto &cmd : filter_commands_for_session_locked(
+               session_id, last_completed_commands_)) {
+        if (session.queued_commands.size() >= kMaxQueuedCommandsPerSession) {
+          if (session.dropped_commands++ == 0) {
+            std::cerr << "[FluxGraph:" << instance_id_
+                      << "] WARNING: command queue full for "
+                      << session.provider_id << ", dropping commands\n";
+          }
+          continue;
+        }
+        session.queued_commands.push_back(std::move(cmd));
+      }
+    }
+  }
+
+  // Push completed-tick values to subscribers (one copy for all streams).
+  if (watched_signal_ids_) {
+    publish_subscription_snapshot_locked();
+  }
+
+  // Log major tick milestones only (reduces output spam)
+  int current_tick = static_cast<int>(sim_time_ / dt_);
+  const bool milestone = current_tick % 100 == 0 &&
+                         current_tick != last_logged_tick_ &&
+                         tick_mode_ != TickMode::as_fast_as_possible;
+  if (current_tick == 0 || milestone || (current_tick < 10)) {
+    std::cout << "[FluxGraph:" << instance_id_ << "] Tick " << current_tick
+              << " (t=" << std::fixed << std::setprecision(1) << sim_time_
+              << "s, generation=" << tick_generation_
+              << ", commands=" << last_completed_commands_.size() << ")\n";
+    last_logged_tick_ = current_tick;
+  }
+}
+
+void SimulationInstance::wait_for_advance_locked(
+    std::unique_lock<std::mutex> &lock) {
+  tick_cv_.wait(lock, [this]() { return !advancing_; });
+}
+
+bool SimulationInstance::barrier_ready_locked(uint64_t generation) const {
+  if (sessions_.empty()) {
+    return false;
+  }
+
+  size_t reported = 0;
+  for (const auto &[session_id, session] : sessions_) {
+    (void)session_id;
+    const bool has_reported =
+        session.last_tick_generation.has_value() &&
+        session.last_tick_generation.value() >= generation;
+    if (has_reported) {
+      ++reported;
+    } else if (barrier_policy_.required_providers.count(session.provider_id) >
+               0) {
+      return false;
+    }
+  }
+
+  const size_t needed =
+      barrier_policy_.quorum == 0
+          ? sessions_.size()
+          : std::min(barrier_policy_.quorum, sessions_.size());
+  return reported >= needed;
+}
+
+void SimulationInstance::complete_barrier_tick_locked(uint64_t generation) {
+  // Late providers' previous writes are still in the store (zero-order hold).
+  last_completed_late_providers_.clear();
+  for (auto &[session_id, session] : sessions_) {
+    (void)session_id;
+    if (!session.last_tick_generation.has_value() ||
+        session.last_tick_generation.value() < generation) {
+      ++session.lateness.held_ticks;
+      ++session.unreported_held_ticks;
+      last_completed_late_providers_.push_back(session.provider_id);
+    }
+  }
+
+  generation_first_report_.reset();
+  execute_tick_locked();
+}
+
+grpc::Status SimulationInstance::resolve_writable_input_locked(
+    const std::string &path, const std::string &unit, SignalId *id) const {
+  *id = signal_ns_.resolve(path);
+  if (*id == INVALID_SIGNAL) {
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "Unknown signal: " + path);
+  }
+  if (protected_write_signals_.count(*id) > 0) {
+    return grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                        "Write denied for protected signal: " + path);
+  }
+
+  try {
+    store_.validate_unit(*id, unit);
+  } catch (const std::exception &e) {
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status SimulationInstance::stage_input_locked(
+    const fluxgraph::rpc::SignalUpdate &update) {
+  SignalId id = INVALID_SIGNAL;
+  grpc::Status status =
+      resolve_writable_input_locked(update.path(), update.unit(), &id);
+  if (!status.ok()) {
+    return status;
+  }
+
+  const size_t index = static_cast<size_t>(id);
+  if (index >= staged_inputs_.size()) {
+    staged_inputs_.resize(index + 1U);
+  }
+
+  // Latest value wins: repeated writes before a tick overwrite in place.
+  StagedInput &staged = staged_inputs_[index];
+  staged.value = update.value();
+  staged.unit = update.unit();
+  if (!staged.dirty) {
+    staged.dirty = true;
+    staged_input_ids_.push_back(id);
+  }
+  return grpc::Status::OK;
+}
+
+void SimulationInstance::apply_staged_inputs_locked() {
+  for (SignalId id : staged_input_ids_) {
+    StagedInput &staged = staged_inputs_[static_cast<size_t>(id)];
+    store_.write(id, staged.value, staged.unit);
+    staged.dirty = false;
+  }
+  staged_input_ids_.clear();
+}
+
+void SimulationInstance::watch_signals_locked(
+    const std::vector<SignalSubscription> &subs) {
+  bool layout_changed = false;
+  for (const auto &sub : subs) {
+    if (watched_signal_refs_[sub.id]++ == 0) {
+      layout_changed = true;
+    }
+  }
+
+  if (layout_changed) {
+    watched_signal_ids_ = collect_watched_ids(watched_signal_refs_);
+  }
+}
+
+void SimulationInstance::unwatch_signals_locked(
+    const std::vector<SignalSubscription> &subs) {
+  bool layout_changed = false;
+  for (const auto &sub : subs) {
+    const auto it = watched_signal_refs_.find(sub.id);
+    if (it != watched_signal_refs_.end() && --it->second == 0) {
+      watched_signal_refs_.erase(it);
+      layout_changed = true;
+    }
+  }
+
+  if (layout_changed) {
+    watched_signal_ids_ = collect_watched_ids(watched_signal_refs_);
+  }
+}
+
+const std::string &
+SimulationInstance::reported_unit_locked(SignalId id) const {
+  return store_.has_declared_unit(id) ? store_.declared_unit(id)
+                                      : store_.read_unit(id);
+}
+
+void SimulationInstance::publish_subscription_snapshot_locked() {
+  auto snapshot = std::make_shared<SubscriptionSnapshot>();
+  snapshot->config_epoch = config_epoch_;
+  snapshot->tick_generation = last_completed_generation_;
+  snapshot->sim_time = sim_time_;
+  snapshot->state_hash = last_completed_state_hash_;
+  snapshot->ids = watched_signal_ids_;
+  if (snapshot->ids) {
+    snapshot->values.reserve(snapshot->ids->size());
+    for (SignalId id : *snapshot->ids) {
+      snapshot->values.push_back(store_.read_value(id));
+    }
+
+    // Units settle after a signal's first write; rebuild only on change
+    const std::vector<SignalId> &ids = *snapshot->ids;
+    bool units_current = watched_signal_units_ &&
+                         watched_signal_units_->size() == ids.size();
+    for (size_t i = 0; units_current && i < ids.size(); ++i) {
+      units_current =
+          (*watched_signal_units_)[i] == reported_unit_locked(ids[i]);
+    }
+    if (!units_current) {
+      auto units = std::make_shared<std::vector<std::string>>();
+      units->reserve(ids.size());
+      for (SignalId id : ids) {
+        units->push_back(reported_unit_locked(id));
+      }
+      watched_signal_units_ = std::move(units);
+    }
+    snapshot->units = watched_signal_units_;
+  }
+
+  {
+    std::lock_guard lock(subscription_mutex_);
+    snapshot->sequence = ++subscription_sequence_;
+    subscription_snapshot_ = std::move(snapshot);
+  }
+  subscription_cv_.notify_all();
+}
+
+} // namespace fluxgraph::server
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "fluxgraph.grpc.pb.h"
+#include "fluxgraph/command.hpp"
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/engine.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "metrics.hpp"
+
+namespace fluxgraph::server {
+
+/// Tick pacing policy
+enum class TickMode {
+  provider_barrier,    ///< Tick when every registered provider has updated
+  realtime,            ///< Free-running ticks paced by wall clock
+  as_fast_as_possible, ///< Free-running ticks without pacing
+};
+
+/// Deadline accounting for free-running ticks
+struct TickPacingStats {
+  /// Bucket i counts wakeups later than 2^(i-1) us and at most 2^i us past
+  /// their deadline (bucket 0: <= 1 us, last bucket: open-ended).
+  static constexpr size_t kLatenessBuckets = 24;
+
+  uint64_t ticks = 0;
+  uint64_t overruns = 0;        // Ticks that finished after the next deadline
+  uint64_t schedule_resets = 0; // Deadline re-anchored after a full period lag
+  std::chrono::nanoseconds max_lateness{0};
+  std::chrono::nanoseconds total_lateness{0};
+  std::array<uint64_t, kLatenessBuckets> lateness_histogram{};
+};
+
+/// Barrier policy for provider_barrier tick mode.
+/// A tick fires when every registered required provider has reported and the
+/// reported count reaches the quorum, or when the deadline after the first
+/// report of a generation expires. Providers that miss the tick keep their
+/// last written values (zero-order hold) and are flagged in TickResponse.
+struct BarrierPolicy {
+  size_t quorum = 0; // 0 = all active providers
+  std::set<std::string> required_providers;
+  std::chrono::milliseconds deadline{0}; // 0 = wait for the barrier
+};
+
+/// Per-provider barrier lateness accounting
+struct ProviderLatenessStats {
+  uint64_t arrivals = 0;
+  uint64_t held_ticks = 0; // Ticks completed with this provider's inputs held
+  std::chrono::nanoseconds total_arrival_lag{0}; // After generation's first
+  std::chrono::nanoseconds max_arrival_lag{0};   // provider report
+};
+
+/// Provider session information
+struct ProviderSession {
+  std::string provider_id;
+  std::vector<std::string> device_ids;
+  std::chrono::steady_clock::time_point last_update;
+  std::optional<uint64_t> last_tick_generation; // Last generation this provider
+                                                // submitted updates for
+  // Free-running modes only: commands accumulated since the last update
+  std::vector<fluxgraph::Command> queued_commands;
+  uint64_t dropped_commands = 0;
+  // Barrier mode: lateness metrics and held ticks not yet reported
+  ProviderLatenessStats lateness;
+  uint32_t unreported_held_ticks = 0;
+  std::shared_ptr<Histogram> barrier_wait; // Time spent waiting for the tick
+};
+
+/// Per-signal change filter state for one Subscribe stream
+struct SignalSubscription {
+  std::string path;
+  SignalId id = INVALID_SIGNAL;
+  bool physics_driven = false;
+  double deadband = 0.0;
+  std::chrono::steady_clock::duration min_interval{0};
+  double last_sent_value = 0.0;
+  std::chrono::steady_clock::time_point last_sent_time;
+  size_t snapshot_slot = 0; // Index into SubscriptionSnapshot::values
+};
+
+/// Completed-tick values for the union of all subscribed signals.
+/// Built once per tick regardless of subscriber count; each Subscribe stream
+/// filters it on its own handler thread.
+struct SubscriptionSnapshot {
+  uint64_t sequence = 0; // Monotonic publish counter (survives Reset)
+  uint64_t config_epoch = 0;
+  uint64_t tick_generation = 0;
+  double sim_time = 0.0;
+  uint64_t state_hash = 0; // Engine digest at tick_generation (0 = disabled)
+  std::shared_ptr<const std::vector<SignalId>> ids; // Sorted, shared layout
+  std::vector<double> values;                       // Parallel to *ids
+  // Parallel to *ids; shared across snapshots until a unit changes
+  std::shared_ptr<const std::vector<std::string>> units;
+};
+
+/// Per-instance accounting reported by ListInstances
+struct InstanceStats {
+  std::string instance_id;
+  bool loaded = false;
+  double sim_time = 0.0;
+  uint64_t tick_generation = 0;
+  uint64_t state_hash = 0; // Last completed tick (0 = hashing disabled)
+  size_t provider_count = 0;
+  size_t signal_count = 0;
+  size_t approx_memory_bytes = 0;
+  size_t queued_commands = 0; // Free-running backlog across sessions
+  size_t staged_inputs = 0;   // Writes waiting for the next tick boundary
+  uint64_t ticks = 0;
+  std::chrono::nanoseconds total_tick_time{0};
+  std::chrono::nanoseconds max_tick_time{0};
+  std::chrono::nanoseconds last_tick_time{0};
+};
+
+/// One independently hosted simulation: engine, store, namespaces, provider
+/// barrier and subscriptions. The gRPC service routes requests to instances
+/// by instance_id.
+///
+/// Thread-safety: All instance operations are serialized with the instance
+/// mutex; instances never share locks, so tenants do not contend.
+/// Tick coordination: In provider_barrier mode the instance waits for its
+/// providers per BarrierPolicy and ticks on the calling RPC thread (idle
+/// instances cost nothing). In free-running modes a shared TickScheduler
+/// worker calls run_scheduled_tick() and provider writes are staged into a
+/// latest-value buffer that is applied at the next tick boundary.
+class SimulationInstance {
+public:
+  SimulationInstance(std::string instance_id, double dt,
+                     std::shared_ptr<MetricsRegistry> metrics,
+                     BarrierPolicy barrier_policy = {});
+  ~SimulationInstance();
+
+  SimulationInstance(const SimulationInstance &) = delete;
+  SimulationInstance &operator=(const SimulationInstance &) = delete;
+
+  const std::string &id() const { return instance_id_; }
+
+  // ========================================================================
+  // RPC Bodies (same contracts as the FluxGraph service RPCs)
+  // ========================================================================
+
+  grpc::Status load_config(const fluxgraph::rpc::ConfigRequest *request,
+                           fluxgraph::rpc::ConfigResponse *response);
+
+  grpc::Status
+  register_provider(const fluxgraph::rpc::ProviderRegistration *request,
+                    fluxgraph::rpc::ProviderRegistrationResponse *response);
+
+  grpc::Status
+  unregister_provider(const fluxgraph::rpc::UnregisterRequest *request,
+                      fluxgraph::rpc::UnregisterResponse *response);
+
+  grpc::Status update_signals(const fluxgraph::rpc::SignalUpdates *request,
+                              fluxgraph::rpc::TickResponse *response);
+
+  grpc::Status read_signals(const fluxgraph::rpc::SignalRequest *request,
+                            fluxgraph::rpc::SignalResponse *response);
+
+  grpc::Status
+  subscribe(grpc::ServerContext *context,
+            const fluxgraph::rpc::SubscribeRequest *request,
+            grpc::ServerWriter<fluxgraph::rpc::SignalBatch> *writer);
+
+  grpc::Status
+  advance_ticks(const fluxgraph::rpc::AdvanceTicksRequest *request,
+                fluxgraph::rpc::AdvanceTicksResponse *response);
+
+  grpc::Status reset(const fluxgraph::rpc::ResetRequest *request,
+                     fluxgraph::rpc::ResetResponse *response);
+
+  // ========================================================================
+  // Free-Running Scheduling
+  // ========================================================================
+
+  /// Switch to a free-running mode; waits for an AdvanceTicks batch in
+  /// flight, so call it without the service's registry lock.
+  /// @return Scheduling token for TickScheduler, or 0 if already
+  ///         free-running or closed
+  uint64_t begin_free_running(TickMode mode);
+
+  /// Return to provider_barrier mode; outstanding scheduler entries go stale
+  void end_free_running();
+
+  /// Detach from the service: stop scheduling and end open Subscribe streams
+  void close();
+
+  /// True once close() ran (the instance is being deleted)
+  bool is_closed() const { return closed_; }
+
+  /// Execute one scheduled tick.
+  /// @return Next deadline, or nullopt when the entry is stale or unloaded
+  std::optional<std::chrono::steady_clock::time_point>
+  run_scheduled_tick(uint64_t token,
+                     std::chrono::steady_clock::time_point deadline,
+                     std::chrono::nanoseconds period);
+
+  // ========================================================================
+  // Policy and Accounting
+  // ========================================================================
+
+  /// Configure provider_barrier tick policy (default: wait for all)
+  void set_barrier_policy(BarrierPolicy policy);
+
+  /// Barrier lateness metrics keyed by provider_id (active sessions only)
+  std::map<std::string, ProviderLatenessStats> provider_lateness_stats();
+
+  /// Snapshot of free-running deadline accounting
+  TickPacingStats tick_pacing_stats();
+
+  /// Memory and tick-time accounting
+  InstanceStats stats();
+
+  bool is_loaded();
+
+private:
+  // ========================================================================
+  // Core State
+  // ========================================================================
+
+  fluxgraph::Engine engine_;
+  fluxgraph::SignalStore store_;
+  fluxgraph::SignalNamespace signal_ns_;
+  fluxgraph::FunctionNamespace func_ns_;
+
+  // Thread safety
+  std::mutex state_mutex_;
+  std::condition_variable tick_cv_; // Notified when tick completes
+  uint64_t tick_generation_ = 0;    // Increments after each tick
+  // AdvanceTicks releases state_mutex_ between chunks; paths that tick,
+  // reload or reset wait on tick_cv_ until the batch completes.
+  bool advancing_ = false;
+
+  // Last completed tick snapshot (command queue is drained exactly once per
+  // tick)
+  uint64_t last_completed_generation_ = 0;
+  double last_completed_sim_time_ = 0.0;
+  uint64_t last_completed_state_hash_ = 0; // 0 unless LoadConfig enabled it
+  std::vector<fluxgraph::Command> last_completed_commands_;
+  std::vector<std::string> last_completed_late_providers_;
+
+  // Barrier policy state
+  BarrierPolicy barrier_policy_;
+  std::optional<std::chrono::steady_clock::time_point> generation_first_report_;
+
+  // Configuration
+  std::string instance_id_;
+  bool loaded_ = false;
+  size_t config_bytes_ = 0;
+  std::string current_config_hash_;
+  double dt_; // Runtime timestep in seconds
+  double sim_time_ = 0.0;
+  std::set<SignalId> protected_write_signals_;
+  std::set<SignalId> physics_owned_signals_;
+
+  // Tick-time accounting (engine tick only, excludes barrier waits)
+  struct TickTiming {
+    uint64_t ticks = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds last{0};
+  };
+  TickTiming tick_timing_;
+  int last_logged_tick_ = -1;
+
+  // Metric handles (series labelled instance=<id>); registry lookups happen
+  // only at construction and provider registration.
+  std::shared_ptr<MetricsRegistry> metrics_;
+  std::shared_ptr<Histogram> tick_duration_metric_;
+  std::shared_ptr<Histogram> stage_models_metric_;
+  std::shared_ptr<Histogram> stage_edges_metric_;
+  std::shared_ptr<Histogram> stage_rules_metric_;
+  std::shared_ptr<Counter> ticks_metric_;
+  std::shared_ptr<Counter> commands_metric_;
+
+  // Provider tracking
+  std::map<std::string, ProviderSession> sessions_; // session_id -> session
+  std::chrono::milliseconds session_timeout_{5000};
+
+  // Subscriptions: watched set is guarded by state_mutex_, the published
+  // snapshot by subscription_mutex_ so streams never contend with ticks.
+  std::map<SignalId, size_t> watched_signal_refs_;
+  std::shared_ptr<const std::vector<SignalId>> watched_signal_ids_;
+  std::shared_ptr<const std::vector<std::string>> watched_signal_units_;
+  uint64_t config_epoch_ = 0;
+  uint64_t subscription_sequence_ = 0;
+  std::mutex subscription_mutex_;
+  std::condition_variable subscription_cv_;
+  std::atomic<bool> closed_{false}; // Set by close(); ends Subscribe streams
+  std::shared_ptr<const SubscriptionSnapshot> subscription_snapshot_;
+
+  // Free-running staging (mode and token guarded by state_mutex_)
+  struct StagedInput {
+    double value = 0.0;
+    std::string unit;
+    bool dirty = false;
+  };
+
+  TickMode tick_mode_ = TickMode::provider_barrier;
+  uint64_t schedule_token_ = 0; // Invalidates stale scheduler entries
+  TickPacingStats pacing_stats_;
+  std::vector<StagedInput> staged_inputs_; // Indexed by SignalId
+  std::vector<SignalId> staged_input_ids_;  // Dirty entries in arrival order
+
+  // ========================================================================
+  // Helper Methods (lock must already be held)
+  // ========================================================================
+
+  // Generate unique session ID for provider
+  std::string generate_session_id(const std::string &provider_id);
+
+  // Convert FluxGraph Command to protobuf Command
+  void convert_command(const fluxgraph::Command &cmd,
+                       fluxgraph::rpc::Command *pb_cmd);
+
+  // Remove a session and its provider-labelled metric series
+  std::map<std::string, ProviderSession>::iterator
+  erase_session_locked(std::map<std::string, ProviderSession>::iterator it);
+
+  // Remove stale sessions (except currently active session)
+  void prune_stale_sessions_locked(const std::string &active_session_id,
+                                   std::chrono::steady_clock::time_point now);
+
+  // Filter commands for a specific provider session
+  std::vector<fluxgraph::Command> filter_commands_for_session_locked(
+      const std::string &session_id,
+      const std::vector<fluxgraph::Command> &all_commands);
+
+  // Populate TickResponse from last completed tick snapshot
+  void populate_tick_response_for_session_locked(
+      const std::string &session_id, fluxgraph::rpc::TickResponse *response);
+
+  // Advance one tick, snapshot commands and notify subscribers
+  void execute_tick_locked();
+
+  /// Block until no AdvanceTicks batch is in progress
+  void wait_for_advance_locked(std::unique_lock<std::mutex> &lock);
+
+  // True when the barrier policy allows ticking the given generation
+  bool barrier_ready_locked(uint64_t generation) const;
+
+  // Flag providers that missed the generation, then tick
+  void complete_barrier_tick_locked(uint64_t generation);
+
+  // Resolve a provider-writable input signal and validate its unit
+  grpc::Status resolve_writable_input_locked(const std::string &path,
+                                             const std::string &unit,
+                                             SignalId *id) const;
+
+  // Validate a provider write and stage it for the next tick boundary
+  grpc::Status stage_input_locked(const fluxgraph::rpc::SignalUpdate &update);
+
+  // Apply staged provider writes to the store
+  void apply_staged_inputs_locked();
+
+  // Add/remove subscription references to the watched signal set
+  void watch_signals_locked(const std::vector<SignalSubscription> &subs);
+  void unwatch_signals_locked(const std::vector<SignalSubscription> &subs);
+
+  // Copy watched values from the store and wake Subscribe streams
+  void publish_subscription_snapshot_locked();
+
+  // Unit reported to subscribers: the contract once declared, so a signal
+  // subscribed before its first write is not stuck at "dimensionless"
+  const std::string &reported_unit_locked(SignalId id) const;
+};
+
+} // namespace fluxgraph::server
@@ -0,0 +1,89 @@
+#include "tick_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fluxgraph::server {
+
+TickScheduler::TickScheduler(size_t worker_count)
+    : worker_count_(std::max<size_t>(worker_count, 1)) {
+  workers_.reserve(worker_count_);
+  for (size_t i = 0; i < worker_count_; ++i) {
+    workers_.emplace_back(&TickScheduler::worker_loop, this);
+  }
+}
+
+TickScheduler::~TickScheduler() { stop(); }
+
+void TickScheduler::schedule(std::shared_ptr<SimulationInstance> instance,
+                             uint64_t token, std::chrono::nanoseconds period) {
+  {
+    std::lock_guard lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+
+    Entry entry;
+    entry.deadline = clock::now() + period;
+    entry.order = next_order_++;
+    entry.instance = std::move(instance);
+    entry.token = token;
+    entry.period = period;
+    queue_.push(std::move(entry));
+  }
+  // Waiters may be sleeping on a later deadline than the new entry.
+  cv_.notify_all();
+}
+
+void TickScheduler::stop() {
+  {
+    std::lock_guard lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  std::lock_guard lock(mutex_);
+  queue_ = {};
+}
+
+void TickScheduler::worker_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (queue_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+
+    const auto deadline = queue_.top().deadline;
+    if (clock::now() < deadline) {
+      cv_.wait_until(lock, deadline);
+      continue;
+    }
+
+    Entry entry = queue_.top();
+    queue_.pop();
+    lock.unlock();
+
+    const auto next = entry.instance->run_scheduled_tick(
+        entry.token, entry.deadline, entry.period);
+
+    lock.lock();
+    if (next.has_value() && !stopping_) {
+      entry.deadline = *next;
+      entry.order = next_order_++;
+      queue_.push(std::move(entry));
+      cv_.notify_one();
+    }
+  }
+}
+
+} // namespace fluxgraph::server
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "simulation_instance.hpp"
+
+namespace fluxgraph::server {
+
+/// Shared worker pool advancing free-running simulation instances.
+///
+/// Entries are ordered earliest-deadline-first; each instance has at most one
+/// entry, so an instance is never ticked by two workers at once. Realtime
+/// instances carry absolute deadlines, as-fast-as-possible instances are
+/// always due and round-robin behind overdue realtime work. Instances without
+/// an entry (unloaded or barrier-driven) cost no scheduler time.
+class TickScheduler {
+public:
+  explicit TickScheduler(size_t worker_count);
+  ~TickScheduler();
+
+  TickScheduler(const TickScheduler &) = delete;
+  TickScheduler &operator=(const TickScheduler &) = delete;
+
+  /// Queue an instance for free-running ticks.
+  /// @param token Token from SimulationInstance::begin_free_running()
+  /// @param period Wall-clock tick period (0 for as-fast-as-possible)
+  void schedule(std::shared_ptr<SimulationInstance> instance, uint64_t token,
+                std::chrono::nanoseconds period);
+
+  /// Stop and join all workers (idempotent)
+  void stop();
+
+  size_t worker_count() const { return worker_count_; }
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  struct Entry {
+    clock::time_point deadline;
+    uint64_t order = 0; // FIFO tie-break for equal deadlines
+    std::shared_ptr<SimulationInstance> instance;
+    uint64_t token = 0;
+    std::chrono::nanoseconds period{0};
+  };
+
+  struct LaterDeadline {
+    bool operator()(const Entry &lhs, const Entry &rhs) const {
+      if (lhs.deadline != rhs.deadline) {
+        return lhs.deadline > rhs.deadline;
+      }
+      return lhs.order > rhs.order;
+    }
+  };
+
+  void worker_loop();
+
+  size_t worker_count_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::priority_queue<Entry, std::vector<Entry>, LaterDeadline> queue_;
+  uint64_t next_order_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace fluxgraph::server
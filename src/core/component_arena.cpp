@@ -0,0 +1,43 @@
+#include "fluxgraph/core/component_arena.hpp"
+#include <algorithm>
+
+namespace fluxgraph {
+
+void ComponentArena::reserve(std::size_t bytes) {
+  next_block_ = std::max(bytes, kCacheLine);
+}
+
+void *ComponentArena::allocate(std::size_t size, std::size_t align) {
+  align = std::max<std::size_t>(align, 1);
+  auto place = [&](std::size_t offset) {
+    offset = (offset + align - 1) / align * align;
+    if (size > kCacheLine && offset % kCacheLine != 0) {
+      offset += kCacheLine - offset % kCacheLine;
+    }
+    return offset;
+  };
+
+  std::size_t offset = place(cursor_);
+  if (blocks_.empty() || offset + size > capacity_) {
+    // Blocks are cache-line aligned, so offsets within a block keep the
+    // placement rules above
+    const std::size_t whole_lines =
+        (size + kCacheLine - 1) / kCacheLine * kCacheLine;
+    const std::size_t block_size = std::max(next_block_, whole_lines);
+    blocks_.emplace_back(static_cast<std::byte *>(
+        ::operator new[](block_size, std::align_val_t(kCacheLine))));
+    used_ += capacity_ - cursor_; // Tail of the previous block is lost
+    capacity_ = block_size;
+    cursor_ = 0;
+    reserved_ += block_size;
+    next_block_ = block_size * 2;
+    offset = 0;
+  }
+
+  used_ += offset + size - cursor_;
+  cursor_ = offset + size;
+  ++objects_;
+  return blocks_.back().get() + offset;
+}
+
+} // namespace fluxgraph
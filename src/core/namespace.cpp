@@ -1,55 +1,208 @@
 #include "fluxgraph/core/namespace.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace fluxgraph {
 
 // SignalNamespace implementation
 
+namespace {
+
+constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ULL;
+
+constexpr size_t kMinSlots = 16;
+constexpr size_t kArenaBlockBytes = 64 * 1024;
+
+uint64_t rotl64(uint64_t value, unsigned bits) {
+  return (value << bits) | (value >> (64U - bits));
+}
+
+uint64_t hash_round(uint64_t acc, uint64_t word) {
+  acc ^= word * kHashPrime2;
+  return rotl64(acc, 31) * kHashPrime1;
+}
+
+// Table load factor is kept at or below 7/10
+bool needs_grow(size_t count, size_t slot_count) {
+  return count * 10 >= slot_count * 7;
+}
+
+} // namespace
+
 SignalNamespace::SignalNamespace() = default;
 SignalNamespace::~SignalNamespace() = default;
 
-SignalId SignalNamespace::intern(const std::string &path) {
-  auto it = path_to_id_.find(path);
-  if (it != path_to_id_.end()) {
-    return it->second; // Already interned
+SignalNamespace::SignalNamespace(const SignalNamespace &other) {
+  *this = other;
+}
+
+SignalNamespace &SignalNamespace::operator=(const SignalNamespace &other) {
+  if (this == &other) {
+    return *this;
+  }
+  clear();
+  reserve(other.size());
+  for (std::string_view path : other.id_to_path_) {
+    intern(path);
+  }
+  return *this;
+}
+
+uint64_t SignalNamespace::hash_path(std::string_view path) {
+  // Eight bytes per round; the tail is zero-padded into one more word
+  const char *data = path.data();
+  size_t remaining = path.size();
+  uint64_t hash = kHashPrime3 ^ (path.size() * kHashPrime1);
+  while (remaining >= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    hash = hash_round(hash, word);
+    data += sizeof(word);
+    remaining -= sizeof(word);
+  }
+  if (remaining > 0) {
+    uint64_t word = 0;
+    std::memcpy(&word, data, remaining);
+    hash = hash_round(hash, word);
+  }
+
+  hash ^= hash >> 33U;
+  hash *= kHashPrime2;
+  hash ^= hash >> 29U;
+  hash *= kHashPrime3;
+  hash ^= hash >> 32U;
+  return hash;
+}
+
+size_t SignalNamespace::find_slot(std::string_view path, uint64_t hash) const {
+  // Returns the slot holding path, or the empty slot where it would go
+  const size_t mask = slots_.size() - 1;
+  size_t index = static_cast<size_t>(hash) & mask;
+  while (true) {
+    const Slot &slot = slots_[index];
+    if (slot.id == INVALID_SIGNAL ||
+        (slot.hash == hash && id_to_path_[slot.id] == path)) {
+      return index;
+    }
+    index = (index + 1) & mask;
+  }
+}
+
+void SignalNamespace::rehash(size_t slot_count) {
+  std::vector<Slot> slots(slot_count);
+  const size_t mask = slot_count - 1;
+  for (SignalId id = 0; id < id_to_hash_.size(); ++id) {
+    size_t index = static_cast<size_t>(id_to_hash_[id]) & mask;
+    while (slots[index].id != INVALID_SIGNAL) {
+      index = (index + 1) & mask;
+    }
+    slots[index] = Slot{id_to_hash_[id], id};
+  }
+  slots_ = std::move(slots);
+}
+
+std::string_view SignalNamespace::store_path(std::string_view path) {
+  if (arena_blocks_.empty() || arena_used_ + path.size() > arena_capacity_) {
+    arena_capacity_ = std::max(kArenaBlockBytes, path.size());
+    arena_blocks_.push_back(std::make_unique<char[]>(arena_capacity_));
+    arena_reserved_ += arena_capacity_;
+    arena_used_ = 0;
+  }
+  char *dest = arena_blocks_.back().get() + arena_used_;
+  if (!path.empty()) {
+    std::memcpy(dest, path.data(), path.size());
+  }
+  arena_used_ += path.size();
+  return std::string_view(dest, path.size());
+}
+
+SignalId SignalNamespace::intern(std::string_view path) {
+  const uint64_t hash = hash_path(path);
+  if (needs_grow(id_to_path_.size() + 1, slots_.size())) {
+    rehash(std::max(kMinSlots, slots_.size() * 2));
+  }
+
+  const size_t index = find_slot(path, hash);
+  if (slots_[index].id != INVALID_SIGNAL) {
+    return slots_[index].id; // Already interned
   }
 
-  SignalId id = next_id_++;
-  path_to_id_[path] = id;
-  id_to_path_[id] = path;
+  const auto id = static_cast<SignalId>(id_to_path_.size());
+  id_to_path_.push_back(store_path(path));
+  id_to_hash_.push_back(hash);
+  path_index_.insert(id_to_path_.back(), id);
+  slots_[index] = Slot{hash, id};
   return id;
 }
 
-SignalId SignalNamespace::resolve(const std::string &path) const {
-  auto it = path_to_id_.find(path);
-  if (it != path_to_id_.end()) {
-    return it->second;
+SignalId SignalNamespace::resolve(std::string_view path) const {
+  if (slots_.empty()) {
+    return INVALID_SIGNAL;
   }
-  return INVALID_SIGNAL;
+  return slots_[find_slot(path, hash_path(path))].id;
 }
 
-std::string SignalNamespace::lookup(SignalId id) const {
-  auto it = id_to_path_.find(id);
-  if (it != id_to_path_.end()) {
-    return it->second;
+std::string_view SignalNamespace::lookup(SignalId id) const {
+  if (id < id_to_path_.size()) {
+    return id_to_path_[id];
   }
-  return ""; // Return empty string for unknown IDs
+  return {}; // Empty view for unknown IDs
 }
 
-size_t SignalNamespace::size() const { return path_to_id_.size(); }
+size_t SignalNamespace::size() const { return id_to_path_.size(); }
 
 std::vector<std::string> SignalNamespace::all_paths() const {
-  std::vector<std::string> paths;
-  paths.reserve(path_to_id_.size());
-  for (const auto &[path, id] : path_to_id_) {
-    paths.push_back(path);
-  }
+  std::vector<std::string> paths(id_to_path_.begin(), id_to_path_.end());
+  std::sort(paths.begin(), paths.end());
   return paths;
 }
 
+std::vector<SignalId>
+SignalNamespace::find_prefix(std::string_view prefix) const {
+  std::vector<SignalId> ids;
+  path_index_.find_prefix(prefix, ids);
+  return ids;
+}
+
+std::vector<SignalId>
+SignalNamespace::find_glob(std::string_view pattern) const {
+  std::vector<SignalId> ids;
+  path_index_.find_glob(pattern, ids);
+  return ids;
+}
+
+void SignalNamespace::reserve(size_t count) {
+  id_to_path_.reserve(count);
+  id_to_hash_.reserve(count);
+  size_t slot_count = std::max(kMinSlots, slots_.size());
+  while (needs_grow(count + 1, slot_count)) {
+    slot_count *= 2;
+  }
+  if (slot_count != slots_.size()) {
+    rehash(slot_count);
+  }
+}
+
 void SignalNamespace::clear() {
-  path_to_id_.clear();
+  slots_.clear();
   id_to_path_.clear();
-  next_id_ = 0;
+  id_to_hash_.clear();
+  arena_blocks_.clear();
+  arena_used_ = 0;
+  arena_capacity_ = 0;
+  arena_reserved_ = 0;
+  path_index_.clear();
+}
+
+size_t SignalNamespace::memory_bytes() const {
+  return arena_reserved_ +
+         arena_blocks_.capacity() * sizeof(std::unique_ptr<char[]>) +
+         slots_.capacity() * sizeof(Slot) +
+         id_to_path_.capacity() * sizeof(std::string_view) +
+         id_to_hash_.capacity() * sizeof(uint64_t) +
+         path_index_.memory_bytes();
 }
 
 // FunctionNamespace implementation
@@ -0,0 +1,301 @@
+#include "fluxgraph/core/path_index.hpp"
+#include <algorithm>
+
+namespace fluxgraph {
+
+namespace {
+
+bool is_separator(char c) { return c == '/' || c == '.'; }
+
+// Siblings are ordered like std::string comparison (unsigned bytes)
+bool byte_less(char a, char b) {
+  return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+}
+
+size_t common_prefix(std::string_view a, std::string_view b) {
+  const size_t limit = std::min(a.size(), b.size());
+  size_t i = 0;
+  while (i < limit && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+} // namespace
+
+// Pattern compiled to tokens; NFA state i means "tokens before i matched".
+// A state set is one byte per state, so stepping it over a character is a
+// single pass over the pattern.
+struct PathIndex::Glob {
+  enum class Kind : uint8_t { literal, any_char, star, globstar };
+  struct Token {
+    Kind kind;
+    char c;
+  };
+
+  explicit Glob(std::string_view pattern) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      if (pattern[i] == '*') {
+        const bool globstar = i + 1 < pattern.size() && pattern[i + 1] == '*';
+        tokens.push_back({globstar ? Kind::globstar : Kind::star, '*'});
+        i += globstar ? 1U : 0U;
+      } else if (pattern[i] == '?') {
+        tokens.push_back({Kind::any_char, '?'});
+      } else {
+        tokens.push_back({Kind::literal, pattern[i]});
+      }
+    }
+  }
+
+  void start(std::vector<uint8_t> &states) const {
+    states.assign(tokens.size() + 1U, 0);
+    states[0] = 1;
+    close(states);
+  }
+
+  /// Advance states over c into next; false when no state survives
+  bool step(const std::vector<uint8_t> &states, char c,
+            std::vector<uint8_t> &next) const {
+    next.assign(tokens.size() + 1U, 0);
+    const bool separator = is_separator(c);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      if (states[i] == 0U) {
+        continue;
+      }
+      switch (tokens[i].kind) {
+      case Kind::literal:
+        next[i + 1] |= static_cast<uint8_t>(tokens[i].c == c);
+        break;
+      case Kind::any_char:
+        next[i + 1] |= static_cast<uint8_t>(!separator);
+        break;
+      case Kind::star:
+        next[i] |= static_cast<uint8_t>(!separator);
+        break;
+      case Kind::globstar:
+        next[i] = 1;
+        break;
+      }
+    }
+    close(next);
+    return std::find(next.begin(), next.end(), 1U) != next.end();
+  }
+
+  bool accepts(const std::vector<uint8_t> &states) const {
+    return states.back() != 0U;
+  }
+
+  std::vector<Token> tokens;
+
+private:
+  // Stars also match the empty run
+  void close(std::vector<uint8_t> &states) const {
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      if (states[i] != 0U && (tokens[i].kind == Kind::star ||
+                              tokens[i].kind == Kind::globstar)) {
+        states[i + 1] = 1;
+      }
+    }
+  }
+};
+
+PathIndex::PathIndex() { nodes_.emplace_back(); }
+
+void PathIndex::insert(std::string_view path, SignalId id) {
+  if (nodes_.empty()) { // Moved-from
+    nodes_.emplace_back();
+  }
+  uint32_t node = 0;
+  size_t pos = 0;
+  while (pos < path.size()) {
+    const std::string_view rest = path.substr(pos);
+
+    // Find the child starting with rest[0], remembering its predecessor so
+    // new or split nodes can be linked in place
+    uint32_t prev = kNoNode;
+    uint32_t child = nodes_[node].first_child;
+    while (child != kNoNode && byte_less(nodes_[child].label[0], rest[0])) {
+      prev = child;
+      child = nodes_[child].next_sibling;
+    }
+    auto link = [&](uint32_t replacement) {
+      if (prev == kNoNode) {
+        nodes_[node].first_child = replacement;
+      } else {
+        nodes_[prev].next_sibling = replacement;
+      }
+    };
+
+    if (child == kNoNode || nodes_[child].label[0] != rest[0]) {
+      const auto leaf = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(Node{rest, kNoNode, child, id});
+      link(leaf);
+      return;
+    }
+
+    const std::string_view label = nodes_[child].label;
+    const size_t common = common_prefix(label, rest);
+    if (common < label.size()) {
+      // Split the edge: child keeps the suffix under a new interior node
+      const auto mid = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(Node{label.substr(0, common), child,
+                            nodes_[child].next_sibling, INVALID_SIGNAL});
+      nodes_[child].label = label.substr(common);
+      nodes_[child].next_sibling = kNoNode;
+      link(mid);
+      child = mid;
+    }
+    node = child;
+    pos += common;
+  }
+  nodes_[node].id = id;
+}
+
+uint32_t PathIndex::find_subtree(std::string_view prefix,
+                                 std::string *path_to_node) const {
+  if (nodes_.empty()) {
+    return kNoNode;
+  }
+  uint32_t node = 0;
+  size_t pos = 0;
+  while (pos < prefix.size()) {
+    uint32_t child = nodes_[node].first_child;
+    while (child != kNoNode && nodes_[child].label[0] != prefix[pos]) {
+      child = nodes_[child].next_sibling;
+    }
+    if (child == kNoNode) {
+      return kNoNode;
+    }
+
+    const std::string_view label = nodes_[child].label;
+    const size_t compared = std::min(label.size(), prefix.size() - pos);
+    if (label.compare(0, compared, prefix, pos, compared) != 0) {
+      return kNoNode;
+    }
+    if (path_to_node != nullptr) {
+      path_to_node->append(prefix.substr(pos, compared));
+      path_to_node->append(label.substr(compared));
+    }
+    node = child;
+    pos += compared;
+  }
+  return node;
+}
+
+void PathIndex::collect(uint32_t node, std::vector<SignalId> &out) const {
+  // Pre-order walk: a node, then its children's subtrees, then its siblings
+  if (nodes_[node].id != INVALID_SIGNAL) {
+    out.push_back(nodes_[node].id);
+  }
+  std::vector<uint32_t> stack;
+  if (nodes_[node].first_child != kNoNode) {
+    stack.push_back(nodes_[node].first_child);
+  }
+  while (!stack.empty()) {
+    const Node &current = nodes_[stack.back()];
+    stack.pop_back();
+    if (current.id != INVALID_SIGNAL) {
+      out.push_back(current.id);
+    }
+    if (current.next_sibling != kNoNode) {
+      stack.push_back(current.next_sibling);
+    }
+    if (current.first_child != kNoNode) {
+      stack.push_back(current.first_child);
+    }
+  }
+}
+
+void PathIndex::collect_glob(uint32_t node, const Glob &glob, size_t depth,
+                             std::vector<std::vector<uint8_t>> &states,
+                             std::vector<uint8_t> &scratch,
+                             std::vector<SignalId> &out) const {
+  if (nodes_[node].id != INVALID_SIGNAL && glob.accepts(states[depth])) {
+    out.push_back(nodes_[node].id);
+  }
+  if (states.size() <= depth + 1) {
+    states.resize(depth + 2);
+  }
+  // Indexed access only: deeper calls may grow states
+  for (uint32_t child = nodes_[node].first_child; child != kNoNode;
+       child = nodes_[child].next_sibling) {
+    states[depth + 1] = states[depth];
+    bool alive = true;
+    for (char c : nodes_[child].label) {
+      alive = glob.step(states[depth + 1], c, scratch);
+      states[depth + 1].swap(scratch);
+      if (!alive) {
+        break;
+      }
+    }
+    if (alive) {
+      collect_glob(child, glob, depth + 1, states, scratch, out);
+    }
+  }
+}
+
+void PathIndex::find_prefix(std::string_view prefix,
+                            std::vector<SignalId> &out) const {
+  const uint32_t node = find_subtree(prefix, nullptr);
+  if (node != kNoNode) {
+    collect(node, out);
+  }
+}
+
+void PathIndex::find_glob(std::string_view pattern,
+                          std::vector<SignalId> &out) const {
+  const size_t wildcard = pattern.find_first_of("*?");
+  const std::string_view literal = pattern.substr(0, wildcard);
+  if (wildcard == std::string_view::npos) {
+    std::string path;
+    const uint32_t node = find_subtree(literal, &path);
+    if (node != kNoNode && nodes_[node].id != INVALID_SIGNAL &&
+        path == literal) {
+      out.push_back(nodes_[node].id);
+    }
+    return;
+  }
+
+  std::string path;
+  const uint32_t node = find_subtree(literal, &path);
+  if (node == kNoNode) {
+    return;
+  }
+  // The subtree's own path can run past the literal prefix
+  const Glob glob(pattern);
+  std::vector<std::vector<uint8_t>> states(1);
+  std::vector<uint8_t> scratch;
+  glob.start(states[0]);
+  for (char c : path) {
+    if (!glob.step(states[0], c, scratch)) {
+      return;
+    }
+    states[0].swap(scratch);
+  }
+  collect_glob(node, glob, 0, states, scratch, out);
+}
+
+bool PathIndex::is_glob(std::string_view pattern) {
+  return pattern.find_first_of("*?") != std::string_view::npos;
+}
+
+bool PathIndex::glob_match(std::string_view pattern, std::string_view path) {
+  const Glob glob(pattern);
+  std::vector<uint8_t> states;
+  std::vector<uint8_t> next;
+  glob.start(states);
+  for (char c : path) {
+    if (!glob.step(states, c, next)) {
+      return false;
+    }
+    states.swap(next);
+  }
+  return glob.accepts(states);
+}
+
+void PathIndex::clear() {
+  nodes_.clear();
+  nodes_.emplace_back();
+}
+
+} // namespace fluxgraph
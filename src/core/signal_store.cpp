@@ -1,12 +1,57 @@
 #include "fluxgraph/core/signal_store.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 namespace fluxgraph {
 
+namespace {
+
+uint64_t next_contract_set_id() {
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Value held by unwritten slots, so the value plane hashes in one pass
+double unwritten_value() {
+  constexpr uint64_t kUnwrittenMarker = 0x7FF4F1C0DE5EED01ULL; // Signaling NaN
+  double value;
+  std::memcpy(&value, &kUnwrittenMarker, sizeof(value));
+  return value;
+}
+
+} // namespace
+
 SignalStore::SignalStore() = default;
 SignalStore::~SignalStore() = default;
 
+SignalStore::ContractSetId::ContractSetId() : value(next_contract_set_id()) {}
+
+SignalStore::ContractSetId::ContractSetId(const ContractSetId & /*other*/)
+    : ContractSetId() {}
+
+SignalStore::ContractSetId::ContractSetId(ContractSetId &&other) noexcept
+    : value(other.value) {
+  other.value = next_contract_set_id();
+}
+
+SignalStore::ContractSetId &
+SignalStore::ContractSetId::operator=(const ContractSetId & /*other*/) {
+  value = next_contract_set_id();
+  return *this;
+}
+
+SignalStore::ContractSetId &
+SignalStore::ContractSetId::operator=(ContractSetId &&other) noexcept {
+  if (this != &other) {
+    value = other.value;
+    other.value = next_contract_set_id();
+  }
+  return *this;
+}
+
 const std::string &SignalStore::dimensionless_unit() {
   static const std::string kDimensionless = "dimensionless";
   return kDimensionless;
@@ -14,15 +59,46 @@ const std::string &SignalStore::dimensionless_unit() {
 
 void SignalStore::ensure_index(SignalId id) {
   const size_t needed = static_cast<size_t>(id) + 1U;
-  if (needed <= signals_.size()) {
+  if (needed <= values_.size()) {
     return;
   }
 
-  signals_.resize(needed);
+  values_.resize(needed, unwritten_value());
+  units_.resize(needed);
   has_signal_.resize(needed, static_cast<uint8_t>(0));
   physics_driven_.resize(needed, static_cast<uint8_t>(0));
   declared_units_.resize(needed);
   has_declared_unit_.resize(needed, static_cast<uint8_t>(0));
+  declared_unit_index_.resize(needed, INVALID_UNIT_INDEX);
+}
+
+void SignalStore::set_declared_unit(size_t index, const std::string &unit,
+                                    UnitIndex unit_index) {
+  declared_units_[index] = unit;
+  has_declared_unit_[index] = static_cast<uint8_t>(1);
+  declared_unit_index_[index] = unit_index;
+}
+
+UnitIndex SignalStore::write_unit_index(const std::string &unit) {
+  // Providers usually repeat the same unit, so a single cached entry keeps
+  // conversion to a string compare, a table lookup and an FMA
+  if (unit != last_write_unit_) {
+    last_write_unit_ = unit;
+    last_write_unit_index_ = UnitRegistry::instance().lookup(unit);
+  }
+  return last_write_unit_index_;
+}
+
+std::optional<UnitConversion>
+SignalStore::conversion_to_declared(const std::string &unit, size_t index,
+                                    UnitIndex unit_index) const {
+  const UnitRegistry &registry = UnitRegistry::instance();
+  const UnitIndex declared = declared_unit_index_[index];
+  if (unit_index != INVALID_UNIT_INDEX && declared != INVALID_UNIT_INDEX) {
+    return registry.conversion(unit_index, declared);
+  }
+  // Unregistered expressions are parsed for this write, not registered
+  return registry.conversion(unit, declared_units_[index]);
 }
 
 void SignalStore::write(SignalId id, double value, const std::string &unit) {
@@ -39,15 +115,26 @@ void SignalStore::write(SignalId id, double value, const std::string &unit) {
   // This avoids accidentally freezing unit contracts to "dimensionless" when a
   // signal is still in its unwritten/default state.
   if (!has_declared_unit_[index] && normalized_unit != dimensionless_unit()) {
-    declared_units_[index] = normalized_unit;
-    has_declared_unit_[index] = static_cast<uint8_t>(1);
+    // Lookup only: units first seen on writes are not registered
+    set_declared_unit(index, normalized_unit,
+                      UnitRegistry::instance().lookup(normalized_unit));
   }
 
   // Validate unit if declared
+  const std::string *stored_unit = &normalized_unit;
   if (has_declared_unit_[index] && declared_units_[index] != normalized_unit) {
-    throw std::runtime_error("Unit mismatch for signal " + std::to_string(id) +
-                             ": expected '" + declared_units_[index] +
-                             "', got '" + normalized_unit + "'");
+    const std::optional<UnitConversion> conversion =
+        convert_units_
+            ? conversion_to_declared(normalized_unit, index,
+                                     write_unit_index(normalized_unit))
+            : std::nullopt;
+    if (!conversion) {
+      throw std::runtime_error(
+          "Unit mismatch for signal " + std::to_string(id) + ": expected '" +
+          declared_units_[index] + "', got '" + normalized_unit + "'");
+    }
+    value = std::fma(value, conversion->scale, conversion->offset);
+    stored_unit = &declared_units_[index];
   }
 
   if (!has_signal_[index]) {
@@ -55,9 +142,13 @@ void SignalStore::write(SignalId id, double value, const std::string &unit) {
     ++signal_count_;
   }
 
-  signals_[index].value = value;
-  if (signals_[index].unit != normalized_unit) {
-    signals_[index].unit = normalized_unit;
+  values_[index] = value;
+  if (units_[index] != *stored_unit) {
+    units_[index] = *stored_unit;
+  }
+
+  if (write_observer_ != nullptr) {
+    write_observer_->on_write(id, value, *stored_unit);
   }
 }
 
@@ -74,7 +165,7 @@ void SignalStore::write_with_source_unit(SignalId target, double value,
 
   const size_t source_index = static_cast<size_t>(source);
   const bool source_written =
-      source_index < signals_.size() && has_signal_[source_index] != 0;
+      source_index < values_.size() && has_signal_[source_index] != 0;
 
   if (!source_written) {
     write(target, value, dimensionless_unit());
@@ -82,14 +173,14 @@ void SignalStore::write_with_source_unit(SignalId target, double value,
   }
 
   const size_t target_index = static_cast<size_t>(target);
-  if (target_index < signals_.size()) {
+  if (target_index < values_.size()) {
     // No growth required; safe to pass reference directly.
-    write(target, value, signals_[source_index].unit);
+    write(target, value, units_[source_index]);
     return;
   }
 
   // Growth may invalidate source references; capture by value first.
-  std::string source_unit = signals_[source_index].unit;
+  std::string source_unit = units_[source_index];
   write(target, value, source_unit);
 }
 
@@ -104,8 +195,8 @@ void SignalStore::write_with_contract_unit(SignalId id, double value) {
     return;
   }
 
-  if (index < signals_.size() && has_signal_[index] != 0U) {
-    write(id, value, signals_[index].unit);
+  if (index < values_.size() && has_signal_[index] != 0U) {
+    write(id, value, units_[index]);
     return;
   }
 
@@ -118,11 +209,11 @@ Signal SignalStore::read(SignalId id) const {
   }
 
   const size_t index = static_cast<size_t>(id);
-  if (index >= signals_.size() || !has_signal_[index]) {
+  if (index >= values_.size() || !has_signal_[index]) {
     return Signal(); // Return default if not found
   }
 
-  return signals_[index];
+  return Signal(values_[index], units_[index]);
 }
 
 double SignalStore::read_value(SignalId id) const {
@@ -131,11 +222,30 @@ double SignalStore::read_value(SignalId id) const {
   }
 
   const size_t index = static_cast<size_t>(id);
-  if (index >= signals_.size() || !has_signal_[index]) {
+  if (index >= values_.size() || !has_signal_[index]) {
     return 0.0;
   }
 
-  return signals_[index].value;
+  return values_[index];
+}
+
+void SignalStore::gather_values(const SignalId *ids, size_t count,
+                                double *out) const {
+  const size_t size = values_.size();
+  for (size_t i = 0; i < count; ++i) {
+    const size_t index = static_cast<size_t>(ids[i]);
+    // INVALID_SIGNAL is out of range, so one bounds check covers both cases
+    out[i] = index < size && has_signal_[index] ? values_[index] : 0.0;
+  }
+}
+
+void SignalStore::hash_values(StateHasher &hasher) const {
+  size_t end = values_.size();
+  while (end > 0 && !has_signal_[end - 1]) {
+    --end;
+  }
+  // Unwritten slots already hold the marker value
+  hasher.add(values_.data(), end);
 }
 
 const std::string &SignalStore::read_unit(SignalId id) const {
@@ -144,11 +254,17 @@ const std::string &SignalStore::read_unit(SignalId id) const {
   }
 
   const size_t index = static_cast<size_t>(id);
-  if (index >= signals_.size() || !has_signal_[index]) {
+  if (index >= values_.size() || !has_signal_[index]) {
     return dimensionless_unit();
   }
 
-  return signals_[index].unit;
+  return units_[index];
+}
+
+bool SignalStore::is_written(SignalId id) const {
+  const size_t index = static_cast<size_t>(id);
+  return id != INVALID_SIGNAL && index < values_.size() &&
+         has_signal_[index] != 0U;
 }
 
 bool SignalStore::is_physics_driven(SignalId id) const {
@@ -194,9 +310,12 @@ void SignalStore::declare_unit(SignalId id, const std::string &expected_unit) {
                              declared_units_[index] + "', new '" +
                              normalized_unit + "'");
   }
+  if (has_declared_unit_[index] != 0U) {
+    return; // Same unit; skip the registry lookup
+  }
 
-  declared_units_[index] = normalized_unit;
-  has_declared_unit_[index] = static_cast<uint8_t>(1);
+  set_declared_unit(index, normalized_unit,
+                    UnitRegistry::instance().index_of(normalized_unit));
 }
 
 void SignalStore::validate_unit(SignalId id, const std::string &unit) const {
@@ -211,7 +330,11 @@ void SignalStore::validate_unit(SignalId id, const std::string &unit) const {
 
   const std::string &normalized_unit =
       unit.empty() ? dimensionless_unit() : unit;
-  if (declared_units_[index] != normalized_unit) {
+  if (declared_units_[index] != normalized_unit &&
+      !(convert_units_ &&
+        conversion_to_declared(normalized_unit, index,
+                               UnitRegistry::instance().lookup(normalized_unit))
+            .has_value())) {
     throw std::runtime_error("Unit mismatch for signal " + std::to_string(id) +
                              ": expected '" + declared_units_[index] +
                              "', got '" + normalized_unit + "'");
@@ -241,27 +364,32 @@ const std::string &SignalStore::declared_unit(SignalId id) const {
 }
 
 void SignalStore::reserve(size_t max_signals) {
-  signals_.reserve(max_signals);
+  values_.reserve(max_signals);
+  units_.reserve(max_signals);
   has_signal_.reserve(max_signals);
   physics_driven_.reserve(max_signals);
   declared_units_.reserve(max_signals);
   has_declared_unit_.reserve(max_signals);
+  declared_unit_index_.reserve(max_signals);
 
-  if (max_signals > signals_.size()) {
-    signals_.resize(max_signals);
+  if (max_signals > values_.size()) {
+    values_.resize(max_signals, unwritten_value());
+    units_.resize(max_signals);
     has_signal_.resize(max_signals, static_cast<uint8_t>(0));
     physics_driven_.resize(max_signals, static_cast<uint8_t>(0));
     declared_units_.resize(max_signals);
     has_declared_unit_.resize(max_signals, static_cast<uint8_t>(0));
+    declared_unit_index_.resize(max_signals, INVALID_UNIT_INDEX);
   }
 }
 
-size_t SignalStore::capacity() const { return signals_.size(); }
+size_t SignalStore::capacity() const { return values_.size(); }
 
 size_t SignalStore::size() const { return signal_count_; }
 
 void SignalStore::clear() {
   std::fill(has_signal_.begin(), has_signal_.end(), static_cast<uint8_t>(0));
+  std::fill(values_.begin(), values_.end(), unwritten_value());
   std::fill(physics_driven_.begin(), physics_driven_.end(),
             static_cast<uint8_t>(0));
   signal_count_ = 0;
@@ -1,6 +1,9 @@
 #include "fluxgraph/core/units.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
 #include <stdexcept>
-#include <unordered_map>
 
 namespace fluxgraph {
 
@@ -22,15 +25,15 @@ DimensionVector dim(int m, int l, int t, int i, int theta, int n, int j) {
   return v;
 }
 
-void add_unit(std::unordered_map<std::string, UnitDef> &units,
+void add_unit(std::vector<UnitDef> &units,
               const std::string &symbol, const DimensionVector &dimension,
               UnitKind kind = UnitKind::generic, double scale_to_si = 1.0,
               double offset_to_si = 0.0) {
-  units.emplace(symbol,
-                UnitDef{symbol, dimension, scale_to_si, offset_to_si, kind});
+  units.push_back(
+      UnitDef{symbol, dimension, scale_to_si, offset_to_si, kind});
 }
 
-void register_base_time_units(std::unordered_map<std::string, UnitDef> &units) {
+void register_base_time_units(std::vector<UnitDef> &units) {
   add_unit(units, "dimensionless", {});
   add_unit(units, "rad", {});
   add_unit(units, "s", dim(0, 0, 1, 0, 0, 0, 0));
@@ -38,7 +41,7 @@ void register_base_time_units(std::unordered_map<std::string, UnitDef> &units) {
   add_unit(units, "rad/s", dim(0, 0, -1, 0, 0, 0, 0));
 }
 
-void register_mechanical_units(std::unordered_map<std::string, UnitDef> &units) {
+void register_mechanical_units(std::vector<UnitDef> &units) {
   add_unit(units, "m", dim(0, 1, 0, 0, 0, 0, 0));
   add_unit(units, "m/s", dim(0, 1, -1, 0, 0, 0, 0));
   add_unit(units, "kg", dim(1, 0, 0, 0, 0, 0, 0));
@@ -51,7 +54,7 @@ void register_mechanical_units(std::unordered_map<std::string, UnitDef> &units)
 }
 
 void register_electrical_rotational_units(
-    std::unordered_map<std::string, UnitDef> &units) {
+    std::vector<UnitDef> &units) {
   add_unit(units, "A", dim(0, 0, 0, 1, 0, 0, 0));
   add_unit(units, "V", dim(1, 2, -3, -1, 0, 0, 0));
   add_unit(units, "Ohm", dim(1, 2, -3, -2, 0, 0, 0));
@@ -61,7 +64,7 @@ void register_electrical_rotational_units(
   add_unit(units, "W", dim(1, 2, -3, 0, 0, 0, 0));
 }
 
-void register_thermal_units(std::unordered_map<std::string, UnitDef> &units) {
+void register_thermal_units(std::vector<UnitDef> &units) {
   add_unit(units, "K", dim(0, 0, 0, 0, 1, 0, 0), UnitKind::absolute_temp);
   add_unit(units, "degC", dim(0, 0, 0, 0, 1, 0, 0),
            UnitKind::absolute_temp, 1.0, 273.15);
@@ -73,26 +76,382 @@ void register_thermal_units(std::unordered_map<std::string, UnitDef> &units) {
   add_unit(units, "W/K", dim(1, 2, -3, 0, -1, 0, 0));
 }
 
+// Terms commonly combined in expressions (kPa, L/min, mbar, rpm)
+void register_common_units(std::vector<UnitDef> &units) {
+  constexpr double kPi = 3.14159265358979323846;
+  add_unit(units, "g", dim(1, 0, 0, 0, 0, 0, 0), UnitKind::generic, 1e-3);
+  add_unit(units, "Pa", dim(1, -1, -2, 0, 0, 0, 0));
+  add_unit(units, "bar", dim(1, -1, -2, 0, 0, 0, 0), UnitKind::generic, 1e5);
+  add_unit(units, "J", dim(1, 2, -2, 0, 0, 0, 0));
+  add_unit(units, "Hz", dim(0, 0, -1, 0, 0, 0, 0));
+  add_unit(units, "L", dim(0, 3, 0, 0, 0, 0, 0), UnitKind::generic, 1e-3);
+  add_unit(units, "min", dim(0, 0, 1, 0, 0, 0, 0), UnitKind::generic, 60.0);
+  add_unit(units, "h", dim(0, 0, 1, 0, 0, 0, 0), UnitKind::generic, 3600.0);
+  add_unit(units, "rpm", dim(0, 0, -1, 0, 0, 0, 0), UnitKind::generic,
+           2.0 * kPi / 60.0);
+  add_unit(units, "deg", {}, UnitKind::generic, kPi / 180.0);
+  add_unit(units, "mol", dim(0, 0, 0, 0, 0, 1, 0));
+  add_unit(units, "cd", dim(0, 0, 0, 0, 0, 0, 1));
+}
+
+struct Prefix {
+  std::string_view symbol;
+  double scale;
+};
+
+// Two-letter prefixes first so "da" wins over "d"
+constexpr Prefix kPrefixes[] = {
+    {"da", 1e1}, {"T", 1e12}, {"G", 1e9}, {"M", 1e6},  {"k", 1e3},
+    {"h", 1e2},  {"d", 1e-1}, {"c", 1e-2}, {"m", 1e-3}, {"u", 1e-6},
+    {"n", 1e-9}, {"p", 1e-12},
+};
+
+bool is_operator(char c) { return c == '*' || c == '/' || c == '^'; }
+
+bool has_operator(std::string_view symbol) {
+  return std::any_of(symbol.begin(), symbol.end(), is_operator);
+}
+
+DimensionVector scaled(const DimensionVector &d, int factor) {
+  return dim(d.m * factor, d.l * factor, d.t * factor, d.i * factor,
+             d.theta * factor, d.n * factor, d.j * factor);
+}
+
+DimensionVector sum(const DimensionVector &a, const DimensionVector &b) {
+  return dim(a.m + b.m, a.l + b.l, a.t + b.t, a.i + b.i, a.theta + b.theta,
+             a.n + b.n, a.j + b.j);
+}
+
+double integer_power(double base, int exponent) {
+  double result = 1.0;
+  for (int k = 0; k < std::abs(exponent); ++k) {
+    result *= base;
+  }
+  return exponent < 0 ? 1.0 / result : result;
+}
+
+bool same_definition(const UnitDef &a, const UnitDef &b) {
+  return a.dimension == b.dimension && a.kind == b.kind &&
+         a.scale_to_si == b.scale_to_si && a.offset_to_si == b.offset_to_si;
+}
+
+// Reason a conversion is not allowed, or nullptr if it is
+const char *conversion_error(const UnitDef &from, const UnitDef &to) {
+  if (from.dimension != to.dimension) {
+    return "Incompatible unit dimensions";
+  }
+  if (is_temperature_kind(from.kind) != is_temperature_kind(to.kind)) {
+    return "Incompatible unit kinds";
+  }
+  if ((from.kind == UnitKind::absolute_temp &&
+       to.kind == UnitKind::delta_temp) ||
+      (from.kind == UnitKind::delta_temp &&
+       to.kind == UnitKind::absolute_temp)) {
+    return "Disallowed absolute/delta temperature conversion";
+  }
+  return nullptr;
+}
+
+std::optional<UnitConversion> convert_between(const UnitDef &from,
+                                              const UnitDef &to) {
+  if (conversion_error(from, to) != nullptr) {
+    return std::nullopt;
+  }
+  UnitConversion conversion;
+  conversion.scale = from.scale_to_si / to.scale_to_si;
+  conversion.offset = (from.offset_to_si - to.offset_to_si) / to.scale_to_si;
+  return conversion;
+}
+
+// Units past this many have no table cells (1.1 MB of table at the cap);
+// their conversions are computed per call
+constexpr size_t kMaxTableUnits = 256;
+
+// Failed spellings cached at most; later ones are re-parsed per lookup
+constexpr size_t kMaxUnparseable = 1024;
+
 } // namespace
 
 UnitRegistry::UnitRegistry() {
-  register_base_time_units(units_);
-  register_mechanical_units(units_);
-  register_electrical_rotational_units(units_);
-  register_thermal_units(units_);
+  std::vector<UnitDef> curated;
+  register_base_time_units(curated);
+  register_mechanical_units(curated);
+  register_electrical_rotational_units(curated);
+  register_thermal_units(curated);
+  register_common_units(curated);
+
+  for (UnitDef &def : curated) {
+    const bool term = !has_operator(def.symbol);
+    add_locked(std::move(def), term);
+  }
 }
 
-const UnitRegistry &UnitRegistry::instance() {
-  static const UnitRegistry kInstance;
+UnitRegistry &UnitRegistry::instance() {
+  static UnitRegistry kInstance;
   return kInstance;
 }
 
+UnitIndex UnitRegistry::add_locked(UnitDef def, bool term) const {
+  if (units_.size() >= INVALID_UNIT_INDEX) {
+    throw std::runtime_error("Unit registry is full");
+  }
+  const auto index = static_cast<UnitIndex>(units_.size());
+  index_.emplace(def.symbol, index);
+  unparseable_.erase(def.symbol);
+  units_.push_back(std::move(def));
+  is_term_.push_back(static_cast<uint8_t>(term ? 1 : 0));
+
+  if (units_.size() > kMaxTableUnits) {
+    return index;
+  }
+  if (units_.size() > stride_) {
+    // Grow geometrically and refill, so registration stays amortized O(n)
+    stride_ = std::min(kMaxTableUnits, std::max<size_t>(64, stride_ * 2));
+    conversions_.assign(stride_ * stride_, UnitConversion{});
+    convertible_.assign(stride_ * stride_, static_cast<uint8_t>(0));
+    for (size_t i = 0; i < units_.size(); ++i) {
+      fill_conversions_locked(i);
+    }
+  } else {
+    fill_conversions_locked(index);
+  }
+  return index;
+}
+
+void UnitRegistry::fill_conversions_locked(size_t index) const {
+  // Row and column of index against every unit up to and including it
+  auto fill = [this](size_t from, size_t to) {
+    if (const std::optional<UnitConversion> conversion =
+            convert_between(units_[from], units_[to])) {
+      conversions_[from * stride_ + to] = *conversion;
+      convertible_[from * stride_ + to] = static_cast<uint8_t>(1);
+    }
+  };
+  for (size_t other = 0; other <= index; ++other) {
+    fill(index, other);
+    fill(other, index);
+  }
+}
+
+UnitIndex UnitRegistry::find_locked(std::string_view symbol) const {
+  const auto it = index_.find(std::string(symbol));
+  return it == index_.end() ? INVALID_UNIT_INDEX : it->second;
+}
+
+UnitIndex UnitRegistry::find_or_parse(std::string_view symbol) const {
+  {
+    std::shared_lock lock(mutex_);
+    const UnitIndex index = find_locked(symbol);
+    if (index != INVALID_UNIT_INDEX ||
+        unparseable_.count(std::string(symbol)) > 0) {
+      return index;
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  if (const UnitIndex index = find_locked(symbol);
+      index != INVALID_UNIT_INDEX) {
+    return index; // Parsed by another thread meanwhile
+  }
+  std::optional<UnitDef> parsed = parse_locked(symbol);
+  if (!parsed) {
+    if (unparseable_.size() < kMaxUnparseable) {
+      unparseable_.emplace(symbol);
+    }
+    return INVALID_UNIT_INDEX;
+  }
+  return add_locked(std::move(*parsed), false);
+}
+
+std::optional<UnitDef>
+UnitRegistry::parse_locked(std::string_view expression) const {
+  UnitDef result;
+  result.symbol = std::string(expression);
+
+  const UnitDef *only_unit = nullptr; // Set while the expression is one term
+  double only_prefix = 1.0;
+  bool has_offset_unit = false;
+  int terms = 0;
+  bool divide = false;
+  size_t pos = 0;
+  while (true) {
+    const size_t end = expression.find_first_of("*/^", pos);
+    const std::string_view token = expression.substr(pos, end - pos);
+    if (token.empty()) {
+      return std::nullopt;
+    }
+
+    // Resolve the term: a known unit, or an SI prefix plus a term unit
+    const UnitDef *unit = nullptr;
+    double prefix = 1.0;
+    if (token != "1") {
+      if (const UnitIndex index = find_locked(token);
+          index != INVALID_UNIT_INDEX) {
+        unit = &units_[index];
+      } else {
+        for (const Prefix &candidate : kPrefixes) {
+          if (token.size() <= candidate.symbol.size() ||
+              token.substr(0, candidate.symbol.size()) != candidate.symbol) {
+            continue;
+          }
+          const UnitIndex index =
+              find_locked(token.substr(candidate.symbol.size()));
+          if (index != INVALID_UNIT_INDEX && is_term_[index] != 0U &&
+              units_[index].offset_to_si == 0.0) {
+            unit = &units_[index];
+            prefix = candidate.scale;
+            break;
+          }
+        }
+        if (unit == nullptr) {
+          return std::nullopt;
+        }
+      }
+    }
+
+    // Optional integer exponent
+    int exponent = 1;
+    size_t next = end;
+    if (next != std::string_view::npos && expression[next] == '^') {
+      size_t digits = next + 1;
+      const bool negative =
+          digits < expression.size() && expression[digits] == '-';
+      digits += negative ? 1 : 0;
+      size_t digits_end = digits;
+      while (digits_end < expression.size() &&
+             std::isdigit(static_cast<unsigned char>(
+                 expression[digits_end])) != 0) {
+        ++digits_end;
+      }
+      if (digits_end == digits || digits_end - digits > 2) {
+        return std::nullopt;
+      }
+      exponent = std::stoi(
+          std::string(expression.substr(digits, digits_end - digits)));
+      exponent = negative ? -exponent : exponent;
+      next = digits_end == expression.size() ? std::string_view::npos
+                                             : digits_end;
+    }
+
+    const int power = divide ? -exponent : exponent;
+    if (unit != nullptr) {
+      has_offset_unit = has_offset_unit || unit->offset_to_si != 0.0;
+      result.dimension = sum(result.dimension, scaled(unit->dimension, power));
+      result.scale_to_si *= integer_power(unit->scale_to_si * prefix, power);
+    }
+    only_unit = (terms == 0 && power == 1) ? unit : nullptr;
+    only_prefix = prefix;
+    ++terms;
+
+    if (next == std::string_view::npos) {
+      break;
+    }
+    if (expression[next] == '^') {
+      return std::nullopt; // Exponent of an exponent
+    }
+    divide = expression[next] == '/';
+    pos = next + 1;
+  }
+
+  if (terms == 1 && only_unit != nullptr) {
+    // A lone (prefixed) unit keeps its temperature kind; offsets only
+    // survive unprefixed, and then the symbol was found directly
+    if (only_unit->offset_to_si != 0.0 && only_prefix != 1.0) {
+      return std::nullopt;
+    }
+    result.kind = only_unit->kind;
+    result.offset_to_si = only_unit->offset_to_si;
+    return result;
+  }
+  if (has_offset_unit) {
+    return std::nullopt; // degC*s and the like are ambiguous
+  }
+  return result;
+}
+
+std::optional<UnitDef> UnitRegistry::parse(std::string_view expression) const {
+  std::shared_lock lock(mutex_);
+  return parse_locked(expression);
+}
+
+UnitIndex UnitRegistry::register_unit(const UnitDef &def) {
+  if (def.symbol.empty() || has_operator(def.symbol)) {
+    throw std::invalid_argument("Invalid unit symbol: '" + def.symbol + "'");
+  }
+
+  std::unique_lock lock(mutex_);
+  if (const UnitIndex existing = find_locked(def.symbol);
+      existing != INVALID_UNIT_INDEX) {
+    if (!same_definition(units_[existing], def)) {
+      throw std::invalid_argument("Conflicting definition for unit '" +
+                                  def.symbol + "'");
+    }
+    return existing;
+  }
+  return add_locked(def, true);
+}
+
 const UnitDef *UnitRegistry::find(std::string_view symbol) const {
-  const auto it = units_.find(std::string(symbol));
-  if (it == units_.end()) {
-    return nullptr;
+  const UnitIndex index = find_or_parse(symbol);
+  return index == INVALID_UNIT_INDEX ? nullptr : &unit(index);
+}
+
+UnitIndex UnitRegistry::index_of(std::string_view symbol) const {
+  return find_or_parse(symbol);
+}
+
+UnitIndex UnitRegistry::lookup(std::string_view symbol) const {
+  std::shared_lock lock(mutex_);
+  return find_locked(symbol);
+}
+
+const UnitDef &UnitRegistry::unit(UnitIndex index) const {
+  std::shared_lock lock(mutex_);
+  return units_[index];
+}
+
+size_t UnitRegistry::size() const {
+  std::shared_lock lock(mutex_);
+  return units_.size();
+}
+
+std::optional<UnitConversion> UnitRegistry::conversion(UnitIndex from,
+                                                       UnitIndex to) const {
+  std::shared_lock lock(mutex_);
+  if (from >= units_.size() || to >= units_.size()) {
+    return std::nullopt;
+  }
+  if (from >= stride_ || to >= stride_) {
+    return convert_between(units_[from], units_[to]);
+  }
+  const size_t cell = static_cast<size_t>(from) * stride_ + to;
+  if (convertible_[cell] == 0U) {
+    return std::nullopt;
   }
-  return &it->second;
+  return conversions_[cell];
+}
+
+std::optional<UnitConversion>
+UnitRegistry::conversion(std::string_view from_symbol,
+                         std::string_view to_symbol) const {
+  std::shared_lock lock(mutex_);
+  std::optional<UnitDef> parsed_from;
+  std::optional<UnitDef> parsed_to;
+  auto resolve = [this](std::string_view symbol,
+                        std::optional<UnitDef> &parsed) -> const UnitDef * {
+    if (const UnitIndex index = find_locked(symbol);
+        index != INVALID_UNIT_INDEX) {
+      return &units_[index];
+    }
+    parsed = parse_locked(symbol);
+    return parsed ? &*parsed : nullptr;
+  };
+  const UnitDef *from = resolve(from_symbol, parsed_from);
+  const UnitDef *to = resolve(to_symbol, parsed_to);
+  if (from == nullptr || to == nullptr) {
+    return std::nullopt;
+  }
+  return convert_between(*from, *to);
 }
 
 bool UnitRegistry::contains(std::string_view symbol) const {
@@ -109,39 +468,22 @@ bool UnitRegistry::are_dimensionally_compatible(
 UnitConversion
 UnitRegistry::resolve_conversion(const std::string &from_symbol,
                                  const std::string &to_symbol) const {
-  const UnitDef *from = find(from_symbol);
-  if (from == nullptr) {
+  const UnitIndex from = index_of(from_symbol);
+  if (from == INVALID_UNIT_INDEX) {
     throw std::runtime_error("Unknown unit symbol: '" + from_symbol + "'");
   }
 
-  const UnitDef *to = find(to_symbol);
-  if (to == nullptr) {
+  const UnitIndex to = index_of(to_symbol);
+  if (to == INVALID_UNIT_INDEX) {
     throw std::runtime_error("Unknown unit symbol: '" + to_symbol + "'");
   }
 
-  if (from->dimension != to->dimension) {
-    throw std::runtime_error("Incompatible unit dimensions: '" + from_symbol +
-                             "' -> '" + to_symbol + "'");
-  }
-
-  if (is_temperature_kind(from->kind) != is_temperature_kind(to->kind)) {
-    throw std::runtime_error("Incompatible unit kinds: '" + from_symbol +
-                             "' -> '" + to_symbol + "'");
+  if (const std::optional<UnitConversion> table_entry = conversion(from, to)) {
+    return *table_entry;
   }
-
-  if ((from->kind == UnitKind::absolute_temp &&
-       to->kind == UnitKind::delta_temp) ||
-      (from->kind == UnitKind::delta_temp &&
-       to->kind == UnitKind::absolute_temp)) {
-    throw std::runtime_error(
-        "Disallowed absolute/delta temperature conversion: '" + from_symbol +
-        "' -> '" + to_symbol + "'");
-  }
-
-  UnitConversion conversion;
-  conversion.scale = from->scale_to_si / to->scale_to_si;
-  conversion.offset = (from->offset_to_si - to->offset_to_si) / to->scale_to_si;
-  return conversion;
+  throw std::runtime_error(
+      std::string(conversion_error(unit(from), unit(to))) + ": '" +
+      from_symbol + "' -> '" + to_symbol + "'");
 }
 
 } // namespace fluxgraph
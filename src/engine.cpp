@@ -4,6 +4,27 @@
 
 namespace fluxgraph {
 
+namespace {
+
+// Engine writes are not external inputs; hide them from any write observer
+class WriteObserverPause {
+public:
+  explicit WriteObserverPause(SignalStore &store)
+      : store_(store), observer_(store.write_observer()) {
+    store_.set_write_observer(nullptr);
+  }
+  ~WriteObserverPause() { store_.set_write_observer(observer_); }
+
+  WriteObserverPause(const WriteObserverPause &) = delete;
+  WriteObserverPause &operator=(const WriteObserverPause &) = delete;
+
+private:
+  SignalStore &store_;
+  SignalWriteObserver *observer_;
+};
+
+} // namespace
+
 Engine::Engine() : loaded_(false) {}
 
 Engine::~Engine() = default;
@@ -14,10 +35,15 @@ void Engine::load(CompiledProgram program) {
   required_signal_capacity_ = program.required_signal_capacity;
   required_command_capacity_ = program.required_command_capacity;
   signal_unit_contracts_ = std::move(program.signal_unit_contracts);
+  signal_id_map_ = std::move(program.signal_id_map);
   edges_ = std::move(program.edges);
   models_ = std::move(program.models);
+  arena_ = std::move(program.arena); // After the old components are gone
   rules_ = std::move(program.rules);
   pending_commands_.clear();
+  generated_ = bind_generated_program(
+      program_layout_hash(edges_, models_, signal_unit_contracts_), edges_,
+      models_);
 
   size_t backlog_capacity = required_command_capacity_;
   if (required_command_capacity_ > 0 &&
@@ -26,7 +52,13 @@ void Engine::load(CompiledProgram program) {
     backlog_capacity = required_command_capacity_ * kCommandBacklogTicks;
   }
   pending_commands_.reserve(backlog_capacity);
+  state_hash_ = 0;
+  contracts_declared_on_ = 0;
   loaded_ = true;
+
+  if (profiler_) {
+    enable_profiling(profiler_->options());
+  }
 }
 
 void Engine::tick(double dt, SignalStore &store) {
@@ -42,8 +74,12 @@ void Engine::tick(double dt, SignalStore &store) {
     store.reserve(required_signal_capacity_);
   }
 
-  for (const auto &contract : signal_unit_contracts_) {
-    store.declare_unit(contract.first, contract.second);
+  // Contracts are append-only, so each store needs them declared once
+  if (store.contract_set_id() != contracts_declared_on_) {
+    for (const auto &contract : signal_unit_contracts_) {
+      store.declare_unit(contract.first, contract.second);
+    }
+    contracts_declared_on_ = store.contract_set_id();
   }
 
   // Runtime stability contract: enforce model limits for supplied dt.
@@ -59,18 +95,162 @@ void Engine::tick(double dt, SignalStore &store) {
 
   // Stage 1: Input boundary freeze
   // (external writes are assumed complete before tick entry)
+  const WriteObserverPause observer_pause(store);
 
-  // Stage 2: Update physics models
-  update_models(dt, store);
+  if (profiler_ && profiler_->sample_next_tick()) {
+    tick_profiled(dt, store);
+  } else if (stage_timing_) {
+    tick_timed(dt, store);
+  } else {
+    // Stage 2: Update physics models
+    update_models(dt, store);
+
+    // Stage 3: Apply transforms in topological order with immediate
+    // propagation
+    process_edges(dt, store);
+
+    // Stage 4: Commit outputs (future: validation, dirty flags)
+    commit_outputs(store);
+
+    // Stage 5: Evaluate rules and emit commands
+    evaluate_rules(store);
+  }
+
+  if (state_hashing_) {
+    state_hash_ = compute_state_hash(store);
+  }
+}
 
-  // Stage 3: Apply transforms in topological order with immediate propagation
+uint64_t Engine::compute_state_hash(const SignalStore &store) const {
+  StateHasher hasher;
+  store.hash_values(hasher);
+  for (const auto &model : models_) {
+    model->hash_state(hasher);
+  }
+  for (const auto &edge : edges_) {
+    edge.transform->hash_state(hasher);
+  }
+  return hasher.digest();
+}
+
+void Engine::set_state_hashing(bool enabled) {
+  state_hashing_ = enabled;
+  if (!enabled) {
+    state_hash_ = 0;
+  }
+}
+
+void Engine::tick_timed(double dt, SignalStore &store) {
+  using clock = std::chrono::steady_clock;
+
+  const auto start = clock::now();
+  update_models(dt, store);
+  const auto models_done = clock::now();
   process_edges(dt, store);
+  commit_outputs(store);
+  const auto edges_done = clock::now();
+  evaluate_rules(store);
+  const auto rules_done = clock::now();
 
-  // Stage 4: Commit outputs (future: validation, dirty flags)
+  stage_times_.models = models_done - start;
+  stage_times_.edges = edges_done - models_done;
+  stage_times_.rules = rules_done - edges_done;
+}
+
+void Engine::tick_profiled(double dt, SignalStore &store) {
+  using clock = std::chrono::steady_clock;
+  TickProfiler &profiler = *profiler_;
+  profiler.begin_tick();
+
+  const auto start = clock::now();
+  auto span_start = start;
+  for (size_t i = 0; i < models_.size(); ++i) {
+    models_[i]->tick(dt, store);
+    const auto span_end = clock::now();
+    profiler.record(ProfileComponent::model, i, span_start, span_end);
+    span_start = span_end;
+  }
+  const auto models_done = span_start;
+
+  for (size_t i = 0; i < edges_.size(); ++i) {
+    apply_edge(edges_[i], dt, store);
+    const auto span_end = clock::now();
+    profiler.record(ProfileComponent::edge, i, span_start, span_end);
+    span_start = span_end;
+  }
   commit_outputs(store);
+  const auto edges_done = clock::now();
 
-  // Stage 5: Evaluate rules and emit commands
-  evaluate_rules(store);
+  span_start = edges_done;
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    evaluate_rule(rules_[i], store);
+    const auto span_end = clock::now();
+    profiler.record(ProfileComponent::rule, i, span_start, span_end);
+    span_start = span_end;
+  }
+  const auto rules_done = span_start;
+
+  profiler.record(ProfileComponent::stage, 0, start, models_done);
+  profiler.record(ProfileComponent::stage, 1, models_done, edges_done);
+  profiler.record(ProfileComponent::stage, 2, edges_done, rules_done);
+  profiler.record(ProfileComponent::tick, 0, start, rules_done);
+
+  stage_times_.models = models_done - start;
+  stage_times_.edges = edges_done - models_done;
+  stage_times_.rules = rules_done - edges_done;
+}
+
+void Engine::enable_profiling(ProfilerOptions options) {
+  profiler_ = std::make_unique<TickProfiler>(options, models_.size(),
+                                             edges_.size(), rules_.size());
+}
+
+void Engine::disable_profiling() { profiler_.reset(); }
+
+std::string Engine::profile_label(ProfileComponent component, size_t index,
+                                  const SignalNamespace &ns) const {
+  static constexpr const char *kStageNames[] = {"models", "edges", "rules"};
+  switch (component) {
+  case ProfileComponent::tick:
+    return "tick";
+  case ProfileComponent::stage:
+    return index < 3 ? kStageNames[index] : "stage";
+  case ProfileComponent::model:
+    return models_[index]->describe();
+  case ProfileComponent::edge: {
+    const auto path = [&](SignalId id) {
+      return std::string(ns.lookup(signal_id_map_.namespace_id(id)));
+    };
+    return path(edges_[index].source) + " -> " + path(edges_[index].target);
+  }
+  case ProfileComponent::rule:
+    return rules_[index].id.empty() ? "rule[" + std::to_string(index) + "]"
+                                    : rules_[index].id;
+  }
+  return {};
+}
+
+std::vector<ProfileEntry> Engine::profile_report(const SignalNamespace &ns,
+                                                 size_t top_n,
+                                                 bool component_only) const {
+  if (!profiler_) {
+    return {};
+  }
+  return profiler_->report(
+      [this, &ns](ProfileComponent component, size_t index) {
+        return profile_label(component, index, ns);
+      },
+      top_n, component_only);
+}
+
+std::string Engine::export_chrome_trace(const SignalNamespace &ns) const {
+  if (!profiler_) {
+    return "{\"traceEvents\":[]}";
+  }
+  return profiler_->chrome_trace_json(
+      [this, &ns](ProfileComponent component, size_t index) {
+        return profile_label(component, index, ns);
+      });
 }
 
 std::vector<Command> Engine::drain_commands() {
@@ -91,6 +271,12 @@ std::vector<Command> Engine::drain_commands() {
   return drained;
 }
 
+size_t Engine::discard_commands() {
+  const size_t discarded = pending_commands_.size();
+  pending_commands_.clear();
+  return discarded;
+}
+
 void Engine::reset() {
   // Reset all models
   for (auto &model : models_) {
@@ -104,17 +290,30 @@ void Engine::reset() {
 
   // Clear pending commands
   pending_commands_.clear();
+  state_hash_ = 0;
 }
 
 void Engine::process_edges(double dt, SignalStore &store) {
+  if (generated_program_active()) {
+    generated_->process_edges(dt, store);
+    return;
+  }
   for (auto &edge : edges_) {
-    const double source_value = store.read_value(edge.source);
-    double output = edge.transform->apply(source_value, dt);
-    store.write_with_contract_unit(edge.target, output);
+    apply_edge(edge, dt, store);
   }
 }
 
+void Engine::apply_edge(CompiledEdge &edge, double dt, SignalStore &store) {
+  const double source_value = store.read_value(edge.source);
+  double output = edge.transform->apply(source_value, dt);
+  store.write_with_contract_unit(edge.target, output);
+}
+
 void Engine::update_models(double dt, SignalStore &store) {
+  if (generated_program_active()) {
+    generated_->update_models(dt, store);
+    return;
+  }
   for (auto &model : models_) {
     model->tick(dt, store);
   }
@@ -128,22 +327,28 @@ void Engine::commit_outputs(SignalStore &store) {
 
 void Engine::evaluate_rules(SignalStore &store) {
   for (const auto &rule : rules_) {
-    if (rule.condition(store)) {
-      // Emit commands for all actions
-      for (size_t i = 0; i < rule.device_functions.size(); ++i) {
-        if (pending_commands_.size() >= pending_commands_.capacity()) {
-          throw std::runtime_error(
-              "Engine: command backlog capacity exceeded; call "
-              "drain_commands() more frequently");
-        }
-
-        PendingCommand cmd;
-        cmd.device = rule.device_functions[i].first;
-        cmd.function = rule.device_functions[i].second;
-        cmd.args = &rule.args_list[i];
-        pending_commands_.push_back(cmd);
-      }
+    evaluate_rule(rule, store);
+  }
+}
+
+void Engine::evaluate_rule(const CompiledRule &rule, const SignalStore &store) {
+  if (!rule.condition(store)) {
+    return;
+  }
+
+  // Emit commands for all actions
+  for (size_t i = 0; i < rule.device_functions.size(); ++i) {
+    if (pending_commands_.size() >= pending_commands_.capacity()) {
+      throw std::runtime_error(
+          "Engine: command backlog capacity exceeded; call "
+          "drain_commands() more frequently");
     }
+
+    PendingCommand cmd;
+    cmd.device = rule.device_functions[i].first;
+    cmd.function = rule.device_functions[i].second;
+    cmd.args = &rule.args_list[i];
+    pending_commands_.push_back(cmd);
   }
 }
 
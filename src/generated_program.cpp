@@ -0,0 +1,89 @@
+#include "fluxgraph/generated_program.hpp"
+#include "fluxgraph/core/state_hash.hpp"
+#include <mutex>
+#include <unordered_map>
+
+namespace fluxgraph {
+
+namespace {
+
+struct GeneratedProgramRegistry {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, std::vector<GeneratedProgramFactory>>
+      factories;
+};
+
+GeneratedProgramRegistry &registry() {
+  static GeneratedProgramRegistry instance;
+  return instance;
+}
+
+void add_string(StateHasher &hasher, const std::string &text) {
+  hasher.add(static_cast<uint64_t>(text.size()));
+  for (const char c : text) {
+    hasher.add(static_cast<uint64_t>(static_cast<unsigned char>(c)));
+  }
+}
+
+} // namespace
+
+uint64_t program_layout_hash(
+    const std::vector<CompiledEdge> &edges,
+    const std::vector<ModelPtr> &models,
+    const std::vector<std::pair<SignalId, std::string>> &unit_contracts) {
+  StateHasher hasher;
+  hasher.add(static_cast<uint64_t>(edges.size()));
+  for (const CompiledEdge &edge : edges) {
+    hasher.add(static_cast<uint64_t>(edge.source));
+    hasher.add(static_cast<uint64_t>(edge.target));
+    hasher.add(static_cast<uint64_t>(edge.is_delay ? 1U : 0U));
+  }
+  hasher.add(static_cast<uint64_t>(models.size()));
+  for (const auto &model : models) {
+    add_string(hasher, model->describe());
+  }
+  hasher.add(static_cast<uint64_t>(unit_contracts.size()));
+  for (const auto &[id, unit] : unit_contracts) {
+    hasher.add(static_cast<uint64_t>(id));
+    add_string(hasher, unit);
+  }
+  return hasher.digest();
+}
+
+uint64_t program_layout_hash(const CompiledProgram &program) {
+  return program_layout_hash(program.edges, program.models,
+                             program.signal_unit_contracts);
+}
+
+bool register_generated_program(uint64_t layout_hash,
+                                GeneratedProgramFactory factory) {
+  if (factory != nullptr) {
+    GeneratedProgramRegistry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.factories[layout_hash].push_back(factory);
+  }
+  return true;
+}
+
+std::unique_ptr<GeneratedProgram>
+bind_generated_program(uint64_t layout_hash, std::vector<CompiledEdge> &edges,
+                       std::vector<ModelPtr> &models) {
+  std::vector<GeneratedProgramFactory> candidates;
+  {
+    GeneratedProgramRegistry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const auto it = reg.factories.find(layout_hash);
+    if (it == reg.factories.end()) {
+      return nullptr;
+    }
+    candidates = it->second;
+  }
+  for (const GeneratedProgramFactory factory : candidates) {
+    if (auto program = factory(edges, models)) {
+      return program;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace fluxgraph
@@ -1,9 +1,11 @@
 #include "fluxgraph/graph/compiler.hpp"
 #include "fluxgraph/core/units.hpp"
+#include "fluxgraph/graph/templates.hpp"
 #include "compiler/algorithms.hpp"
 #include "compiler/common.hpp"
 #include "compiler/dimensional.hpp"
 #include "compiler/registry.hpp"
+#include "compiler/signal_layout.hpp"
 #include <algorithm>
 #include <map>
 #include <mutex>
@@ -21,6 +23,7 @@ using compiler_internal::factory_registry;
 using compiler_internal::has_compatible_dimension_and_kind;
 using compiler_internal::is_unit_known;
 using compiler_internal::ModelRegistryEntry;
+using compiler_internal::plan_signal_layout;
 using compiler_internal::require_param;
 using compiler_internal::topological_sort_edges;
 using compiler_internal::detect_cycles_in_non_delay_subgraph;
@@ -149,6 +152,13 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
                                        SignalNamespace &signal_ns,
                                        FunctionNamespace &func_ns,
                                        const CompilationOptions &options) {
+  if (!spec.templates.empty() || !spec.instances.empty()) {
+    return compile(expand_templates(spec), signal_ns, func_ns, options);
+  }
+  if (options.signal_layout == SignalLayout::execution_order) {
+    return compile_execution_layout(spec, signal_ns, func_ns, options);
+  }
+
   CompiledProgram program;
   const UnitRegistry &unit_registry = UnitRegistry::instance();
 
@@ -195,6 +205,9 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
     signal_contracts[id] = unit;
   }
 
+  // Registry entries are never erased, so pointers stay valid unlocked
+  std::vector<const ModelRegistryEntry *> model_entries;
+  model_entries.reserve(spec.models.size());
   {
     auto &registry = factory_registry();
     std::lock_guard<std::mutex> lock(registry.mutex);
@@ -204,6 +217,7 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
       const auto &model_spec = spec.models[i];
       const auto &entry =
           resolve_model_entry_or_throw(registry, model_spec.type);
+      model_entries.push_back(&entry);
       if (strict && !entry.has_signature) {
         throw std::runtime_error(
             "GraphCompiler: strict mode requires signature metadata for model "
@@ -219,16 +233,45 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
     }
   }
 
+  // Built-in components are placed in the program's arena, models first and
+  // then transforms in schedule order, so a tick walks it front to back.
+  ComponentArena *arena = options.component_arena ? &program.arena : nullptr;
+  if (arena != nullptr) {
+    arena->reserve((spec.models.size() + spec.edges.size()) *
+                   ComponentArena::kCacheLine);
+  }
+
   // Compile models.
-  for (const auto &model_spec : spec.models) {
-    auto *model = parse_model(model_spec, signal_ns);
-    program.models.emplace_back(model);
+  program.models.reserve(spec.models.size());
+  for (size_t i = 0; i < spec.models.size(); ++i) {
+    const ModelRegistryEntry &entry = *model_entries[i];
+    ModelPtr model = entry.arena_factory
+                         ? entry.arena_factory(spec.models[i], signal_ns, arena)
+                         : ModelPtr(entry.factory(spec.models[i], signal_ns));
+    if (!model) {
+      throw std::runtime_error("Model factory returned null for type '" +
+                               spec.models[i].type + "'");
+    }
+    program.models.push_back(std::move(model));
   }
 
   if (options.expected_dt > 0.0) {
     validate_stability(program.models, options.expected_dt);
   }
 
+  // Registry entries by transform type, so instanced graphs with many
+  // identical edges resolve each type once instead of per edge.
+  std::unordered_map<std::string, TransformRegistryEntry> transform_entries;
+
+  // Transforms are instantiated once the schedule is known
+  struct PendingTransform {
+    const TransformRegistryEntry *entry;
+    TransformSpec spec;
+  };
+  std::vector<PendingTransform> pending_transforms;
+  pending_transforms.reserve(spec.edges.size());
+  program.edges.reserve(spec.edges.size());
+
   // Compile edges with dimensional checks.
   for (size_t edge_index = 0; edge_index < spec.edges.size(); ++edge_index) {
     const auto &edge_spec = spec.edges[edge_index];
@@ -256,15 +299,16 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
           "' -> '" + edge_spec.target_path + "')");
     }
 
-    TransformRegistryEntry transform_entry;
-    {
+    auto cached = transform_entries.find(edge_spec.transform.type);
+    if (cached == transform_entries.end()) {
       auto &registry = factory_registry();
       std::lock_guard<std::mutex> lock(registry.mutex);
       ensure_default_factories_registered_locked(registry);
       const auto &entry =
           resolve_transform_entry_or_throw(registry, edge_spec.transform.type);
-      transform_entry = entry;
+      cached = transform_entries.emplace(edge_spec.transform.type, entry).first;
     }
+    const TransformRegistryEntry &transform_entry = cached->second;
 
     if (strict && !transform_entry.has_signature) {
       throw std::runtime_error(
@@ -406,9 +450,10 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
               "'] because one or both units are unknown to registry");
     }
 
-    ITransform *tf = parse_transform(resolved_transform_spec);
     const bool is_delay = edge_spec.transform.type == "delay";
-    program.edges.emplace_back(src, tgt, tf, is_delay);
+    program.edges.emplace_back(src, tgt, TransformPtr(), is_delay);
+    pending_transforms.push_back(
+        {&transform_entry, std::move(resolved_transform_spec)});
   }
 
   // Enforce single-writer ownership across model outputs and edge targets.
@@ -449,7 +494,20 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
   }
 
   detect_cycles(program.edges);
-  topological_sort(program.edges);
+  const std::vector<size_t> schedule = topological_sort(program.edges);
+
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    const PendingTransform &pending = pending_transforms[schedule[i]];
+    TransformPtr transform =
+        pending.entry->arena_factory
+            ? pending.entry->arena_factory(pending.spec, arena)
+            : TransformPtr(pending.entry->factory(pending.spec));
+    if (!transform) {
+      throw std::runtime_error("Transform factory returned null for type '" +
+                               pending.spec.type + "'");
+    }
+    program.edges[i].transform = std::move(transform);
+  }
 
   // Compile rules with threshold unit policy.
   for (const auto &rule_spec : spec.rules) {
@@ -508,6 +566,51 @@ CompiledProgram GraphCompiler::compile(const GraphSpec &spec,
   return program;
 }
 
+CompiledProgram GraphCompiler::compile_execution_layout(
+    const GraphSpec &spec, SignalNamespace &signal_ns,
+    FunctionNamespace &func_ns, const CompilationOptions &options) {
+  // Ids follow interning order, so interning the planned layout into a fresh
+  // namespace first is the renumbering
+  const std::vector<std::string_view> layout = plan_signal_layout(spec);
+  SignalNamespace laid_out;
+  laid_out.reserve(layout.size() + signal_ns.size());
+  for (std::string_view path : layout) {
+    laid_out.intern(path);
+  }
+
+  CompilationOptions layout_options = options;
+  layout_options.signal_layout = SignalLayout::interning_order;
+  CompiledProgram program = compile(spec, laid_out, func_ns, layout_options);
+
+  SignalIdMap &map = program.signal_id_map;
+  if (options.keep_external_ids) {
+    map.external_ids = true;
+    map.to_host.resize(laid_out.size());
+    for (SignalId id = 0; id < laid_out.size(); ++id) {
+      map.to_host[id] = signal_ns.intern(laid_out.lookup(id));
+    }
+    map.to_program.assign(signal_ns.size(), INVALID_SIGNAL);
+    for (SignalId id = 0; id < laid_out.size(); ++id) {
+      map.to_program[map.to_host[id]] = id;
+    }
+    return program;
+  }
+
+  // Paths interned before compile stay resolvable, after the program's
+  if (signal_ns.size() > 0) {
+    map.to_program.resize(signal_ns.size());
+    for (SignalId id = 0; id < signal_ns.size(); ++id) {
+      map.to_program[id] = laid_out.intern(signal_ns.lookup(id));
+    }
+    map.to_host.assign(laid_out.size(), INVALID_SIGNAL);
+    for (SignalId id = 0; id < map.to_program.size(); ++id) {
+      map.to_host[map.to_program[id]] = id;
+    }
+  }
+  signal_ns = std::move(laid_out);
+  return program;
+}
+
 ITransform *GraphCompiler::parse_transform(const TransformSpec &spec) {
   TransformFactory factory;
   {
@@ -546,16 +649,17 @@ IModel *GraphCompiler::parse_model(const ModelSpec &spec, SignalNamespace &ns) {
   return model.release();
 }
 
-void GraphCompiler::topological_sort(std::vector<CompiledEdge> &edges) {
-  topological_sort_edges(edges);
+std::vector<size_t>
+GraphCompiler::topological_sort(std::vector<CompiledEdge> &edges) {
+  return topological_sort_edges(edges);
 }
 
 void GraphCompiler::detect_cycles(const std::vector<CompiledEdge> &edges) {
   detect_cycles_in_non_delay_subgraph(edges);
 }
 
-void GraphCompiler::validate_stability(
-    const std::vector<std::unique_ptr<IModel>> &models, double expected_dt) {
+void GraphCompiler::validate_stability(const std::vector<ModelPtr> &models,
+                                       double expected_dt) {
   validate_model_stability_limits(models, expected_dt);
 }
 
@@ -8,7 +8,7 @@
 
 namespace fluxgraph::compiler_internal {
 
-void topological_sort_edges(std::vector<CompiledEdge> &edges) {
+std::vector<size_t> topological_sort_edges(std::vector<CompiledEdge> &edges) {
   std::vector<size_t> delay_indices;
   std::vector<size_t> immediate_indices;
   delay_indices.reserve(edges.size());
@@ -69,18 +69,18 @@ void topological_sort_edges(std::vector<CompiledEdge> &edges) {
         "GraphCompiler: topological sort failed for non-delay edges.");
   }
 
+  std::vector<size_t> order = std::move(delay_indices);
+  order.insert(order.end(), sorted_immediate_indices.begin(),
+               sorted_immediate_indices.end());
+
   std::vector<CompiledEdge> sorted;
   sorted.reserve(edges.size());
-
-  for (size_t idx : delay_indices) {
-    sorted.push_back(std::move(edges[idx]));
-  }
-
-  for (size_t idx : sorted_immediate_indices) {
+  for (size_t idx : order) {
     sorted.push_back(std::move(edges[idx]));
   }
 
   edges = std::move(sorted);
+  return order;
 }
 
 void detect_cycles_in_non_delay_subgraph(const std::vector<CompiledEdge> &edges) {
@@ -150,8 +150,8 @@ void detect_cycles_in_non_delay_subgraph(const std::vector<CompiledEdge> &edges)
   }
 }
 
-void validate_model_stability_limits(
-    const std::vector<std::unique_ptr<IModel>> &models, double expected_dt) {
+void validate_model_stability_limits(const std::vector<ModelPtr> &models,
+                                     double expected_dt) {
   for (const auto &model : models) {
     double limit = model->compute_stability_limit();
     if (expected_dt > limit) {
@@ -6,9 +6,11 @@
 
 namespace fluxgraph::compiler_internal {
 
-void topological_sort_edges(std::vector<CompiledEdge> &edges);
+/// Sort edges into execution order
+/// @return Original index of each edge in the sorted order
+std::vector<size_t> topological_sort_edges(std::vector<CompiledEdge> &edges);
 void detect_cycles_in_non_delay_subgraph(const std::vector<CompiledEdge> &edges);
-void validate_model_stability_limits(
-    const std::vector<std::unique_ptr<IModel>> &models, double expected_dt);
+void validate_model_stability_limits(const std::vector<ModelPtr> &models,
+                                     double expected_dt);
 
 } // namespace fluxgraph::compiler_internal
@@ -42,6 +42,11 @@ const ParamObject &as_object(const ParamValue &value,
   return param::as_object(value, path);
 }
 
+const ParamNumbers &as_numbers(const ParamValue &value, const std::string &path,
+                               size_t rank, ParamNumbers &scratch) {
+  return param::as_numbers(value, path, rank, scratch);
+}
+
 void require_finite(const double value, const std::string &path) {
   if (!std::isfinite(value)) {
     throw std::runtime_error("Invalid parameter at " + path +
@@ -18,6 +18,8 @@ bool as_bool(const ParamValue &value, const std::string &path);
 std::string as_string(const ParamValue &value, const std::string &path);
 const ParamArray &as_array(const ParamValue &value, const std::string &path);
 const ParamObject &as_object(const ParamValue &value, const std::string &path);
+const ParamNumbers &as_numbers(const ParamValue &value, const std::string &path,
+                               size_t rank, ParamNumbers &scratch);
 
 void require_finite(double value, const std::string &path);
 void require_finite_positive(double value, const std::string &path);
@@ -7,14 +7,22 @@
 
 namespace fluxgraph::compiler_internal {
 
+/// Built-in factories construct into the arena (on the heap when null)
+using ArenaTransformFactory =
+    std::function<TransformPtr(const TransformSpec &, ComponentArena *)>;
+using ArenaModelFactory = std::function<ModelPtr(
+    const ModelSpec &, SignalNamespace &, ComponentArena *)>;
+
 struct TransformRegistryEntry {
   GraphCompiler::TransformFactory factory;
+  ArenaTransformFactory arena_factory; ///< Empty for registered factories
   bool has_signature = false;
   TransformSignature signature;
 };
 
 struct ModelRegistryEntry {
   GraphCompiler::ModelFactory factory;
+  ArenaModelFactory arena_factory; ///< Empty for registered factories
   bool has_signature = false;
   ModelSignature signature;
 };
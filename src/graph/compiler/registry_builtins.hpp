@@ -7,12 +7,12 @@ namespace fluxgraph::compiler_internal {
 
 void register_builtin_transform(FactoryRegistry &registry,
                                 const std::string &type,
-                                GraphCompiler::TransformFactory factory,
+                                ArenaTransformFactory factory,
                                 TransformSignature::Contract contract =
                                     TransformSignature::Contract::preserve);
 
 void register_builtin_model(FactoryRegistry &registry, const std::string &type,
-                            GraphCompiler::ModelFactory factory,
+                            ArenaModelFactory factory,
                             ModelSignature signature);
 
 void register_builtin_transforms(FactoryRegistry &registry);
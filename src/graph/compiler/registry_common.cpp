@@ -5,20 +5,26 @@ namespace fluxgraph::compiler_internal {
 
 void register_builtin_transform(FactoryRegistry &registry,
                                 const std::string &type,
-                                GraphCompiler::TransformFactory factory,
+                                ArenaTransformFactory factory,
                                 TransformSignature::Contract contract) {
   TransformRegistryEntry entry;
-  entry.factory = std::move(factory);
+  entry.factory = [factory](const TransformSpec &spec) {
+    return std::unique_ptr<ITransform>(factory(spec, nullptr).release());
+  };
+  entry.arena_factory = std::move(factory);
   entry.has_signature = true;
   entry.signature.contract = contract;
   registry.transform_factories.emplace(type, std::move(entry));
 }
 
 void register_builtin_model(FactoryRegistry &registry, const std::string &type,
-                            GraphCompiler::ModelFactory factory,
+                            ArenaModelFactory factory,
                             ModelSignature signature) {
   ModelRegistryEntry entry;
-  entry.factory = std::move(factory);
+  entry.factory = [factory](const ModelSpec &spec, SignalNamespace &ns) {
+    return std::unique_ptr<IModel>(factory(spec, ns, nullptr).release());
+  };
+  entry.arena_factory = std::move(factory);
   entry.has_signature = true;
   entry.signature = std::move(signature);
   registry.model_factories.emplace(type, std::move(entry));
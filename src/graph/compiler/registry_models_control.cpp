@@ -26,8 +26,8 @@ void register_builtin_models_control(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "first_order_process",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context =
             "model[" + spec.id + ":first_order_process]";
 
@@ -67,9 +67,9 @@ void register_builtin_models_control(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<FirstOrderProcessModel>(
-            spec.id, gain, tau_s, initial_output, output_path, input_path, ns,
-            integration_method);
+        return make_component<FirstOrderProcessModel>(
+            arena, spec.id, gain, tau_s, initial_output, output_path,
+            input_path, ns, integration_method);
       },
       first_order_signature);
 
@@ -97,8 +97,8 @@ void register_builtin_models_control(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "second_order_process",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context =
             "model[" + spec.id + ":second_order_process]";
 
@@ -148,8 +148,8 @@ void register_builtin_models_control(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<SecondOrderProcessModel>(
-            spec.id, gain, zeta, omega_n_rad_s, initial_output,
+        return make_component<SecondOrderProcessModel>(
+            arena, spec.id, gain, zeta, omega_n_rad_s, initial_output,
             initial_output_rate, output_path, input_path, ns,
             integration_method);
       },
@@ -43,8 +43,8 @@ void register_builtin_models_electromechanical(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "dc_motor",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context = "model[" + spec.id + ":dc_motor]";
 
         const std::string resistance_path = context + "/resistance_ohm";
@@ -119,8 +119,8 @@ void register_builtin_models_electromechanical(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<DcMotorModel>(
-            spec.id, resistance_ohm, inductance_h, torque_constant,
+        return make_component<DcMotorModel>(
+            arena, spec.id, resistance_ohm, inductance_h, torque_constant,
             back_emf_constant, inertia, viscous_friction, initial_current,
             initial_speed, speed_path, current_path, torque_path, voltage_path,
             load_torque_path, ns, integration_method);
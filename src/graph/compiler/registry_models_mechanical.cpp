@@ -30,8 +30,8 @@ void register_builtin_models_mechanical(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "mass_spring_damper",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context = "model[" + spec.id + ":mass_spring_damper]";
 
         const std::string mass_path = context + "/mass";
@@ -83,10 +83,10 @@ void register_builtin_models_mechanical(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<MassSpringDamperModel>(
-            spec.id, mass, damping_coeff, spring_constant, initial_position,
-            initial_velocity, position_path, velocity_path, force_path, ns,
-            integration_method);
+        return make_component<MassSpringDamperModel>(
+            arena, spec.id, mass, damping_coeff, spring_constant,
+            initial_position, initial_velocity, position_path, velocity_path,
+            force_path, ns, integration_method);
       },
       mass_spring_signature);
 }
@@ -1,6 +1,7 @@
 #include "registry_builtins.hpp"
 #include "common.hpp"
 #include "fluxgraph/model/state_space_siso_discrete.hpp"
+#include <cmath>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -10,7 +11,8 @@ namespace fluxgraph::compiler_internal {
 namespace {
 
 struct StateSpaceSisoDiscreteConfig {
-  std::vector<std::vector<double>> a_d;
+  std::vector<double> a_d; // row-major n x n
+  std::size_t n = 0;
   std::vector<double> b_d;
   std::vector<double> c;
   double d = 0.0;
@@ -19,54 +21,55 @@ struct StateSpaceSisoDiscreteConfig {
   std::string input_signal;
 };
 
+void require_finite_elements(const ParamNumbers &numbers,
+                             const std::string &path) {
+  for (std::size_t i = 0; i < numbers.values.size(); ++i) {
+    if (!std::isfinite(numbers.values[i])) {
+      std::string element_path = path;
+      if (numbers.columns == 0) {
+        element_path += "[" + std::to_string(i) + "]";
+      } else {
+        element_path += "[" + std::to_string(i / numbers.columns) + "][" +
+                        std::to_string(i % numbers.columns) + "]";
+      }
+      require_finite(numbers.values[i], element_path);
+    }
+  }
+}
+
 std::vector<double> parse_numeric_vector(const ParamValue &value,
                                          const std::string &path) {
-  const ParamArray &array = as_array(value, path);
-  if (array.empty()) {
+  ParamNumbers scratch;
+  const ParamNumbers &numbers = as_numbers(value, path, 1, scratch);
+  if (numbers.values.empty()) {
     throw std::runtime_error("Invalid parameter at " + path +
                              ": expected non-empty array");
   }
-
-  std::vector<double> out;
-  out.reserve(array.size());
-  for (std::size_t i = 0; i < array.size(); ++i) {
-    const std::string element_path = path + "[" + std::to_string(i) + "]";
-    const double parsed = as_double(array[i], element_path);
-    require_finite(parsed, element_path);
-    out.push_back(parsed);
+  require_finite_elements(numbers, path);
+  if (&numbers == &scratch) {
+    return std::move(scratch.values);
   }
-  return out;
+  return numbers.values;
 }
 
-std::vector<std::vector<double>> parse_numeric_matrix(const ParamValue &value,
-                                                      const std::string &path) {
-  const ParamArray &rows = as_array(value, path);
-  if (rows.empty()) {
+// Row-major matrix; sets rows/columns
+std::vector<double> parse_numeric_matrix(const ParamValue &value,
+                                         const std::string &path,
+                                         std::size_t &rows,
+                                         std::size_t &columns) {
+  ParamNumbers scratch;
+  const ParamNumbers &numbers = as_numbers(value, path, 2, scratch);
+  if (numbers.values.empty()) {
     throw std::runtime_error("Invalid parameter at " + path +
                              ": expected non-empty array");
   }
-
-  std::vector<std::vector<double>> matrix;
-  matrix.reserve(rows.size());
-
-  std::size_t expected_columns = 0;
-  for (std::size_t row_index = 0; row_index < rows.size(); ++row_index) {
-    const std::string row_path = path + "[" + std::to_string(row_index) + "]";
-    const std::vector<double> row = parse_numeric_vector(rows[row_index], row_path);
-
-    if (row_index == 0) {
-      expected_columns = row.size();
-    } else if (row.size() != expected_columns) {
-      throw std::runtime_error("Invalid parameter at " + row_path +
-                               ": expected row length " +
-                               std::to_string(expected_columns) + ", got " +
-                               std::to_string(row.size()));
-    }
-
-    matrix.push_back(row);
+  require_finite_elements(numbers, path);
+  rows = numbers.rows();
+  columns = numbers.columns;
+  if (&numbers == &scratch) {
+    return std::move(scratch.values);
   }
-
-  return matrix;
+  return numbers.values;
 }
 
 StateSpaceSisoDiscreteConfig decode_state_space_siso_discrete_config(
@@ -75,8 +78,10 @@ StateSpaceSisoDiscreteConfig decode_state_space_siso_discrete_config(
       "model[" + spec.id + ":state_space_siso_discrete]";
 
   StateSpaceSisoDiscreteConfig config;
-  config.a_d = parse_numeric_matrix(
-      require_param(spec.params, "A_d", context), context + "/A_d");
+  std::size_t a_d_columns = 0;
+  config.a_d =
+      parse_numeric_matrix(require_param(spec.params, "A_d", context),
+                           context + "/A_d", config.n, a_d_columns);
   config.b_d = parse_numeric_vector(
       require_param(spec.params, "B_d", context), context + "/B_d");
   config.c = parse_numeric_vector(require_param(spec.params, "C", context),
@@ -96,8 +101,8 @@ StateSpaceSisoDiscreteConfig decode_state_space_siso_discrete_config(
       as_string(require_param(spec.params, "input_signal", context),
                 context + "/input_signal");
 
-  const std::size_t n = config.a_d.size();
-  if (config.a_d.front().size() != n) {
+  const std::size_t n = config.n;
+  if (a_d_columns != n) {
     throw std::runtime_error("Invalid parameter at " + context +
                              "/A_d: expected square matrix");
   }
@@ -149,15 +154,16 @@ void register_builtin_models_state_space(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "state_space_siso_discrete",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         StateSpaceSisoDiscreteConfig config =
             decode_state_space_siso_discrete_config(spec);
 
-        return std::make_unique<StateSpaceSisoDiscreteModel>(
-            spec.id, std::move(config.a_d), std::move(config.b_d),
-            std::move(config.c), config.d, std::move(config.x0),
-            config.output_signal, config.input_signal, ns);
+        return make_component<StateSpaceSisoDiscreteModel>(
+            arena, spec.id, config.n, std::move(config.a_d),
+            std::move(config.b_d), std::move(config.c), config.d,
+            std::move(config.x0), config.output_signal, config.input_signal,
+            ns);
       },
       state_space_signature);
 }
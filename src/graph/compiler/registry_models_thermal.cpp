@@ -24,8 +24,8 @@ void register_builtin_models_thermal(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "thermal_mass",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context = "model[" + spec.id + ":thermal_mass]";
         const std::string thermal_mass_path = context + "/thermal_mass";
         const std::string heat_transfer_coeff_path =
@@ -68,9 +68,9 @@ void register_builtin_models_thermal(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<ThermalMassModel>(
-            spec.id, thermal_mass, heat_transfer_coeff, initial_temp, temp_path,
-            power_path, ambient_path, ns, integration_method);
+        return make_component<ThermalMassModel>(
+            arena, spec.id, thermal_mass, heat_transfer_coeff, initial_temp,
+            temp_path, power_path, ambient_path, ns, integration_method);
       },
       thermal_signature);
 
@@ -104,8 +104,8 @@ void register_builtin_models_thermal(FactoryRegistry &registry) {
 
   register_builtin_model(
       registry, "thermal_rc2",
-      [](const ModelSpec &spec,
-         SignalNamespace &ns) -> std::unique_ptr<IModel> {
+      [](const ModelSpec &spec, SignalNamespace &ns,
+         ComponentArena *arena) -> ModelPtr {
         const std::string context = "model[" + spec.id + ":thermal_rc2]";
 
         const std::string thermal_mass_a_path = context + "/thermal_mass_a";
@@ -177,11 +177,11 @@ void register_builtin_models_thermal(FactoryRegistry &registry) {
           }
         }
 
-        return std::make_unique<ThermalRc2Model>(
-            spec.id, thermal_mass_a, thermal_mass_b, heat_transfer_coeff_a,
-            heat_transfer_coeff_b, coupling_coeff, initial_temp_a,
-            initial_temp_b, temp_a_path, temp_b_path, power_path, ambient_path,
-            ns, integration_method);
+        return make_component<ThermalRc2Model>(
+            arena, spec.id, thermal_mass_a, thermal_mass_b,
+            heat_transfer_coeff_a, heat_transfer_coeff_b, coupling_coeff,
+            initial_temp_a, initial_temp_b, temp_a_path, temp_b_path,
+            power_path, ambient_path, ns, integration_method);
       },
       thermal_rc2_signature);
 }
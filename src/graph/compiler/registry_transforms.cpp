@@ -19,7 +19,8 @@ namespace fluxgraph::compiler_internal {
 void register_builtin_transforms(FactoryRegistry &registry) {
   register_builtin_transform(
       registry, "linear",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[linear]";
         double scale = as_double(require_param(spec.params, "scale", context),
                                  context + "/scale");
@@ -35,33 +36,36 @@ void register_builtin_transforms(FactoryRegistry &registry) {
           clamp_max = as_double(it->second, context + "/clamp_max");
         }
 
-        return std::make_unique<LinearTransform>(scale, offset, clamp_min,
-                                                 clamp_max);
+        return make_component<LinearTransform>(arena, scale, offset,
+                                               clamp_min, clamp_max);
       },
       TransformSignature::Contract::linear_conditioning);
 
   register_builtin_transform(
       registry, "first_order_lag",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[first_order_lag]";
         double tau_s = as_double(require_param(spec.params, "tau_s", context),
                                  context + "/tau_s");
-        return std::make_unique<FirstOrderLagTransform>(tau_s);
+        return make_component<FirstOrderLagTransform>(arena, tau_s);
       });
 
   register_builtin_transform(
       registry, "delay",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[delay]";
         double delay_sec =
             as_double(require_param(spec.params, "delay_sec", context),
                       context + "/delay_sec");
-        return std::make_unique<DelayTransform>(delay_sec);
+        return make_component<DelayTransform>(arena, delay_sec);
       });
 
   register_builtin_transform(
       registry, "noise",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[noise]";
         double amplitude =
             as_double(require_param(spec.params, "amplitude", context),
@@ -70,12 +74,13 @@ void register_builtin_transforms(FactoryRegistry &registry) {
         if (auto it = spec.params.find("seed"); it != spec.params.end()) {
           seed = static_cast<uint32_t>(as_int64(it->second, context + "/seed"));
         }
-        return std::make_unique<NoiseTransform>(amplitude, seed);
+        return make_component<NoiseTransform>(arena, amplitude, seed);
       });
 
   register_builtin_transform(
       registry, "saturation",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[saturation]";
         double min_val = 0.0;
         double max_val = 0.0;
@@ -92,22 +97,24 @@ void register_builtin_transforms(FactoryRegistry &registry) {
           max_val = as_double(require_param(spec.params, "max_value", context),
                               context + "/max_value");
         }
-        return std::make_unique<SaturationTransform>(min_val, max_val);
+        return make_component<SaturationTransform>(arena, min_val, max_val);
       });
 
   register_builtin_transform(
       registry, "deadband",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[deadband]";
         double threshold =
             as_double(require_param(spec.params, "threshold", context),
                       context + "/threshold");
-        return std::make_unique<DeadbandTransform>(threshold);
+        return make_component<DeadbandTransform>(arena, threshold);
       });
 
   register_builtin_transform(
       registry, "rate_limiter",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[rate_limiter]";
         double max_rate = 0.0;
         if (auto it = spec.params.find("max_rate_per_sec");
@@ -117,12 +124,13 @@ void register_builtin_transforms(FactoryRegistry &registry) {
           max_rate = as_double(require_param(spec.params, "max_rate", context),
                                context + "/max_rate");
         }
-        return std::make_unique<RateLimiterTransform>(max_rate);
+        return make_component<RateLimiterTransform>(arena, max_rate);
       });
 
   register_builtin_transform(
       registry, "moving_average",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[moving_average]";
         int64_t window_size_raw =
             as_int64(require_param(spec.params, "window_size", context),
@@ -132,12 +140,13 @@ void register_builtin_transforms(FactoryRegistry &registry) {
                                    "/window_size: expected >= 1");
         }
         size_t window_size = static_cast<size_t>(window_size_raw);
-        return std::make_unique<MovingAverageTransform>(window_size);
+        return make_component<MovingAverageTransform>(arena, window_size);
       });
 
   register_builtin_transform(
       registry, "unit_convert",
-      [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+      [](const TransformSpec &spec,
+         ComponentArena *arena) -> TransformPtr {
         const std::string context = "transform[unit_convert]";
         double resolved_scale =
             as_double(require_param(spec.params, "__resolved_scale", context),
@@ -145,8 +154,8 @@ void register_builtin_transforms(FactoryRegistry &registry) {
         double resolved_offset =
             as_double(require_param(spec.params, "__resolved_offset", context),
                       context + "/__resolved_offset");
-        return std::make_unique<UnitConvertTransform>(resolved_scale,
-                                                      resolved_offset);
+        return make_component<UnitConvertTransform>(arena, resolved_scale,
+                                                    resolved_offset);
       },
       TransformSignature::Contract::unit_convert);
 }
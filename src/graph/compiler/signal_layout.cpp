@@ -0,0 +1,134 @@
+#include "signal_layout.hpp"
+#include "registry.hpp"
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fluxgraph::compiler_internal {
+
+namespace {
+
+// Model signal parameter paths, in model order. Unknown types and
+// non-string values are skipped; compilation reports them.
+std::vector<std::string_view> model_signal_paths(const GraphSpec &spec) {
+  std::vector<std::string_view> paths;
+  auto &registry = factory_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  ensure_default_factories_registered_locked(registry);
+
+  for (const ModelSpec &model : spec.models) {
+    const auto entry = registry.model_factories.find(model.type);
+    if (entry == registry.model_factories.end() ||
+        !entry->second.has_signature) {
+      continue;
+    }
+    for (const auto &[name, unit] :
+         entry->second.signature.signal_param_units) {
+      const auto param = model.params.find(name);
+      if (param == model.params.end()) {
+        continue;
+      }
+      if (const auto *path = std::get_if<std::string>(&param->second)) {
+        paths.emplace_back(*path);
+      }
+    }
+  }
+  return paths;
+}
+
+} // namespace
+
+std::vector<std::string_view> plan_signal_layout(const GraphSpec &spec) {
+  std::vector<std::string_view> layout;
+  layout.reserve(spec.edges.size() * 2 + spec.signals.size());
+  std::unordered_set<std::string_view> placed;
+  auto place = [&](std::string_view path) {
+    if (placed.insert(path).second) {
+      layout.push_back(path);
+    }
+  };
+
+  // A tick runs models, then delay edges, then the immediate schedule
+  for (std::string_view path : model_signal_paths(spec)) {
+    place(path);
+  }
+  for (const EdgeSpec &edge : spec.edges) {
+    if (edge.transform.type == "delay") {
+      place(edge.source_path);
+      place(edge.target_path);
+    }
+  }
+
+  // Immediate-edge endpoints as nodes, numbered by first appearance
+  std::unordered_map<std::string_view, size_t> node_of;
+  std::vector<std::string_view> nodes;
+  auto node = [&](std::string_view path) {
+    const auto [it, inserted] = node_of.emplace(path, nodes.size());
+    if (inserted) {
+      nodes.push_back(path);
+    }
+    return it->second;
+  };
+  std::vector<std::vector<size_t>> outgoing;
+  std::vector<size_t> in_degree;
+  for (const EdgeSpec &edge : spec.edges) {
+    if (edge.transform.type == "delay") {
+      continue;
+    }
+    const size_t source = node(edge.source_path);
+    const size_t target = node(edge.target_path);
+    outgoing.resize(nodes.size());
+    in_degree.resize(nodes.size(), 0);
+    outgoing[source].push_back(target);
+    ++in_degree[target];
+  }
+
+  // Replay topological_sort_edges(), which pops the lowest ready SignalId
+  // and emits all of its out-edges, taking each path's place in layout as
+  // its id. Paths not yet placed can only be roots; they rank after every
+  // placed path, by first appearance, which is the id they then receive.
+  // The ids this assigns therefore reproduce the same schedule.
+  std::unordered_map<std::string_view, size_t> rank;
+  for (size_t i = 0; i < layout.size(); ++i) {
+    rank.emplace(layout[i], i);
+  }
+  auto key = [&](size_t n) {
+    const auto it = rank.find(nodes[n]);
+    return it != rank.end() ? it->second : layout.size() + nodes.size() + n;
+  };
+  auto touch = [&](size_t n) {
+    if (rank.emplace(nodes[n], layout.size()).second) {
+      layout.push_back(nodes[n]);
+      placed.insert(nodes[n]);
+    }
+  };
+  std::set<std::pair<size_t, size_t>> ready;
+  for (size_t n = 0; n < nodes.size(); ++n) {
+    if (in_degree[n] == 0) {
+      ready.emplace(key(n), n);
+    }
+  }
+  while (!ready.empty()) {
+    const size_t n = ready.begin()->second;
+    ready.erase(ready.begin());
+    touch(n);
+    for (size_t target : outgoing[n]) {
+      touch(target);
+      if (--in_degree[target] == 0) {
+        ready.emplace(key(target), target);
+      }
+    }
+  }
+
+  // Nodes on a non-delay cycle were never reached; compilation rejects them
+  for (std::string_view path : nodes) {
+    place(path);
+  }
+  for (const SignalSpec &signal : spec.signals) {
+    place(signal.path);
+  }
+  return layout;
+}
+
+} // namespace fluxgraph::compiler_internal
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "fluxgraph/graph/spec.hpp"
+#include <string_view>
+#include <vector>
+
+namespace fluxgraph::compiler_internal {
+
+/// Signal paths of spec in the order a tick first touches them, for
+/// SignalLayout::execution_order:
+/// 1. each model's signal parameters together, in model order (taken from
+///    the model type's signature);
+/// 2. delay edge endpoints, in edge order;
+/// 3. immediate edge endpoints in schedule order, each source followed by
+///    its targets;
+/// 4. remaining declared signals.
+/// Paths only a custom model or a rule names are not listed; they are
+/// interned after these during compilation.
+/// Views point into spec.
+std::vector<std::string_view> plan_signal_layout(const GraphSpec &spec);
+
+} // namespace fluxgraph::compiler_internal
@@ -16,7 +16,8 @@ std::string type_name(const ParamValue &value) {
   if (std::holds_alternative<std::string>(value)) {
     return "string";
   }
-  if (std::holds_alternative<ParamArray>(value)) {
+  if (std::holds_alternative<ParamArray>(value) ||
+      std::holds_alternative<ParamNumbers>(value)) {
     return "array";
   }
   return "object";
@@ -61,6 +62,11 @@ const ParamArray &as_array(const ParamValue &value, const std::string &path) {
   if (std::holds_alternative<ParamArray>(value)) {
     return std::get<ParamArray>(value);
   }
+  if (std::holds_alternative<ParamNumbers>(value)) {
+    throw std::runtime_error("Type error at " + path +
+                             ": expected array of values, got packed numeric "
+                             "array (read it with param::as_numbers)");
+  }
   throw std::runtime_error("Type error at " + path + ": expected array, got " +
                            type_name(value));
 }
@@ -74,4 +80,81 @@ const ParamObject &as_object(const ParamValue &value,
                            type_name(value));
 }
 
+namespace {
+
+std::string element_path(const std::string &path, size_t index) {
+  return path + "[" + std::to_string(index) + "]";
+}
+
+// Checks a packed array's shape against the requested rank, reporting the
+// first element as a nested array would
+void check_packed_rank(const ParamNumbers &numbers, const std::string &path,
+                       size_t rank) {
+  if (numbers.rank() == rank || numbers.values.empty()) {
+    return;
+  }
+  const std::string first = element_path(path, 0);
+  if (rank == 1) {
+    throw std::runtime_error("Type error at " + first +
+                             ": expected number, got array");
+  }
+  throw std::runtime_error("Type error at " + first +
+                           ": expected array, got " +
+                           (numbers.integral ? "int64" : "double"));
+}
+
+void append_row(const ParamArray &row, const std::string &path,
+                ParamNumbers &out) {
+  for (size_t i = 0; i < row.size(); ++i) {
+    out.values.push_back(as_double(row[i], element_path(path, i)));
+  }
+}
+
+} // namespace
+
+const ParamNumbers &as_numbers(const ParamValue &value, const std::string &path,
+                               size_t rank, ParamNumbers &scratch) {
+  if (const auto *packed = std::get_if<ParamNumbers>(&value)) {
+    check_packed_rank(*packed, path, rank);
+    return *packed;
+  }
+
+  const ParamArray &array = as_array(value, path);
+  scratch.values.clear();
+  scratch.columns = 0;
+  scratch.integral = false;
+  if (rank == 1) {
+    scratch.values.reserve(array.size());
+    append_row(array, path, scratch);
+    return scratch;
+  }
+
+  for (size_t row_index = 0; row_index < array.size(); ++row_index) {
+    const std::string row_path = element_path(path, row_index);
+    const auto *packed_row = std::get_if<ParamNumbers>(&array[row_index]);
+    if (packed_row != nullptr) {
+      check_packed_rank(*packed_row, row_path, 1);
+    }
+    const size_t row_size = packed_row != nullptr
+                                ? packed_row->values.size()
+                                : as_array(array[row_index], row_path).size();
+    if (row_index == 0) {
+      scratch.columns = row_size;
+      scratch.values.reserve(array.size() * row_size);
+    } else if (row_size != scratch.columns) {
+      throw std::runtime_error("Invalid parameter at " + row_path +
+                               ": expected row length " +
+                               std::to_string(scratch.columns) + ", got " +
+                               std::to_string(row_size));
+    }
+    if (packed_row != nullptr) {
+      scratch.values.insert(scratch.values.end(), packed_row->values.begin(),
+                            packed_row->values.end());
+    } else {
+      append_row(std::get<ParamArray>(array[row_index]), row_path, scratch);
+    }
+  }
+  return scratch;
+}
+
 } // namespace fluxgraph::param
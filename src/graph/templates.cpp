@@ -0,0 +1,261 @@
+#include "fluxgraph/graph/templates.hpp"
+#include "fluxgraph/graph/param_utils.hpp"
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace fluxgraph {
+
+namespace {
+
+constexpr std::string_view kPrefixPlaceholder = "prefix";
+
+// Placeholder values for stamping one template. Field locations for error
+// messages are passed as callables so they are only built on failure.
+class Substitution {
+public:
+  Substitution(const GraphTemplateSpec &tmpl, const std::string &prefix,
+               const ParamMap &params)
+      : tmpl_(tmpl), prefix_(prefix), params_(params) {}
+
+  template <typename Where>
+  std::string text(const std::string &input, const Where &where) const {
+    size_t open = input.find("${");
+    if (open == std::string::npos) {
+      return input;
+    }
+
+    std::string out;
+    size_t pos = 0;
+    while (open != std::string::npos) {
+      out.append(input, pos, open - pos);
+      const size_t close = input.find('}', open + 2);
+      if (close == std::string::npos) {
+        fail(where, "unterminated placeholder");
+      }
+      const std::string name = input.substr(open + 2, close - open - 2);
+      if (name == kPrefixPlaceholder) {
+        out += prefix_;
+      } else {
+        const ParamValue &value = lookup(name, where);
+        if (!std::holds_alternative<std::string>(value)) {
+          fail(where, "parameter '" + name + "' is " +
+                          param::type_name(value) +
+                          "; only string parameters can be embedded in text");
+        }
+        out += std::get<std::string>(value);
+      }
+      pos = close + 1;
+      open = input.find("${", pos);
+    }
+    out.append(input, pos, std::string::npos);
+    return out;
+  }
+
+  template <typename Where>
+  ParamValue value(const ParamValue &input, const Where &where) const {
+    if (const auto *str = std::get_if<std::string>(&input)) {
+      // Exactly "${name}": take the parameter's value and type
+      if (str->size() > 3 && str->compare(0, 2, "${") == 0 &&
+          str->find_first_of("${}", 2) == str->size() - 1 &&
+          str->back() == '}') {
+        const std::string name = str->substr(2, str->size() - 3);
+        if (name != kPrefixPlaceholder) {
+          return lookup(name, where);
+        }
+      }
+      return text(*str, where);
+    }
+    if (const auto *array = std::get_if<ParamArray>(&input)) {
+      ParamArray out;
+      out.reserve(array->size());
+      for (const ParamValue &item : *array) {
+        out.push_back(value(item, where));
+      }
+      return out;
+    }
+    if (const auto *object = std::get_if<ParamObject>(&input)) {
+      ParamObject out;
+      for (const auto &[key, item] : *object) {
+        out.emplace(key, value(item, where));
+      }
+      return out;
+    }
+    return input;
+  }
+
+  template <typename Where>
+  ParamMap params(const ParamMap &input, const Where &where) const {
+    ParamMap out;
+    for (const auto &[key, item] : input) {
+      out.emplace(key,
+                  value(item, [&] { return where() + ".params." + key; }));
+    }
+    return out;
+  }
+
+  template <typename Where>
+  [[noreturn]] void fail(const Where &where,
+                         const std::string &message) const {
+    std::string context = "GraphCompiler: template '" + tmpl_.name + "'";
+    if (!prefix_.empty()) {
+      context += " (prefix '" + prefix_ + "')";
+    }
+    throw std::runtime_error(context + ": " + message + " at " + where());
+  }
+
+private:
+  template <typename Where>
+  const ParamValue &lookup(const std::string &name, const Where &where) const {
+    const auto it = params_.find(name);
+    if (it == params_.end()) {
+      fail(where, "undeclared parameter '${" + name + "}'");
+    }
+    return it->second;
+  }
+
+  const GraphTemplateSpec &tmpl_;
+  const std::string &prefix_;
+  const ParamMap &params_;
+};
+
+void stamp(const GraphTemplateSpec &tmpl, const Substitution &sub,
+           GraphSpec &out) {
+  for (size_t i = 0; i < tmpl.signals.size(); ++i) {
+    const SignalSpec &signal = tmpl.signals[i];
+    auto where = [i] { return "signals[" + std::to_string(i) + "]"; };
+    out.signals.push_back(SignalSpec{sub.text(signal.path, where),
+                                     sub.text(signal.unit, where)});
+  }
+
+  for (size_t i = 0; i < tmpl.models.size(); ++i) {
+    const ModelSpec &model = tmpl.models[i];
+    auto where = [i] { return "models[" + std::to_string(i) + "]"; };
+    ModelSpec stamped;
+    stamped.id = sub.text(model.id, where);
+    stamped.type = model.type;
+    stamped.params = sub.params(model.params, where);
+    out.models.push_back(std::move(stamped));
+  }
+
+  for (size_t i = 0; i < tmpl.edges.size(); ++i) {
+    const EdgeSpec &edge = tmpl.edges[i];
+    auto where = [i] { return "edges[" + std::to_string(i) + "]"; };
+    EdgeSpec stamped;
+    stamped.source_path = sub.text(edge.source_path, where);
+    stamped.target_path = sub.text(edge.target_path, where);
+    stamped.transform.type = edge.transform.type;
+    stamped.transform.params = sub.params(edge.transform.params, where);
+    out.edges.push_back(std::move(stamped));
+  }
+
+  for (size_t i = 0; i < tmpl.rules.size(); ++i) {
+    const RuleSpec &rule = tmpl.rules[i];
+    auto where = [i] { return "rules[" + std::to_string(i) + "]"; };
+    RuleSpec stamped;
+    stamped.id = sub.text(rule.id, where);
+    stamped.condition = sub.text(rule.condition, where);
+    stamped.on_error = rule.on_error;
+    stamped.actions.reserve(rule.actions.size());
+    for (const ActionSpec &action : rule.actions) {
+      ActionSpec stamped_action;
+      stamped_action.device = sub.text(action.device, where);
+      stamped_action.function = sub.text(action.function, where);
+      for (const auto &[key, arg] : action.args) {
+        const auto *str = std::get_if<std::string>(&arg);
+        stamped_action.args.emplace(
+            key, str != nullptr ? Variant(sub.text(*str, where)) : arg);
+      }
+      stamped.actions.push_back(std::move(stamped_action));
+    }
+    out.rules.push_back(std::move(stamped));
+  }
+}
+
+} // namespace
+
+GraphSpec expand_templates(const GraphSpec &spec) {
+  // Validate each template once by stamping it with its defaults
+  std::unordered_map<std::string, const GraphTemplateSpec *> templates;
+  const std::string no_prefix;
+  for (size_t i = 0; i < spec.templates.size(); ++i) {
+    const GraphTemplateSpec &tmpl = spec.templates[i];
+    if (tmpl.name.empty()) {
+      throw std::runtime_error("GraphCompiler: templates[" +
+                               std::to_string(i) + "].name must be non-empty");
+    }
+    if (!templates.emplace(tmpl.name, &tmpl).second) {
+      throw std::runtime_error("GraphCompiler: duplicate template name '" +
+                               tmpl.name + "'");
+    }
+    if (tmpl.params.count(std::string(kPrefixPlaceholder)) > 0) {
+      throw std::runtime_error("GraphCompiler: template '" + tmpl.name +
+                               "' declares reserved parameter 'prefix'");
+    }
+    GraphSpec scratch;
+    stamp(tmpl, Substitution(tmpl, no_prefix, tmpl.params), scratch);
+  }
+
+  size_t signal_count = spec.signals.size();
+  size_t model_count = spec.models.size();
+  size_t edge_count = spec.edges.size();
+  size_t rule_count = spec.rules.size();
+  for (const TemplateInstanceSpec &instance : spec.instances) {
+    if (const auto it = templates.find(instance.template_name);
+        it != templates.end()) {
+      signal_count += it->second->signals.size();
+      model_count += it->second->models.size();
+      edge_count += it->second->edges.size();
+      rule_count += it->second->rules.size();
+    }
+  }
+  GraphSpec out;
+  out.signals.reserve(signal_count);
+  out.models.reserve(model_count);
+  out.edges.reserve(edge_count);
+  out.rules.reserve(rule_count);
+  out.signals.insert(out.signals.end(), spec.signals.begin(),
+                     spec.signals.end());
+  out.models.insert(out.models.end(), spec.models.begin(), spec.models.end());
+  out.edges.insert(out.edges.end(), spec.edges.begin(), spec.edges.end());
+  out.rules.insert(out.rules.end(), spec.rules.begin(), spec.rules.end());
+
+  std::set<std::pair<std::string, std::string>> stamped;
+  for (size_t i = 0; i < spec.instances.size(); ++i) {
+    const TemplateInstanceSpec &instance = spec.instances[i];
+    const std::string context = "instances[" + std::to_string(i) + "]";
+    const auto it = templates.find(instance.template_name);
+    if (it == templates.end()) {
+      throw std::runtime_error("GraphCompiler: " + context +
+                               " references unknown template '" +
+                               instance.template_name + "'");
+    }
+    const GraphTemplateSpec &tmpl = *it->second;
+    if (instance.prefix.empty()) {
+      throw std::runtime_error("GraphCompiler: " + context +
+                               ".prefix must be non-empty");
+    }
+    if (!stamped.emplace(tmpl.name, instance.prefix).second) {
+      throw std::runtime_error("GraphCompiler: template '" + tmpl.name +
+                               "' instantiated twice with prefix '" +
+                               instance.prefix + "'");
+    }
+
+    ParamMap values = tmpl.params;
+    for (const auto &[key, value] : instance.params) {
+      const auto declared = values.find(key);
+      if (declared == values.end()) {
+        throw std::runtime_error("GraphCompiler: " + context +
+                                 " overrides undeclared parameter '" + key +
+                                 "' of template '" + tmpl.name + "'");
+      }
+      declared->second = value;
+    }
+    stamp(tmpl, Substitution(tmpl, instance.prefix, values), out);
+  }
+  return out;
+}
+
+} // namespace fluxgraph
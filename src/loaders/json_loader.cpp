@@ -1,6 +1,7 @@
 #ifdef FLUXGRAPH_JSON_ENABLED
 
 #include "fluxgraph/loaders/json_loader.hpp"
+#include "param_packing.hpp"
 #include "param_parse_limits.hpp"
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -12,7 +13,55 @@ namespace fluxgraph::loaders {
 
 namespace {
 
-ParamValue json_to_param_value(const json &j, const std::string &path,
+// Packs an all-numeric array or rectangular numeric matrix. Nodes are
+// consumed in the same order as the nested walk, so limit errors match;
+// returns false without reporting when the array is not packable.
+bool pack_numbers(const json &j, const detail::ParamPath &path,
+                  detail::ParamParseBudget &budget, size_t depth,
+                  ParamNumbers &out) {
+  const bool matrix = j[0].is_array();
+  const size_t columns = matrix ? j[0].size() : 0;
+  if (matrix && columns == 0) {
+    return false;
+  }
+  detail::NumericPacker packer(matrix ? j.size() * columns : j.size());
+  auto add_leaf = [&](const json &leaf, const detail::ParamPath &leaf_path,
+                      size_t leaf_depth) {
+    budget.check_depth(leaf_depth, leaf_path);
+    budget.consume_node(leaf_path);
+    if (leaf.is_number_float()) {
+      packer.add_double(leaf.get<double>());
+      return true;
+    }
+    return leaf.is_number_integer() && packer.add_int(leaf.get<int64_t>());
+  };
+
+  for (size_t i = 0; i < j.size(); ++i) {
+    const detail::ParamPath item_path(path, i);
+    if (!matrix) {
+      if (!add_leaf(j[i], item_path, depth + 1)) {
+        return false;
+      }
+      continue;
+    }
+    const json &row = j[i];
+    if (!row.is_array() || row.size() != columns) {
+      return false;
+    }
+    budget.check_depth(depth + 1, item_path);
+    budget.consume_node(item_path);
+    detail::check_array_size(columns, item_path);
+    for (size_t k = 0; k < columns; ++k) {
+      if (!add_leaf(row[k], detail::ParamPath(item_path, k), depth + 2)) {
+        return false;
+      }
+    }
+  }
+  out = packer.finish(columns);
+  return true;
+}
+
+ParamValue json_to_param_value(const json &j, const detail::ParamPath &path,
                                detail::ParamParseBudget &budget,
                                size_t depth = 0) {
   budget.check_depth(depth, path);
@@ -30,25 +79,32 @@ ParamValue json_to_param_value(const json &j, const std::string &path,
     return value;
   } else if (j.is_array()) {
     detail::check_array_size(j.size(), path);
+    if (!j.empty()) {
+      const size_t nodes_before = budget.nodes;
+      ParamNumbers packed;
+      if (pack_numbers(j, path, budget, depth, packed)) {
+        return packed;
+      }
+      budget.nodes = nodes_before;
+    }
     ParamArray arr;
     arr.reserve(j.size());
     for (size_t i = 0; i < j.size(); ++i) {
-      arr.push_back(
-          json_to_param_value(j[i], path + "/" + std::to_string(i), budget,
-                              depth + 1));
+      arr.push_back(json_to_param_value(j[i], detail::ParamPath(path, i),
+                                        budget, depth + 1));
     }
     return arr;
   } else if (j.is_object()) {
     detail::check_object_size(j.size(), path);
     ParamObject obj;
     for (auto &[key, value] : j.items()) {
-      detail::check_string_size(key.size(), path + "/<key>");
-      obj.emplace(key, json_to_param_value(value, path + "/" + key, budget,
-                                           depth + 1));
+      detail::check_string_size(key.size(), detail::ParamPath(path, "<key>"));
+      obj.emplace(key, json_to_param_value(value, detail::ParamPath(path, key),
+                                           budget, depth + 1));
     }
     return obj;
   } else {
-    throw std::runtime_error("Parameter parse error at " + path +
+    throw std::runtime_error("Parameter parse error at " + path.str() +
                              ": Unsupported JSON type");
   }
 }
@@ -70,6 +126,23 @@ Variant json_to_variant(const json &j, const std::string &path) {
   }
 }
 
+// Parse the `params` object of the entry at path
+ParamMap parse_params(const json &j, const std::string &path,
+                      detail::ParamParseBudget &budget) {
+  if (!j.is_object()) {
+    throw std::runtime_error("JSON parse error at " + path +
+                             "/params: Expected object");
+  }
+  ParamMap params;
+  const std::string params_root = path + "/params";
+  const detail::ParamPath params_path(params_root);
+  for (auto &[key, value] : j.items()) {
+    params[key] =
+        json_to_param_value(value, detail::ParamPath(params_path, key), budget);
+  }
+  return params;
+}
+
 // Parse transform specification
 TransformSpec parse_transform(const json &j, const std::string &base_path,
                               detail::ParamParseBudget &budget) {
@@ -85,14 +158,7 @@ TransformSpec parse_transform(const json &j, const std::string &base_path,
   spec.type = j["type"].get<std::string>();
 
   if (j.contains("params")) {
-    if (!j["params"].is_object()) {
-      throw std::runtime_error("JSON parse error at " + path +
-                               "/params: Expected object");
-    }
-    for (auto &[key, value] : j["params"].items()) {
-      std::string param_path = path + "/params/" + key;
-      spec.params[key] = json_to_param_value(value, param_path, budget);
-    }
+    spec.params = parse_params(j["params"], path, budget);
   }
 
   return spec;
@@ -168,14 +234,7 @@ ModelSpec parse_model(const json &j, const std::string &base_path,
   spec.type = j["type"].get<std::string>();
 
   if (j.contains("params")) {
-    if (!j["params"].is_object()) {
-      throw std::runtime_error("JSON parse error at " + path +
-                               "/params: Expected object");
-    }
-    for (auto &[key, value] : j["params"].items()) {
-      std::string param_path = path + "/params/" + key;
-      spec.params[key] = json_to_param_value(value, param_path, budget);
-    }
+    spec.params = parse_params(j["params"], path, budget);
   }
 
   return spec;
@@ -242,6 +301,71 @@ RuleSpec parse_rule(const json &j, const std::string &base_path, size_t index) {
   return spec;
 }
 
+// Parse subgraph template
+GraphTemplateSpec parse_template(const json &j, size_t index,
+                                 detail::ParamParseBudget &budget) {
+  const std::string path = "/templates/" + std::to_string(index);
+  GraphTemplateSpec spec;
+
+  if (!j.contains("name")) {
+    throw std::runtime_error("JSON parse error at " + path +
+                             ": Missing required field 'name'");
+  }
+  spec.name = j["name"].get<std::string>();
+  if (j.contains("params")) {
+    spec.params = parse_params(j["params"], path, budget);
+  }
+
+  if (j.contains("signals") && j["signals"].is_array()) {
+    size_t i = 0;
+    for (const auto &signal_json : j["signals"]) {
+      spec.signals.push_back(parse_signal(signal_json, path + "/signals", i++));
+    }
+  }
+  if (j.contains("models") && j["models"].is_array()) {
+    size_t i = 0;
+    for (const auto &model_json : j["models"]) {
+      spec.models.push_back(
+          parse_model(model_json, path + "/models", i++, budget));
+    }
+  }
+  if (j.contains("edges") && j["edges"].is_array()) {
+    size_t i = 0;
+    for (const auto &edge_json : j["edges"]) {
+      spec.edges.push_back(parse_edge(edge_json, path + "/edges", i++, budget));
+    }
+  }
+  if (j.contains("rules") && j["rules"].is_array()) {
+    size_t i = 0;
+    for (const auto &rule_json : j["rules"]) {
+      spec.rules.push_back(parse_rule(rule_json, path + "/rules", i++));
+    }
+  }
+  return spec;
+}
+
+// Parse template instantiation
+TemplateInstanceSpec parse_instance(const json &j, size_t index,
+                                    detail::ParamParseBudget &budget) {
+  const std::string path = "/instances/" + std::to_string(index);
+  TemplateInstanceSpec spec;
+
+  if (!j.contains("template")) {
+    throw std::runtime_error("JSON parse error at " + path +
+                             ": Missing required field 'template'");
+  }
+  if (!j.contains("prefix")) {
+    throw std::runtime_error("JSON parse error at " + path +
+                             ": Missing required field 'prefix'");
+  }
+  spec.template_name = j["template"].get<std::string>();
+  spec.prefix = j["prefix"].get<std::string>();
+  if (j.contains("params")) {
+    spec.params = parse_params(j["params"], path, budget);
+  }
+  return spec;
+}
+
 // Parse complete GraphSpec from JSON
 GraphSpec parse_json(const json &j) {
   GraphSpec spec;
@@ -281,6 +405,22 @@ GraphSpec parse_json(const json &j) {
     }
   }
 
+  // Parse subgraph templates and their instances (optional)
+  if (j.contains("templates") && j["templates"].is_array()) {
+    size_t index = 0;
+    for (const auto &template_json : j["templates"]) {
+      spec.templates.push_back(
+          parse_template(template_json, index++, param_budget));
+    }
+  }
+  if (j.contains("instances") && j["instances"].is_array()) {
+    size_t index = 0;
+    for (const auto &instance_json : j["instances"]) {
+      spec.instances.push_back(
+          parse_instance(instance_json, index++, param_budget));
+    }
+  }
+
   return spec;
 }
 
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "fluxgraph/core/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace fluxgraph::loaders::detail {
+
+/// Collects the leaves of an all-numeric array (or rectangular matrix of
+/// them) into one ParamNumbers. Loaders feed leaves in document order and
+/// fall back to a nested ParamArray when a leaf is not a number, a row is
+/// ragged, or an integer would not survive the round trip through double.
+class NumericPacker {
+public:
+  explicit NumericPacker(size_t expected) { out_.values.reserve(expected); }
+
+  bool add_int(int64_t value) {
+    constexpr int64_t kMaxExact = int64_t{1} << 53;
+    if (value > kMaxExact || value < -kMaxExact) {
+      return false;
+    }
+    out_.values.push_back(static_cast<double>(value));
+    return true;
+  }
+
+  void add_double(double value) {
+    out_.values.push_back(value);
+    any_double_ = true;
+  }
+
+  ParamNumbers finish(size_t columns) {
+    out_.columns = columns;
+    out_.integral = !any_double_;
+    return std::move(out_);
+  }
+
+private:
+  ParamNumbers out_;
+  bool any_double_ = false;
+};
+
+} // namespace fluxgraph::loaders::detail
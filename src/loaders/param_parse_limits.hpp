@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace fluxgraph::loaders::detail {
 
@@ -14,22 +15,51 @@ struct ParamParseLimits {
   static constexpr size_t kMaxStringBytes = 1 << 20; // 1 MiB
 };
 
+/// Location of the value being parsed, rendered as a string only when an
+/// error is reported. Each level lives on the parser's stack and points at
+/// its parent, so descending costs no allocation.
+class ParamPath {
+public:
+  /// Root segment; the viewed string must outlive the path
+  explicit ParamPath(std::string_view root) : root_(root) {}
+  ParamPath(const ParamPath &parent, std::string_view key)
+      : parent_(&parent), root_(key) {}
+  ParamPath(const ParamPath &parent, size_t index)
+      : parent_(&parent), index_(index), is_index_(true) {}
+
+  std::string str() const {
+    std::string out = parent_ != nullptr ? parent_->str() + "/" : "";
+    if (is_index_) {
+      out += std::to_string(index_);
+    } else {
+      out += root_;
+    }
+    return out;
+  }
+
+private:
+  const ParamPath *parent_ = nullptr;
+  std::string_view root_; ///< Root text, or this level's key
+  size_t index_ = 0;
+  bool is_index_ = false;
+};
+
 struct ParamParseBudget {
   size_t nodes = 0;
 
-  void consume_node(const std::string &path) {
+  void consume_node(const ParamPath &path) {
     ++nodes;
     if (nodes > ParamParseLimits::kMaxNodes) {
-      throw std::runtime_error("Parameter parse error at " + path +
+      throw std::runtime_error("Parameter parse error at " + path.str() +
                                ": node count exceeds limit (" +
                                std::to_string(ParamParseLimits::kMaxNodes) +
                                ")");
     }
   }
 
-  void check_depth(size_t depth, const std::string &path) const {
+  void check_depth(size_t depth, const ParamPath &path) const {
     if (depth > ParamParseLimits::kMaxDepth) {
-      throw std::runtime_error("Parameter parse error at " + path +
+      throw std::runtime_error("Parameter parse error at " + path.str() +
                                ": nesting depth exceeds limit (" +
                                std::to_string(ParamParseLimits::kMaxDepth) +
                                ")");
@@ -37,27 +67,27 @@ struct ParamParseBudget {
   }
 };
 
-inline void check_object_size(size_t size, const std::string &path) {
+inline void check_object_size(size_t size, const ParamPath &path) {
   if (size > ParamParseLimits::kMaxObjectMembers) {
-    throw std::runtime_error("Parameter parse error at " + path +
+    throw std::runtime_error("Parameter parse error at " + path.str() +
                              ": object member count exceeds limit (" +
                              std::to_string(ParamParseLimits::kMaxObjectMembers) +
                              ")");
   }
 }
 
-inline void check_array_size(size_t size, const std::string &path) {
+inline void check_array_size(size_t size, const ParamPath &path) {
   if (size > ParamParseLimits::kMaxArrayElements) {
-    throw std::runtime_error("Parameter parse error at " + path +
+    throw std::runtime_error("Parameter parse error at " + path.str() +
                              ": array length exceeds limit (" +
                              std::to_string(ParamParseLimits::kMaxArrayElements) +
                              ")");
   }
 }
 
-inline void check_string_size(size_t size, const std::string &path) {
+inline void check_string_size(size_t size, const ParamPath &path) {
   if (size > ParamParseLimits::kMaxStringBytes) {
-    throw std::runtime_error("Parameter parse error at " + path +
+    throw std::runtime_error("Parameter parse error at " + path.str() +
                              ": string length exceeds limit (" +
                              std::to_string(ParamParseLimits::kMaxStringBytes) +
                              " bytes)");
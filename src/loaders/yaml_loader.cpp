@@ -1,13 +1,20 @@
 #ifdef FLUXGRAPH_YAML_ENABLED
 
 #include "fluxgraph/loaders/yaml_loader.hpp"
+#include "param_packing.hpp"
 #include "param_parse_limits.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <yaml-cpp/yaml.h>
 
 namespace fluxgraph::loaders {
@@ -53,14 +60,75 @@ bool parse_double_strict(const std::string &text, double &out) {
   return true;
 }
 
-ParamValue yaml_to_param_value(const YAML::Node &node, const std::string &path,
+// Packs an all-numeric sequence or rectangular numeric matrix. Nodes are
+// consumed in the same order as the nested walk, so limit errors match;
+// returns false without reporting when the sequence is not packable.
+bool pack_numbers(const YAML::Node &node, const detail::ParamPath &path,
+                  detail::ParamParseBudget &budget, size_t depth,
+                  ParamNumbers &out) {
+  const YAML::Node first = *node.begin();
+  const bool matrix = first.IsSequence();
+  const size_t columns = matrix ? first.size() : 0;
+  if (matrix && columns == 0) {
+    return false;
+  }
+  detail::NumericPacker packer(matrix ? node.size() * columns : node.size());
+  auto add_leaf = [&](const YAML::Node &leaf,
+                      const detail::ParamPath &leaf_path, size_t leaf_depth) {
+    budget.check_depth(leaf_depth, leaf_path);
+    budget.consume_node(leaf_path);
+    if (!leaf.IsScalar()) {
+      return false;
+    }
+    const std::string &scalar = leaf.Scalar();
+    detail::check_string_size(scalar.size(), leaf_path);
+    int64_t int_val = 0;
+    if (parse_int64_strict(scalar, int_val)) {
+      return packer.add_int(int_val);
+    }
+    double double_val = 0.0;
+    if (parse_double_strict(scalar, double_val)) {
+      packer.add_double(double_val);
+      return true;
+    }
+    return false;
+  };
+
+  size_t i = 0;
+  for (const YAML::Node &item : node) {
+    const detail::ParamPath item_path(path, i++);
+    if (!matrix) {
+      if (!add_leaf(item, item_path, depth + 1)) {
+        return false;
+      }
+      continue;
+    }
+    if (!item.IsSequence() || item.size() != columns) {
+      return false;
+    }
+    budget.check_depth(depth + 1, item_path);
+    budget.consume_node(item_path);
+    detail::check_array_size(columns, item_path);
+    size_t k = 0;
+    for (const YAML::Node &leaf : item) {
+      if (!add_leaf(leaf, detail::ParamPath(item_path, k++), depth + 2)) {
+        return false;
+      }
+    }
+  }
+  out = packer.finish(columns);
+  return true;
+}
+
+ParamValue yaml_to_param_value(const YAML::Node &node,
+                               const detail::ParamPath &path,
                                detail::ParamParseBudget &budget,
                                size_t depth = 0) {
   budget.check_depth(depth, path);
   budget.consume_node(path);
 
   if (node.IsScalar()) {
-    const std::string scalar = node.as<std::string>();
+    const std::string &scalar = node.Scalar();
     detail::check_string_size(scalar.size(), path);
     if (scalar == "true") {
       return true;
@@ -84,11 +152,21 @@ ParamValue yaml_to_param_value(const YAML::Node &node, const std::string &path,
 
   if (node.IsSequence()) {
     detail::check_array_size(node.size(), path);
+    if (node.size() > 0) {
+      const size_t nodes_before = budget.nodes;
+      ParamNumbers packed;
+      if (pack_numbers(node, path, budget, depth, packed)) {
+        return packed;
+      }
+      budget.nodes = nodes_before;
+    }
     ParamArray arr;
     arr.reserve(node.size());
-    for (size_t i = 0; i < node.size(); ++i) {
-      arr.push_back(yaml_to_param_value(node[i], path + "/" + std::to_string(i),
+    size_t i = 0;
+    for (const YAML::Node &item : node) {
+      arr.push_back(yaml_to_param_value(item, detail::ParamPath(path, i),
                                         budget, depth + 1));
+      ++i;
     }
     return arr;
   }
@@ -98,13 +176,14 @@ ParamValue yaml_to_param_value(const YAML::Node &node, const std::string &path,
     ParamObject obj;
     for (auto it = node.begin(); it != node.end(); ++it) {
       const std::string key = it->first.as<std::string>();
-      detail::check_string_size(key.size(), path + "/<key>");
-      obj.emplace(key, yaml_to_param_value(it->second, path + "/" + key,
+      detail::check_string_size(key.size(), detail::ParamPath(path, "<key>"));
+      obj.emplace(key, yaml_to_param_value(it->second,
+                                           detail::ParamPath(path, key),
                                            budget, depth + 1));
     }
     return obj;
   } else {
-    throw std::runtime_error("YAML parse error at " + path +
+    throw std::runtime_error("YAML parse error at " + path.str() +
                              ": Expected scalar/sequence/map value");
   }
 }
@@ -136,8 +215,27 @@ Variant yaml_to_variant(const YAML::Node &node, const std::string &path) {
   }
 }
 
+// Parse the `params` map of the entry at path
+ParamMap parse_params(const YAML::Node &node, const std::string &path,
+                      detail::ParamParseBudget &budget) {
+  if (!node.IsMap()) {
+    throw std::runtime_error("YAML parse error at " + path +
+                             "/params: Expected map");
+  }
+  ParamMap params;
+  const std::string params_root = path + "/params";
+  const detail::ParamPath params_path(params_root);
+  for (auto it = node.begin(); it != node.end(); ++it) {
+    const std::string key = it->first.as<std::string>();
+    params[key] = yaml_to_param_value(
+        it->second, detail::ParamPath(params_path, key), budget);
+  }
+  return params;
+}
+
 // Parse transform specification
-TransformSpec parse_transform(const YAML::Node &node, const std::string &base_path,
+TransformSpec parse_transform(const YAML::Node &node,
+                              const std::string &base_path,
                               detail::ParamParseBudget &budget) {
   TransformSpec spec;
 
@@ -151,24 +249,16 @@ TransformSpec parse_transform(const YAML::Node &node, const std::string &base_pa
   spec.type = node["type"].as<std::string>();
 
   if (node["params"]) {
-    if (!node["params"].IsMap()) {
-      throw std::runtime_error("YAML parse error at " + path +
-                               "/params: Expected map");
-    }
-    for (auto it = node["params"].begin(); it != node["params"].end(); ++it) {
-      std::string key = it->first.as<std::string>();
-      std::string param_path = path + "/params/" + key;
-      spec.params[key] = yaml_to_param_value(it->second, param_path, budget);
-    }
+    spec.params = parse_params(node["params"], path, budget);
   }
 
   return spec;
 }
 
 // Parse edge specification
-EdgeSpec parse_edge(const YAML::Node &node, size_t index,
-                    detail::ParamParseBudget &budget) {
-  std::string path = "/edges/" + std::to_string(index);
+EdgeSpec parse_edge(const YAML::Node &node, const std::string &base_path,
+                    size_t index, detail::ParamParseBudget &budget) {
+  std::string path = base_path + "/" + std::to_string(index);
   EdgeSpec spec;
 
   if (!node["source"]) {
@@ -195,8 +285,9 @@ EdgeSpec parse_edge(const YAML::Node &node, size_t index,
   return spec;
 }
 
-SignalSpec parse_signal(const YAML::Node &node, size_t index) {
-  const std::string path = "/signals/" + std::to_string(index);
+SignalSpec parse_signal(const YAML::Node &node, const std::string &base_path,
+                        size_t index) {
+  const std::string path = base_path + "/" + std::to_string(index);
   SignalSpec spec;
 
   if (!node["path"]) {
@@ -214,9 +305,9 @@ SignalSpec parse_signal(const YAML::Node &node, size_t index) {
 }
 
 // Parse model specification
-ModelSpec parse_model(const YAML::Node &node, size_t index,
-                      detail::ParamParseBudget &budget) {
-  std::string path = "/models/" + std::to_string(index);
+ModelSpec parse_model(const YAML::Node &node, const std::string &base_path,
+                      size_t index, detail::ParamParseBudget &budget) {
+  std::string path = base_path + "/" + std::to_string(index);
   ModelSpec spec;
 
   if (!node["id"]) {
@@ -232,23 +323,16 @@ ModelSpec parse_model(const YAML::Node &node, size_t index,
   spec.type = node["type"].as<std::string>();
 
   if (node["params"]) {
-    if (!node["params"].IsMap()) {
-      throw std::runtime_error("YAML parse error at " + path +
-                               "/params: Expected map");
-    }
-    for (auto it = node["params"].begin(); it != node["params"].end(); ++it) {
-      std::string key = it->first.as<std::string>();
-      std::string param_path = path + "/params/" + key;
-      spec.params[key] = yaml_to_param_value(it->second, param_path, budget);
-    }
+    spec.params = parse_params(node["params"], path, budget);
   }
 
   return spec;
 }
 
 // Parse rule specification
-RuleSpec parse_rule(const YAML::Node &node, size_t index) {
-  std::string path = "/rules/" + std::to_string(index);
+RuleSpec parse_rule(const YAML::Node &node, const std::string &base_path,
+                    size_t index) {
+  std::string path = base_path + "/" + std::to_string(index);
   RuleSpec spec;
 
   if (!node["id"]) {
@@ -308,51 +392,337 @@ RuleSpec parse_rule(const YAML::Node &node, size_t index) {
   return spec;
 }
 
-} // anonymous namespace
+// Append each entry of the list at node["key"] (if it is a sequence)
+template <typename Parse>
+void parse_list(const YAML::Node &node, const char *key,
+                const std::string &path, Parse parse) {
+  const YAML::Node list = node[key];
+  if (!list || !list.IsSequence()) {
+    return;
+  }
+  const std::string base_path = path + "/" + key;
+  size_t index = 0;
+  for (const auto &item : list) {
+    parse(item, base_path, index);
+    ++index;
+  }
+}
 
-GraphSpec load_yaml_string(const std::string &yaml_content) {
-  GraphSpec spec;
-  detail::ParamParseBudget param_budget;
+// Parse subgraph template
+GraphTemplateSpec parse_template(const YAML::Node &node, size_t index,
+                                 detail::ParamParseBudget &budget) {
+  const std::string path = "/templates/" + std::to_string(index);
+  GraphTemplateSpec spec;
 
-  try {
-    YAML::Node root = YAML::Load(yaml_content);
-
-    // Parse signals array
-    if (root["signals"] && root["signals"].IsSequence()) {
-      size_t index = 0;
-      for (const auto &signal_node : root["signals"]) {
-        spec.signals.push_back(parse_signal(signal_node, index));
-        ++index;
+  if (!node["name"]) {
+    throw std::runtime_error("YAML parse error at " + path +
+                             ": Missing required field 'name'");
+  }
+  spec.name = node["name"].as<std::string>();
+  if (node["params"]) {
+    spec.params = parse_params(node["params"], path, budget);
+  }
+
+  parse_list(node, "signals", path,
+             [&](const YAML::Node &item, const std::string &base, size_t i) {
+               spec.signals.push_back(parse_signal(item, base, i));
+             });
+  parse_list(node, "models", path,
+             [&](const YAML::Node &item, const std::string &base, size_t i) {
+               spec.models.push_back(parse_model(item, base, i, budget));
+             });
+  parse_list(node, "edges", path,
+             [&](const YAML::Node &item, const std::string &base, size_t i) {
+               spec.edges.push_back(parse_edge(item, base, i, budget));
+             });
+  parse_list(node, "rules", path,
+             [&](const YAML::Node &item, const std::string &base, size_t i) {
+               spec.rules.push_back(parse_rule(item, base, i));
+             });
+  return spec;
+}
+
+// Parse template instantiation
+TemplateInstanceSpec parse_instance(const YAML::Node &node, size_t index,
+                                    detail::ParamParseBudget &budget) {
+  const std::string path = "/instances/" + std::to_string(index);
+  TemplateInstanceSpec spec;
+
+  if (!node["template"]) {
+    throw std::runtime_error("YAML parse error at " + path +
+                             ": Missing required field 'template'");
+  }
+  if (!node["prefix"]) {
+    throw std::runtime_error("YAML parse error at " + path +
+                             ": Missing required field 'prefix'");
+  }
+  spec.template_name = node["template"].as<std::string>();
+  spec.prefix = node["prefix"].as<std::string>();
+  if (node["params"]) {
+    spec.params = parse_params(node["params"], path, budget);
+  }
+  return spec;
+}
+
+// Top-level sections, in the order they are parsed
+constexpr std::string_view kSections[] = {
+    "signals", "edges", "models", "rules", "templates", "instances"};
+
+// Append the entries of one top-level section; first_index numbers them
+// when root holds only part of the section's list
+void parse_section(const YAML::Node &root, size_t section, size_t first_index,
+                   GraphSpec &spec, detail::ParamParseBudget &budget) {
+  const YAML::Node list = root[std::string(kSections[section])];
+  if (!list || !list.IsSequence()) {
+    return;
+  }
+  size_t index = first_index;
+  for (const auto &node : list) {
+    switch (section) {
+    case 0:
+      spec.signals.push_back(parse_signal(node, "/signals", index));
+      break;
+    case 1:
+      spec.edges.push_back(parse_edge(node, "/edges", index, budget));
+      break;
+    case 2:
+      spec.models.push_back(parse_model(node, "/models", index, budget));
+      break;
+    case 3:
+      spec.rules.push_back(parse_rule(node, "/rules", index));
+      break;
+    case 4:
+      spec.templates.push_back(parse_template(node, index, budget));
+      break;
+    default:
+      spec.instances.push_back(parse_instance(node, index, budget));
+      break;
+    }
+    ++index;
+  }
+}
+
+// Standalone document holding one section, or a run of its list items
+struct YamlPiece {
+  size_t section = 0;
+  size_t first_index = 0;
+  std::string text;
+};
+
+bool is_blank_or_comment(std::string_view line) {
+  const size_t first = line.find_first_not_of(" \r");
+  return first == std::string_view::npos || line[first] == '#';
+}
+
+bool is_list_item(std::string_view line, size_t indent) {
+  return line.size() > indent && line[indent] == '-' &&
+         (line.size() == indent + 1 || line[indent + 1] == ' ' ||
+          line[indent + 1] == '\r');
+}
+
+// Section index if line is `<section>:` (optionally followed by a comment)
+size_t match_section_header(std::string_view line, bool &inline_value) {
+  for (size_t section = 0; section < std::size(kSections); ++section) {
+    const std::string_view name = kSections[section];
+    if (line.size() > name.size() && line.compare(0, name.size(), name) == 0 &&
+        line[name.size()] == ':') {
+      const std::string_view rest = line.substr(name.size() + 1);
+      if (!rest.empty() && rest[0] != ' ' && rest[0] != '\r') {
+        continue; // e.g. "edges:x" is another key
       }
+      inline_value = !is_blank_or_comment(rest);
+      return section;
     }
+  }
+  return std::size(kSections);
+}
 
-    // Parse edges array
-    if (root["edges"] && root["edges"].IsSequence()) {
-      size_t index = 0;
-      for (const auto &edge_node : root["edges"]) {
-        spec.edges.push_back(parse_edge(edge_node, index, param_budget));
-        ++index;
+// Split a block-style document into pieces of roughly target_bytes. Returns
+// false for layouts that are not plainly splittable; a piece that still
+// fails to parse makes the caller fall back to a whole-document load.
+bool split_document(const std::string &content, size_t target_bytes,
+                    std::vector<YamlPiece> &pieces) {
+  struct SectionRange {
+    size_t section;
+    size_t header;     // Offset of the header line
+    size_t body;       // Offset just past the header line
+    size_t end;        // Offset past the section's last line
+    bool splittable;   // Body is a block list at one indentation
+    size_t indent;     // Indentation of the list's items
+    std::vector<size_t> items; // Offsets of item lines
+  };
+
+  std::vector<SectionRange> sections;
+  bool seen[std::size(kSections)] = {};
+  bool indent_known = false;
+  size_t pos = 0;
+  while (pos < content.size()) {
+    const size_t line_begin = pos;
+    const size_t newline = content.find('\n', pos);
+    const size_t line_end =
+        newline == std::string::npos ? content.size() : newline;
+    pos = newline == std::string::npos ? content.size() : newline + 1;
+    const std::string_view line(content.data() + line_begin,
+                                line_end - line_begin);
+    if (line.find('\t') != std::string_view::npos) {
+      return false;
+    }
+    if (is_blank_or_comment(line)) {
+      continue;
+    }
+
+    if (line[0] != ' ' && !(is_list_item(line, 0) && !sections.empty())) {
+      bool inline_value = false;
+      const size_t section = match_section_header(line, inline_value);
+      if (section == std::size(kSections) || seen[section]) {
+        return false; // Unknown, repeated or non-key top-level content
       }
+      seen[section] = true;
+      if (!sections.empty()) {
+        sections.back().end = line_begin;
+      }
+      sections.push_back(SectionRange{section, line_begin, pos, 0,
+                                      !inline_value, 0, {}});
+      indent_known = false;
+      continue;
+    }
+    if (sections.empty()) {
+      return false;
     }
 
-    // Parse models array
-    if (root["models"] && root["models"].IsSequence()) {
-      size_t index = 0;
-      for (const auto &model_node : root["models"]) {
-        spec.models.push_back(parse_model(model_node, index, param_budget));
-        ++index;
+    SectionRange &current = sections.back();
+    if (!current.splittable) {
+      continue;
+    }
+    const size_t indent = line.find_first_not_of(' ');
+    if (!indent_known) {
+      indent_known = true;
+      current.indent = indent;
+    }
+    if (indent == current.indent && is_list_item(line, indent)) {
+      current.items.push_back(line_begin);
+    } else if (indent <= current.indent) {
+      current.splittable = false;
+    }
+  }
+  if (sections.empty()) {
+    return false;
+  }
+  sections.back().end = content.size();
+
+  for (const SectionRange &range : sections) {
+    if (!range.splittable || range.items.size() < 2) {
+      pieces.push_back(YamlPiece{
+          range.section, 0,
+          content.substr(range.header, range.end - range.header)});
+      continue;
+    }
+    const std::string header = std::string(kSections[range.section]) + ":\n";
+    size_t first_item = 0;
+    size_t begin = range.body;
+    for (size_t item = 1; item <= range.items.size(); ++item) {
+      const size_t end =
+          item == range.items.size() ? range.end : range.items[item];
+      if (end - begin < target_bytes && item != range.items.size()) {
+        continue;
       }
+      pieces.push_back(YamlPiece{range.section, first_item,
+                                 header + content.substr(begin, end - begin)});
+      first_item = item;
+      begin = end;
     }
+  }
+  return true;
+}
+
+// Parse split pieces on worker threads; false means "load sequentially"
+bool load_parallel(const std::string &content, unsigned threads,
+                   GraphSpec &spec) {
+  std::vector<YamlPiece> pieces;
+  const size_t target_bytes =
+      std::max<size_t>(16 * 1024, content.size() / (threads * 4));
+  if (!split_document(content, target_bytes, pieces) || pieces.size() < 2) {
+    return false;
+  }
 
-    // Parse rules array
-    if (root["rules"] && root["rules"].IsSequence()) {
-      size_t index = 0;
-      for (const auto &rule_node : root["rules"]) {
-        spec.rules.push_back(parse_rule(rule_node, index));
-        ++index;
+  std::vector<GraphSpec> partial(pieces.size());
+  std::vector<detail::ParamParseBudget> budgets(pieces.size());
+  std::vector<std::exception_ptr> errors(pieces.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < pieces.size(); i = next++) {
+      try {
+        const YAML::Node root = YAML::Load(pieces[i].text);
+        parse_section(root, pieces[i].section, pieces[i].first_index,
+                      partial[i], budgets[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
       }
     }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t worker_count = std::min<size_t>(threads, pieces.size());
+  workers.reserve(worker_count - 1);
+  for (size_t t = 1; t < worker_count; ++t) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (std::thread &thread : workers) {
+    thread.join();
+  }
+
+  // The node budget spans the whole document
+  size_t nodes = 0;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    if (errors[i]) {
+      return false;
+    }
+    nodes += budgets[i].nodes;
+  }
+  if (nodes > detail::ParamParseLimits::kMaxNodes) {
+    return false;
+  }
 
+  for (GraphSpec &part : partial) {
+    std::move(part.signals.begin(), part.signals.end(),
+              std::back_inserter(spec.signals));
+    std::move(part.edges.begin(), part.edges.end(),
+              std::back_inserter(spec.edges));
+    std::move(part.models.begin(), part.models.end(),
+              std::back_inserter(spec.models));
+    std::move(part.rules.begin(), part.rules.end(),
+              std::back_inserter(spec.rules));
+    std::move(part.templates.begin(), part.templates.end(),
+              std::back_inserter(spec.templates));
+    std::move(part.instances.begin(), part.instances.end(),
+              std::back_inserter(spec.instances));
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+GraphSpec load_yaml_string(const std::string &yaml_content,
+                           const YamlLoadOptions &options) {
+  const unsigned threads =
+      options.threads != 0 ? options.threads
+                           : std::max(1U, std::thread::hardware_concurrency());
+  if (threads > 1 && yaml_content.size() >= options.parallel_min_bytes) {
+    GraphSpec spec;
+    if (load_parallel(yaml_content, threads, spec)) {
+      return spec;
+    }
+  }
+
+  GraphSpec spec;
+  detail::ParamParseBudget param_budget;
+
+  try {
+    const YAML::Node root = YAML::Load(yaml_content);
+    for (size_t section = 0; section < std::size(kSections); ++section) {
+      parse_section(root, section, 0, spec, param_budget);
+    }
   } catch (const YAML::ParserException &e) {
     throw std::runtime_error(format_yaml_error(e.msg, e.mark));
   } catch (const YAML::Exception &e) {
@@ -362,7 +732,8 @@ GraphSpec load_yaml_string(const std::string &yaml_content) {
   return spec;
 }
 
-GraphSpec load_yaml_file(const std::string &path) {
+GraphSpec load_yaml_file(const std::string &path,
+                         const YamlLoadOptions &options) {
   std::ifstream file(path);
   if (!file.is_open()) {
     throw std::runtime_error("Cannot open YAML file: " + path);
@@ -372,7 +743,7 @@ GraphSpec load_yaml_file(const std::string &path) {
   buffer << file.rdbuf();
 
   try {
-    return load_yaml_string(buffer.str());
+    return load_yaml_string(buffer.str(), options);
   } catch (const std::exception &e) {
     throw std::runtime_error("Error loading YAML file '" + path +
                              "': " + e.what());
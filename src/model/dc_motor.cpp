@@ -172,4 +172,9 @@ std::vector<SignalId> DcMotorModel::output_signal_ids() const {
   return {speed_signal_, current_signal_, torque_signal_};
 }
 
+void DcMotorModel::hash_state(StateHasher &hasher) const {
+  hasher.add(i_);
+  hasher.add(omega_);
+}
+
 } // namespace fluxgraph
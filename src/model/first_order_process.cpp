@@ -37,22 +37,10 @@ FirstOrderProcessModel::FirstOrderProcessModel(
   }
 }
 
-double FirstOrderProcessModel::derivative(double y, double u) const {
-  return (gain_ * u - y) / tau_s_;
-}
-
 void FirstOrderProcessModel::tick(double dt, SignalStore &store) {
   const double u = store.read_value(input_signal_);
 
-  if (integration_method_ == IntegrationMethod::ForwardEuler) {
-    output_ += derivative(output_, u) * dt;
-  } else {
-    const double k1 = derivative(output_, u);
-    const double k2 = derivative(output_ + 0.5 * dt * k1, u);
-    const double k3 = derivative(output_ + 0.5 * dt * k2, u);
-    const double k4 = derivative(output_ + dt * k3, u);
-    output_ += (dt / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
-  }
+  output_ = step(output_, u, gain_, tau_s_, dt, integration_method_);
 
   store.write(output_signal_, output_, "dimensionless");
   store.mark_physics_driven(output_signal_, true);
@@ -63,13 +51,10 @@ void FirstOrderProcessModel::reset() { output_ = initial_output_; }
 double FirstOrderProcessModel::compute_stability_limit() const {
   // For dy/dt = -y/tau + ..., lambda = -1/tau.
   const double lambda_mag = 1.0 / tau_s_;
-  const double limit = (integration_method_ == IntegrationMethod::Rk4)
-                           ? kRk4NegativeRealAxisStabilityLimit
-                           : 2.0;
   if (!(lambda_mag > 0.0)) {
     return std::numeric_limits<double>::infinity();
   }
-  return limit / lambda_mag;
+  return stability_limit(tau_s_, integration_method_);
 }
 
 std::string FirstOrderProcessModel::describe() const {
@@ -84,4 +69,8 @@ std::vector<SignalId> FirstOrderProcessModel::output_signal_ids() const {
   return {output_signal_};
 }
 
+void FirstOrderProcessModel::hash_state(StateHasher &hasher) const {
+  hasher.add(output_);
+}
+
 } // namespace fluxgraph
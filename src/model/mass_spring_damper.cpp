@@ -138,4 +138,9 @@ std::vector<SignalId> MassSpringDamperModel::output_signal_ids() const {
   return {position_signal_, velocity_signal_};
 }
 
+void MassSpringDamperModel::hash_state(StateHasher &hasher) const {
+  hasher.add(x_);
+  hasher.add(v_);
+}
+
 } // namespace fluxgraph
@@ -128,4 +128,9 @@ std::vector<SignalId> SecondOrderProcessModel::output_signal_ids() const {
   return {output_signal_};
 }
 
+void SecondOrderProcessModel::hash_state(StateHasher &hasher) const {
+  hasher.add(y_);
+  hasher.add(y_dot_);
+}
+
 } // namespace fluxgraph
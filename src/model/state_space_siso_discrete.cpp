@@ -36,15 +36,30 @@ StateSpaceSisoDiscreteModel::StateSpaceSisoDiscreteModel(
     std::vector<double> b_d, std::vector<double> c, double d,
     std::vector<double> x0, const std::string &output_signal_path,
     const std::string &input_signal_path, SignalNamespace &ns)
+    : StateSpaceSisoDiscreteModel(id, a_d.size(), flatten_square_matrix(a_d),
+                                  std::move(b_d), std::move(c), d,
+                                  std::move(x0), output_signal_path,
+                                  input_signal_path, ns) {}
+
+StateSpaceSisoDiscreteModel::StateSpaceSisoDiscreteModel(
+    const std::string &id, std::size_t state_dim,
+    std::vector<double> a_d_row_major, std::vector<double> b_d,
+    std::vector<double> c, double d, std::vector<double> x0,
+    const std::string &output_signal_path,
+    const std::string &input_signal_path, SignalNamespace &ns)
     : id_(id), output_signal_(ns.intern(output_signal_path)),
-      input_signal_(ns.intern(input_signal_path)), state_dim_(a_d.size()),
-      a_d_(flatten_square_matrix(a_d)), b_d_(std::move(b_d)), c_(std::move(c)),
+      input_signal_(ns.intern(input_signal_path)), state_dim_(state_dim),
+      a_d_(std::move(a_d_row_major)), b_d_(std::move(b_d)), c_(std::move(c)),
       d_(d), state_(std::move(x0)), initial_state_(state_),
       scratch_state_(state_dim_, 0.0) {
   if (state_dim_ == 0) {
     throw std::invalid_argument(
         "StateSpaceSisoDiscreteModel: A_d must be non-empty");
   }
+  if (a_d_.size() != state_dim_ * state_dim_) {
+    throw std::invalid_argument(
+        "StateSpaceSisoDiscreteModel: A_d must be square");
+  }
 
   if (b_d_.size() != state_dim_) {
     throw std::invalid_argument(
@@ -125,4 +140,8 @@ std::vector<SignalId> StateSpaceSisoDiscreteModel::output_signal_ids() const {
   return {output_signal_};
 }
 
+void StateSpaceSisoDiscreteModel::hash_state(StateHasher &hasher) const {
+  hasher.add(state_.data(), state_.size());
+}
+
 } // namespace fluxgraph
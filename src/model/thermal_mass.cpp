@@ -42,30 +42,13 @@ ThermalMassModel::ThermalMassModel(const std::string &id, double thermal_mass,
   }
 }
 
-double ThermalMassModel::derivative(double temperature, double net_power,
-                                    double ambient) const {
-  const double heat_loss = heat_transfer_coeff_ * (temperature - ambient);
-  return (net_power - heat_loss) / thermal_mass_;
-}
-
 void ThermalMassModel::tick(double dt, SignalStore &store) {
   // Read inputs
   double net_power = store.read_value(power_signal_);
   double ambient = store.read_value(ambient_signal_);
 
-  if (integration_method_ == ThermalIntegrationMethod::ForwardEuler) {
-    // Forward Euler integration: T += dT/dt * dt
-    temperature_ += derivative(temperature_, net_power, ambient) * dt;
-  } else {
-    // Classic RK4 with fixed inputs over the tick interval.
-    const double k1 = derivative(temperature_, net_power, ambient);
-    const double k2 =
-        derivative(temperature_ + 0.5 * dt * k1, net_power, ambient);
-    const double k3 =
-        derivative(temperature_ + 0.5 * dt * k2, net_power, ambient);
-    const double k4 = derivative(temperature_ + dt * k3, net_power, ambient);
-    temperature_ += (dt / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
-  }
+  temperature_ = step(temperature_, net_power, ambient, thermal_mass_,
+                      heat_transfer_coeff_, dt, integration_method_);
 
   // Write output with unit
   store.write(temp_signal_, temperature_, "degC");
@@ -81,12 +64,8 @@ double ThermalMassModel::compute_stability_limit() const {
                                                     // unconditionally stable
   }
 
-  const double tau = thermal_mass_ / heat_transfer_coeff_;
-  if (integration_method_ == ThermalIntegrationMethod::ForwardEuler) {
-    return 2.0 * tau;
-  }
-
-  return kRk4NegativeRealAxisStabilityLimit * tau;
+  return stability_limit(thermal_mass_, heat_transfer_coeff_,
+                         integration_method_);
 }
 
 std::string ThermalMassModel::describe() const {
@@ -102,4 +81,8 @@ std::vector<SignalId> ThermalMassModel::output_signal_ids() const {
   return {temp_signal_};
 }
 
+void ThermalMassModel::hash_state(StateHasher &hasher) const {
+  hasher.add(temperature_);
+}
+
 } // namespace fluxgraph
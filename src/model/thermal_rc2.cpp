@@ -160,4 +160,9 @@ std::vector<SignalId> ThermalRc2Model::output_signal_ids() const {
   return {temp_a_signal_, temp_b_signal_};
 }
 
+void ThermalRc2Model::hash_state(StateHasher &hasher) const {
+  hasher.add(temp_a_);
+  hasher.add(temp_b_);
+}
+
 } // namespace fluxgraph
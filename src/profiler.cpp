@@ -0,0 +1,220 @@
+#include "fluxgraph/profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace fluxgraph {
+
+namespace {
+
+constexpr size_t kStageCount = 3;
+
+std::string escape_json(const std::string &text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+        escaped += buffer;
+      } else {
+        escaped += c;
+      }
+    }
+  }
+  return escaped;
+}
+
+} // namespace
+
+const char *to_string(ProfileComponent component) {
+  switch (component) {
+  case ProfileComponent::tick:
+    return "tick";
+  case ProfileComponent::stage:
+    return "stage";
+  case ProfileComponent::model:
+    return "model";
+  case ProfileComponent::edge:
+    return "edge";
+  case ProfileComponent::rule:
+    return "rule";
+  }
+  return "unknown";
+}
+
+TickProfiler::TickProfiler(ProfilerOptions options, size_t model_count,
+                           size_t edge_count, size_t rule_count)
+    : options_(options), epoch_(clock::now()), tick_(1), stages_(kStageCount),
+      models_(model_count), edges_(edge_count), rules_(rule_count) {
+  if (options_.sample_interval == 0) {
+    throw std::invalid_argument("TickProfiler: sample_interval must be >= 1");
+  }
+
+  // One tick span, three stages and every component per frame.
+  const size_t events_per_tick =
+      1 + kStageCount + model_count + edge_count + rule_count;
+  frames_.resize(options_.trace_window);
+  for (auto &frame : frames_) {
+    frame.events.reserve(events_per_tick);
+  }
+}
+
+void TickProfiler::begin_tick() {
+  ++sampled_ticks_;
+  if (frames_.empty()) {
+    current_frame_ = nullptr;
+    return;
+  }
+
+  current_frame_ = &frames_[next_frame_];
+  current_frame_->tick = ticks_seen_ - 1;
+  current_frame_->events.clear();
+  next_frame_ = (next_frame_ + 1) % frames_.size();
+}
+
+void TickProfiler::record(ProfileComponent component, size_t index,
+                          clock::time_point start, clock::time_point end) {
+  const int64_t duration_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count();
+
+  Accumulator &acc = accumulators(component)[index];
+  ++acc.samples;
+  acc.total_ns += duration_ns;
+  acc.max_ns = std::max(acc.max_ns, duration_ns);
+
+  if (current_frame_ != nullptr) {
+    current_frame_->events.push_back(
+        {component, static_cast<uint32_t>(index),
+         std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_)
+             .count(),
+         duration_ns});
+  }
+}
+
+std::vector<TickProfiler::Accumulator> &
+TickProfiler::accumulators(ProfileComponent component) {
+  return const_cast<std::vector<Accumulator> &>(
+      static_cast<const TickProfiler *>(this)->accumulators(component));
+}
+
+const std::vector<TickProfiler::Accumulator> &
+TickProfiler::accumulators(ProfileComponent component) const {
+  switch (component) {
+  case ProfileComponent::tick:
+    return tick_;
+  case ProfileComponent::stage:
+    return stages_;
+  case ProfileComponent::model:
+    return models_;
+  case ProfileComponent::edge:
+    return edges_;
+  case ProfileComponent::rule:
+    return rules_;
+  }
+  throw std::invalid_argument("TickProfiler: unknown component");
+}
+
+std::vector<ProfileEntry> TickProfiler::report(const Labeler &label,
+                                               size_t top_n,
+                                               bool component_only) const {
+  std::vector<ProfileEntry> entries;
+  const auto collect = [&](ProfileComponent component) {
+    const auto &accs = accumulators(component);
+    for (size_t i = 0; i < accs.size(); ++i) {
+      if (accs[i].samples == 0) {
+        continue;
+      }
+      ProfileEntry entry;
+      entry.component = component;
+      entry.index = i;
+      entry.samples = accs[i].samples;
+      entry.total = std::chrono::nanoseconds(accs[i].total_ns);
+      entry.max = std::chrono::nanoseconds(accs[i].max_ns);
+      entries.push_back(std::move(entry));
+    }
+  };
+
+  if (!component_only) {
+    collect(ProfileComponent::tick);
+    collect(ProfileComponent::stage);
+  }
+  collect(ProfileComponent::model);
+  collect(ProfileComponent::edge);
+  collect(ProfileComponent::rule);
+
+  std::sort(entries.begin(), entries.end(),
+            [](const ProfileEntry &lhs, const ProfileEntry &rhs) {
+              if (lhs.total != rhs.total) {
+                return lhs.total > rhs.total;
+              }
+              return std::tie(lhs.component, lhs.index) <
+                     std::tie(rhs.component, rhs.index);
+            });
+  if (top_n > 0 && entries.size() > top_n) {
+    entries.resize(top_n);
+  }
+
+  // Label only the survivors; labels may need namespace lookups.
+  for (auto &entry : entries) {
+    entry.label = label(entry.component, entry.index);
+  }
+  return entries;
+}
+
+std::string TickProfiler::chrome_trace_json(const Labeler &label) const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3); // Microseconds with ns detail
+  out << "{\"traceEvents\":[";
+  bool first = true;
+
+  // Oldest frame first: the ring's next slot holds the oldest frame once full.
+  for (size_t n = 0; n < frames_.size(); ++n) {
+    const TraceFrame &frame = frames_[(next_frame_ + n) % frames_.size()];
+    for (const auto &event : frame.events) {
+      std::string name = event.component == ProfileComponent::tick
+                             ? "tick " + std::to_string(frame.tick)
+                             : label(event.component, event.index);
+      out << (first ? "" : ",") << "{\"name\":\"" << escape_json(name)
+          << "\",\"cat\":\"" << to_string(event.component)
+          << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+          << static_cast<double>(event.start_ns) / 1000.0
+          << ",\"dur\":" << static_cast<double>(event.duration_ns) / 1000.0
+          << ",\"args\":{\"tick\":" << frame.tick << "}}";
+      first = false;
+    }
+  }
+
+  out << "],\"displayTimeUnit\":\"ns\"}";
+  return out.str();
+}
+
+void TickProfiler::reset() {
+  for (auto *accs : {&tick_, &stages_, &models_, &edges_, &rules_}) {
+    std::fill(accs->begin(), accs->end(), Accumulator{});
+  }
+  for (auto &frame : frames_) {
+    frame.events.clear();
+  }
+  next_frame_ = 0;
+  current_frame_ = nullptr;
+  ticks_seen_ = 0;
+  sampled_ticks_ = 0;
+}
+
+} // namespace fluxgraph
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace fluxgraph::trace_internal {
+
+// File layout (host byte order, guarded by kByteOrderMark):
+//
+//   header: magic[8] "FGTRACE1"
+//           u32 version, u32 byte-order mark, u32 compression,
+//           u32 block_frames, u32 signal_count,
+//           signal_count x { u32 signal id, u32 name length, name bytes }
+//   block:  u32 frame_count, u32 payload bytes,
+//           payload = time column then one column per signal, each holding
+//           frame_count values (raw doubles, or xor_delta encoded)
+//
+// Columns restart their XOR predecessor at zero in every block, so blocks
+// decode independently of each other.
+
+constexpr char kMagic[8] = {'F', 'G', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+/// Input journal files (see journal.cpp for the layout)
+constexpr char kJournalMagic[8] = {'F', 'G', 'J', 'R', 'N', 'L', '0', '1'};
+constexpr uint32_t kJournalVersion = 1;
+
+struct FileCloser {
+  void operator()(std::FILE *file) const { std::fclose(file); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+template <typename T> bool write_pod(std::FILE *file, const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return std::fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T> bool read_pod(std::FILE *file, T &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+/// u32 length followed by the bytes
+inline bool write_string(std::FILE *file, const std::string &text) {
+  return write_pod(file, static_cast<uint32_t>(text.size())) &&
+         (text.empty() ||
+          std::fwrite(text.data(), text.size(), 1, file) == 1);
+}
+
+inline bool read_string(std::FILE *file, std::string &text) {
+  uint32_t length = 0;
+  if (!read_pod(file, length)) {
+    return false;
+  }
+  text.assign(length, '\0');
+  return length == 0 || std::fread(text.data(), length, 1, file) == 1;
+}
+
+/// Worst-case encoded size of one xor_delta value (control byte + 8 bytes)
+constexpr size_t kMaxEncodedValueBytes = 9;
+
+inline uint64_t to_bits(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline double from_bits(uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/// XOR-encode `count` values read at `stride` doubles apart into `out`.
+/// Each value is XORed with its predecessor; the result is stored as a
+/// control byte (leading zero bytes << 4 | trailing zero bytes) followed by
+/// the remaining middle bytes. Unchanged values cost one byte.
+/// @return Bytes written (at most count * kMaxEncodedValueBytes)
+inline size_t encode_xor_column(const double *values, size_t count,
+                                size_t stride, uint8_t *out) {
+  uint8_t *cursor = out;
+  uint64_t previous = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t bits = to_bits(values[i * stride]);
+    const uint64_t delta = bits ^ previous;
+    previous = bits;
+
+    if (delta == 0) {
+      *cursor++ = static_cast<uint8_t>(8U << 4U);
+      continue;
+    }
+
+    unsigned leading = 0;
+    while (((delta >> (56U - 8U * leading)) & 0xFFU) == 0) {
+      ++leading;
+    }
+    unsigned trailing = 0;
+    while (((delta >> (8U * trailing)) & 0xFFU) == 0) {
+      ++trailing;
+    }
+
+    *cursor++ = static_cast<uint8_t>((leading << 4U) | trailing);
+    for (unsigned byte = trailing; byte < 8U - leading; ++byte) {
+      *cursor++ = static_cast<uint8_t>((delta >> (8U * byte)) & 0xFFU);
+    }
+  }
+  return static_cast<size_t>(cursor - out);
+}
+
+/// Inverse of encode_xor_column.
+/// @return Bytes consumed, or 0 if the input is truncated or malformed
+inline size_t decode_xor_column(const uint8_t *in, size_t size, size_t count,
+                                double *out) {
+  const uint8_t *cursor = in;
+  const uint8_t *end = in + size;
+  uint64_t previous = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (cursor == end) {
+      return 0;
+    }
+    const unsigned control = *cursor++;
+    const unsigned leading = control >> 4U;
+    const unsigned trailing = control & 0x0FU;
+    if (leading + trailing > 8U) {
+      return 0;
+    }
+
+    uint64_t delta = 0;
+    const unsigned middle = 8U - leading - trailing;
+    if (static_cast<size_t>(end - cursor) < middle) {
+      return 0;
+    }
+    for (unsigned byte = 0; byte < middle; ++byte) {
+      delta |= static_cast<uint64_t>(*cursor++) << (8U * (trailing + byte));
+    }
+
+    previous ^= delta;
+    out[i] = from_bits(previous);
+  }
+  return static_cast<size_t>(cursor - in);
+}
+
+} // namespace fluxgraph::trace_internal
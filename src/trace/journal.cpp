@@ -0,0 +1,300 @@
+#include "fluxgraph/trace/journal.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "format.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fluxgraph {
+
+using trace_internal::read_pod;
+using trace_internal::read_string;
+using trace_internal::write_pod;
+using trace_internal::write_string;
+
+// File layout (host byte order, guarded by the byte-order mark):
+//
+//   magic[8] "FGJRNL01", u32 version, u32 byte-order mark
+//   u32 path_count,   path_count x { u32 signal id, string path }
+//   u32 unit_count,   unit_count x { string unit }
+//   u32 output_count, output_count x { u32 signal id }
+//   u64 tick_count,   tick_count x { f64 dt, u64 first_write,
+//                                    u32 write_count, u64 output_hash }
+//   u64 write_count,  write_count x { u32 signal id, u32 unit, f64 value }
+//
+// Signal ids in the file are the recording namespace's ids; the path table
+// maps them to paths so load() can remap them.
+
+namespace {
+
+[[noreturn]] void fail(const std::string &path, const std::string &what) {
+  throw std::runtime_error("InputJournal: '" + path + "': " + what);
+}
+
+SignalId resolve_output(const SignalNamespace &ns, const std::string &path,
+                        const SignalIdMap *id_map) {
+  SignalId id = ns.resolve(path);
+  if (id != INVALID_SIGNAL && id_map != nullptr) {
+    id = id_map->program_id_from_namespace(id);
+  }
+  if (id == INVALID_SIGNAL) {
+    throw std::invalid_argument("InputJournal: unknown signal path '" + path +
+                                "'");
+  }
+  return id;
+}
+
+} // namespace
+
+uint64_t hash_signal_values(const SignalStore &store,
+                            const std::vector<SignalId> &ids) {
+  StateHasher hasher;
+  for (SignalId id : ids) {
+    hasher.add(store.read_value(id));
+  }
+  return hasher.digest();
+}
+
+InputJournal::InputJournal(const SignalNamespace &ns,
+                           const std::vector<std::string> &output_paths,
+                           const SignalIdMap *id_map) {
+  if (output_paths.empty()) {
+    for (const auto &path : ns.all_paths()) {
+      // Host-only paths have no program id and no slot in the store
+      const SignalId id = ns.resolve(path);
+      if (id_map == nullptr ||
+          id_map->program_id_from_namespace(id) != INVALID_SIGNAL) {
+        output_ids_.push_back(resolve_output(ns, path, id_map));
+      }
+    }
+  } else {
+    for (const auto &path : output_paths) {
+      output_ids_.push_back(resolve_output(ns, path, id_map));
+    }
+  }
+}
+
+uint32_t InputJournal::intern_unit(const std::string &unit) {
+  // Providers tend to write runs of signals with the same unit
+  if (last_unit_ < units_.size() && units_[last_unit_] == unit) {
+    return last_unit_;
+  }
+  for (uint32_t i = 0; i < units_.size(); ++i) {
+    if (units_[i] == unit) {
+      last_unit_ = i;
+      return i;
+    }
+  }
+  units_.push_back(unit);
+  last_unit_ = static_cast<uint32_t>(units_.size() - 1U);
+  return last_unit_;
+}
+
+void InputJournal::on_write(SignalId id, double value,
+                            const std::string &unit) {
+  writes_.push_back({id, intern_unit(unit), value});
+}
+
+void InputJournal::end_tick(double dt, const SignalStore &store) {
+  JournalTick tick;
+  tick.dt = dt;
+  tick.first_write = tick_first_write_;
+  tick.write_count = static_cast<uint32_t>(pending_writes());
+  tick.output_hash = hash_signal_values(store, output_ids_);
+  ticks_.push_back(tick);
+  tick_first_write_ = writes_.size();
+}
+
+void InputJournal::reserve(size_t ticks, size_t writes) {
+  ticks_.reserve(ticks);
+  writes_.reserve(writes);
+}
+
+void InputJournal::save(const std::string &file_path,
+                        const SignalNamespace &ns,
+                        const SignalIdMap *id_map) const {
+  trace_internal::FilePtr file(std::fopen(file_path.c_str(), "wb"));
+  if (!file) {
+    fail(file_path, "cannot open for writing");
+  }
+  std::FILE *out = file.get();
+
+  // Path table: every id referenced by a journaled write or an output
+  std::vector<SignalId> referenced = output_ids_;
+  for (size_t i = 0; i < tick_first_write_; ++i) {
+    referenced.push_back(writes_[i].id);
+  }
+  std::sort(referenced.begin(), referenced.end());
+  referenced.erase(std::unique(referenced.begin(), referenced.end()),
+                   referenced.end());
+
+  bool ok = std::fwrite(trace_internal::kJournalMagic,
+                        sizeof(trace_internal::kJournalMagic), 1, out) == 1;
+  ok = ok && write_pod(out, trace_internal::kJournalVersion);
+  ok = ok && write_pod(out, trace_internal::kByteOrderMark);
+
+  ok = ok && write_pod(out, static_cast<uint32_t>(referenced.size()));
+  for (size_t i = 0; ok && i < referenced.size(); ++i) {
+    const std::string path(ns.lookup(
+        id_map != nullptr ? id_map->namespace_id(referenced[i])
+                          : referenced[i]));
+    if (path.empty()) {
+      fail(file_path, "signal " + std::to_string(referenced[i]) +
+                          " is not interned in the namespace");
+    }
+    ok = write_pod(out, referenced[i]) && write_string(out, path);
+  }
+
+  ok = ok && write_pod(out, static_cast<uint32_t>(units_.size()));
+  for (size_t i = 0; ok && i < units_.size(); ++i) {
+    ok = write_string(out, units_[i]);
+  }
+
+  ok = ok && write_pod(out, static_cast<uint32_t>(output_ids_.size()));
+  for (size_t i = 0; ok && i < output_ids_.size(); ++i) {
+    ok = write_pod(out, output_ids_[i]);
+  }
+
+  ok = ok && write_pod(out, static_cast<uint64_t>(ticks_.size()));
+  for (size_t i = 0; ok && i < ticks_.size(); ++i) {
+    const JournalTick &tick = ticks_[i];
+    ok = write_pod(out, tick.dt) && write_pod(out, tick.first_write) &&
+         write_pod(out, tick.write_count) && write_pod(out, tick.output_hash);
+  }
+
+  // Pending writes after the last end_tick() belong to no tick; drop them
+  ok = ok && write_pod(out, static_cast<uint64_t>(tick_first_write_));
+  for (size_t i = 0; ok && i < tick_first_write_; ++i) {
+    const JournalWrite &write = writes_[i];
+    ok = write_pod(out, write.id) && write_pod(out, write.unit) &&
+         write_pod(out, write.value);
+  }
+
+  if (!ok || std::fflush(out) != 0) {
+    fail(file_path, "write failed");
+  }
+}
+
+InputJournal InputJournal::load(const std::string &file_path,
+                                const SignalNamespace &ns,
+                                const SignalIdMap *id_map) {
+  trace_internal::FilePtr file(std::fopen(file_path.c_str(), "rb"));
+  if (!file) {
+    fail(file_path, "cannot open");
+  }
+  std::FILE *in = file.get();
+
+  char magic[sizeof(trace_internal::kJournalMagic)];
+  if (std::fread(magic, sizeof(magic), 1, in) != 1 ||
+      std::memcmp(magic, trace_internal::kJournalMagic, sizeof(magic)) != 0) {
+    fail(file_path, "not a FluxGraph input journal");
+  }
+  uint32_t version = 0;
+  uint32_t byte_order = 0;
+  if (!read_pod(in, version) || !read_pod(in, byte_order)) {
+    fail(file_path, "truncated header");
+  }
+  if (version != trace_internal::kJournalVersion) {
+    fail(file_path, "unsupported version " + std::to_string(version));
+  }
+  if (byte_order != trace_internal::kByteOrderMark) {
+    fail(file_path, "written on a host with different byte order");
+  }
+
+  std::unordered_map<SignalId, SignalId> remap;
+  uint32_t path_count = 0;
+  if (!read_pod(in, path_count)) {
+    fail(file_path, "truncated path table");
+  }
+  for (uint32_t i = 0; i < path_count; ++i) {
+    SignalId recorded = INVALID_SIGNAL;
+    std::string path;
+    if (!read_pod(in, recorded) || !read_string(in, path)) {
+      fail(file_path, "truncated path table");
+    }
+    SignalId id = ns.resolve(path);
+    if (id != INVALID_SIGNAL && id_map != nullptr) {
+      id = id_map->program_id_from_namespace(id);
+    }
+    if (id == INVALID_SIGNAL) {
+      fail(file_path, "signal path '" + path + "' is not in the namespace");
+    }
+    remap[recorded] = id;
+  }
+  const auto map_id = [&](SignalId recorded) {
+    auto it = remap.find(recorded);
+    if (it == remap.end()) {
+      fail(file_path, "signal " + std::to_string(recorded) +
+                          " missing from path table");
+    }
+    return it->second;
+  };
+
+  InputJournal journal;
+  uint32_t unit_count = 0;
+  if (!read_pod(in, unit_count)) {
+    fail(file_path, "truncated unit table");
+  }
+  journal.units_.resize(unit_count);
+  for (auto &unit : journal.units_) {
+    if (!read_string(in, unit)) {
+      fail(file_path, "truncated unit table");
+    }
+  }
+
+  uint32_t output_count = 0;
+  if (!read_pod(in, output_count)) {
+    fail(file_path, "truncated output table");
+  }
+  journal.output_ids_.resize(output_count);
+  for (auto &id : journal.output_ids_) {
+    SignalId recorded = INVALID_SIGNAL;
+    if (!read_pod(in, recorded)) {
+      fail(file_path, "truncated output table");
+    }
+    id = map_id(recorded);
+  }
+
+  uint64_t tick_count = 0;
+  if (!read_pod(in, tick_count)) {
+    fail(file_path, "truncated tick table");
+  }
+  for (uint64_t i = 0; i < tick_count; ++i) {
+    JournalTick tick;
+    if (!read_pod(in, tick.dt) || !read_pod(in, tick.first_write) ||
+        !read_pod(in, tick.write_count) || !read_pod(in, tick.output_hash)) {
+      fail(file_path, "truncated tick table");
+    }
+    journal.ticks_.push_back(tick);
+  }
+
+  uint64_t write_count = 0;
+  if (!read_pod(in, write_count)) {
+    fail(file_path, "truncated write table");
+  }
+  for (uint64_t i = 0; i < write_count; ++i) {
+    SignalId recorded = INVALID_SIGNAL;
+    JournalWrite write;
+    if (!read_pod(in, recorded) || !read_pod(in, write.unit) ||
+        !read_pod(in, write.value)) {
+      fail(file_path, "truncated write table");
+    }
+    if (write.unit >= unit_count) {
+      fail(file_path, "write references unknown unit");
+    }
+    write.id = map_id(recorded);
+    journal.writes_.push_back(write);
+  }
+
+  for (const auto &tick : journal.ticks_) {
+    if (tick.first_write > write_count ||
+        tick.write_count > write_count - tick.first_write) {
+      fail(file_path, "tick references writes out of range");
+    }
+  }
+  journal.tick_first_write_ = journal.writes_.size();
+  return journal;
+}
+
+} // namespace fluxgraph
@@ -0,0 +1,122 @@
+#include "fluxgraph/trace/reader.hpp"
+#include "format.hpp"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace fluxgraph {
+
+using trace_internal::read_pod;
+using trace_internal::read_string;
+
+namespace {
+
+[[noreturn]] void fail(const std::string &path, const std::string &what) {
+  throw std::runtime_error("read_trace: '" + path + "': " + what);
+}
+
+} // namespace
+
+TraceData read_trace(const std::string &file_path) {
+  trace_internal::FilePtr file(std::fopen(file_path.c_str(), "rb"));
+  if (!file) {
+    fail(file_path, "cannot open");
+  }
+
+  char magic[sizeof(trace_internal::kMagic)];
+  if (std::fread(magic, sizeof(magic), 1, file.get()) != 1 ||
+      std::memcmp(magic, trace_internal::kMagic, sizeof(magic)) != 0) {
+    fail(file_path, "not a FluxGraph trace file");
+  }
+
+  uint32_t version = 0;
+  uint32_t byte_order = 0;
+  uint32_t compression = 0;
+  uint32_t block_frames = 0;
+  uint32_t signal_count = 0;
+  if (!read_pod(file.get(), version) || !read_pod(file.get(), byte_order) ||
+      !read_pod(file.get(), compression) ||
+      !read_pod(file.get(), block_frames) ||
+      !read_pod(file.get(), signal_count)) {
+    fail(file_path, "truncated header");
+  }
+  if (version != trace_internal::kVersion) {
+    fail(file_path, "unsupported version " + std::to_string(version));
+  }
+  if (byte_order != trace_internal::kByteOrderMark) {
+    fail(file_path, "written on a host with different byte order");
+  }
+  if (compression != static_cast<uint32_t>(TraceCompression::none) &&
+      compression != static_cast<uint32_t>(TraceCompression::xor_delta)) {
+    fail(file_path, "unknown compression " + std::to_string(compression));
+  }
+
+  TraceData data;
+  data.compression = static_cast<TraceCompression>(compression);
+  for (uint32_t i = 0; i < signal_count; ++i) {
+    uint32_t id = 0;
+    std::string path;
+    if (!read_pod(file.get(), id) || !read_string(file.get(), path)) {
+      fail(file_path, "truncated signal table");
+    }
+    data.signal_ids.push_back(id);
+    data.signal_paths.push_back(std::move(path));
+  }
+  data.columns.resize(signal_count);
+
+  std::vector<uint8_t> payload;
+  uint32_t frames = 0;
+  while (read_pod(file.get(), frames)) {
+    uint32_t payload_size = 0;
+    if (!read_pod(file.get(), payload_size)) {
+      fail(file_path, "truncated block header");
+    }
+    if (frames > block_frames) {
+      fail(file_path, "block exceeds declared block_frames");
+    }
+    payload.resize(payload_size);
+    if (payload_size > 0 &&
+        std::fread(payload.data(), payload_size, 1, file.get()) != 1) {
+      fail(file_path, "truncated block");
+    }
+
+    const uint8_t *cursor = payload.data();
+    size_t remaining = payload.size();
+    const auto decode_column = [&](std::vector<double> &column) {
+      const size_t offset = column.size();
+      column.resize(offset + frames);
+      if (data.compression == TraceCompression::xor_delta) {
+        const size_t used = trace_internal::decode_xor_column(
+            cursor, remaining, frames, column.data() + offset);
+        if (used == 0 && frames > 0) {
+          fail(file_path, "corrupt block");
+        }
+        cursor += used;
+        remaining -= used;
+      } else {
+        const size_t bytes = frames * sizeof(double);
+        if (remaining < bytes) {
+          fail(file_path, "corrupt block");
+        }
+        std::memcpy(column.data() + offset, cursor, bytes);
+        cursor += bytes;
+        remaining -= bytes;
+      }
+    };
+
+    decode_column(data.times);
+    for (auto &column : data.columns) {
+      decode_column(column);
+    }
+    if (remaining != 0) {
+      fail(file_path, "corrupt block");
+    }
+  }
+  if (!std::feof(file.get())) {
+    fail(file_path, "read error");
+  }
+
+  return data;
+}
+
+} // namespace fluxgraph
@@ -0,0 +1,255 @@
+#include "fluxgraph/trace/recorder.hpp"
+#include "format.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace fluxgraph {
+
+using trace_internal::write_pod;
+using trace_internal::write_string;
+
+TraceRecorder::TraceRecorder(const std::string &file_path,
+                             const SignalNamespace &ns,
+                             const std::vector<std::string> &signal_paths,
+                             TraceRecorderOptions options)
+    : options_(options) {
+  if (options_.block_frames == 0) {
+    throw std::invalid_argument("TraceRecorder: block_frames must be >= 1");
+  }
+  if (options_.ring_blocks < 2) {
+    throw std::invalid_argument("TraceRecorder: ring_blocks must be >= 2");
+  }
+  if (options_.compression != TraceCompression::none &&
+      options_.compression != TraceCompression::xor_delta) {
+    throw std::invalid_argument("TraceRecorder: unknown compression");
+  }
+
+  signal_ids_.reserve(signal_paths.size());
+  for (const auto &path : signal_paths) {
+    const SignalId id = ns.resolve(path);
+    if (id == INVALID_SIGNAL) {
+      throw std::invalid_argument("TraceRecorder: unknown signal path '" +
+                                  path + "'");
+    }
+    signal_ids_.push_back(id);
+  }
+
+  // Time column plus one column per signal, worst-case encoding
+  const size_t column_count = signal_ids_.size() + 1U;
+  const size_t max_payload = column_count * options_.block_frames *
+                             trace_internal::kMaxEncodedValueBytes;
+  if (max_payload / column_count / options_.block_frames !=
+          trace_internal::kMaxEncodedValueBytes ||
+      max_payload > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument(
+        "TraceRecorder: block_frames x signal count exceeds block size limit");
+  }
+
+  ring_.resize(options_.ring_blocks);
+  for (auto &block : ring_) {
+    block.times.resize(options_.block_frames);
+    block.values.resize(options_.block_frames * signal_ids_.size());
+  }
+  encode_buffer_.resize(max_payload);
+
+  file_ = std::fopen(file_path.c_str(), "wb");
+  if (file_ == nullptr) {
+    throw std::runtime_error("TraceRecorder: cannot open '" + file_path +
+                             "' for writing");
+  }
+  try {
+    write_header(signal_paths);
+  } catch (...) {
+    std::fclose(file_);
+    throw;
+  }
+
+  writer_ = std::thread(&TraceRecorder::writer_loop, this);
+}
+
+TraceRecorder::~TraceRecorder() {
+  try {
+    close();
+  } catch (...) {
+    // Destructors must not throw; close() explicitly to observe errors
+  }
+}
+
+void TraceRecorder::write_header(const std::vector<std::string> &signal_paths) {
+  bool ok = std::fwrite(trace_internal::kMagic, sizeof(trace_internal::kMagic),
+                        1, file_) == 1;
+  ok = ok && write_pod(file_, trace_internal::kVersion);
+  ok = ok && write_pod(file_, trace_internal::kByteOrderMark);
+  ok = ok && write_pod(file_, static_cast<uint32_t>(options_.compression));
+  ok = ok && write_pod(file_, static_cast<uint32_t>(options_.block_frames));
+  ok = ok && write_pod(file_, static_cast<uint32_t>(signal_ids_.size()));
+  for (size_t i = 0; ok && i < signal_ids_.size(); ++i) {
+    ok = write_pod(file_, signal_ids_[i]) &&
+         write_string(file_, signal_paths[i]);
+  }
+  if (!ok) {
+    throw std::runtime_error("TraceRecorder: failed to write trace header");
+  }
+}
+
+void TraceRecorder::capture(const SignalStore &store, double time) {
+  if (closed_) {
+    throw std::logic_error("TraceRecorder: capture after close");
+  }
+  if (current_ == nullptr && !acquire_next_block()) {
+    ++frames_dropped_;
+    return;
+  }
+
+  Block &block = *current_;
+  const size_t signal_count = signal_ids_.size();
+  block.times[block.frame_count] = time;
+  store.gather_values(signal_ids_.data(), signal_count,
+                      block.values.data() + block.frame_count * signal_count);
+  ++block.frame_count;
+  ++frames_captured_;
+
+  if (block.frame_count == options_.block_frames) {
+    submit_current_block();
+  }
+}
+
+bool TraceRecorder::acquire_next_block() {
+  const uint64_t ring_size = ring_.size();
+  if (next_sequence_ - blocks_written_.load(std::memory_order_acquire) >=
+      ring_size) {
+    if (options_.drop_when_full) {
+      return false;
+    }
+    std::unique_lock lock(mutex_);
+    written_cv_.wait(lock, [this, ring_size] {
+      return next_sequence_ - blocks_written_.load(std::memory_order_acquire) <
+             ring_size;
+    });
+  }
+
+  current_ = &ring_[next_sequence_ % ring_size];
+  current_->frame_count = 0;
+  return true;
+}
+
+void TraceRecorder::submit_current_block() {
+  {
+    std::lock_guard lock(mutex_);
+    ++blocks_submitted_;
+  }
+  submitted_cv_.notify_one();
+  current_ = nullptr;
+  ++next_sequence_;
+}
+
+void TraceRecorder::flush() {
+  if (closed_) {
+    return;
+  }
+  if (current_ != nullptr && current_->frame_count > 0) {
+    submit_current_block();
+  }
+  {
+    std::unique_lock lock(mutex_);
+    written_cv_.wait(lock, [this] {
+      return blocks_written_.load(std::memory_order_acquire) ==
+             blocks_submitted_;
+    });
+  }
+  if (!write_failed_ && std::fflush(file_) != 0) {
+    write_failed_ = true;
+  }
+  if (write_failed_) {
+    throw std::runtime_error("TraceRecorder: write failed");
+  }
+}
+
+void TraceRecorder::close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+
+  if (current_ != nullptr && current_->frame_count > 0) {
+    submit_current_block();
+  }
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  submitted_cv_.notify_one();
+  writer_.join();
+
+  if (std::fclose(file_) != 0) {
+    write_failed_ = true;
+  }
+  file_ = nullptr;
+  if (write_failed_) {
+    throw std::runtime_error("TraceRecorder: write failed");
+  }
+}
+
+void TraceRecorder::writer_loop() {
+  for (;;) {
+    uint64_t sequence = 0;
+    {
+      std::unique_lock lock(mutex_);
+      submitted_cv_.wait(lock, [this] {
+        return stopping_ || blocks_submitted_ > blocks_written_.load(
+                                                    std::memory_order_relaxed);
+      });
+      sequence = blocks_written_.load(std::memory_order_relaxed);
+      if (sequence == blocks_submitted_) {
+        return; // Stopping with nothing left to drain
+      }
+    }
+
+    // After a failure blocks are still retired so capture() never stalls
+    if (!write_failed_) {
+      write_block(ring_[sequence % ring_.size()]);
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      blocks_written_.store(sequence + 1, std::memory_order_release);
+    }
+    written_cv_.notify_all();
+  }
+}
+
+void TraceRecorder::write_block(const Block &block) {
+  const size_t frames = block.frame_count;
+  const size_t signal_count = signal_ids_.size();
+  uint8_t *out = encode_buffer_.data();
+
+  if (options_.compression == TraceCompression::xor_delta) {
+    out += trace_internal::encode_xor_column(block.times.data(), frames, 1,
+                                             out);
+    for (size_t s = 0; s < signal_count; ++s) {
+      out += trace_internal::encode_xor_column(block.values.data() + s, frames,
+                                               signal_count, out);
+    }
+  } else {
+    std::memcpy(out, block.times.data(), frames * sizeof(double));
+    out += frames * sizeof(double);
+    for (size_t s = 0; s < signal_count; ++s) {
+      for (size_t f = 0; f < frames; ++f) {
+        std::memcpy(out, &block.values[f * signal_count + s], sizeof(double));
+        out += sizeof(double);
+      }
+    }
+  }
+
+  const size_t payload = static_cast<size_t>(out - encode_buffer_.data());
+  const bool ok =
+      write_pod(file_, static_cast<uint32_t>(frames)) &&
+      write_pod(file_, static_cast<uint32_t>(payload)) &&
+      std::fwrite(encode_buffer_.data(), 1, payload, file_) == payload;
+  if (!ok) {
+    write_failed_ = true;
+  }
+}
+
+} // namespace fluxgraph
@@ -0,0 +1,43 @@
+#include "fluxgraph/trace/replay.hpp"
+
+namespace fluxgraph {
+
+ReplayResult replay_journal(const InputJournal &journal, Engine &engine,
+                            SignalStore &store, ReplayOptions options) {
+  using clock = std::chrono::steady_clock;
+
+  const auto &ticks = journal.ticks();
+  const auto &writes = journal.writes();
+  const auto &units = journal.units();
+  const auto &outputs = journal.output_ids();
+
+  ReplayResult result;
+  const auto start = clock::now();
+  for (size_t t = 0; t < ticks.size(); ++t) {
+    const JournalTick &tick = ticks[t];
+    const JournalWrite *write = writes.data() + tick.first_write;
+    for (uint32_t w = 0; w < tick.write_count; ++w, ++write) {
+      store.write(write->id, write->value, units[write->unit]);
+    }
+
+    engine.tick(tick.dt, store);
+    result.commands_discarded += engine.discard_commands();
+    ++result.ticks_replayed;
+
+    const uint64_t actual = hash_signal_values(store, outputs);
+    if (actual != tick.output_hash) {
+      if (result.divergent_ticks++ == 0) {
+        result.first_divergent_tick = t;
+        result.expected_hash = tick.output_hash;
+        result.actual_hash = actual;
+      }
+      if (options.stop_on_divergence) {
+        break;
+      }
+    }
+  }
+  result.elapsed = clock::now() - start;
+  return result;
+}
+
+} // namespace fluxgraph
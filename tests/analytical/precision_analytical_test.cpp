@@ -0,0 +1,144 @@
+// Accuracy of the batched static graph under each precision policy against
+// closed-form solutions. The per-policy bounds document the loss: float64
+// carries only discretization error, mixed adds float rounding of stored
+// signals, float32 adds rounding of the integrator state every tick.
+
+#include "fluxgraph/static_batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace fluxgraph;
+namespace sg = fluxgraph::static_graph;
+
+namespace {
+
+constexpr std::size_t kLanes = 8;
+
+/// Max absolute error bounds per policy, 2-4x the measured error (see
+/// docs/numerical-methods.md for the measured values)
+template <typename Policy> struct AccuracyBudget;
+
+template <> struct AccuracyBudget<sg::precision::float64> {
+  static constexpr double thermal_mass = 5e-4; // Euler truncation
+  static constexpr double first_order_process = 1e-12;
+  static constexpr double first_order_lag = 1e-12;
+};
+
+template <> struct AccuracyBudget<sg::precision::mixed> {
+  static constexpr double thermal_mass = 5e-4;
+  static constexpr double first_order_process = 1e-6; // Half a float ulp
+  static constexpr double first_order_lag = 1e-6;
+};
+
+template <> struct AccuracyBudget<sg::precision::float32> {
+  static constexpr double thermal_mass = 5e-3;
+  static constexpr double first_order_process = 2e-5;
+  static constexpr double first_order_lag = 5e-5;
+};
+
+template <typename Policy> class PrecisionAnalytical : public ::testing::Test {
+protected:
+  void report(const char *name, double error) {
+    RecordProperty(name, std::to_string(error));
+  }
+};
+
+using Policies = ::testing::Types<sg::precision::float64,
+                                  sg::precision::mixed,
+                                  sg::precision::float32>;
+TYPED_TEST_SUITE(PrecisionAnalytical, Policies);
+
+using Power = sg::SignalSlot<0>;
+using Ambient = sg::SignalSlot<1>;
+using Temp = sg::SignalSlot<2>;
+
+} // namespace
+
+TYPED_TEST(PrecisionAnalytical, ThermalMassExponentialDecay) {
+  // T(t) = T_amb + (T0 - T_amb) * exp(-h t / C), C = 1000 J/K, h = 10 W/K
+  using Plant = sg::Graph<sg::Model<sg::ThermalMass<
+      Temp, Power, Ambient, std::ratio<1000>, std::ratio<10>,
+      std::ratio<100>>>>;
+  auto batch = std::make_unique<sg::Batch<Plant, kLanes, TypeParam>>();
+  batch->template fill<Power>(0.0);
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    batch->template write<Ambient>(lane, 10.0 + 5.0 * lane);
+  }
+
+  constexpr double dt = 1e-3;
+  double max_error = 0.0;
+  for (int i = 1; i <= 100000; ++i) { // 100 s
+    batch->tick(dt);
+    if (i % 100 != 0) {
+      continue;
+    }
+    const double t = i * dt;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const double ambient = 10.0 + 5.0 * lane;
+      const double expected =
+          ambient + (100.0 - ambient) * std::exp(-10.0 * t / 1000.0);
+      max_error = std::max(
+          max_error, std::abs(batch->template read<Temp>(lane) - expected));
+    }
+  }
+  this->report("thermal_mass", max_error);
+  EXPECT_LE(max_error, AccuracyBudget<TypeParam>::thermal_mass);
+}
+
+TYPED_TEST(PrecisionAnalytical, FirstOrderProcessStepRk4) {
+  // y(t) = K u + (y0 - K u) * exp(-t / tau), K = 1.5, tau = 2 s, y0 = -1
+  using U = sg::SignalSlot<0>;
+  using Y = sg::SignalSlot<1>;
+  using Plant = sg::Graph<sg::Model<sg::FirstOrderProcess<
+      Y, U, std::ratio<3, 2>, std::ratio<2>, std::ratio<-1>,
+      IntegrationMethod::Rk4>>>;
+  auto batch = std::make_unique<sg::Batch<Plant, kLanes, TypeParam>>();
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    batch->template write<U>(lane, 0.5 + 0.5 * lane);
+  }
+
+  constexpr double dt = 1e-3;
+  double max_error = 0.0;
+  for (int i = 1; i <= 10000; ++i) { // 10 s
+    batch->tick(dt);
+    const double t = i * dt;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const double y_ss = 1.5 * (0.5 + 0.5 * lane);
+      const double expected = y_ss + (-1.0 - y_ss) * std::exp(-t / 2.0);
+      max_error = std::max(
+          max_error, std::abs(batch->template read<Y>(lane) - expected));
+    }
+  }
+  this->report("first_order_process", max_error);
+  EXPECT_LE(max_error, AccuracyBudget<TypeParam>::first_order_process);
+}
+
+TYPED_TEST(PrecisionAnalytical, FirstOrderLagStepResponse) {
+  // Exact exponential update: y(t) = u (1 - exp(-t / tau)), tau = 1 s
+  using U = sg::SignalSlot<0>;
+  using Y = sg::SignalSlot<1>;
+  using Filter = sg::Graph<sg::Edge<U, Y, sg::FirstOrderLag<std::ratio<1>>>>;
+  auto batch = std::make_unique<sg::Batch<Filter, kLanes, TypeParam>>();
+  batch->template fill<U>(0.0);
+  batch->tick(1e-3); // Initialize at 0
+
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    batch->template write<U>(lane, 1.0 + lane);
+  }
+  constexpr double dt = 1e-3;
+  double max_error = 0.0;
+  for (int i = 1; i <= 5000; ++i) { // 5 tau
+    batch->tick(dt);
+    const double t = i * dt;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const double expected = (1.0 + lane) * (1.0 - std::exp(-t));
+      max_error = std::max(
+          max_error, std::abs(batch->template read<Y>(lane) - expected));
+    }
+  }
+  this->report("first_order_lag", max_error);
+  EXPECT_LE(max_error, AccuracyBudget<TypeParam>::first_order_lag);
+}
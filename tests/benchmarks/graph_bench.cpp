@@ -0,0 +1,155 @@
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/core/signal_store.hpp"
+#include "fluxgraph/engine.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "support/allocation_counter.hpp"
+#include "support/perf_counters.hpp"
+#include "support/synthetic_graph.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Engine tick sweep over synthetic graphs (Google Benchmark).
+//
+// Each benchmark is tick/<shape>/edges:<N>. Besides time per tick it
+// reports the graph size, `per_edge` (time per edge per tick) and
+// `allocs_per_tick`, plus `<event>_per_tick` hardware counters where
+// perf_event_open is available. Extra flag: --max_edges=N caps the sweep
+// (default 1M).
+
+using namespace fluxgraph;
+using namespace fluxgraph::bench;
+
+namespace {
+
+constexpr double kDt = 0.01;
+
+struct Shape {
+  const char *name;
+  size_t fan_out;
+  size_t chain_depth;
+  size_t models_per_1k_edges;
+  size_t rules_per_1k_edges;
+  double delay_share;
+};
+
+constexpr Shape kShapes[] = {
+    {"chain", 1, 16, 0, 0, 0.0},   // Long dependency chains
+    {"tree", 4, 4, 0, 0, 0.0},     // Wide, shallow fan-out
+    {"mixed", 2, 6, 10, 10, 0.1},  // Models, rules and delay edges
+};
+
+// A loaded engine is reused across the repeated calls Google Benchmark
+// makes while sizing iterations; only the most recent graph is kept so
+// large sweeps do not hold every size in memory.
+struct LoadedGraph {
+  std::string key;
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  Engine engine;
+  SyntheticGraph graph;
+};
+
+LoadedGraph &load_graph(const Shape &shape, size_t edges) {
+  static std::unique_ptr<LoadedGraph> cached;
+  const std::string key = std::string(shape.name) + "/" + std::to_string(edges);
+  if (cached && cached->key == key) {
+    return *cached;
+  }
+  cached.reset();
+  cached = std::make_unique<LoadedGraph>();
+  cached->key = key;
+
+  SyntheticGraphConfig config;
+  config.edges = edges;
+  config.fan_out = shape.fan_out;
+  config.chain_depth = shape.chain_depth;
+  config.models = edges * shape.models_per_1k_edges / 1000;
+  config.rules = edges * shape.rules_per_1k_edges / 1000;
+  config.delay_share = shape.delay_share;
+  cached->graph = generate_synthetic_graph(config);
+
+  GraphCompiler compiler;
+  cached->engine.load(compiler.compile(cached->graph.spec, cached->signal_ns,
+                                       cached->func_ns));
+  for (const std::string &path : cached->graph.input_paths) {
+    cached->store.write(cached->signal_ns.resolve(path), 1.0, "dimensionless");
+  }
+  // Keep the counts, drop the spec
+  cached->graph.spec = GraphSpec{};
+  for (int i = 0; i < 3; ++i) {
+    cached->engine.tick(kDt, cached->store);
+  }
+  return *cached;
+}
+
+void tick_benchmark(benchmark::State &state, const Shape &shape) {
+  const auto edges = static_cast<size_t>(state.range(0));
+  LoadedGraph &loaded = load_graph(shape, edges);
+
+  PerfCounterGroup perf;
+  AllocationCountScope allocations;
+  perf.start();
+  for (auto _ : state) {
+    loaded.engine.tick(kDt, loaded.store);
+  }
+  const PerfReadings readings = perf.stop();
+  const std::uint64_t allocation_count = allocations.stop();
+
+  state.counters["edges"] = static_cast<double>(edges);
+  state.counters["signals"] = static_cast<double>(loaded.graph.signal_count);
+  state.counters["per_edge"] =
+      benchmark::Counter(static_cast<double>(edges),
+                         benchmark::Counter::kIsIterationInvariantRate |
+                             benchmark::Counter::kInvert);
+  state.counters["allocs_per_tick"] =
+      benchmark::Counter(static_cast<double>(allocation_count),
+                         benchmark::Counter::kAvgIterations);
+  for (size_t i = 0; i < kPerfEventCount; ++i) {
+    const auto event = static_cast<PerfEvent>(i);
+    if (readings.has(event)) {
+      state.counters[std::string(perf_event_key(event)) + "_per_tick"] =
+          benchmark::Counter(readings.get(event),
+                             benchmark::Counter::kAvgIterations);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+
+  int64_t max_edges = 1000000;
+  for (int i = 1; i < argc; ++i) {
+    constexpr const char kFlag[] = "--max_edges=";
+    if (std::strncmp(argv[i], kFlag, sizeof(kFlag) - 1) == 0) {
+      max_edges = std::strtoll(argv[i] + sizeof(kFlag) - 1, nullptr, 10);
+    } else {
+      std::cerr << "graph_bench: unknown argument '" << argv[i] << "'\n";
+      return 1;
+    }
+  }
+  if (max_edges < 10) {
+    std::cerr << "graph_bench: --max_edges must be at least 10\n";
+    return 1;
+  }
+
+  for (const Shape &shape : kShapes) {
+    const std::string name = std::string("tick/") + shape.name;
+    benchmark::RegisterBenchmark(name.c_str(), tick_benchmark, shape)
+        ->ArgName("edges")
+        ->RangeMultiplier(10)
+        ->Range(10, max_edges)
+        ->Unit(benchmark::kNanosecond);
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -58,6 +58,42 @@ std::string generate_json_graph(int num_edges, int num_models) {
   return oss.str();
 }
 
+// Generate JSON for one state_space_siso_discrete model with an n x n A_d
+std::string generate_state_space_json(int n) {
+  std::ostringstream oss;
+  auto vector = [&oss, n](double value) {
+    oss << "[";
+    for (int i = 0; i < n; ++i) {
+      oss << (i > 0 ? ", " : "") << value;
+    }
+    oss << "]";
+  };
+
+  oss << "{\n  \"models\": [\n    {\n";
+  oss << "      \"id\": \"plant\",\n";
+  oss << "      \"type\": \"state_space_siso_discrete\",\n";
+  oss << "      \"params\": {\n";
+  oss << "        \"A_d\": [";
+  for (int row = 0; row < n; ++row) {
+    oss << (row > 0 ? ",\n          " : "\n          ") << "[";
+    for (int col = 0; col < n; ++col) {
+      oss << (col > 0 ? ", " : "") << (row == col ? 0.5 : 0.001);
+    }
+    oss << "]";
+  }
+  oss << "\n        ],\n";
+  oss << "        \"B_d\": ";
+  vector(0.1);
+  oss << ",\n        \"C\": ";
+  vector(1.0);
+  oss << ",\n        \"D\": 0.0,\n        \"x0\": ";
+  vector(0.0);
+  oss << ",\n        \"output_signal\": \"plant.y\",\n";
+  oss << "        \"input_signal\": \"plant.u\"\n";
+  oss << "      }\n    }\n  ]\n}\n";
+  return oss.str();
+}
+
 void benchmark_json_loader(const std::string &name, const std::string &json,
                            int iterations) {
   auto start = high_resolution_clock::now();
@@ -95,6 +131,11 @@ int main() {
   std::string large_json = generate_json_graph(1000, 50);
   benchmark_json_loader("Large graph (1000 edges, 50 models)", large_json, 100);
 
+  // Structured params: one 200x200 state-space matrix (40k numeric leaves)
+  std::string state_space_json = generate_state_space_json(200);
+  benchmark_json_loader("State-space model (200x200 A_d)", state_space_json,
+                        50);
+
   std::cout << "All JSON loader benchmarks complete.\n";
 
   return 0;
@@ -2,6 +2,7 @@
 #include <chrono>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace fluxgraph;
@@ -70,12 +71,86 @@ void benchmark_namespace_resolve() {
   std::cout << "  (sum=" << sum << " to prevent optimization)\n\n";
 }
 
+void benchmark_namespace_large() {
+  // 1M hierarchical paths, interned without reserve() so growth is included
+  const int num_signals = 1000000;
+  std::vector<std::string> paths;
+  paths.reserve(num_signals);
+  for (int i = 0; i < num_signals; ++i) {
+    paths.push_back("rack" + std::to_string(i / 10000) + "/device" +
+                    std::to_string(i / 100) + "/signal" + std::to_string(i));
+  }
+
+  SignalNamespace ns;
+  auto start = high_resolution_clock::now();
+  for (const auto &path : paths) {
+    ns.intern(path);
+  }
+  auto end = high_resolution_clock::now();
+  auto intern_ms = duration_cast<milliseconds>(end - start).count();
+
+  std::cout << "Namespace Intern (1M):\n";
+  std::cout << "  Operations: " << num_signals << "\n";
+  std::cout << "  Duration:   " << intern_ms << " ms\n";
+  std::cout << "  Target:     <1000ms\n";
+  std::cout << "  Status:     " << (intern_ms < 1000 ? "PASS" : "FAIL")
+            << "\n\n";
+
+  // Resolve through views into a separate buffer, the way the server hands
+  // over protobuf-owned strings
+  std::vector<std::string_view> views(paths.begin(), paths.end());
+  start = high_resolution_clock::now();
+  SignalId sum = 0;
+  for (std::string_view path : views) {
+    sum += ns.resolve(path);
+  }
+  end = high_resolution_clock::now();
+  auto resolve_ms = duration_cast<milliseconds>(end - start).count();
+
+  std::cout << "Namespace Resolve (1M):\n";
+  std::cout << "  Operations: " << num_signals << "\n";
+  std::cout << "  Duration:   " << resolve_ms << " ms\n";
+  std::cout << "  Target:     <500ms\n";
+  std::cout << "  Status:     " << (resolve_ms < 500 ? "PASS" : "FAIL")
+            << "\n";
+  std::cout << "  (sum=" << sum << " to prevent optimization)\n\n";
+}
+
+void benchmark_namespace_prefix_query() {
+  // 100k signals in 1000 devices; query one device's subtree repeatedly
+  const int num_signals = 100000;
+  const int num_queries = 1000;
+  SignalNamespace ns;
+  for (int i = 0; i < num_signals; ++i) {
+    ns.intern("device" + std::to_string(i / 100) + "/signal" +
+              std::to_string(i));
+  }
+
+  auto start = high_resolution_clock::now();
+  size_t found = 0;
+  for (int q = 0; q < num_queries; ++q) {
+    found += ns.find_prefix("device" + std::to_string(q) + "/").size();
+  }
+  auto end = high_resolution_clock::now();
+  auto duration_ms = duration_cast<milliseconds>(end - start).count();
+
+  std::cout << "Namespace Prefix Query (100k):\n";
+  std::cout << "  Operations: " << num_queries << "\n";
+  std::cout << "  Duration:   " << duration_ms << " ms\n";
+  std::cout << "  Target:     <50ms\n";
+  std::cout << "  Status:     " << (duration_ms < 50 ? "PASS" : "FAIL")
+            << "\n";
+  std::cout << "  (found=" << found << ")\n\n";
+}
+
 int main() {
   std::cout << "FluxGraph Namespace Benchmarks\n";
   std::cout << "===============================\n\n";
 
   benchmark_namespace_intern();
   benchmark_namespace_resolve();
+  benchmark_namespace_large();
+  benchmark_namespace_prefix_query();
 
   return 0;
 }
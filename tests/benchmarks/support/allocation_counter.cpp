@@ -0,0 +1,70 @@
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<bool> g_count_allocations{false};
+std::atomic<std::uint64_t> g_allocation_count{0};
+} // namespace
+
+namespace fluxgraph::bench {
+
+AllocationCountScope::AllocationCountScope() {
+  g_allocation_count.store(0, std::memory_order_relaxed);
+  g_count_allocations.store(true, std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCountScope::stop() {
+  g_count_allocations.store(false, std::memory_order_relaxed);
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+} // namespace fluxgraph::bench
+
+void *operator new(std::size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  if (void *ptr = std::malloc(size)) {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+      g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  if (void *ptr = std::malloc(size)) {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+      g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return ::operator new(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return ::operator new[](size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace fluxgraph::bench {
+
+/// Counts global operator new calls between construction and stop().
+/// Linking allocation_counter.cpp into a benchmark executable replaces the
+/// global allocation operators for that executable.
+class AllocationCountScope {
+public:
+  AllocationCountScope();
+
+  std::uint64_t stop();
+};
+
+} // namespace fluxgraph::bench
@@ -0,0 +1,168 @@
+#include "support/perf_counters.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fluxgraph::bench {
+
+namespace {
+
+constexpr const char *kLabels[kPerfEventCount] = {
+    "Instructions", "Cycles", "L1D misses", "LLC misses", "Branch misses"};
+constexpr const char *kKeys[kPerfEventCount] = {
+    "instructions", "cycles", "l1d_misses", "llc_misses", "branch_misses"};
+
+#ifdef __linux__
+struct EventConfig {
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+constexpr EventConfig kEvents[kPerfEventCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int open_event(const EventConfig &event, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                     PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+} // namespace
+
+PerfCounterGroup::PerfCounterGroup() {
+  fds_.fill(-1);
+#ifdef __linux__
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    const int fd = open_event(kEvents[i], leader_);
+    if (fd < 0) {
+      if (i == 0) {
+        reason_ = std::string("perf_event_open: ") + std::strerror(errno);
+        return;
+      }
+      continue; // This PMU lacks the event; count the rest
+    }
+    if (ioctl(fd, PERF_EVENT_IOC_ID, &ids_[i]) != 0) {
+      close(fd);
+      continue;
+    }
+    fds_[i] = fd;
+    if (i == 0) {
+      leader_ = fd;
+    }
+  }
+#else
+  reason_ = "perf_event_open requires Linux";
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void PerfCounterGroup::start() {
+#ifdef __linux__
+  if (available()) {
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+}
+
+PerfReadings PerfCounterGroup::stop() {
+  PerfReadings readings;
+#ifdef __linux__
+  if (!available()) {
+    return readings;
+  }
+  ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  // { nr, time_enabled, time_running, { value, id }[nr] }
+  std::uint64_t buffer[3 + 2 * kPerfEventCount] = {};
+  if (read(leader_, buffer, sizeof(buffer)) <= 0) {
+    return readings;
+  }
+  const std::uint64_t count = buffer[0];
+  const std::uint64_t enabled = buffer[1];
+  const std::uint64_t running = buffer[2];
+  if (running == 0) {
+    return readings;
+  }
+  const double scale =
+      static_cast<double>(enabled) / static_cast<double>(running);
+  for (std::uint64_t n = 0; n < count && n < kPerfEventCount; ++n) {
+    const std::uint64_t value = buffer[3 + 2 * n];
+    const std::uint64_t id = buffer[4 + 2 * n];
+    for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+      if (fds_[i] >= 0 && ids_[i] == id) {
+        readings.values[i] = static_cast<double>(value) * scale;
+        readings.present[i] = true;
+      }
+    }
+  }
+#endif
+  return readings;
+}
+
+const char *perf_event_label(PerfEvent event) {
+  return kLabels[static_cast<std::size_t>(event)];
+}
+
+const char *perf_event_key(PerfEvent event) {
+  return kKeys[static_cast<std::size_t>(event)];
+}
+
+void print_perf_readings(std::ostream &out, const PerfCounterGroup &group,
+                         const PerfReadings &readings, std::uint64_t ticks) {
+  if (!group.available()) {
+    out << "  Perf counters: unavailable (" << group.unavailable_reason()
+        << ")\n\n";
+    return;
+  }
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(1);
+  for (std::size_t i = 0; i < kPerfEventCount; ++i) {
+    const auto event = static_cast<PerfEvent>(i);
+    if (readings.has(event)) {
+      out << "  " << perf_event_label(event)
+          << "/tick: " << readings.get(event) / static_cast<double>(ticks)
+          << "\n";
+    }
+  }
+  out << "\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+} // namespace fluxgraph::bench
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace fluxgraph::bench {
+
+enum class PerfEvent : std::size_t {
+  instructions,
+  cycles,
+  l1d_misses,
+  llc_misses,
+  branch_misses,
+};
+
+constexpr std::size_t kPerfEventCount = 5;
+
+/// Event counts for one measured region; an event the host cannot count is
+/// absent rather than zero.
+struct PerfReadings {
+  std::array<double, kPerfEventCount> values{};
+  std::array<bool, kPerfEventCount> present{};
+
+  bool has(PerfEvent event) const {
+    return present[static_cast<std::size_t>(event)];
+  }
+  double get(PerfEvent event) const {
+    return values[static_cast<std::size_t>(event)];
+  }
+};
+
+/// Hardware counters (user space only) read with perf_event_open on Linux.
+///
+/// The events are opened as one group so they cover the same instructions;
+/// counts are scaled if the kernel multiplexed the group. Elsewhere, or when
+/// the kernel refuses (perf_event_paranoid, containers, VMs without a PMU),
+/// available() is false and stop() returns no readings. start()/stop() do
+/// not allocate, so they can sit inside an AllocationCountScope.
+class PerfCounterGroup {
+public:
+  PerfCounterGroup();
+  ~PerfCounterGroup();
+  PerfCounterGroup(const PerfCounterGroup &) = delete;
+  PerfCounterGroup &operator=(const PerfCounterGroup &) = delete;
+
+  bool available() const { return leader_ >= 0; }
+  const std::string &unavailable_reason() const { return reason_; }
+
+  void start();
+  PerfReadings stop();
+
+private:
+  int leader_ = -1;
+  std::array<int, kPerfEventCount> fds_{};
+  std::array<std::uint64_t, kPerfEventCount> ids_{};
+  std::string reason_;
+};
+
+/// Report label and result-metric stem, e.g. "L1D misses" / "l1d_misses"
+const char *perf_event_label(PerfEvent event);
+const char *perf_event_key(PerfEvent event);
+
+/// Print "  <Label>/tick: <value>" lines for the counted events, or a single
+/// "  Perf counters: unavailable (...)" line
+void print_perf_readings(std::ostream &out, const PerfCounterGroup &group,
+                         const PerfReadings &readings, std::uint64_t ticks);
+
+} // namespace fluxgraph::bench
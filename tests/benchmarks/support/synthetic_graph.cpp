@@ -0,0 +1,148 @@
+#include "synthetic_graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace fluxgraph::bench {
+
+namespace {
+
+std::string node_path(size_t tree, size_t node) {
+  return "t" + std::to_string(tree) + "/n" + std::to_string(node);
+}
+
+// Nodes in a full tree of the given shape, capped at limit
+size_t tree_nodes(size_t fan_out, size_t depth, size_t limit) {
+  size_t total = 1;
+  size_t level = 1;
+  for (size_t d = 0; d < depth && total < limit; ++d) {
+    level = level > limit / fan_out ? limit : level * fan_out;
+    total = total > limit - level ? limit : total + level;
+  }
+  return total;
+}
+
+EdgeSpec make_edge(size_t index, size_t tree, size_t parent, size_t child,
+                   double delay_share) {
+  EdgeSpec edge;
+  edge.source_path = node_path(tree, parent);
+  edge.target_path = node_path(tree, child);
+  // Spread delay edges evenly: edge i is a delay when the running count of
+  // delays floor(i * share) steps up
+  const bool delay = std::floor(static_cast<double>(index + 1) * delay_share) >
+                     std::floor(static_cast<double>(index) * delay_share);
+  if (delay) {
+    edge.transform.type = "delay";
+    edge.transform.params["delay_sec"] = 0.05;
+  } else {
+    // Contracting map keeps values bounded along deep chains
+    edge.transform.type = "linear";
+    edge.transform.params["scale"] = 0.5;
+    edge.transform.params["offset"] = 0.1;
+  }
+  return edge;
+}
+
+ModelSpec make_model(size_t index, const std::string &type,
+                     const std::string &input, const std::string &output) {
+  ModelSpec model;
+  model.id = "m" + std::to_string(index);
+  model.type = type;
+  if (type == "thermal_mass") {
+    model.params["temp_signal"] = output;
+    model.params["power_signal"] = input;
+    model.params["ambient_signal"] = std::string("ambient");
+    model.params["thermal_mass"] = 1000.0;
+    model.params["heat_transfer_coeff"] = 10.0;
+    model.params["initial_temp"] = 25.0;
+  } else if (type == "first_order_process") {
+    model.params["input_signal"] = input;
+    model.params["output_signal"] = output;
+    model.params["gain"] = 1.0;
+    model.params["tau_s"] = 1.0;
+    model.params["initial_output"] = 0.0;
+  } else if (type == "second_order_process") {
+    model.params["input_signal"] = input;
+    model.params["output_signal"] = output;
+    model.params["gain"] = 1.0;
+    model.params["zeta"] = 0.7;
+    model.params["omega_n_rad_s"] = 2.0;
+    model.params["initial_output"] = 0.0;
+    model.params["initial_output_rate"] = 0.0;
+  } else {
+    throw std::invalid_argument("generate_synthetic_graph: unsupported model "
+                                "type '" +
+                                type + "'");
+  }
+  return model;
+}
+
+} // namespace
+
+SyntheticGraph generate_synthetic_graph(const SyntheticGraphConfig &config) {
+  if (config.edges == 0 || config.fan_out == 0 || config.chain_depth == 0) {
+    throw std::invalid_argument("generate_synthetic_graph: edges, fan_out and "
+                                "chain_depth must be positive");
+  }
+  if (!(config.delay_share >= 0.0 && config.delay_share <= 1.0)) {
+    throw std::invalid_argument(
+        "generate_synthetic_graph: delay_share must be in [0, 1]");
+  }
+  if (config.models > 0 && config.model_mix.empty()) {
+    throw std::invalid_argument(
+        "generate_synthetic_graph: model_mix is empty");
+  }
+
+  SyntheticGraph graph;
+  GraphSpec &spec = graph.spec;
+  spec.edges.reserve(config.edges);
+
+  // Heap numbering: node c's parent is (c - 1) / fan_out, so emitting
+  // c = 1, 2, ... walks each tree breadth-first
+  const size_t full_tree_edges =
+      tree_nodes(config.fan_out, config.chain_depth, config.edges + 1) - 1;
+  std::vector<size_t> last_node; // Deepest node emitted per tree
+  size_t emitted = 0;
+  while (emitted < config.edges) {
+    const size_t tree = last_node.size();
+    const size_t count = std::min(full_tree_edges, config.edges - emitted);
+    graph.input_paths.push_back(node_path(tree, 0));
+    for (size_t child = 1; child <= count; ++child) {
+      spec.edges.push_back(make_edge(emitted++, tree,
+                                     (child - 1) / config.fan_out, child,
+                                     config.delay_share));
+    }
+    last_node.push_back(count);
+    graph.signal_count += count + 1;
+  }
+  graph.tree_count = last_node.size();
+
+  bool needs_ambient = false;
+  spec.models.reserve(config.models);
+  for (size_t i = 0; i < config.models; ++i) {
+    const std::string &type = config.model_mix[i % config.model_mix.size()];
+    const size_t tree = i % graph.tree_count;
+    const std::string output = "m" + std::to_string(i) + "/out";
+    spec.models.push_back(
+        make_model(i, type, node_path(tree, last_node[tree]), output));
+    needs_ambient = needs_ambient || type == "thermal_mass";
+    ++graph.signal_count;
+  }
+  if (needs_ambient) {
+    graph.input_paths.emplace_back("ambient");
+    ++graph.signal_count;
+  }
+
+  spec.rules.reserve(config.rules);
+  for (size_t i = 0; i < config.rules; ++i) {
+    RuleSpec rule;
+    rule.id = "r" + std::to_string(i);
+    rule.condition = node_path(i % graph.tree_count, 0) + " > 1000000.0";
+    rule.on_error = "log_and_continue";
+    rule.actions.push_back(ActionSpec{"bench", "noop", {}});
+    spec.rules.push_back(std::move(rule));
+  }
+  return graph;
+}
+
+} // namespace fluxgraph::bench
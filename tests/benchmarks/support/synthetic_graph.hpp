@@ -0,0 +1,40 @@
+#pragma once
+
+#include "fluxgraph/graph/spec.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace fluxgraph::bench {
+
+/// Shape of a generated benchmark graph.
+///
+/// Edges form trees: each root is a host-written input, every signal above
+/// the deepest level has fan_out children, and a root-to-leaf path has
+/// chain_depth edges (fan_out 1 gives plain chains). Trees are generated
+/// until `edges` is reached; the last one may be partial. The signal count
+/// follows from the shape: one per tree node, plus model outputs.
+struct SyntheticGraphConfig {
+  size_t edges = 1000;
+  size_t fan_out = 1;
+  size_t chain_depth = 8;
+  size_t models = 0;  ///< Assigned round-robin from model_mix
+  std::vector<std::string> model_mix = {
+      "thermal_mass", "first_order_process", "second_order_process"};
+  size_t rules = 0;         ///< Threshold rules that never fire
+  double delay_share = 0.0; ///< Fraction of edges using a delay transform
+};
+
+struct SyntheticGraph {
+  GraphSpec spec;
+  std::vector<std::string> input_paths; ///< Signals the host must write
+  size_t signal_count = 0;
+  size_t tree_count = 0;
+};
+
+/// Deterministic: the same config always yields the same spec.
+/// @throws std::invalid_argument on zero edges/fan_out/chain_depth, a
+///         delay_share outside [0, 1] or an unsupported model type
+SyntheticGraph generate_synthetic_graph(const SyntheticGraphConfig &config);
+
+} // namespace fluxgraph::bench
@@ -2,81 +2,22 @@
 #include "fluxgraph/core/signal_store.hpp"
 #include "fluxgraph/engine.hpp"
 #include "fluxgraph/graph/compiler.hpp"
-#include <atomic>
+#include "support/allocation_counter.hpp"
+#include "support/perf_counters.hpp"
+#include "support/synthetic_graph.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
-#include <cstdlib>
 #include <iostream>
-#include <new>
+#include <random>
+#include <set>
+#include <vector>
 
 using namespace fluxgraph;
+using namespace fluxgraph::bench;
 using namespace std::chrono;
 
-namespace {
-std::atomic<bool> g_count_allocations{false};
-std::atomic<std::uint64_t> g_allocation_count{0};
-
-class AllocationCountScope {
-public:
-  AllocationCountScope() {
-    g_allocation_count.store(0, std::memory_order_relaxed);
-    g_count_allocations.store(true, std::memory_order_relaxed);
-  }
-
-  std::uint64_t stop() {
-    g_count_allocations.store(false, std::memory_order_relaxed);
-    return g_allocation_count.load(std::memory_order_relaxed);
-  }
-};
-} // namespace
-
-void *operator new(std::size_t size) {
-  if (size == 0) {
-    size = 1;
-  }
-  if (void *ptr = std::malloc(size)) {
-    if (g_count_allocations.load(std::memory_order_relaxed)) {
-      g_allocation_count.fetch_add(1, std::memory_order_relaxed);
-    }
-    return ptr;
-  }
-  throw std::bad_alloc();
-}
-
-void *operator new[](std::size_t size) {
-  if (size == 0) {
-    size = 1;
-  }
-  if (void *ptr = std::malloc(size)) {
-    if (g_count_allocations.load(std::memory_order_relaxed)) {
-      g_allocation_count.fetch_add(1, std::memory_order_relaxed);
-    }
-    return ptr;
-  }
-  throw std::bad_alloc();
-}
-
-void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
-  try {
-    return ::operator new(size);
-  } catch (...) {
-    return nullptr;
-  }
-}
-
-void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
-  try {
-    return ::operator new[](size);
-  } catch (...) {
-    return nullptr;
-  }
-}
-
-void operator delete(void *ptr) noexcept { std::free(ptr); }
-void operator delete[](void *ptr) noexcept { std::free(ptr); }
-void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
-void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
-
 void benchmark_simple_graph() {
   // Simple graph: 10 signals, 5 edges, 1 model
   SignalNamespace sig_ns;
@@ -129,13 +70,16 @@ void benchmark_simple_graph() {
 
   // Benchmark: 1000 ticks
   const int num_ticks = 1000;
+  PerfCounterGroup perf;
   AllocationCountScope alloc_scope;
   auto start = high_resolution_clock::now();
+  perf.start();
 
   for (int i = 0; i < num_ticks; ++i) {
     engine.tick(0.1, store);
   }
 
+  PerfReadings counters = perf.stop();
   auto end = high_resolution_clock::now();
   std::uint64_t allocations = alloc_scope.stop();
   auto duration_us = duration_cast<microseconds>(end - start).count();
@@ -154,6 +98,7 @@ void benchmark_simple_graph() {
   std::cout << "  Target:      0 allocations/tick [memory]\n";
   std::cout << "  Status:      " << (allocations == 0 ? "PASS" : "FAIL")
             << "\n\n";
+  print_perf_readings(std::cout, perf, counters, num_ticks);
 }
 
 void benchmark_complex_graph() {
@@ -215,13 +160,16 @@ void benchmark_complex_graph() {
 
   // Benchmark: 100 ticks (fewer for complex graph)
   const int num_ticks = 100;
+  PerfCounterGroup perf;
   AllocationCountScope alloc_scope;
   auto start = high_resolution_clock::now();
+  perf.start();
 
   for (int i = 0; i < num_ticks; ++i) {
     engine.tick(0.1, store);
   }
 
+  PerfReadings counters = perf.stop();
   auto end = high_resolution_clock::now();
   std::uint64_t allocations = alloc_scope.stop();
   auto duration_us = duration_cast<microseconds>(end - start).count();
@@ -240,6 +188,160 @@ void benchmark_complex_graph() {
   std::cout << "  Target:      0 allocations/tick [memory]\n";
   std::cout << "  Status:      " << (allocations == 0 ? "PASS" : "FAIL")
             << "\n\n";
+  print_perf_readings(std::cout, perf, counters, num_ticks);
+}
+
+namespace {
+
+struct LocalityRun {
+  double avg_us = 0.0;
+  size_t schedule_bytes = 0; ///< Edge and model vectors
+  size_t arena_used = 0;
+  size_t arena_reserved = 0;
+  size_t component_span = 0; ///< Lowest to highest component address
+  size_t cache_lines = 0;    ///< Distinct lines holding a component start
+  size_t backward_steps = 0; ///< Tick-order steps to a lower address
+  size_t components = 0;
+  double signal_stride = 0.0; ///< Mean id distance between edge accesses
+};
+
+LocalityRun run_locality(const SyntheticGraph &graph, bool arena,
+                         SignalLayout layout = SignalLayout::interning_order) {
+  SignalNamespace sig_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  CompilationOptions options;
+  options.component_arena = arena;
+  options.signal_layout = layout;
+
+  GraphCompiler compiler;
+  auto program = compiler.compile(graph.spec, sig_ns, func_ns, options);
+
+  LocalityRun run;
+  run.schedule_bytes = program.edges.capacity() * sizeof(CompiledEdge) +
+                       program.models.capacity() * sizeof(ModelPtr);
+  run.arena_used = program.arena.bytes_used();
+  run.arena_reserved = program.arena.bytes_reserved();
+
+  // Addresses in the order a tick visits them: models, then edges
+  std::vector<uintptr_t> addresses;
+  for (const auto &model : program.models) {
+    addresses.push_back(reinterpret_cast<uintptr_t>(model.get()));
+  }
+  for (const auto &edge : program.edges) {
+    addresses.push_back(reinterpret_cast<uintptr_t>(edge.transform.get()));
+  }
+  std::set<uintptr_t> lines;
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    lines.insert(addresses[i] / ComponentArena::kCacheLine);
+    if (i > 0 && addresses[i] < addresses[i - 1]) {
+      ++run.backward_steps;
+    }
+  }
+  const auto [lowest, highest] =
+      std::minmax_element(addresses.begin(), addresses.end());
+  run.component_span = static_cast<size_t>(*highest - *lowest);
+  run.cache_lines = lines.size();
+  run.components = addresses.size();
+
+  // Signal slots in the order edges read and write them
+  std::vector<SignalId> accesses;
+  for (const auto &edge : program.edges) {
+    accesses.push_back(edge.source);
+    accesses.push_back(edge.target);
+  }
+  double stride = 0.0;
+  for (size_t i = 1; i < accesses.size(); ++i) {
+    stride += std::abs(static_cast<double>(accesses[i]) -
+                       static_cast<double>(accesses[i - 1]));
+  }
+  run.signal_stride =
+      accesses.size() > 1 ? stride / static_cast<double>(accesses.size() - 1)
+                          : 0.0;
+
+  Engine engine;
+  engine.load(std::move(program));
+  for (const std::string &path : graph.input_paths) {
+    store.write(sig_ns.resolve(path), 1.0, "dimensionless");
+  }
+  for (int i = 0; i < 10; ++i) {
+    engine.tick(0.01, store);
+  }
+
+  const int num_ticks = 200;
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < num_ticks; ++i) {
+    engine.tick(0.01, store);
+  }
+  auto end = high_resolution_clock::now();
+  run.avg_us = static_cast<double>(
+                   duration_cast<nanoseconds>(end - start).count()) /
+               1000.0 / num_ticks;
+  return run;
+}
+
+void print_locality(const char *label, const LocalityRun &run) {
+  std::cout << "  " << label << ":\n";
+  std::cout << "    Avg/tick:        " << run.avg_us << " us\n";
+  std::cout << "    Footprint:       " << run.schedule_bytes + run.arena_used
+            << " bytes (schedule " << run.schedule_bytes << " + arena "
+            << run.arena_used << " of " << run.arena_reserved
+            << " reserved";
+  if (run.arena_used == 0) {
+    std::cout << "; " << run.components << " heap objects not counted";
+  }
+  std::cout << ")\n";
+  std::cout << "    Component span:  " << run.component_span << " bytes\n";
+  std::cout << "    Cache lines:     " << run.cache_lines << " for "
+            << run.components << " components\n";
+  std::cout << "    Backward steps:  " << run.backward_steps << "\n";
+  std::cout << "    Signal stride:   " << run.signal_stride << " ids\n";
+}
+
+} // namespace
+
+void benchmark_component_locality() {
+  // Components in the compiler's arena versus one heap allocation each
+  SyntheticGraphConfig config;
+  config.edges = 20000;
+  config.fan_out = 2;
+  config.chain_depth = 8;
+  config.models = 300;
+  const SyntheticGraph graph = generate_synthetic_graph(config);
+
+  const LocalityRun heap = run_locality(graph, false);
+  const LocalityRun arena = run_locality(graph, true);
+
+  std::cout << "Component Locality (" << graph.signal_count << " signals, "
+            << config.edges << " edges, " << config.models << " models):\n";
+  print_locality("Arena", arena);
+  print_locality("Heap (component_arena = false)", heap);
+  std::cout << "  Speedup:         " << heap.avg_us / arena.avg_us << "x\n\n";
+}
+
+void benchmark_signal_layout() {
+  // The locality graph with its edges and signals declared in shuffled
+  // order, so interning order no longer follows the schedule
+  SyntheticGraphConfig config;
+  config.edges = 20000;
+  config.fan_out = 2;
+  config.chain_depth = 8;
+  config.models = 300;
+  SyntheticGraph graph = generate_synthetic_graph(config);
+  std::mt19937 rng(42);
+  std::shuffle(graph.spec.edges.begin(), graph.spec.edges.end(), rng);
+  std::shuffle(graph.spec.signals.begin(), graph.spec.signals.end(), rng);
+
+  const LocalityRun interned = run_locality(graph, true);
+  const LocalityRun laid_out =
+      run_locality(graph, true, SignalLayout::execution_order);
+
+  std::cout << "Signal Layout (shuffled spec, " << graph.signal_count
+            << " signals, " << config.edges << " edges):\n";
+  print_locality("interning_order", interned);
+  print_locality("execution_order", laid_out);
+  std::cout << "  Speedup:         " << interned.avg_us / laid_out.avg_us
+            << "x\n\n";
 }
 
 int main() {
@@ -248,6 +350,8 @@ int main() {
 
   benchmark_simple_graph();
   benchmark_complex_graph();
+  benchmark_component_locality();
+  benchmark_signal_layout();
 
   return 0;
 }
@@ -1,9 +1,11 @@
 #ifdef FLUXGRAPH_YAML_ENABLED
 
 #include "fluxgraph/loaders/yaml_loader.hpp"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 using namespace fluxgraph::loaders;
 using namespace std::chrono;
@@ -39,12 +41,49 @@ std::string generate_yaml_graph(int num_edges, int num_models) {
   return oss.str();
 }
 
+// Generated multi-MB document using every top-level section, with nested
+// transform params so the param conversion path is exercised
+std::string generate_large_yaml_graph(int num_edges, int num_models) {
+  std::ostringstream oss;
+
+  oss << "signals:\n";
+  for (int i = 0; i < num_edges; ++i) {
+    oss << "  - path: signal_" << i << ".output\n";
+    oss << "    unit: degC\n";
+  }
+
+  oss << generate_yaml_graph(num_edges, num_models);
+  for (int i = 0; i < num_edges; ++i) {
+    oss << "  - source: signal_" << i << ".output\n";
+    oss << "    target: filtered_" << i << ".value\n";
+    oss << "    transform:\n";
+    oss << "      type: first_order_lag\n";
+    oss << "      params:\n";
+    oss << "        tau_s: 0.5\n";
+    oss << "        limits: {min: -40.0, max: 150.0}\n";
+    oss << "        taps: [0.25, 0.5, 0.25]\n";
+  }
+
+  oss << "rules:\n";
+  for (int i = 0; i < num_models; ++i) {
+    oss << "  - id: overheat_" << i << "\n";
+    oss << "    condition: model_" << i << ".temp > 100.0\n";
+    oss << "    actions:\n";
+    oss << "      - device: heater_" << i << "\n";
+    oss << "        function: shutdown\n";
+    oss << "        args: {reason: overheat}\n";
+  }
+
+  return oss.str();
+}
+
 void benchmark_yaml_loader(const std::string &name, const std::string &yaml,
-                           int iterations) {
+                           int iterations,
+                           const YamlLoadOptions &options = {}) {
   auto start = high_resolution_clock::now();
 
   for (int i = 0; i < iterations; ++i) {
-    auto spec = load_yaml_string(yaml);
+    auto spec = load_yaml_string(yaml, options);
     (void)spec; // Prevent optimization
   }
 
@@ -76,6 +115,21 @@ int main() {
   std::string large_yaml = generate_yaml_graph(1000, 50);
   benchmark_yaml_loader("Large graph (1000 edges, 50 models)", large_yaml, 100);
 
+  // Generated multi-MB documents: sequential vs split parallel parse
+  const unsigned threads = std::max(2U, std::thread::hardware_concurrency());
+  YamlLoadOptions sequential;
+  sequential.threads = 1;
+  YamlLoadOptions parallel;
+  parallel.threads = threads;
+
+  std::string xl_yaml = generate_large_yaml_graph(10000, 500);
+  std::cout << "Generated graph size: " << xl_yaml.size() / 1024 << " KiB\n\n";
+  benchmark_yaml_loader("XL graph (20000 edges, 500 models, sequential)",
+                        xl_yaml, 3, sequential);
+  benchmark_yaml_loader("XL graph (20000 edges, 500 models, " +
+                            std::to_string(threads) + " threads)",
+                        xl_yaml, 3, parallel);
+
   std::cout << "All YAML loader benchmarks complete.\n";
 
   return 0;
@@ -0,0 +1,164 @@
+// Runs equivalence_graph_spec() through the program generated at build time
+// and through the interpreter, and compares every signal after each tick.
+
+#include "equivalence_graph.hpp"
+#include "fluxgraph/engine.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/transform/linear.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace fluxgraph;
+using namespace fluxgraph::codegen_test;
+
+namespace {
+
+struct Instance {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  Engine engine;
+
+  explicit Instance(bool generated, const GraphSpec &spec) {
+    GraphCompiler compiler;
+    engine.load(compiler.compile(spec, signal_ns, func_ns));
+    engine.set_generated_programs(generated);
+  }
+};
+
+void drive(Instance &instance, int step) {
+  const double t = 0.01 * step;
+  const double values[] = {40.0 * std::sin(0.9 * t) + 20.0 * std::sin(7.0 * t),
+                           20.0 + 3.0 * std::sin(0.05 * t),
+                           25.0 + 60.0 * std::sin(0.3 * t)};
+  const auto inputs = equivalence_graph_inputs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    instance.store.write(instance.signal_ns.resolve(inputs[i].path), values[i],
+                         inputs[i].unit);
+  }
+}
+
+void expect_same_signals(const Instance &generated,
+                         const Instance &interpreted, int step) {
+  ASSERT_EQ(generated.signal_ns.size(), interpreted.signal_ns.size());
+  for (SignalId id = 0; id < generated.signal_ns.size(); ++id) {
+    EXPECT_DOUBLE_EQ(generated.store.read_value(id),
+                     interpreted.store.read_value(id))
+        << generated.signal_ns.lookup(id) << " at step " << step;
+  }
+}
+
+// Subclass of a folded built-in; its override must not be folded away
+class OffsetLinearTransform : public LinearTransform {
+public:
+  using LinearTransform::LinearTransform;
+
+  double apply(double input, double dt) override {
+    return LinearTransform::apply(input, dt) + 1.0;
+  }
+  ITransform *clone() const override {
+    return new OffsetLinearTransform(*this);
+  }
+};
+
+void register_offset_linear() {
+  const std::string type = "test.codegen.offset_linear";
+  if (GraphCompiler::is_transform_registered(type)) {
+    return;
+  }
+  GraphCompiler::register_transform_factory(
+      type, [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+        return std::make_unique<OffsetLinearTransform>(
+            std::get<double>(spec.params.at("scale")),
+            std::get<double>(spec.params.at("offset")));
+      });
+}
+
+void run_in_lockstep(Instance &generated, Instance &interpreted, int steps) {
+  for (int step = 0; step < steps; ++step) {
+    drive(generated, step);
+    drive(interpreted, step);
+    generated.engine.tick(0.01, generated.store);
+    interpreted.engine.tick(0.01, interpreted.store);
+    expect_same_signals(generated, interpreted, step);
+    if (::testing::Test::HasFailure()) {
+      return;
+    }
+  }
+}
+
+} // namespace
+
+TEST(CodegenEquivalenceTest, GeneratedProgramBindsToMatchingGraph) {
+  Instance generated(true, equivalence_graph_spec());
+  EXPECT_TRUE(generated.engine.generated_program_active());
+}
+
+TEST(CodegenEquivalenceTest, GeneratedMatchesInterpretedTicks) {
+  const GraphSpec spec = equivalence_graph_spec();
+  Instance generated(true, spec);
+  Instance interpreted(false, spec);
+  ASSERT_TRUE(generated.engine.generated_program_active());
+  ASSERT_FALSE(interpreted.engine.generated_program_active());
+
+  run_in_lockstep(generated, interpreted, 2000);
+
+  generated.engine.set_state_hashing(true);
+  interpreted.engine.set_state_hashing(true);
+  run_in_lockstep(generated, interpreted, 10);
+  EXPECT_EQ(generated.engine.last_state_hash(),
+            interpreted.engine.last_state_hash());
+}
+
+TEST(CodegenEquivalenceTest, ResetAndProfiledTicksStayInStep) {
+  const GraphSpec spec = equivalence_graph_spec();
+  Instance generated(true, spec);
+  Instance interpreted(false, spec);
+  run_in_lockstep(generated, interpreted, 300);
+
+  // Reset acts on the components the generated code is bound to
+  generated.engine.reset();
+  interpreted.engine.reset();
+  run_in_lockstep(generated, interpreted, 300);
+
+  // Sampled ticks are interpreted; unsampled ones stay generated
+  ProfilerOptions options;
+  options.sample_interval = 3;
+  generated.engine.enable_profiling(options);
+  run_in_lockstep(generated, interpreted, 300);
+  EXPECT_TRUE(generated.engine.generated_program_active());
+}
+
+TEST(CodegenEquivalenceTest, ChangedFoldedParameterFallsBackToInterpreter) {
+  GraphSpec spec = equivalence_graph_spec();
+  spec.edges[0].transform.params["scale"] = 12.0;
+
+  Instance changed(true, spec);
+  EXPECT_FALSE(changed.engine.generated_program_active());
+
+  Instance interpreted(false, spec);
+  run_in_lockstep(changed, interpreted, 50);
+}
+
+TEST(CodegenEquivalenceTest, SubclassOfBuiltinDoesNotBind) {
+  register_offset_linear();
+  GraphSpec spec = equivalence_graph_spec();
+  spec.edges[0].transform.type = "test.codegen.offset_linear";
+
+  // Same layout hash and constants, but not exactly a LinearTransform
+  Instance subclassed(true, spec);
+  EXPECT_FALSE(subclassed.engine.generated_program_active());
+
+  Instance interpreted(false, spec);
+  run_in_lockstep(subclassed, interpreted, 50);
+}
+
+TEST(CodegenEquivalenceTest, ChangedLayoutDoesNotBind) {
+  GraphSpec spec = equivalence_graph_spec();
+  spec.edges.pop_back();
+
+  Instance changed(true, spec);
+  EXPECT_FALSE(changed.engine.generated_program_active());
+}
@@ -0,0 +1,116 @@
+#include "equivalence_graph.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/transform/interface.hpp"
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace fluxgraph::codegen_test {
+
+namespace {
+
+// Extension type the generator does not know; exercises the virtual path
+class SoftClipTransform : public ITransform {
+public:
+  explicit SoftClipTransform(double knee) : knee_(knee) {}
+
+  double apply(double input, double) override {
+    return knee_ * std::tanh(input / knee_);
+  }
+  void reset() override {}
+  ITransform *clone() const override { return new SoftClipTransform(*this); }
+
+private:
+  double knee_;
+};
+
+void register_soft_clip() {
+  const std::string type = "test.codegen.soft_clip";
+  if (GraphCompiler::is_transform_registered(type)) {
+    return;
+  }
+  GraphCompiler::register_transform_factory(
+      type, [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+        const auto it = spec.params.find("knee");
+        if (it == spec.params.end() ||
+            !std::holds_alternative<double>(it->second)) {
+          throw std::runtime_error("test.codegen.soft_clip: missing knee");
+        }
+        return std::make_unique<SoftClipTransform>(
+            std::get<double>(it->second));
+      });
+}
+
+EdgeSpec edge(std::string source, std::string target, std::string type,
+              ParamMap params) {
+  EdgeSpec out;
+  out.source_path = std::move(source);
+  out.target_path = std::move(target);
+  out.transform.type = std::move(type);
+  out.transform.params = std::move(params);
+  return out;
+}
+
+} // namespace
+
+GraphSpec equivalence_graph_spec() {
+  register_soft_clip();
+
+  GraphSpec spec;
+  spec.signals.push_back(SignalSpec{"probe.temp_c", "degC"});
+  spec.signals.push_back(SignalSpec{"probe.temp_k", "K"});
+
+  ModelSpec thermal;
+  thermal.id = "chamber";
+  thermal.type = "thermal_mass";
+  thermal.params["temp_signal"] = std::string("chamber.temp");
+  thermal.params["power_signal"] = std::string("chamber.power");
+  thermal.params["ambient_signal"] = std::string("ambient");
+  thermal.params["thermal_mass"] = 1000.0;
+  thermal.params["heat_transfer_coeff"] = 10.0;
+  thermal.params["initial_temp"] = 25.0;
+  spec.models.push_back(thermal);
+
+  // Heater command conditioning (folded)
+  spec.edges.push_back(edge("cmd.raw", "cmd.scaled", "linear",
+                            {{"scale", 12.5}, {"offset", -0.1}}));
+  spec.edges.push_back(edge("cmd.scaled", "cmd.clamped", "linear",
+                            {{"scale", 1.0},
+                             {"offset", 0.0},
+                             {"clamp_min", 0.0},
+                             {"clamp_max", 800.0}}));
+  spec.edges.push_back(edge("cmd.clamped", "cmd.limited", "rate_limiter",
+                            {{"max_rate", 400.0}}));
+  spec.edges.push_back(edge("cmd.limited", "chamber.power", "saturation",
+                            {{"min", 0.0}, {"max", 750.0}}));
+
+  // Sensor chain on the model output (direct)
+  spec.edges.push_back(edge("chamber.temp", "sensor.lagged",
+                            "first_order_lag", {{"tau_s", 0.7}}));
+  spec.edges.push_back(edge("sensor.lagged", "sensor.noisy", "noise",
+                            {{"amplitude", 0.05}, {"seed", int64_t{7}}}));
+  spec.edges.push_back(edge("sensor.noisy", "sensor.smoothed",
+                            "moving_average", {{"window_size", int64_t{5}}}));
+  spec.edges.push_back(edge("sensor.smoothed", "sensor.delayed", "delay",
+                            {{"delay_sec", 0.3}}));
+  spec.edges.push_back(edge("sensor.delayed", "sensor.error", "linear",
+                            {{"scale", -1.0}, {"offset", 40.0}}));
+  spec.edges.push_back(edge("sensor.error", "sensor.error_db", "deadband",
+                            {{"threshold", 0.25}}));
+
+  // Fan-out from one source and a unit conversion (folded)
+  spec.edges.push_back(edge("probe.temp_c", "probe.temp_k", "unit_convert",
+                            {{"to_unit", std::string("K")}}));
+  spec.edges.push_back(edge("probe.temp_c", "probe.clipped",
+                            "test.codegen.soft_clip", {{"knee", 30.0}}));
+  return spec;
+}
+
+std::vector<DrivenSignal> equivalence_graph_inputs() {
+  return {{"cmd.raw", "dimensionless"},
+          {"ambient", "degC"},
+          {"probe.temp_c", "degC"}};
+}
+
+} // namespace fluxgraph::codegen_test
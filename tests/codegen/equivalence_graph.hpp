@@ -0,0 +1,22 @@
+#pragma once
+
+#include "fluxgraph/graph/spec.hpp"
+#include <string>
+#include <vector>
+
+namespace fluxgraph::codegen_test {
+
+/// Graph covering every emission path of fluxgraph-codegen: folded
+/// transforms (with and without clamps), direct stateful transforms, a
+/// built-in model and an extension transform called through ITransform.
+/// Registers the extension transform type on first use.
+GraphSpec equivalence_graph_spec();
+
+/// Externally driven signals of equivalence_graph_spec(), with units
+struct DrivenSignal {
+  std::string path;
+  std::string unit;
+};
+std::vector<DrivenSignal> equivalence_graph_inputs();
+
+} // namespace fluxgraph::codegen_test
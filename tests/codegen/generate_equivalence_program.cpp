@@ -0,0 +1,42 @@
+// Build-time step of codegen_equivalence_test: emits the generated program
+// for equivalence_graph_spec() through the same emitter as fluxgraph-codegen
+
+#include "equivalence_graph.hpp"
+#include "fluxgraph/codegen/cpp_emitter.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    std::cerr << "usage: " << argv[0] << " <generated.cpp>\n";
+    return 2;
+  }
+
+  try {
+    fluxgraph::SignalNamespace signal_ns;
+    fluxgraph::FunctionNamespace func_ns;
+    fluxgraph::GraphCompiler compiler;
+    const fluxgraph::CompiledProgram program = compiler.compile(
+        fluxgraph::codegen_test::equivalence_graph_spec(), signal_ns, func_ns);
+
+    fluxgraph::codegen::CppEmitOptions options;
+    options.source_label = "equivalence_graph_spec()";
+    // Small chunks so the test also covers multi-function emission
+    options.components_per_function = 4;
+    const auto result =
+        fluxgraph::codegen::emit_cpp(program, signal_ns, options);
+
+    std::ofstream out(argv[1], std::ios::binary);
+    out << result.source;
+    if (!out) {
+      std::cerr << "error: failed writing " << argv[1] << "\n";
+      return 1;
+    }
+    return 0;
+  } catch (const std::exception &ex) {
+    std::cerr << "error: " << ex.what() << "\n";
+    return 1;
+  }
+}
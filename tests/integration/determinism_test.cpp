@@ -375,3 +375,48 @@ TEST(DeterminismTest, RegisteredCustomTransformIsDeterministic) {
     EXPECT_DOUBLE_EQ(run1[i], run2[i]) << "Mismatch at tick " << i;
   }
 }
+
+TEST(DeterminismTest, RedundantInstancesAgreeOnStateHashEveryTick) {
+  // Redundant instances compare a 64-bit digest per tick instead of values
+
+  GraphSpec spec;
+  ModelSpec model;
+  model.id = "thermal";
+  model.type = "thermal_mass";
+  model.params["temp_signal"] = std::string("chamber.temp");
+  model.params["power_signal"] = std::string("chamber.power");
+  model.params["ambient_signal"] = std::string("ambient");
+  model.params["thermal_mass"] = 1000.0;
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  spec.models.push_back(model);
+
+  EdgeSpec edge;
+  edge.source_path = "chamber.temp";
+  edge.target_path = "chamber.temp_filtered";
+  edge.transform.type = "first_order_lag";
+  edge.transform.params["tau_s"] = 1.0;
+  spec.edges.push_back(edge);
+
+  SignalNamespace ns1, ns2;
+  FunctionNamespace fn1, fn2;
+  SignalStore store1, store2;
+  Engine engine1, engine2;
+  GraphCompiler compiler;
+  engine1.load(compiler.compile(spec, ns1, fn1));
+  engine2.load(compiler.compile(spec, ns2, fn2));
+  engine1.set_state_hashing(true);
+  engine2.set_state_hashing(true);
+
+  store1.write(ns1.resolve("ambient"), 20.0, "degC");
+  store2.write(ns2.resolve("ambient"), 20.0, "degC");
+  for (int i = 0; i < 1000; ++i) {
+    const double power = 50.0 * static_cast<double>(i % 11);
+    store1.write(ns1.resolve("chamber.power"), power, "W");
+    store2.write(ns2.resolve("chamber.power"), power, "W");
+    engine1.tick(0.1, store1);
+    engine2.tick(0.1, store2);
+    ASSERT_EQ(engine1.last_state_hash(), engine2.last_state_hash())
+        << "Diverged at tick " << i;
+  }
+}
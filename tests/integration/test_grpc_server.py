@@ -4,7 +4,7 @@ import grpc
 import pytest
 import subprocess
 import time
-from typing import Any, cast
+from typing import Any, Iterator, List, cast
 
 
 def _pb() -> Any:
@@ -61,15 +61,14 @@ def _register_provider(grpc_stub: Any, pb: Any, provider_id: str = "sim_test") -
     return cast(str, response.session_id)
 
 
-@pytest.fixture
-def grpc_stub_dt_025(server_exe: Any, free_port: int, proto_bindings: Any) -> Any:
-    """Start a dedicated server instance with --dt=0.25 and return a stub."""
+def _spawn_server_stub(server_exe: Any, port: int, extra_args: List[str]) -> Iterator[Any]:
+    """Start a dedicated server instance with extra CLI args and yield a stub."""
     import fluxgraph_pb2 as pb
     import fluxgraph_pb2_grpc as pb_grpc
 
-    address = f"127.0.0.1:{free_port}"
+    address = f"127.0.0.1:{port}"
     proc = subprocess.Popen(
-        [str(server_exe), "--port", str(free_port), "--dt", "0.25"],
+        [str(server_exe), "--port", str(port), *extra_args],
         stdout=subprocess.PIPE,
         stderr=subprocess.PIPE,
         text=True,
@@ -96,7 +95,7 @@ def grpc_stub_dt_025(server_exe: Any, free_port: int, proto_bindings: Any) -> An
     if not ready:
         proc.terminate()
         out, err = proc.communicate(timeout=2)
-        pytest.fail(f"Server failed readiness with --dt=0.25.\nstdout:\n{out}\nstderr:\n{err}")
+        pytest.fail(f"Server failed readiness with {extra_args}.\nstdout:\n{out}\nstderr:\n{err}")
 
     try:
         yield stub
@@ -110,6 +109,24 @@ def grpc_stub_dt_025(server_exe: Any, free_port: int, proto_bindings: Any) -> An
                 proc.kill()
 
 
+@pytest.fixture
+def grpc_stub_dt_025(server_exe: Any, free_port: int, proto_bindings: Any) -> Any:
+    """Start a dedicated server instance with --dt=0.25 and return a stub."""
+    yield from _spawn_server_stub(server_exe, free_port, ["--dt", "0.25"])
+
+
+@pytest.fixture
+def grpc_stub_barrier_deadline(server_exe: Any, free_port: int, proto_bindings: Any) -> Any:
+    """Start a dedicated server instance with a 200 ms barrier deadline."""
+    yield from _spawn_server_stub(server_exe, free_port, ["--barrier-deadline-ms", "200"])
+
+
+@pytest.fixture
+def grpc_stub_realtime(server_exe: Any, free_port: int, proto_bindings: Any) -> Any:
+    """Start a dedicated server instance ticking freely at 50 Hz wall clock."""
+    yield from _spawn_server_stub(server_exe, free_port, ["--dt", "0.1", "--realtime", "--rate", "50"])
+
+
 @pytest.mark.integration
 @pytest.mark.slow
 def test_server_health_check(grpc_stub: Any) -> None:
@@ -177,6 +194,22 @@ def test_signal_lifecycle(grpc_stub: Any) -> None:
     assert read.signals[0].unit == "W"
 
 
+@pytest.mark.integration
+def test_read_signals_expands_glob_patterns(grpc_stub: Any) -> None:
+    """Wildcard patterns return every matching signal in path order."""
+    pb = _pb()
+    _load_config(grpc_stub, pb)
+
+    read = grpc_stub.ReadSignals(
+        pb.SignalRequest(paths=["heater.output"], patterns=["chamber.*", "missing.*"])
+    )
+    assert [s.path for s in read.signals] == [
+        "heater.output",
+        "chamber.power",
+        "chamber.temp",
+    ]
+
+
 @pytest.mark.integration
 def test_invalid_config_handling(grpc_stub: Any) -> None:
     """Verify malformed YAML is rejected with INVALID_ARGUMENT."""
@@ -267,6 +300,68 @@ def test_dt_flag_controls_runtime_timestep(grpc_stub_dt_025: Any) -> None:
     assert tick2.sim_time_sec == pytest.approx(0.50)
 
 
+@pytest.mark.integration
+def test_reject_writes_to_templated_targets(grpc_stub: Any) -> None:
+    """Write authority covers signals stamped out by template instances."""
+    pb = _pb()
+    templated_yaml = """
+templates:
+  - name: zone
+    signals:
+      - path: ${prefix}.power
+        unit: W
+    models:
+      - id: ${prefix}.mass
+        type: thermal_mass
+        params:
+          temp_signal: ${prefix}.temp
+          power_signal: ${prefix}.power
+          ambient_signal: ambient.temp
+          thermal_mass: 1000.0
+          heat_transfer_coeff: 10.0
+          initial_temp: 25.0
+    edges:
+      - source: ${prefix}.command
+        target: ${prefix}.power
+        transform:
+          type: linear
+          params:
+            scale: 1.0
+            offset: 0.0
+
+instances:
+  - template: zone
+    prefix: zone1
+"""
+    response = grpc_stub.LoadConfig(
+        pb.ConfigRequest(
+            config_content=templated_yaml,
+            format="yaml",
+            config_hash="templated_cfg",
+        )
+    )
+    assert response.success
+    session_id = _register_provider(grpc_stub, pb, provider_id="provider_templated")
+
+    for path, unit in (("zone1.power", "W"), ("zone1.temp", "degC")):
+        with pytest.raises(grpc.RpcError) as exc_info:
+            grpc_stub.UpdateSignals(
+                pb.SignalUpdates(
+                    session_id=session_id,
+                    signals=[pb.SignalUpdate(path=path, value=1.0, unit=unit)],
+                )
+            )
+        assert exc_info.value.code() == grpc.StatusCode.PERMISSION_DENIED
+
+    accepted = grpc_stub.UpdateSignals(
+        pb.SignalUpdates(
+            session_id=session_id,
+            signals=[pb.SignalUpdate(path="zone1.command", value=5.0, unit="W")],
+        )
+    )
+    assert accepted.tick_occurred
+
+
 @pytest.mark.integration
 def test_stability_validation_rejects_unsafe_dt(grpc_stub: Any) -> None:
     """LoadConfig should fail when model stability limit is below runtime dt."""
@@ -295,3 +390,379 @@ models:
 
     assert exc_info.value.code() == grpc.StatusCode.INVALID_ARGUMENT
     assert "Stability violation" in exc_info.value.details()
+
+
+@pytest.mark.integration
+def test_subscribe_pushes_filtered_changes(grpc_stub: Any) -> None:
+    """Subscribe streams an initial frame, then only changes past the deadband."""
+    pb = _pb()
+    _load_config(grpc_stub, pb)
+    session_id = _register_provider(grpc_stub, pb, provider_id="provider_subscribe")
+
+    stream = grpc_stub.Subscribe(
+        pb.SubscribeRequest(
+            signals=[
+                pb.SignalSubscription(path="heater.output", deadband=10.0),
+                pb.SignalSubscription(path="chamber.power"),
+            ]
+        )
+    )
+
+    try:
+        initial = next(stream)
+        assert {s.path for s in initial.signals} == {"heater.output", "chamber.power"}
+
+        def push(value: float) -> None:
+            tick = grpc_stub.UpdateSignals(
+                pb.SignalUpdates(
+                    session_id=session_id,
+                    signals=[pb.SignalUpdate(path="heater.output", value=value, unit="W")],
+                )
+            )
+            assert tick.tick_occurred
+
+        push(500.0)
+        first = next(stream)
+        assert first.tick_generation == 1
+        assert {s.path: s.value for s in first.signals} == pytest.approx(
+            {"heater.output": 500.0, "chamber.power": 500.0}
+        )
+
+        # Below deadband for heater.output, but chamber.power has no deadband.
+        push(505.0)
+        second = next(stream)
+        assert second.tick_generation == 2
+        assert [s.path for s in second.signals] == ["chamber.power"]
+        assert second.signals[0].value == pytest.approx(505.0)
+    finally:
+        stream.cancel()
+
+
+@pytest.mark.integration
+def test_subscribe_reports_units_written_after_subscribing(grpc_stub: Any) -> None:
+    """Pushed units follow the first write, not the unit seen at subscribe time."""
+    pb = _pb()
+    _load_config(grpc_stub, pb)
+    session_id = _register_provider(grpc_stub, pb, provider_id="provider_sub_units")
+
+    stream = grpc_stub.Subscribe(
+        pb.SubscribeRequest(
+            signals=[
+                pb.SignalSubscription(path="heater.output"),
+                pb.SignalSubscription(path="chamber.power"),
+            ]
+        )
+    )
+
+    try:
+        initial = next(stream)
+        assert {s.path: s.unit for s in initial.signals} == {
+            "heater.output": "dimensionless",
+            "chamber.power": "dimensionless",
+        }
+
+        tick = grpc_stub.UpdateSignals(
+            pb.SignalUpdates(
+                session_id=session_id,
+                signals=[pb.SignalUpdate(path="heater.output", value=250.0, unit="W")],
+            )
+        )
+        assert tick.tick_occurred
+
+        first = next(stream)
+        assert {s.path: s.unit for s in first.signals} == {
+            "heater.output": "W",
+            "chamber.power": "W",
+        }
+    finally:
+        stream.cancel()
+
+
+@pytest.mark.integration
+def test_subscribe_rejects_unknown_signal(grpc_stub: Any) -> None:
+    """Subscribe fails fast for paths that are not in the loaded graph."""
+    pb = _pb()
+    _load_config(grpc_stub, pb)
+
+    stream = grpc_stub.Subscribe(
+        pb.SubscribeRequest(signals=[pb.SignalSubscription(path="does.not.exist")])
+    )
+    with pytest.raises(grpc.RpcError) as exc_info:
+        next(stream)
+    assert exc_info.value.code() == grpc.StatusCode.INVALID_ARGUMENT
+
+
+@pytest.mark.integration
+def test_realtime_mode_ticks_without_providers(grpc_stub_realtime: Any) -> None:
+    """Free-running mode advances time with zero providers; writes are staged."""
+    pb = _pb()
+    _load_config(grpc_stub_realtime, pb, config_hash="cfg_realtime")
+
+    time.sleep(0.5)
+    session_id = _register_provider(grpc_stub_realtime, pb, provider_id="provider_rt")
+
+    update = grpc_stub_realtime.UpdateSignals(
+        pb.SignalUpdates(
+            session_id=session_id,
+            signals=[pb.SignalUpdate(path="heater.output", value=250.0, unit="W")],
+        )
+    )
+    # Ticks happened before this provider ever wrote anything.
+    assert update.sim_time_sec > 0.0
+
+    time.sleep(0.2)
+    read = grpc_stub_realtime.ReadSignals(pb.SignalRequest(paths=["chamber.power"]))
+    assert read.signals[0].value == pytest.approx(250.0)
+
+
+@pytest.mark.integration
+def test_barrier_deadline_holds_late_provider_inputs(grpc_stub_barrier_deadline: Any) -> None:
+    """A jittery provider no longer stalls the tick past the barrier deadline."""
+    pb = _pb()
+    stub = grpc_stub_barrier_deadline
+    _load_config(stub, pb, config_hash="cfg_barrier_deadline")
+    fast = _register_provider(stub, pb, provider_id="fast")
+    slow = stub.RegisterProvider(pb.ProviderRegistration(provider_id="slow", device_ids=["heater1"])).session_id
+
+    start = time.time()
+    tick = stub.UpdateSignals(
+        pb.SignalUpdates(
+            session_id=fast,
+            signals=[pb.SignalUpdate(path="heater.output", value=100.0, unit="W")],
+        )
+    )
+    assert tick.tick_occurred
+    assert time.time() - start < 1.5
+    assert list(tick.late_providers) == ["slow"]
+    assert tick.inputs_held_ticks == 0
+
+    # The slow provider's next update reports the tick it missed.
+    late = stub.UpdateSignals(pb.SignalUpdates(session_id=slow))
+    assert late.tick_occurred
+    assert late.inputs_held_ticks == 1
+
+
+@pytest.mark.integration
+def test_instances_are_isolated(grpc_stub_dt_025: Any) -> None:
+    """Independent instance_ids get their own store, providers and sim time."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+
+    for instance_id in ("tenant_a", "tenant_b"):
+        response = stub.LoadConfig(
+            pb.ConfigRequest(
+                config_content=_valid_yaml_config(),
+                format="yaml",
+                config_hash="cfg_multi_tenant",
+                instance_id=instance_id,
+            )
+        )
+        assert response.success
+
+    session_a = stub.RegisterProvider(
+        pb.ProviderRegistration(provider_id="sim_a", device_ids=["heater0"], instance_id="tenant_a")
+    ).session_id
+    tick = stub.UpdateSignals(
+        pb.SignalUpdates(
+            session_id=session_a,
+            instance_id="tenant_a",
+            signals=[pb.SignalUpdate(path="heater.output", value=300.0, unit="W")],
+        )
+    )
+    assert tick.tick_occurred
+
+    read_a = stub.ReadSignals(pb.SignalRequest(paths=["heater.output"], instance_id="tenant_a"))
+    read_b = stub.ReadSignals(pb.SignalRequest(paths=["heater.output"], instance_id="tenant_b"))
+    assert read_a.signals[0].value == pytest.approx(300.0)
+    assert read_b.signals[0].value == pytest.approx(0.0)
+
+    # Sessions are scoped to the instance they registered with.
+    with pytest.raises(grpc.RpcError) as exc_info:
+        stub.UpdateSignals(pb.SignalUpdates(session_id=session_a, instance_id="tenant_b"))
+    assert exc_info.value.code() == grpc.StatusCode.UNAUTHENTICATED
+
+    listed = {info.instance_id: info for info in stub.ListInstances(pb.ListInstancesRequest()).instances}
+    assert set(listed) == {"tenant_a", "tenant_b"}
+    assert listed["tenant_a"].ticks == 1
+    assert listed["tenant_a"].sim_time_sec == pytest.approx(0.25)
+    assert listed["tenant_b"].ticks == 0
+    assert listed["tenant_a"].approx_memory_bytes > 0
+
+    assert stub.DeleteInstance(pb.DeleteInstanceRequest(instance_id="tenant_b")).success
+    with pytest.raises(grpc.RpcError) as exc_info:
+        stub.ReadSignals(pb.SignalRequest(paths=["heater.output"], instance_id="tenant_b"))
+    assert exc_info.value.code() == grpc.StatusCode.FAILED_PRECONDITION
+
+
+@pytest.mark.integration
+def test_advance_ticks_applies_schedule_and_decimates_traces(grpc_stub_dt_025: Any) -> None:
+    """AdvanceTicks runs a whole input schedule server-side in one call."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+    _load_config(stub, pb, config_hash="cfg_advance_ticks")
+
+    response = stub.AdvanceTicks(
+        pb.AdvanceTicksRequest(
+            tick_count=100,
+            decimation=10,
+            inputs=[
+                pb.ScheduledInput(tick=50, path="heater.output", value=500.0, unit="W"),
+                pb.ScheduledInput(tick=80, path="heater.output", value=2000.0, unit="W"),
+            ],
+            trace_paths=["chamber.power", "chamber.temp"],
+        )
+    )
+    assert response.ticks_executed == 100
+    assert response.sim_time_sec == pytest.approx(25.0)
+
+    power, temp = response.traces
+    assert power.path == "chamber.power"
+    assert temp.unit == "degC"
+    # Sample k holds the value after tick 10k + 9: input steps at ticks 50 and 80.
+    assert list(power.values) == pytest.approx([0.0] * 5 + [500.0] * 3 + [1000.0] * 2)
+    assert temp.values[-1] > temp.values[4]
+
+    # Scheduled values are held after the batch.
+    read = stub.ReadSignals(pb.SignalRequest(paths=["heater.output"]))
+    assert read.signals[0].value == pytest.approx(2000.0)
+
+    with pytest.raises(grpc.RpcError) as exc_info:
+        stub.AdvanceTicks(
+            pb.AdvanceTicksRequest(
+                tick_count=10,
+                inputs=[pb.ScheduledInput(tick=10, path="heater.output", value=1.0, unit="W")],
+            )
+        )
+    assert exc_info.value.code() == grpc.StatusCode.INVALID_ARGUMENT
+
+
+@pytest.mark.integration
+def test_state_hash_matches_across_redundant_instances(grpc_stub_dt_025: Any) -> None:
+    """Instances fed identical inputs report identical per-sample digests."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+
+    batches = {}
+    for instance_id in ("hash_a", "hash_b"):
+        loaded = stub.LoadConfig(
+            pb.ConfigRequest(
+                config_content=_valid_yaml_config(),
+                format="yaml",
+                instance_id=instance_id,
+                state_hashing=True,
+            )
+        )
+        assert loaded.success
+        batches[instance_id] = stub.AdvanceTicks(
+            pb.AdvanceTicksRequest(
+                instance_id=instance_id,
+                tick_count=20,
+                decimation=5,
+                inputs=[pb.ScheduledInput(tick=3, path="heater.output", value=750.0, unit="W")],
+            )
+        )
+
+    first, second = batches["hash_a"], batches["hash_b"]
+    assert len(first.state_hashes) == 4
+    assert all(first.state_hashes)
+    assert list(first.state_hashes) == list(second.state_hashes)
+    assert first.state_hash == first.state_hashes[-1] == second.state_hash
+
+    # Diverging inputs change the digest
+    diverged = stub.AdvanceTicks(
+        pb.AdvanceTicksRequest(
+            instance_id="hash_b",
+            tick_count=1,
+            inputs=[pb.ScheduledInput(tick=0, path="heater.output", value=751.0, unit="W")],
+        )
+    )
+    same = stub.AdvanceTicks(pb.AdvanceTicksRequest(instance_id="hash_a", tick_count=1))
+    assert diverged.state_hash != same.state_hash
+
+    for instance_id in ("hash_a", "hash_b"):
+        stub.DeleteInstance(pb.DeleteInstanceRequest(instance_id=instance_id))
+
+
+@pytest.mark.integration
+def test_convert_units_normalizes_compatible_provider_writes(grpc_stub_dt_025: Any) -> None:
+    """With convert_units, K written to a degC signal is stored in degC."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+    loaded = stub.LoadConfig(
+        pb.ConfigRequest(
+            config_content=_valid_yaml_config(),
+            format="yaml",
+            instance_id="units",
+            convert_units=True,
+        )
+    )
+    assert loaded.success
+
+    session_id = stub.RegisterProvider(
+        pb.ProviderRegistration(provider_id="units_provider", device_ids=["heater0"], instance_id="units")
+    ).session_id
+    for value, unit in ((20.0, "degC"), (300.0, "K")):
+        stub.UpdateSignals(
+            pb.SignalUpdates(
+                session_id=session_id,
+                instance_id="units",
+                signals=[pb.SignalUpdate(path="ambient.temp", value=value, unit=unit)],
+            )
+        )
+
+    read = stub.ReadSignals(pb.SignalRequest(paths=["ambient.temp"], instance_id="units"))
+    assert read.signals[0].value == pytest.approx(26.85)
+    assert read.signals[0].unit == "degC"
+    stub.DeleteInstance(pb.DeleteInstanceRequest(instance_id="units"))
+
+
+@pytest.mark.integration
+def test_get_metrics_exposes_prometheus_text(grpc_stub_dt_025: Any) -> None:
+    """GetMetrics renders RPC, tick-stage and per-instance series."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+    _load_config(stub, pb, config_hash="cfg_metrics")
+    session_id = _register_provider(stub, pb, provider_id="metrics_provider")
+    stub.UpdateSignals(
+        pb.SignalUpdates(
+            session_id=session_id,
+            signals=[pb.SignalUpdate(path="heater.output", value=10.0, unit="W")],
+        )
+    )
+
+    text = stub.GetMetrics(pb.MetricsRequest()).text
+    samples = {}
+    for line in text.splitlines():
+        if line and not line.startswith("#"):
+            name, value = line.rsplit(" ", 1)
+            samples[name] = float(value)
+
+    assert "# TYPE fluxgraph_tick_stage_seconds histogram" in text
+    assert samples['fluxgraph_ticks_total{instance="default"}'] == 1
+    assert samples['fluxgraph_rpc_duration_seconds_count{method="UpdateSignals"}'] == 1
+    assert samples['fluxgraph_tick_stage_seconds_count{instance="default",stage="edges"}'] == 1
+    assert samples['fluxgraph_providers{instance="default"}'] == 1
+    assert samples["fluxgraph_instances"] == 1
+
+
+@pytest.mark.integration
+def test_metrics_drop_series_of_departed_providers(grpc_stub_dt_025: Any) -> None:
+    """Provider- and instance-labelled series end with their owner."""
+    pb = _pb()
+    stub = grpc_stub_dt_025
+    loaded = stub.LoadConfig(
+        pb.ConfigRequest(config_content=_valid_yaml_config(), format="yaml", instance_id="churn")
+    )
+    assert loaded.success
+    session_id = stub.RegisterProvider(
+        pb.ProviderRegistration(provider_id="churn_provider", instance_id="churn")
+    ).session_id
+    assert 'provider="churn_provider"' in stub.GetMetrics(pb.MetricsRequest()).text
+
+    stub.UnregisterProvider(pb.UnregisterRequest(session_id=session_id, instance_id="churn"))
+    text = stub.GetMetrics(pb.MetricsRequest()).text
+    assert 'provider="churn_provider"' not in text
+    assert 'fluxgraph_providers{instance="churn"} 0' in text
+
+    stub.DeleteInstance(pb.DeleteInstanceRequest(instance_id="churn"))
+    assert 'instance="churn"' not in stub.GetMetrics(pb.MetricsRequest()).text
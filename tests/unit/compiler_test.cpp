@@ -1,9 +1,12 @@
 #include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/graph/param_utils.hpp"
+#include "fluxgraph/model/thermal_mass.hpp"
 #include <gtest/gtest.h>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace fluxgraph;
@@ -511,6 +514,94 @@ TEST(GraphCompilerTest, ParseStateSpaceSisoDiscreteRejectsRaggedMatrix) {
   EXPECT_THROW(compiler.parse_model(spec, ns), std::runtime_error);
 }
 
+TEST(GraphCompilerTest, ParseStateSpaceSisoDiscretePackedParamsMatchNested) {
+  ModelSpec nested;
+  nested.id = "ss";
+  nested.type = "state_space_siso_discrete";
+  nested.params["A_d"] = matrix_param({{0.8, 0.1}, {0.0, 0.9}});
+  nested.params["B_d"] = vector_param({0.1, 0.5});
+  nested.params["C"] = vector_param({1.0, 0.0});
+  nested.params["D"] = 0.0;
+  nested.params["x0"] = vector_param({0.0, 0.0});
+  nested.params["output_signal"] = std::string("ss.y");
+  nested.params["input_signal"] = std::string("ss.u");
+
+  ModelSpec packed = nested;
+  packed.params["A_d"] = ParamNumbers{{0.8, 0.1, 0.0, 0.9}, 2};
+  packed.params["B_d"] = ParamNumbers{{0.1, 0.5}};
+  // Integral packed arrays convert like int64 scalars
+  packed.params["C"] = ParamNumbers{{1.0, 0.0}, 0, true};
+
+  SignalNamespace ns;
+  SignalStore store;
+  GraphCompiler compiler;
+  std::unique_ptr<IModel> from_nested(compiler.parse_model(nested, ns));
+  std::unique_ptr<IModel> from_packed(compiler.parse_model(packed, ns));
+  const SignalId y = ns.resolve("ss.y");
+  store.write(ns.resolve("ss.u"), 1.0, "dimensionless");
+
+  for (int i = 0; i < 5; ++i) {
+    from_nested->tick(0.1, store);
+    const double expected = store.read_value(y);
+    from_packed->tick(0.1, store);
+    EXPECT_DOUBLE_EQ(store.read_value(y), expected);
+  }
+}
+
+TEST(GraphCompilerTest, PackedParamShapeErrorsNameFirstElement) {
+  ModelSpec spec;
+  spec.id = "ss";
+  spec.type = "state_space_siso_discrete";
+  spec.params["A_d"] = ParamNumbers{{1.0, 0.0}};
+  spec.params["B_d"] = vector_param({0.0, 1.0});
+  spec.params["C"] = vector_param({1.0, 0.0});
+  spec.params["D"] = 0.0;
+  spec.params["x0"] = vector_param({0.0, 0.0});
+  spec.params["output_signal"] = std::string("ss.y");
+  spec.params["input_signal"] = std::string("ss.u");
+
+  SignalNamespace ns;
+  GraphCompiler compiler;
+  try {
+    compiler.parse_model(spec, ns);
+    FAIL() << "expected a shape error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("A_d[0]: expected array, got double"),
+              std::string::npos)
+        << e.what();
+  }
+
+  spec.params["A_d"] = matrix_param({{1.0, 0.0}, {0.0, 1.0}});
+  spec.params["x0"] = ParamNumbers{{0.0, 0.0, 0.0, 0.0}, 2};
+  try {
+    compiler.parse_model(spec, ns);
+    FAIL() << "expected a shape error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("x0[0]: expected number, got array"),
+              std::string::npos)
+        << e.what();
+  }
+}
+
+TEST(GraphCompilerTest, NestedMatrixAcceptsPackedRows) {
+  ParamArray rows;
+  rows.emplace_back(ParamNumbers{{0.5, 0.0}});
+  rows.emplace_back(ParamNumbers{{0.0, 0.5}});
+
+  ParamNumbers scratch;
+  const ParamNumbers &numbers =
+      param::as_numbers(ParamValue{rows}, "A_d", 2, scratch);
+  EXPECT_EQ(&numbers, &scratch);
+  EXPECT_EQ(numbers.columns, 2u);
+  EXPECT_EQ(numbers.values, (std::vector<double>{0.5, 0.0, 0.0, 0.5}));
+
+  rows.emplace_back(ParamNumbers{{1.0}});
+  EXPECT_THROW(param::as_numbers(ParamValue{rows}, "A_d", 2, scratch),
+               std::runtime_error);
+  EXPECT_THROW(param::as_array(ParamValue{ParamNumbers{{1.0}}}, "B_d"),
+               std::runtime_error);
+}
+
 TEST(GraphCompilerTest, StrictModeRejectsUndeclaredStateSpaceSignalContracts) {
   GraphSpec spec;
 
@@ -1661,3 +1752,242 @@ TEST(GraphCompilerTest,
   }
   EXPECT_TRUE(saw_gain_warning);
 }
+
+namespace {
+
+GraphSpec arena_test_spec() {
+  GraphSpec spec;
+  spec.signals.push_back({"arena.temp", "degC"});
+  spec.signals.push_back({"arena.power", "W"});
+  spec.signals.push_back({"arena.ambient", "degC"});
+
+  ModelSpec model;
+  model.id = "chamber";
+  model.type = "thermal_mass";
+  model.params["temp_signal"] = std::string("arena.temp");
+  model.params["power_signal"] = std::string("arena.power");
+  model.params["ambient_signal"] = std::string("arena.ambient");
+  model.params["thermal_mass"] = 1000.0;
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  spec.models.push_back(model);
+
+  // Declared against execution order: c->d runs last
+  const char *const paths[][2] = {
+      {"arena.c", "arena.d"}, {"arena.b", "arena.c"}, {"arena.a", "arena.b"}};
+  for (const auto &path : paths) {
+    EdgeSpec edge;
+    edge.source_path = path[0];
+    edge.target_path = path[1];
+    edge.transform.type = "first_order_lag";
+    edge.transform.params["tau_s"] = 0.5;
+    spec.edges.push_back(edge);
+  }
+  return spec;
+}
+
+} // namespace
+
+TEST(GraphCompilerTest, PlacesBuiltinComponentsInArenaInScheduleOrder) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  auto program = compiler.compile(arena_test_spec(), signal_ns, func_ns);
+
+  ASSERT_EQ(program.edges.size(), 3U);
+  ASSERT_EQ(program.models.size(), 1U);
+  EXPECT_EQ(program.edges[0].source, signal_ns.resolve("arena.a"));
+  EXPECT_EQ(program.edges[2].target, signal_ns.resolve("arena.d"));
+  EXPECT_EQ(program.arena.object_count(), 4U);
+  EXPECT_EQ(program.arena.block_count(), 1U);
+
+  // Model first, then transforms in the order a tick visits them
+  const auto *previous =
+      reinterpret_cast<const char *>(program.models[0].get());
+  for (const auto &edge : program.edges) {
+    const auto *address = reinterpret_cast<const char *>(edge.transform.get());
+    EXPECT_GT(address, previous);
+    EXPECT_LE(static_cast<size_t>(address - previous),
+              sizeof(ThermalMassModel) + ComponentArena::kCacheLine);
+    previous = address;
+  }
+  EXPECT_LE(static_cast<size_t>(previous -
+                                reinterpret_cast<const char *>(
+                                    program.models[0].get())),
+            program.arena.bytes_used());
+}
+
+TEST(GraphCompilerTest, ComponentArenaCanBeDisabled) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  CompilationOptions options;
+  options.component_arena = false;
+  auto program = compiler.compile(arena_test_spec(), signal_ns, func_ns,
+                                  options);
+
+  EXPECT_EQ(program.arena.object_count(), 0U);
+  EXPECT_EQ(program.arena.bytes_reserved(), 0U);
+  for (const auto &edge : program.edges) {
+    ASSERT_NE(edge.transform, nullptr);
+    EXPECT_FALSE(edge.transform.in_arena());
+  }
+  EXPECT_FALSE(program.models[0].in_arena());
+}
+
+TEST(GraphCompilerTest, RegisteredFactoriesStayOnHeapBesideArena) {
+  const std::string type = "test.custom_affine_transform";
+  if (!GraphCompiler::is_transform_registered(type)) {
+    GraphCompiler::register_transform_factory(
+        type, [](const TransformSpec &spec) -> std::unique_ptr<ITransform> {
+          return std::make_unique<AffineTestTransform>(variant_to_double(
+              spec.params.at("bias"), "transform[test]/bias"));
+        });
+  }
+
+  GraphSpec spec = arena_test_spec();
+  spec.edges[0].transform.type = type;
+  spec.edges[0].transform.params = {{"bias", 3.5}};
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  auto program = compiler.compile(spec, signal_ns, func_ns);
+
+  EXPECT_EQ(program.arena.object_count(), 3U);
+  ASSERT_EQ(program.edges[2].target, signal_ns.resolve("arena.d"));
+  EXPECT_FALSE(program.edges[2].transform.in_arena());
+  EXPECT_DOUBLE_EQ(program.edges[2].transform->apply(2.0, 0.1), 7.5);
+  EXPECT_TRUE(program.edges[0].transform.in_arena());
+}
+
+namespace {
+
+// Model output feeds a chain declared out of order; the chain's end drives
+// the model through a delay
+GraphSpec layout_test_spec() {
+  GraphSpec spec;
+  spec.signals.push_back({"l.temp", "degC"});
+  spec.signals.push_back({"l.power", "W"});
+  spec.signals.push_back({"l.ambient", "degC"});
+  spec.signals.push_back({"l.unused", "dimensionless"});
+
+  ModelSpec model;
+  model.id = "chamber";
+  model.type = "thermal_mass";
+  model.params["temp_signal"] = std::string("l.temp");
+  model.params["power_signal"] = std::string("l.power");
+  model.params["ambient_signal"] = std::string("l.ambient");
+  model.params["thermal_mass"] = 1000.0;
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  spec.models.push_back(model);
+
+  auto add_edge = [&spec](const char *source, const char *target,
+                          const char *type) {
+    EdgeSpec edge;
+    edge.source_path = source;
+    edge.target_path = target;
+    edge.transform.type = type;
+    if (std::string(type) == "delay") {
+      edge.transform.params["delay_sec"] = 0.2;
+    } else if (std::string(type) == "first_order_lag") {
+      edge.transform.params["tau_s"] = 0.5;
+    } else {
+      edge.transform.params["scale"] = 2.0;
+      edge.transform.params["offset"] = -1.0;
+    }
+    spec.edges.push_back(edge);
+  };
+  add_edge("l.c", "l.d", "linear");
+  add_edge("l.temp", "l.a", "first_order_lag");
+  add_edge("l.a", "l.b", "linear");
+  add_edge("l.b", "l.c", "linear");
+  add_edge("l.d", "l.power", "delay");
+  add_edge("l.a", "l.e", "linear");
+  return spec;
+}
+
+CompilationOptions execution_layout() {
+  CompilationOptions options;
+  options.signal_layout = SignalLayout::execution_order;
+  return options;
+}
+
+} // namespace
+
+TEST(GraphCompilerTest, ExecutionLayoutNumbersSignalsByFirstTouch) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  auto program = compiler.compile(layout_test_spec(), signal_ns, func_ns,
+                                  execution_layout());
+
+  // Model signals (by parameter name), the delay source, the schedule,
+  // then the rest
+  const std::vector<std::string> expected = {
+      "l.ambient", "l.power", "l.temp", "l.d", "l.a",
+      "l.b",       "l.e",     "l.c",    "l.unused"};
+  ASSERT_EQ(signal_ns.size(), expected.size());
+  for (SignalId id = 0; id < expected.size(); ++id) {
+    EXPECT_EQ(signal_ns.lookup(id), expected[id]);
+  }
+  EXPECT_TRUE(program.signal_id_map.empty());
+  EXPECT_EQ(program.required_signal_capacity, expected.size());
+
+  // Recompiling with the new ids keeps the schedule the layout assumed
+  const std::vector<std::pair<SignalId, SignalId>> schedule = {
+      {3, 1}, {2, 4}, {4, 5}, {4, 6}, {5, 7}, {7, 3}};
+  ASSERT_EQ(program.edges.size(), schedule.size());
+  EXPECT_TRUE(program.edges[0].is_delay);
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    EXPECT_EQ(program.edges[i].source, schedule[i].first) << i;
+    EXPECT_EQ(program.edges[i].target, schedule[i].second) << i;
+  }
+}
+
+TEST(GraphCompilerTest, ExecutionLayoutRenumbersExistingNamespace) {
+  SignalNamespace signal_ns;
+  const SignalId cached_d = signal_ns.intern("l.d");
+  const SignalId cached_other = signal_ns.intern("host.other");
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  auto program = compiler.compile(layout_test_spec(), signal_ns, func_ns,
+                                  execution_layout());
+
+  EXPECT_EQ(signal_ns.resolve("l.d"), 3U);
+  EXPECT_EQ(signal_ns.resolve("host.other"), 9U) << "Kept after the program";
+  EXPECT_EQ(program.required_signal_capacity, 9U);
+
+  const SignalIdMap &map = program.signal_id_map;
+  EXPECT_EQ(map.program_id(cached_d), 3U);
+  EXPECT_EQ(map.program_id(cached_other), 9U);
+  EXPECT_EQ(map.host_id(3), cached_d);
+  EXPECT_EQ(map.host_id(2), INVALID_SIGNAL) << "l.temp was not cached";
+}
+
+TEST(GraphCompilerTest, ExecutionLayoutCanKeepExternalIds) {
+  SignalNamespace signal_ns;
+  const SignalId cached_d = signal_ns.intern("l.d");
+  const SignalId cached_other = signal_ns.intern("host.other");
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  CompilationOptions options = execution_layout();
+  options.keep_external_ids = true;
+  auto program =
+      compiler.compile(layout_test_spec(), signal_ns, func_ns, options);
+
+  EXPECT_EQ(signal_ns.resolve("l.d"), cached_d);
+  EXPECT_EQ(signal_ns.resolve("host.other"), cached_other);
+  ASSERT_NE(signal_ns.resolve("l.temp"), INVALID_SIGNAL);
+
+  const SignalIdMap &map = program.signal_id_map;
+  EXPECT_EQ(map.program_id(cached_d), 3U);
+  EXPECT_EQ(map.program_id(signal_ns.resolve("l.temp")), 2U);
+  EXPECT_EQ(map.program_id(cached_other), INVALID_SIGNAL);
+  for (SignalId id = 0; id < program.required_signal_capacity; ++id) {
+    EXPECT_EQ(map.program_id(map.host_id(id)), id);
+  }
+  ASSERT_EQ(program.edges.size(), 6U);
+  EXPECT_EQ(program.edges.back().target, 3U);
+}
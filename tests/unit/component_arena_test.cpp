@@ -0,0 +1,79 @@
+#include "fluxgraph/core/component_arena.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace fluxgraph;
+
+namespace {
+
+constexpr std::size_t kLine = ComponentArena::kCacheLine;
+
+std::size_t line_offset(const void *address) {
+  return reinterpret_cast<std::uintptr_t>(address) % kLine;
+}
+
+struct Counted {
+  explicit Counted(int *live) : live_(live) { ++*live_; }
+  ~Counted() { --*live_; }
+  int *live_;
+};
+
+static_assert(sizeof(ComponentPtr<Counted>) == sizeof(Counted *),
+              "Arena flag must not grow the pointer");
+
+} // namespace
+
+TEST(ComponentArenaTest, PacksSmallObjectsBackToBack) {
+  ComponentArena arena;
+  const auto *first = static_cast<const char *>(arena.allocate(20, 8));
+  EXPECT_EQ(line_offset(first), 0U);
+  for (int i = 1; i < 20; ++i) {
+    const auto *p = static_cast<const char *>(arena.allocate(20, 8));
+    EXPECT_EQ(p - first, i * 24) << "20 bytes padded to alignment 8";
+  }
+  EXPECT_EQ(arena.block_count(), 1U);
+  EXPECT_EQ(arena.object_count(), 20U);
+  EXPECT_EQ(arena.bytes_used(), 19U * 24U + 20U);
+}
+
+TEST(ComponentArenaTest, StartsLargeObjectsOnALine) {
+  ComponentArena arena;
+  arena.allocate(8, 8);
+  const void *large = arena.allocate(100, 8);
+  EXPECT_EQ(line_offset(large), 0U);
+  EXPECT_EQ(arena.bytes_used(), kLine + 100);
+}
+
+TEST(ComponentArenaTest, GrowsWithNewBlocks) {
+  ComponentArena arena;
+  arena.reserve(256);
+  for (int i = 0; i < 4; ++i) {
+    arena.allocate(kLine, 8);
+  }
+  EXPECT_EQ(arena.block_count(), 1U);
+
+  const void *spilled = arena.allocate(1000, 8);
+  EXPECT_EQ(line_offset(spilled), 0U);
+  EXPECT_EQ(arena.block_count(), 2U);
+  EXPECT_GE(arena.bytes_reserved(), 256U + 1000U);
+}
+
+TEST(ComponentArenaTest, ComponentPtrDestroysArenaAndHeapObjects) {
+  int live = 0;
+  ComponentArena arena;
+  {
+    ComponentPtr<Counted> in_arena = make_component<Counted>(&arena, &live);
+    ComponentPtr<Counted> on_heap = make_component<Counted>(nullptr, &live);
+    EXPECT_TRUE(in_arena.in_arena());
+    EXPECT_FALSE(on_heap.in_arena());
+    EXPECT_EQ(live, 2);
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(arena.object_count(), 1U);
+
+  // Plain unique_ptrs (e.g. from registered factories) convert
+  ComponentPtr<Counted> adopted = std::make_unique<Counted>(&live);
+  EXPECT_FALSE(adopted.in_arena());
+  adopted.reset();
+  EXPECT_EQ(live, 0);
+}
@@ -1,4 +1,5 @@
 #include "fluxgraph/engine.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
 
 using namespace fluxgraph;
@@ -96,6 +97,72 @@ TEST(EngineTest, EdgePropagationUsesTargetContractUnit) {
   EXPECT_EQ(store.read_unit(output_id), "degC");
 }
 
+TEST(EngineTest, UnitContractsAreDeclaredOncePerStore) {
+  GraphSpec spec;
+  spec.signals.push_back({"input", "W"});
+  spec.signals.push_back({"output", "degC"});
+
+  EdgeSpec edge;
+  edge.source_path = "input";
+  edge.target_path = "output";
+  edge.transform.type = "linear";
+  edge.transform.params["scale"] = 1.0;
+  edge.transform.params["offset"] = 0.0;
+  spec.edges.push_back(edge);
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  Engine engine;
+  engine.load(compiler.compile(spec, signal_ns, func_ns));
+  const SignalId output_id = signal_ns.resolve("output");
+
+  SignalStore first;
+  engine.tick(0.1, first);
+  engine.tick(0.1, first);
+  EXPECT_EQ(first.declared_unit(output_id), "degC");
+
+  // A copy carries the contracts under its own id; a fresh store gets them
+  // on its first tick
+  SignalStore copy(first);
+  EXPECT_NE(copy.contract_set_id(), first.contract_set_id());
+  EXPECT_EQ(copy.declared_unit(output_id), "degC");
+  SignalStore moved(std::move(copy));
+  EXPECT_EQ(moved.declared_unit(output_id), "degC");
+  SignalStore second;
+  EXPECT_NE(second.contract_set_id(), first.contract_set_id());
+  EXPECT_FALSE(second.has_declared_unit(output_id));
+  engine.tick(0.1, second);
+  EXPECT_EQ(second.declared_unit(output_id), "degC");
+
+  EXPECT_NO_THROW(second.declare_unit(output_id, "degC"));
+  EXPECT_THROW(second.declare_unit(output_id, "K"), std::runtime_error);
+}
+
+TEST(EngineTest, UnitContractsReachStoresCopiedBeforeFirstTick) {
+  GraphSpec spec;
+  spec.signals.push_back({"output", "degC"});
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  Engine engine;
+  engine.load(compiler.compile(spec, signal_ns, func_ns));
+  const SignalId output_id = signal_ns.resolve("output");
+
+  SignalStore original;
+  SignalStore copy(original);
+  SignalStore assigned;
+  assigned = original;
+  engine.tick(0.1, original);
+  ASSERT_TRUE(original.has_declared_unit(output_id));
+
+  engine.tick(0.1, copy);
+  EXPECT_TRUE(copy.has_declared_unit(output_id));
+  engine.tick(0.1, assigned);
+  EXPECT_TRUE(assigned.has_declared_unit(output_id));
+}
+
 TEST(EngineTest, TickPreallocatesSignalStoreFromProgramMetadata) {
   GraphSpec spec;
 
@@ -447,3 +514,274 @@ TEST(EngineTest, RuleCommandBacklogOverflowThrows) {
 
   EXPECT_TRUE(overflow_observed);
 }
+
+TEST(EngineTest, StageTimingIsOptIn) {
+  GraphSpec spec;
+
+  EdgeSpec edge;
+  edge.source_path = "input";
+  edge.target_path = "output";
+  edge.transform.type = "linear";
+  edge.transform.params["scale"] = 2.0;
+  edge.transform.params["offset"] = 0.0;
+  spec.edges.push_back(edge);
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  GraphCompiler compiler;
+  Engine engine;
+  engine.load(compiler.compile(spec, signal_ns, func_ns));
+
+  SignalId input_id = signal_ns.resolve("input");
+  SignalId output_id = signal_ns.resolve("output");
+  store.write(input_id, 3.0, "dimensionless");
+
+  engine.tick(0.1, store);
+  EXPECT_EQ(engine.last_stage_times().edges.count(), 0);
+
+  engine.set_stage_timing(true);
+  engine.tick(0.1, store);
+  EXPECT_DOUBLE_EQ(store.read_value(output_id), 6.0);
+  const TickStageTimes &times = engine.last_stage_times();
+  EXPECT_GE(times.models.count(), 0);
+  EXPECT_GE(times.edges.count(), 0);
+  EXPECT_GE(times.rules.count(), 0);
+}
+
+TEST(EngineTest, StateHashTracksValuesAndModelState) {
+  GraphSpec spec;
+  ModelSpec model;
+  model.id = "thermal";
+  model.type = "thermal_mass";
+  model.params["temp_signal"] = std::string("chamber.temp");
+  model.params["power_signal"] = std::string("chamber.power");
+  model.params["ambient_signal"] = std::string("ambient");
+  model.params["thermal_mass"] = 1000.0;
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  spec.models.push_back(model);
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  Engine engine_a;
+  Engine engine_b;
+  engine_a.load(compiler.compile(spec, signal_ns, func_ns));
+  engine_b.load(compiler.compile(spec, signal_ns, func_ns));
+  engine_a.set_state_hashing(true);
+  engine_b.set_state_hashing(true);
+
+  SignalStore store_a;
+  SignalStore store_b;
+  store_b.reserve(64); // Capacity alone must not change the digest
+  for (SignalStore *store : {&store_a, &store_b}) {
+    store->write(signal_ns.resolve("ambient"), 20.0, "degC");
+    store->write(signal_ns.resolve("chamber.power"), 100.0, "W");
+  }
+
+  EXPECT_EQ(engine_a.last_state_hash(), 0u);
+  for (int i = 0; i < 5; ++i) {
+    engine_a.tick(0.1, store_a);
+    engine_b.tick(0.1, store_b);
+    EXPECT_EQ(engine_a.last_state_hash(), engine_b.last_state_hash());
+  }
+  EXPECT_NE(engine_a.last_state_hash(), 0u);
+  EXPECT_EQ(engine_a.last_state_hash(), engine_a.compute_state_hash(store_a));
+
+  // One ulp of input difference shows up after the next tick
+  store_b.write(signal_ns.resolve("chamber.power"),
+                std::nextafter(100.0, 200.0), "W");
+  engine_a.tick(0.1, store_a);
+  engine_b.tick(0.1, store_b);
+  EXPECT_NE(engine_a.last_state_hash(), engine_b.last_state_hash());
+
+  engine_a.set_state_hashing(false);
+  EXPECT_EQ(engine_a.last_state_hash(), 0u);
+}
+
+TEST(EngineTest, StateHashCoversTransformState) {
+  GraphSpec spec;
+  EdgeSpec edge;
+  edge.source_path = "delay.in";
+  edge.target_path = "delay.out";
+  edge.transform.type = "delay";
+  edge.transform.params["delay_sec"] = 0.3;
+  spec.edges.push_back(edge);
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  Engine engine_a;
+  Engine engine_b;
+  engine_a.load(compiler.compile(spec, signal_ns, func_ns));
+  engine_b.load(compiler.compile(spec, signal_ns, func_ns));
+  const SignalId in = signal_ns.resolve("delay.in");
+  const SignalId out = signal_ns.resolve("delay.out");
+
+  SignalStore store_a;
+  SignalStore store_b;
+  for (SignalStore *store : {&store_a, &store_b}) {
+    store->write(in, 5.0, "dimensionless");
+  }
+  engine_a.tick(0.1, store_a);
+  engine_b.tick(0.1, store_b);
+
+  // Different samples enter the buffers; the delayed output stays 5
+  store_a.write(in, 7.0, "dimensionless");
+  store_b.write(in, 8.0, "dimensionless");
+  engine_a.tick(0.1, store_a);
+  engine_b.tick(0.1, store_b);
+  ASSERT_EQ(store_a.read_value(out), store_b.read_value(out));
+
+  store_b.write(in, 7.0, "dimensionless");
+  EXPECT_NE(engine_a.compute_state_hash(store_a),
+            engine_b.compute_state_hash(store_b))
+      << "Equal signal values, diverged delay buffers";
+
+  engine_a.reset();
+  engine_b.reset();
+  store_a.clear();
+  store_b.clear();
+  EXPECT_EQ(engine_a.compute_state_hash(store_a),
+            engine_b.compute_state_hash(store_b));
+  EXPECT_EQ(engine_a.compute_state_hash(store_a),
+            engine_a.compute_state_hash(SignalStore()))
+      << "clear() restores the unwritten marker";
+}
+
+namespace {
+
+// Stands in for fluxgraph-codegen output: applies the single edge through
+// the Engine-owned transform and counts how often it ran
+class CountingGeneratedProgram final : public GeneratedProgram {
+public:
+  static inline int edge_calls = 0;
+
+  static std::unique_ptr<GeneratedProgram>
+  bind(std::vector<CompiledEdge> &edges, std::vector<ModelPtr> &models) {
+    if (edges.size() != 1U || !models.empty()) {
+      return nullptr;
+    }
+    return std::make_unique<CountingGeneratedProgram>(edges[0]);
+  }
+
+  explicit CountingGeneratedProgram(CompiledEdge &edge) : edge_(edge) {}
+
+  void update_models(double, SignalStore &) override {}
+
+  void process_edges(double dt, SignalStore &store) override {
+    ++edge_calls;
+    store.write_with_contract_unit(
+        edge_.target, edge_.transform->apply(store.read_value(edge_.source),
+                                             dt));
+  }
+
+private:
+  CompiledEdge &edge_;
+};
+
+} // namespace
+
+TEST(EngineTest, LoadBindsRegisteredGeneratedProgram) {
+  GraphSpec spec;
+  EdgeSpec edge;
+  edge.source_path = "generated.input";
+  edge.target_path = "generated.output";
+  edge.transform.type = "linear";
+  edge.transform.params["scale"] = 3.0;
+  edge.transform.params["offset"] = 1.0;
+  spec.edges.push_back(edge);
+
+  // Registrations are process-wide: shift the ids so other tests' single
+  // linear edges do not share this layout
+  SignalNamespace signal_ns;
+  for (int i = 0; i < 7; ++i) {
+    signal_ns.intern("generated.padding" + std::to_string(i));
+  }
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  CompiledProgram program = compiler.compile(spec, signal_ns, func_ns);
+  EXPECT_TRUE(register_generated_program(program_layout_hash(program),
+                                         &CountingGeneratedProgram::bind));
+
+  Engine engine;
+  engine.load(std::move(program));
+  ASSERT_TRUE(engine.generated_program_active());
+
+  SignalStore store;
+  const SignalId input = signal_ns.resolve("generated.input");
+  const SignalId output = signal_ns.resolve("generated.output");
+  store.write(input, 2.0, "dimensionless");
+  CountingGeneratedProgram::edge_calls = 0;
+  engine.tick(0.1, store);
+  EXPECT_EQ(CountingGeneratedProgram::edge_calls, 1);
+  EXPECT_EQ(store.read_value(output), 7.0);
+
+  // Interpreted fallback produces the same result
+  engine.set_generated_programs(false);
+  EXPECT_FALSE(engine.generated_program_active());
+  store.write(input, 4.0, "dimensionless");
+  engine.tick(0.1, store);
+  EXPECT_EQ(CountingGeneratedProgram::edge_calls, 1);
+  EXPECT_EQ(store.read_value(output), 13.0);
+
+  // A different layout does not pick up the registration
+  spec.edges[0].target_path = "generated.other";
+  Engine other;
+  other.load(compiler.compile(spec, signal_ns, func_ns));
+  EXPECT_FALSE(other.generated_program_active());
+}
+
+TEST(EngineTest, ExecutionLayoutMatchesInterningLayout) {
+  GraphSpec spec;
+  ModelSpec model;
+  model.id = "chamber";
+  model.type = "thermal_mass";
+  model.params["temp_signal"] = std::string("x.temp");
+  model.params["power_signal"] = std::string("x.power");
+  model.params["ambient_signal"] = std::string("x.ambient");
+  model.params["thermal_mass"] = 1000.0;
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  spec.models.push_back(model);
+  const char *chain[][2] = {{"x.b", "x.c"}, {"x.temp", "x.a"}, {"x.a", "x.b"}};
+  for (const auto &link : chain) {
+    EdgeSpec edge;
+    edge.source_path = link[0];
+    edge.target_path = link[1];
+    edge.transform.type = "first_order_lag";
+    edge.transform.params["tau_s"] = 0.3;
+    spec.edges.push_back(edge);
+  }
+  EdgeSpec feedback;
+  feedback.source_path = "x.c";
+  feedback.target_path = "x.power";
+  feedback.transform.type = "delay";
+  feedback.transform.params["delay_sec"] = 0.2;
+  spec.edges.push_back(feedback);
+
+  const std::vector<std::string> paths = {"x.temp", "x.a", "x.b", "x.c",
+                                          "x.power"};
+  auto run = [&](SignalLayout layout) {
+    SignalNamespace signal_ns;
+    FunctionNamespace func_ns;
+    CompilationOptions options;
+    options.signal_layout = layout;
+    Engine engine;
+    engine.load(GraphCompiler().compile(spec, signal_ns, func_ns, options));
+    SignalStore store;
+    std::vector<double> trace;
+    for (int step = 0; step < 40; ++step) {
+      store.write(signal_ns.resolve("x.ambient"), 20.0 + step, "degC");
+      engine.tick(0.05, store);
+      for (const auto &path : paths) {
+        trace.push_back(store.read_value(signal_ns.resolve(path)));
+      }
+    }
+    return trace;
+  };
+
+  EXPECT_EQ(run(SignalLayout::interning_order),
+            run(SignalLayout::execution_order));
+}
@@ -0,0 +1,165 @@
+#include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/graph/templates.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace fluxgraph;
+
+namespace {
+
+GraphTemplateSpec heater_zone_template() {
+  GraphTemplateSpec tmpl;
+  tmpl.name = "heater_zone";
+  tmpl.params["gain"] = 1.0;
+  tmpl.params["mass"] = 1000.0;
+  tmpl.params["ambient"] = std::string("ambient.temp");
+
+  tmpl.signals.push_back({"${prefix}.temp", "degC"});
+
+  ModelSpec model;
+  model.id = "${prefix}.air";
+  model.type = "thermal_mass";
+  model.params["thermal_mass"] = std::string("${mass}");
+  model.params["heat_transfer_coeff"] = 10.0;
+  model.params["initial_temp"] = 25.0;
+  model.params["temp_signal"] = std::string("${prefix}.temp");
+  model.params["power_signal"] = std::string("${prefix}.power");
+  model.params["ambient_signal"] = std::string("${ambient}");
+  tmpl.models.push_back(model);
+
+  EdgeSpec edge;
+  edge.source_path = "${prefix}.command";
+  edge.target_path = "${prefix}.power";
+  edge.transform.type = "linear";
+  edge.transform.params["scale"] = std::string("${gain}");
+  edge.transform.params["offset"] = 0.0;
+  tmpl.edges.push_back(edge);
+
+  RuleSpec rule;
+  rule.id = "${prefix}_overheat";
+  rule.condition = "${prefix}.temp > 100.0";
+  rule.on_error = "log_and_continue";
+  ActionSpec action;
+  action.device = "${prefix}_heater";
+  action.function = "shutdown";
+  action.args["zone"] = std::string("${prefix}");
+  rule.actions.push_back(action);
+  tmpl.rules.push_back(rule);
+  return tmpl;
+}
+
+GraphSpec heater_zones(int count) {
+  GraphSpec spec;
+  spec.templates.push_back(heater_zone_template());
+  for (int i = 0; i < count; ++i) {
+    spec.instances.push_back({"heater_zone", "zone" + std::to_string(i), {}});
+  }
+  return spec;
+}
+
+} // namespace
+
+TEST(GraphTemplatesTest, ExpandsInstancesWithPrefixAndOverrides) {
+  GraphSpec spec = heater_zones(2);
+  spec.instances[1].params["gain"] = 2.5;
+  spec.signals.push_back({"ambient.temp", "degC"});
+
+  const GraphSpec flat = expand_templates(spec);
+  EXPECT_TRUE(flat.templates.empty());
+  EXPECT_TRUE(flat.instances.empty());
+  ASSERT_EQ(flat.signals.size(), 3u);
+  ASSERT_EQ(flat.models.size(), 2u);
+  ASSERT_EQ(flat.edges.size(), 2u);
+  ASSERT_EQ(flat.rules.size(), 2u);
+
+  // Spec's own entries first, then instances in order
+  EXPECT_EQ(flat.signals[0].path, "ambient.temp");
+  EXPECT_EQ(flat.signals[2].path, "zone1.temp");
+  EXPECT_EQ(flat.models[1].id, "zone1.air");
+  EXPECT_EQ(std::get<std::string>(flat.models[1].params.at("temp_signal")),
+            "zone1.temp");
+  EXPECT_EQ(std::get<double>(flat.models[1].params.at("thermal_mass")),
+            1000.0);
+  EXPECT_EQ(flat.edges[0].source_path, "zone0.command");
+  EXPECT_EQ(std::get<double>(flat.edges[0].transform.params.at("scale")), 1.0);
+  EXPECT_EQ(std::get<double>(flat.edges[1].transform.params.at("scale")), 2.5);
+  EXPECT_EQ(flat.rules[1].id, "zone1_overheat");
+  EXPECT_EQ(flat.rules[1].condition, "zone1.temp > 100.0");
+  EXPECT_EQ(flat.rules[1].actions[0].device, "zone1_heater");
+  EXPECT_EQ(std::get<std::string>(flat.rules[1].actions[0].args.at("zone")),
+            "zone1");
+}
+
+TEST(GraphTemplatesTest, CompilerStampsOutInstances) {
+  GraphSpec spec = heater_zones(50);
+  spec.signals.push_back({"ambient.temp", "degC"});
+
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  const CompiledProgram program = compiler.compile(spec, signal_ns, func_ns);
+
+  EXPECT_EQ(program.models.size(), 50u);
+  EXPECT_EQ(program.edges.size(), 50u);
+  EXPECT_EQ(program.rules.size(), 50u);
+  EXPECT_NE(signal_ns.resolve("zone49.temp"), INVALID_SIGNAL);
+  EXPECT_NE(signal_ns.resolve("zone0.command"), INVALID_SIGNAL);
+  EXPECT_EQ(program.signal_unit_contracts.size(), 51u);
+}
+
+TEST(GraphTemplatesTest, ValidatesTemplatesOnceWithoutInstances) {
+  GraphSpec spec = heater_zones(0);
+  spec.templates[0].edges[0].target_path = "${prefix}.${missing}";
+  try {
+    expand_templates(spec);
+    FAIL() << "expected an undeclared-parameter error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("undeclared parameter '${missing}'"),
+              std::string::npos)
+        << e.what();
+    EXPECT_NE(std::string(e.what()).find("edges[0]"), std::string::npos);
+  }
+
+  spec = heater_zones(0);
+  spec.templates[0].signals[0].path = "${prefix";
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  spec = heater_zones(0);
+  spec.templates[0].params["prefix"] = std::string("x");
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  spec = heater_zones(0);
+  spec.templates.push_back(heater_zone_template());
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+}
+
+TEST(GraphTemplatesTest, RejectsInvalidInstances) {
+  GraphSpec spec = heater_zones(1);
+  spec.instances[0].template_name = "boiler";
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  spec = heater_zones(1);
+  spec.instances[0].params["power"] = 1.0; // Not declared by the template
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  spec = heater_zones(2);
+  spec.instances[1].prefix = spec.instances[0].prefix;
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  spec = heater_zones(1);
+  spec.instances[0].prefix.clear();
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+
+  // Non-string value embedded in a longer string
+  spec = heater_zones(1);
+  spec.instances[0].params["ambient"] = 20.0;
+  spec.templates[0].models[0].params["ambient_signal"] =
+      std::string("${ambient}"); // Whole-value use is fine...
+  EXPECT_NO_THROW(expand_templates(spec));
+  spec.templates[0].signals[0].path = "${prefix}.${ambient}.temp";
+  spec.instances[0].params.clear();
+  EXPECT_NO_THROW(expand_templates(spec));
+  spec.instances[0].params["ambient"] = 20.0; // ...text use is not
+  EXPECT_THROW(expand_templates(spec), std::runtime_error);
+}
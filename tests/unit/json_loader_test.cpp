@@ -211,13 +211,11 @@ TEST(JsonLoaderTest, NestedParamsSupported) {
   ASSERT_EQ(spec.edges.size(), 1);
 
   const auto &matrix_value = spec.models[0].params.at("matrix");
-  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(matrix_value));
-  const auto &matrix = std::get<fluxgraph::ParamArray>(matrix_value);
-  ASSERT_EQ(matrix.size(), 2u);
-  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(matrix[0]));
-  const auto &row0 = std::get<fluxgraph::ParamArray>(matrix[0]);
-  ASSERT_EQ(row0.size(), 2u);
-  EXPECT_EQ(std::get<int64_t>(row0[0]), 1);
+  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamNumbers>(matrix_value));
+  const auto &matrix = std::get<fluxgraph::ParamNumbers>(matrix_value);
+  EXPECT_EQ(matrix.columns, 2u);
+  EXPECT_TRUE(matrix.integral);
+  EXPECT_EQ(matrix.values, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
 
   const auto &config_value = spec.models[0].params.at("config");
   ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamObject>(config_value));
@@ -229,6 +227,39 @@ TEST(JsonLoaderTest, NestedParamsSupported) {
   ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamObject>(coeff_value));
 }
 
+TEST(JsonLoaderTest, NonNumericArraysStayNested) {
+  std::string json = R"({
+        "models": [
+            {
+                "id": "nested",
+                "type": "test_model",
+                "params": {
+                    "mixed": [1, 2.5],
+                    "labels": [1, "two"],
+                    "ragged": [[1, 2], [3]],
+                    "huge": [9007199254740993],
+                    "cube": [[[1]]]
+                }
+            }
+        ]
+    })";
+
+  auto spec = load_json_string(json);
+  auto &params = spec.models[0].params;
+
+  const auto &mixed = std::get<fluxgraph::ParamNumbers>(params["mixed"]);
+  EXPECT_FALSE(mixed.integral);
+  EXPECT_EQ(mixed.values, (std::vector<double>{1.0, 2.5}));
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(params["labels"]));
+  const auto &ragged = std::get<fluxgraph::ParamArray>(params["ragged"]);
+  ASSERT_EQ(ragged.size(), 2u);
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamNumbers>(ragged[1]));
+  // Not exactly representable as double
+  const auto &huge = std::get<fluxgraph::ParamArray>(params["huge"]);
+  EXPECT_EQ(std::get<int64_t>(huge[0]), 9007199254740993LL);
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(params["cube"]));
+}
+
 TEST(JsonLoaderTest, RejectsNestedCommandArgs) {
   std::string json = R"({
         "rules": [
@@ -286,6 +317,30 @@ TEST(JsonLoaderTest, EnforcesParamDepthLimit) {
   EXPECT_THROW({ load_json_string(nested); }, std::runtime_error);
 }
 
+TEST(JsonLoaderTest, PackedMatrixCountsTowardNodeLimit) {
+  // 600 x 600 leaves exceed the 250k parameter node budget
+  std::string row = "[0";
+  for (int i = 1; i < 600; ++i) {
+    row += ",0";
+  }
+  row += "]";
+  std::string json = R"({"models":[{"id":"m","type":"test_model","params":{)"
+                     R"("A_d":[)";
+  for (int i = 0; i < 600; ++i) {
+    json += (i == 0 ? "" : ",") + row;
+  }
+  json += "]}}]}";
+
+  try {
+    load_json_string(json);
+    FAIL() << "expected node limit error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("node count exceeds limit"),
+              std::string::npos)
+        << e.what();
+  }
+}
+
 TEST(JsonLoaderTest, EmptyGraph) {
   std::string json = "{}";
 
@@ -314,6 +369,55 @@ TEST(JsonLoaderTest, LoadSignalContracts) {
   EXPECT_EQ(spec.signals[1].unit, "W");
 }
 
+TEST(JsonLoaderTest, LoadTemplatesAndInstances) {
+  std::string json = R"({
+        "templates": [
+            {
+                "name": "heater_zone",
+                "params": {"gain": 1.0},
+                "signals": [{"path": "${prefix}.temp", "unit": "degC"}],
+                "edges": [
+                    {
+                        "source": "${prefix}.command",
+                        "target": "${prefix}.power",
+                        "transform": {
+                            "type": "linear",
+                            "params": {"scale": "${gain}", "offset": 0.0}
+                        }
+                    }
+                ]
+            }
+        ],
+        "instances": [
+            {"template": "heater_zone", "prefix": "zone0"},
+            {"template": "heater_zone", "prefix": "zone1",
+             "params": {"gain": 2.5}}
+        ]
+    })";
+
+  auto spec = load_json_string(json);
+
+  ASSERT_EQ(spec.templates.size(), 1);
+  EXPECT_EQ(spec.templates[0].name, "heater_zone");
+  EXPECT_EQ(std::get<double>(spec.templates[0].params["gain"]), 1.0);
+  ASSERT_EQ(spec.templates[0].signals.size(), 1);
+  EXPECT_EQ(spec.templates[0].signals[0].path, "${prefix}.temp");
+  ASSERT_EQ(spec.templates[0].edges.size(), 1);
+  EXPECT_EQ(std::get<std::string>(
+                spec.templates[0].edges[0].transform.params["scale"]),
+            "${gain}");
+  ASSERT_EQ(spec.instances.size(), 2);
+  EXPECT_EQ(spec.instances[1].template_name, "heater_zone");
+  EXPECT_EQ(spec.instances[1].prefix, "zone1");
+  EXPECT_EQ(std::get<double>(spec.instances[1].params["gain"]), 2.5);
+}
+
+TEST(JsonLoaderTest, InstanceRequiresPrefix) {
+  std::string json = R"({"instances": [{"template": "heater_zone"}]})";
+
+  EXPECT_THROW(load_json_string(json), std::runtime_error);
+}
+
 TEST(JsonLoaderTest, InvalidJson) {
   std::string json = "{ invalid json }";
 
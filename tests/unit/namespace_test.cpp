@@ -85,6 +85,76 @@ TEST_F(SignalNamespaceTest, Clear) {
   EXPECT_EQ(ns.resolve("path1"), INVALID_SIGNAL);
 }
 
+TEST_F(SignalNamespaceTest, ResolveAcceptsStringView) {
+  SignalId id = ns.intern("tempctl0/chamber/temperature");
+
+  const char buffer[] = "tempctl0/chamber/temperature/extra";
+  std::string_view prefix(buffer, 28);
+  EXPECT_EQ(ns.resolve(prefix), id);
+  EXPECT_EQ(ns.resolve(std::string_view(buffer)), INVALID_SIGNAL);
+}
+
+TEST_F(SignalNamespaceTest, IdsAndViewsSurviveGrowth) {
+  const int count = 50000;
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(ns.intern("dev" + std::to_string(i % 97) + "/sig" +
+                        std::to_string(i)),
+              static_cast<SignalId>(i));
+  }
+  std::string_view first = ns.lookup(0);
+
+  ns.intern(std::string(100000, 'x')); // Longer than an arena block
+  EXPECT_EQ(first, "dev0/sig0");
+  EXPECT_EQ(ns.size(), static_cast<size_t>(count) + 1);
+  for (int i = 0; i < count; i += 997) {
+    std::string path =
+        "dev" + std::to_string(i % 97) + "/sig" + std::to_string(i);
+    EXPECT_EQ(ns.resolve(path), static_cast<SignalId>(i));
+    EXPECT_EQ(ns.lookup(static_cast<SignalId>(i)), path);
+  }
+  EXPECT_EQ(ns.resolve(std::string(100000, 'x')),
+            static_cast<SignalId>(count));
+}
+
+TEST_F(SignalNamespaceTest, CopyPreservesIds) {
+  ns.intern("a");
+  ns.intern("b");
+  ns.intern("");
+
+  SignalNamespace copy(ns);
+  ns.clear();
+  EXPECT_EQ(copy.resolve("a"), 0u);
+  EXPECT_EQ(copy.resolve("b"), 1u);
+  EXPECT_EQ(copy.resolve(""), 2u);
+  EXPECT_EQ(copy.lookup(1), "b");
+  EXPECT_EQ(copy.intern("c"), 3u);
+
+  SignalNamespace moved(std::move(copy));
+  EXPECT_EQ(moved.lookup(3), "c");
+}
+
+TEST_F(SignalNamespaceTest, MemoryBytesTracksArenaAndTables) {
+  const size_t empty = ns.memory_bytes();
+
+  // A path longer than any arena block gets a block of its own
+  const std::string long_path(100000, 'x');
+  ns.intern("short");
+  ns.intern(long_path);
+  EXPECT_GE(ns.memory_bytes(), empty + long_path.size());
+
+  ns.clear();
+  EXPECT_LT(ns.memory_bytes(), long_path.size());
+}
+
+TEST_F(SignalNamespaceTest, AllPathsIsSorted) {
+  ns.intern("zeta");
+  ns.intern("alpha");
+  ns.intern("mid");
+
+  EXPECT_EQ(ns.all_paths(),
+            (std::vector<std::string>{"alpha", "mid", "zeta"}));
+}
+
 class FunctionNamespaceTest : public ::testing::Test {
 protected:
   FunctionNamespace fns;
@@ -0,0 +1,112 @@
+#include "fluxgraph/core/namespace.hpp"
+#include <gtest/gtest.h>
+
+using namespace fluxgraph;
+
+class PathIndexTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    for (const char *path :
+         {"chamber/temp", "chamber/power", "chamber.air.temp",
+          "chamber/wall/temp", "chamberB/temp", "ambient/temp", "chamber"}) {
+      ns.intern(path);
+    }
+  }
+
+  std::vector<std::string> paths(const std::vector<SignalId> &ids) const {
+    std::vector<std::string> result;
+    for (SignalId id : ids) {
+      result.emplace_back(ns.lookup(id));
+    }
+    return result;
+  }
+
+  SignalNamespace ns;
+};
+
+TEST_F(PathIndexTest, PrefixReturnsSubtreeInPathOrder) {
+  EXPECT_EQ(paths(ns.find_prefix("chamber/")),
+            (std::vector<std::string>{"chamber/power", "chamber/temp",
+                                      "chamber/wall/temp"}));
+  // A prefix may end inside an edge label
+  EXPECT_EQ(paths(ns.find_prefix("chamber/p")),
+            (std::vector<std::string>{"chamber/power"}));
+  EXPECT_EQ(ns.find_prefix("chamber").size(), 6u);
+  EXPECT_TRUE(ns.find_prefix("missing").empty());
+  EXPECT_EQ(paths(ns.find_prefix("")), ns.all_paths());
+}
+
+TEST_F(PathIndexTest, GlobWildcardsStopAtSeparators) {
+  EXPECT_EQ(paths(ns.find_glob("chamber/*")),
+            (std::vector<std::string>{"chamber/power", "chamber/temp"}));
+  EXPECT_EQ(paths(ns.find_glob("*/temp")),
+            (std::vector<std::string>{"ambient/temp", "chamber/temp",
+                                      "chamberB/temp"}));
+  EXPECT_EQ(paths(ns.find_glob("chamber**temp")),
+            (std::vector<std::string>{"chamber.air.temp", "chamber/temp",
+                                      "chamber/wall/temp", "chamberB/temp"}));
+  EXPECT_EQ(paths(ns.find_glob("chamber?temp")),
+            std::vector<std::string>{});
+  EXPECT_EQ(paths(ns.find_glob("chamber?/temp")),
+            (std::vector<std::string>{"chamberB/temp"}));
+}
+
+TEST_F(PathIndexTest, GlobWithoutWildcardIsExactMatch) {
+  EXPECT_EQ(paths(ns.find_glob("chamber")),
+            (std::vector<std::string>{"chamber"}));
+  EXPECT_TRUE(ns.find_glob("chamber/te").empty());
+}
+
+TEST_F(PathIndexTest, IndexFollowsClearAndCopy) {
+  SignalNamespace copy(ns);
+  ns.clear();
+  EXPECT_TRUE(ns.find_prefix("").empty());
+  EXPECT_EQ(copy.find_prefix("chamber/").size(), 3u);
+
+  ns.intern("x/y");
+  EXPECT_EQ(paths(ns.find_glob("x/*")), (std::vector<std::string>{"x/y"}));
+}
+
+TEST(PathIndexGlobTest, MatchRules) {
+  EXPECT_TRUE(PathIndex::glob_match("a/*/c", "a/b/c"));
+  EXPECT_FALSE(PathIndex::glob_match("a/*/c", "a/b/x/c"));
+  EXPECT_TRUE(PathIndex::glob_match("a/**/c", "a/b/x/c"));
+  EXPECT_TRUE(PathIndex::glob_match("a.*", "a.temp"));
+  EXPECT_FALSE(PathIndex::glob_match("a.*", "a.temp.raw"));
+  EXPECT_TRUE(PathIndex::glob_match("**", ""));
+  EXPECT_TRUE(PathIndex::glob_match("*", ""));
+  EXPECT_FALSE(PathIndex::glob_match("?", ""));
+  EXPECT_TRUE(PathIndex::is_glob("a/*"));
+  EXPECT_FALSE(PathIndex::is_glob("a/b"));
+}
+
+TEST(PathIndexGlobTest, PathologicalPatternsStayPolynomial) {
+  // Backtracking would try every split of the run between the stars
+  const std::string run(4000, 'a');
+  std::string pattern;
+  for (int i = 0; i < 24; ++i) {
+    pattern += "*a";
+  }
+  EXPECT_FALSE(PathIndex::glob_match(pattern + "*b", run));
+  EXPECT_TRUE(PathIndex::glob_match(pattern + "*", run));
+
+  std::string globstars;
+  for (int i = 0; i < 24; ++i) {
+    globstars += "**/";
+  }
+  const std::string deep = [] {
+    std::string p;
+    for (int i = 0; i < 500; ++i) {
+      p += "n/";
+    }
+    return p + "leaf";
+  }();
+  EXPECT_FALSE(PathIndex::glob_match(globstars + "missing", deep));
+  EXPECT_TRUE(PathIndex::glob_match(globstars + "leaf", deep));
+
+  SignalNamespace ns;
+  ns.intern(run + "/x");
+  ns.intern(deep);
+  EXPECT_TRUE(ns.find_glob(pattern + "*b").empty());
+  EXPECT_EQ(ns.find_glob(globstars + "leaf").size(), 1u);
+}
@@ -0,0 +1,172 @@
+#include "fluxgraph/engine.hpp"
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace fluxgraph;
+
+namespace {
+
+// thermal model -> two-edge chain, plus one rule on the chain output
+GraphSpec make_profiled_spec() {
+  GraphSpec spec;
+
+  ModelSpec model_spec;
+  model_spec.id = "chamber";
+  model_spec.type = "thermal_mass";
+  model_spec.params["thermal_mass"] = 1000.0;
+  model_spec.params["heat_transfer_coeff"] = 10.0;
+  model_spec.params["initial_temp"] = 25.0;
+  model_spec.params["temp_signal"] = std::string("chamber.temp");
+  model_spec.params["power_signal"] = std::string("chamber.power");
+  model_spec.params["ambient_signal"] = std::string("ambient.temp");
+  spec.models.push_back(model_spec);
+
+  EdgeSpec first;
+  first.source_path = "chamber.temp";
+  first.target_path = "sensor.raw";
+  first.transform.type = "linear";
+  first.transform.params["scale"] = 1.0;
+  first.transform.params["offset"] = 0.0;
+  spec.edges.push_back(first);
+
+  EdgeSpec second = first;
+  second.source_path = "sensor.raw";
+  second.target_path = "sensor.filtered";
+  spec.edges.push_back(second);
+
+  RuleSpec rule;
+  rule.id = "overheat";
+  rule.condition = "sensor.filtered > 1000.0";
+  ActionSpec action;
+  action.device = "heater";
+  action.function = "off";
+  rule.actions.push_back(action);
+  spec.rules.push_back(rule);
+
+  return spec;
+}
+
+} // namespace
+
+TEST(ProfilerTest, DisabledByDefault) {
+  Engine engine;
+  EXPECT_EQ(engine.profiler(), nullptr);
+
+  SignalNamespace signal_ns;
+  EXPECT_TRUE(engine.profile_report(signal_ns).empty());
+  EXPECT_EQ(engine.export_chrome_trace(signal_ns), "{\"traceEvents\":[]}");
+}
+
+TEST(ProfilerTest, SamplesEveryNthTickAndLabelsComponents) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  GraphCompiler compiler;
+
+  Engine engine;
+  engine.enable_profiling({/*sample_interval=*/3, /*trace_window=*/0});
+  engine.load(compiler.compile(make_profiled_spec(), signal_ns, func_ns));
+  store.write(signal_ns.resolve("chamber.power"), 0.0, "W");
+  store.write(signal_ns.resolve("ambient.temp"), 20.0, "degC");
+
+  for (int i = 0; i < 10; ++i) {
+    engine.tick(0.1, store);
+  }
+
+  const TickProfiler *profiler = engine.profiler();
+  ASSERT_NE(profiler, nullptr);
+  EXPECT_EQ(profiler->ticks_seen(), 10u);
+  EXPECT_EQ(profiler->sampled_ticks(), 4u); // ticks 0, 3, 6, 9
+
+  const auto report = engine.profile_report(signal_ns, 0);
+  ASSERT_EQ(report.size(), 4u); // 1 model + 2 edges + 1 rule
+
+  std::map<std::string, ProfileEntry> by_label;
+  for (const auto &entry : report) {
+    EXPECT_EQ(entry.samples, 4u);
+    EXPECT_GE(entry.max, entry.mean());
+    by_label[entry.label] = entry;
+  }
+  EXPECT_EQ(by_label.count("chamber.temp -> sensor.raw"), 1u);
+  EXPECT_EQ(by_label.count("sensor.raw -> sensor.filtered"), 1u);
+  EXPECT_EQ(by_label.count("overheat"), 1u);
+  EXPECT_EQ(by_label["overheat"].component, ProfileComponent::rule);
+
+  // Sorted by total cost, truncated to top_n
+  const auto top = engine.profile_report(signal_ns, 2);
+  ASSERT_EQ(top.size(), 2u);
+  EXPECT_GE(top[0].total, top[1].total);
+
+  const auto with_stages = engine.profile_report(signal_ns, 0, false);
+  EXPECT_EQ(with_stages.size(), report.size() + 4u); // tick + 3 stages
+}
+
+TEST(ProfilerTest, LabelsTranslateProgramIdsWithKeepExternalIds) {
+  // Host ids that differ from the execution-order program ids
+  SignalNamespace signal_ns;
+  signal_ns.intern("host.other");
+  signal_ns.intern("sensor.filtered");
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  CompilationOptions options;
+  options.signal_layout = SignalLayout::execution_order;
+  options.keep_external_ids = true;
+  auto program =
+      compiler.compile(make_profiled_spec(), signal_ns, func_ns, options);
+  const SignalIdMap map = program.signal_id_map;
+  ASSERT_NE(map.program_id(signal_ns.resolve("sensor.filtered")),
+            signal_ns.resolve("sensor.filtered"));
+
+  Engine engine;
+  engine.enable_profiling({/*sample_interval=*/1, /*trace_window=*/1});
+  engine.load(std::move(program));
+  SignalStore store;
+  store.write(map.program_id(signal_ns.resolve("chamber.power")), 0.0, "W");
+  store.write(map.program_id(signal_ns.resolve("ambient.temp")), 20.0,
+              "degC");
+  engine.tick(0.1, store);
+
+  std::set<std::string> labels;
+  for (const auto &entry : engine.profile_report(signal_ns, 0)) {
+    labels.insert(entry.label);
+  }
+  EXPECT_EQ(labels.count("chamber.temp -> sensor.raw"), 1u);
+  EXPECT_EQ(labels.count("sensor.raw -> sensor.filtered"), 1u);
+  EXPECT_NE(engine.export_chrome_trace(signal_ns).find(
+                "\"name\":\"sensor.raw -> sensor.filtered\""),
+            std::string::npos);
+}
+
+TEST(ProfilerTest, ChromeTraceKeepsLastWindow) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  GraphCompiler compiler;
+
+  Engine engine;
+  engine.load(compiler.compile(make_profiled_spec(), signal_ns, func_ns));
+  engine.enable_profiling({/*sample_interval=*/1, /*trace_window=*/2});
+  store.write(signal_ns.resolve("chamber.power"), 0.0, "W");
+  store.write(signal_ns.resolve("ambient.temp"), 20.0, "degC");
+
+  for (int i = 0; i < 5; ++i) {
+    engine.tick(0.1, store);
+  }
+
+  const std::string trace = engine.export_chrome_trace(signal_ns);
+  EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_EQ(trace.find("\"name\":\"tick 2\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"tick 3\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"tick 4\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"sensor.raw -> sensor.filtered\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"cat\":\"rule\""), std::string::npos);
+
+  engine.disable_profiling();
+  EXPECT_EQ(engine.profiler(), nullptr);
+}
+
+TEST(ProfilerTest, RejectsZeroSampleInterval) {
+  Engine engine;
+  EXPECT_THROW(engine.enable_profiling({0, 0}), std::invalid_argument);
+}
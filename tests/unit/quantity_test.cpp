@@ -0,0 +1,102 @@
+#include "fluxgraph/core/typed_signal.hpp"
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace fluxgraph;
+
+// Compile-time checks: conversions fold to constants, mismatched dimensions
+// and absolute/delta temperature mixes do not convert
+static_assert(sizeof(Quantity<units::degC>) == sizeof(double));
+static_assert(Quantity<units::degC>(Quantity<units::K>(273.15)).value() ==
+              0.0);
+static_assert(std::is_convertible_v<Quantity<units::K>,
+                                    Quantity<units::degC>>);
+static_assert(std::is_convertible_v<Quantity<units::rad_per_s>,
+                                    Quantity<units::per_s>>);
+static_assert(!std::is_convertible_v<Quantity<units::W>,
+                                     Quantity<units::degC>>);
+static_assert(!std::is_convertible_v<Quantity<units::delta_K>,
+                                     Quantity<units::K>>);
+static_assert(!std::is_convertible_v<double, Quantity<units::W>>);
+static_assert(std::is_same_v<decltype(Quantity<units::V>() *
+                                      Quantity<units::A>())::unit::dimension,
+                             units::W::dimension>);
+static_assert(std::is_same_v<decltype(Quantity<units::W>() /
+                                      Quantity<units::W_per_K>())::unit::
+                                 dimension,
+                             dimensions::temperature>);
+
+TEST(QuantityTest, ArithmeticAndConversions) {
+  constexpr Quantity<units::N_m> torque(2.0);
+  constexpr Quantity<units::rad_per_s> speed(10.0);
+  constexpr Quantity<units::W> power = torque * speed;
+  EXPECT_DOUBLE_EQ(power.value(), 20.0);
+
+  Quantity<units::degC> temp(25.0);
+  temp += Quantity<units::degC>(5.0);
+  EXPECT_DOUBLE_EQ(quantity_cast<units::K>(temp).value(), 303.15);
+  EXPECT_TRUE(temp > Quantity<units::degC>(29.0));
+  EXPECT_DOUBLE_EQ((2.0 * Quantity<units::m>(1.5)).value(), 3.0);
+}
+
+namespace {
+
+template <typename... Units> void bind_each(SignalStore &store) {
+  SignalId id = 0;
+  (TypedSignal<Units>::bind(store, id++), ...);
+}
+
+} // namespace
+
+TEST(QuantityTest, NamedUnitsMatchRegistry) {
+  // bind() verifies each unit against the registry entry for its symbol
+  SignalStore store;
+  EXPECT_NO_THROW((bind_each<
+                   units::dimensionless, units::rad, units::s, units::per_s,
+                   units::rad_per_s, units::m, units::m_per_s, units::kg,
+                   units::kg_m2, units::N, units::N_per_m, units::N_s_per_m,
+                   units::N_m, units::N_m_s_per_rad, units::A, units::V,
+                   units::Ohm, units::H, units::N_m_per_A, units::V_s_per_rad,
+                   units::W, units::K, units::degC, units::delta_K,
+                   units::delta_degC, units::J_per_K, units::W_per_K>(store)));
+}
+
+TEST(TypedSignalTest, WritesConvertAndShareStringContracts) {
+  SignalNamespace ns;
+  SignalStore store;
+  ns.intern("chamber.temp");
+
+  auto temp = TypedSignal<units::degC>::bind(store, ns, "chamber.temp");
+  temp.write(store, Quantity<units::K>(300.0));
+  EXPECT_NEAR(store.read_value(temp.id()), 26.85, 1e-12);
+  EXPECT_EQ(store.read_unit(temp.id()), "degC");
+  EXPECT_EQ(store.declared_unit(temp.id()), "degC");
+
+  temp.write(store, Quantity<units::degC>(30.0));
+  EXPECT_DOUBLE_EQ(temp.read(store).value(), 30.0);
+
+  // String writers still see the declared contract
+  EXPECT_THROW(store.write(temp.id(), 1.0, "K"), std::runtime_error);
+  EXPECT_NO_THROW(store.write(temp.id(), 31.0, "degC"));
+  EXPECT_DOUBLE_EQ(temp.read(store).value(), 31.0);
+}
+
+TEST(TypedSignalTest, BindRejectsConflictingContracts) {
+  SignalNamespace ns;
+  SignalStore store;
+  const SignalId power = ns.intern("heater.power");
+  store.write(power, 10.0, "W");
+
+  EXPECT_THROW(TypedSignal<units::K>::bind(store, power), std::runtime_error);
+  EXPECT_NO_THROW(TypedSignal<units::W>::bind(store, power));
+  EXPECT_THROW(TypedSignal<units::W>::bind(store, ns, "missing"),
+               std::invalid_argument);
+}
+
+TEST(TypedSignalTest, BindRelabelsDimensionlessValue) {
+  SignalStore store;
+  store.write(0, 5.0);
+  auto length = TypedSignal<units::m>::bind(store, 0);
+  EXPECT_EQ(store.read_unit(0), "m");
+  EXPECT_DOUBLE_EQ(length.read(store).value(), 5.0);
+}
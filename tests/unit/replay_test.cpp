@@ -0,0 +1,186 @@
+#include "fluxgraph/trace/replay.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+using namespace fluxgraph;
+
+namespace {
+
+GraphSpec make_replay_spec(double initial_temp = 25.0) {
+  GraphSpec spec;
+
+  ModelSpec model_spec;
+  model_spec.id = "chamber";
+  model_spec.type = "thermal_mass";
+  model_spec.params["thermal_mass"] = 1000.0;
+  model_spec.params["heat_transfer_coeff"] = 10.0;
+  model_spec.params["initial_temp"] = initial_temp;
+  model_spec.params["temp_signal"] = std::string("chamber.temp");
+  model_spec.params["power_signal"] = std::string("chamber.power");
+  model_spec.params["ambient_signal"] = std::string("ambient.temp");
+  spec.models.push_back(model_spec);
+
+  EdgeSpec edge;
+  edge.source_path = "chamber.temp";
+  edge.target_path = "sensor.temp";
+  edge.transform.type = "first_order_lag";
+  edge.transform.params["tau_s"] = 0.5;
+  spec.edges.push_back(edge);
+
+  RuleSpec rule;
+  rule.id = "hot";
+  rule.condition = "sensor.temp > 25.5";
+  ActionSpec action;
+  action.device = "heater";
+  action.function = "off";
+  rule.actions.push_back(action);
+  spec.rules.push_back(rule);
+
+  return spec;
+}
+
+struct Rig {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  SignalStore store;
+  Engine engine;
+
+  explicit Rig(double initial_temp = 25.0) {
+    GraphCompiler compiler;
+    engine.load(compiler.compile(make_replay_spec(initial_temp), signal_ns,
+                                 func_ns));
+  }
+};
+
+std::string temp_journal_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() /
+          ("fluxgraph_" + name + ".fgjournal"))
+      .string();
+}
+
+// Provider writes ambient once, then a varying heater power every 3rd tick
+InputJournal record_run(Rig &rig, int tick_count) {
+  InputJournal journal(rig.signal_ns, {"chamber.temp", "sensor.temp"});
+  rig.store.set_write_observer(&journal);
+
+  const SignalId power = rig.signal_ns.resolve("chamber.power");
+  rig.store.write(rig.signal_ns.resolve("ambient.temp"), 20.0, "degC");
+  for (int tick = 0; tick < tick_count; ++tick) {
+    if (tick % 3 == 0) {
+      rig.store.write(power, 100.0 * (tick % 7), "W");
+    }
+    rig.engine.tick(0.1, rig.store);
+    rig.engine.drain_commands();
+    journal.end_tick(0.1, rig.store);
+  }
+
+  rig.store.set_write_observer(nullptr);
+  return journal;
+}
+
+} // namespace
+
+TEST(ReplayTest, JournalCapturesOnlyExternalWritesBetweenTicks) {
+  Rig rig;
+  const InputJournal journal = record_run(rig, 10);
+
+  ASSERT_EQ(journal.tick_count(), 10u);
+  // ambient + power before tick 0, then power before ticks 3, 6, 9
+  EXPECT_EQ(journal.writes().size(), 5u);
+  EXPECT_EQ(journal.ticks()[0].write_count, 2u);
+  EXPECT_EQ(journal.ticks()[1].write_count, 0u);
+  EXPECT_EQ(journal.ticks()[3].first_write, 2u);
+  EXPECT_EQ(journal.units().size(), 2u); // degC, W
+  EXPECT_EQ(journal.pending_writes(), 0u);
+}
+
+TEST(ReplayTest, ReplayFromSavedJournalIsBitwiseDeterministic) {
+  const std::string path = temp_journal_path("roundtrip");
+  {
+    Rig recording;
+    record_run(recording, 200).save(path, recording.signal_ns);
+  }
+
+  Rig replay;
+  const InputJournal journal = InputJournal::load(path, replay.signal_ns);
+  const ReplayResult result =
+      replay_journal(journal, replay.engine, replay.store);
+  EXPECT_TRUE(result.deterministic());
+  EXPECT_EQ(result.ticks_replayed, 200u);
+  EXPECT_GT(result.commands_discarded, 0u);
+  std::remove(path.c_str());
+}
+
+TEST(ReplayTest, ReportsFirstDivergentTick) {
+  Rig recording;
+  const InputJournal journal = record_run(recording, 20);
+
+  Rig diverged(/*initial_temp=*/25.0 + 1e-9);
+  ReplayOptions options;
+  options.stop_on_divergence = false;
+  const ReplayResult result =
+      replay_journal(journal, diverged.engine, diverged.store, options);
+  EXPECT_FALSE(result.deterministic());
+  EXPECT_EQ(result.first_divergent_tick, 0u);
+  EXPECT_EQ(result.divergent_ticks, 20u);
+  EXPECT_NE(result.expected_hash, result.actual_hash);
+  EXPECT_EQ(result.ticks_replayed, 20u);
+}
+
+TEST(ReplayTest, SaveAndLoadTranslateKeptExternalIds) {
+  // Host ids that differ from the execution-order program ids
+  SignalNamespace signal_ns;
+  signal_ns.intern("host.other");
+  signal_ns.intern("sensor.temp");
+  FunctionNamespace func_ns;
+  CompilationOptions options;
+  options.signal_layout = SignalLayout::execution_order;
+  options.keep_external_ids = true;
+  Engine engine;
+  engine.load(GraphCompiler().compile(make_replay_spec(), signal_ns, func_ns,
+                                      options));
+  const SignalIdMap &map = engine.signal_id_map();
+  ASSERT_NE(map.program_id(signal_ns.resolve("sensor.temp")),
+            signal_ns.resolve("sensor.temp"));
+
+  SignalStore store;
+  InputJournal journal(signal_ns, {}, &map);
+  EXPECT_EQ(journal.output_ids().size(), 4u) << "host.other is not hashed";
+  store.set_write_observer(&journal);
+  store.write(map.program_id(signal_ns.resolve("ambient.temp")), 20.0,
+              "degC");
+  store.write(map.program_id(signal_ns.resolve("chamber.power")), 500.0,
+              "W");
+  for (int tick = 0; tick < 10; ++tick) {
+    engine.tick(0.1, store);
+    journal.end_tick(0.1, store);
+  }
+  store.set_write_observer(nullptr);
+
+  const std::string path = temp_journal_path("external_ids");
+  journal.save(path, signal_ns, &map);
+
+  // Replays against a renumbered namespace and back through the id map
+  Rig replay;
+  const ReplayResult result = replay_journal(
+      InputJournal::load(path, replay.signal_ns), replay.engine, replay.store);
+  EXPECT_TRUE(result.deterministic());
+  EXPECT_EQ(result.ticks_replayed, 10u);
+
+  const InputJournal reloaded = InputJournal::load(path, signal_ns, &map);
+  EXPECT_EQ(reloaded.output_ids(), journal.output_ids());
+  ASSERT_EQ(reloaded.writes().size(), journal.writes().size());
+  EXPECT_EQ(reloaded.writes()[0].id, journal.writes()[0].id);
+  std::remove(path.c_str());
+}
+
+TEST(ReplayTest, LoadRejectsPathsMissingFromNamespace) {
+  const std::string path = temp_journal_path("missing_path");
+  Rig recording;
+  record_run(recording, 3).save(path, recording.signal_ns);
+
+  SignalNamespace empty_ns;
+  EXPECT_THROW(InputJournal::load(path, empty_ns), std::runtime_error);
+  std::remove(path.c_str());
+}
@@ -186,3 +186,48 @@ TEST_F(SignalStoreTest, DeclaredUnitsPersistedAfterClear) {
   EXPECT_THROW(store.write(id, 10.0, "A"), std::runtime_error);
   EXPECT_NO_THROW(store.write(id, 10.0, "V"));
 }
+
+TEST_F(SignalStoreTest, UnitConversionConvertsCompatibleWrites) {
+  SignalId id = 4;
+  store.declare_unit(id, "degC");
+
+  EXPECT_THROW(store.write(id, 300.0, "K"), std::runtime_error);
+
+  store.set_unit_conversion(true);
+  store.write(id, 300.0, "K");
+  EXPECT_NEAR(store.read_value(id), 26.85, 1e-12);
+  EXPECT_EQ(store.read_unit(id), "degC");
+
+  // Incompatible and unknown units still throw
+  EXPECT_THROW(store.write(id, 1.0, "delta_K"), std::runtime_error);
+  EXPECT_THROW(store.write(id, 1.0, "W"), std::runtime_error);
+  EXPECT_THROW(store.write(id, 1.0, "furlong"), std::runtime_error);
+  EXPECT_NEAR(store.read_value(id), 26.85, 1e-12);
+}
+
+TEST_F(SignalStoreTest, ConvertingWritesDoNotGrowTheUnitRegistry) {
+  SignalId id = 4;
+  store.declare_unit(id, "W");
+  store.set_unit_conversion(true);
+  const UnitRegistry &registry = UnitRegistry::instance();
+  const size_t size = registry.size();
+
+  store.write(id, 60.0, "J/min");
+  EXPECT_NEAR(store.read_value(id), 1.0, 1e-12);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_THROW(store.write(id, 1.0, "bogus" + std::to_string(i)),
+                 std::runtime_error);
+  }
+  EXPECT_EQ(registry.size(), size);
+  EXPECT_EQ(registry.lookup("J/min"), INVALID_UNIT_INDEX);
+}
+
+TEST_F(SignalStoreTest, ValidateUnitAcceptsConvertibleUnitsWhenEnabled) {
+  SignalId id = 6;
+  store.declare_unit(id, "degC");
+  EXPECT_THROW(store.validate_unit(id, "K"), std::runtime_error);
+
+  store.set_unit_conversion(true);
+  EXPECT_NO_THROW(store.validate_unit(id, "K"));
+  EXPECT_THROW(store.validate_unit(id, "W"), std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include "fluxgraph/static_batch.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <type_traits>
+
+using namespace fluxgraph;
+namespace sg = fluxgraph::static_graph;
+
+namespace {
+
+using Cmd = sg::SignalSlot<0>;
+using Power = sg::SignalSlot<1>;
+using Ambient = sg::SignalSlot<2>;
+using Temp = sg::SignalSlot<3>;
+using Lagged = sg::SignalSlot<4>;
+using Smoothed = sg::SignalSlot<5>;
+using Delayed = sg::SignalSlot<6>;
+using Error = sg::SignalSlot<7>;
+using Limited = sg::SignalSlot<8>;
+using Process = sg::SignalSlot<9>;
+
+template <std::uint32_t Seed>
+using Plant = sg::Graph<
+    sg::Model<sg::ThermalMass<Temp, Power, Ambient, std::ratio<1000>,
+                              std::ratio<10>, std::ratio<25>,
+                              ThermalIntegrationMethod::Rk4>>,
+    sg::Model<sg::FirstOrderProcess<Process, Error, std::ratio<2>,
+                                    std::ratio<3, 2>>>,
+    sg::Edge<Cmd, Limited,
+             sg::Linear<std::ratio<25, 2>, std::ratio<-1, 10>, std::ratio<0>,
+                        std::ratio<800>>>,
+    sg::Edge<Limited, Power, sg::RateLimiter<std::ratio<400>>>,
+    sg::Edge<Temp, Lagged, sg::FirstOrderLag<std::ratio<7, 10>>>,
+    sg::Edge<Lagged, Smoothed, sg::Noise<std::ratio<1, 20>, Seed>>,
+    sg::Edge<Smoothed, Delayed, sg::Delay<std::ratio<3, 10>, 64>>,
+    sg::Edge<Delayed, Error,
+             sg::Deadband<std::ratio<1, 4>>>>;
+
+constexpr std::size_t kLanes = 6;
+
+double cmd_at(std::size_t lane, int step) {
+  return 40.0 * std::sin(0.009 * step + 0.3 * lane) + 5.0 * lane;
+}
+
+} // namespace
+
+TEST(StaticBatchTest, Float64LanesMatchSingleLaneGraph) {
+  using Batch = sg::Batch<Plant<7>, kLanes>;
+  auto batch = std::make_unique<Batch>();
+  // Lane k of a Noise edge is seeded with Seed + k
+  Plant<7> lane0;
+  Plant<8> lane1;
+  Plant<12> lane5;
+
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    batch->write<Ambient>(lane, 20.0 + lane);
+  }
+  lane0.write<Ambient>(20.0);
+  lane1.write<Ambient>(21.0);
+  lane5.write<Ambient>(25.0);
+
+  auto run = [&](int steps) {
+    for (int step = 0; step < steps; ++step) {
+      for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        batch->write<Cmd>(lane, cmd_at(lane, step));
+      }
+      lane0.write<Cmd>(cmd_at(0, step));
+      lane1.write<Cmd>(cmd_at(1, step));
+      lane5.write<Cmd>(cmd_at(5, step));
+      batch->tick(0.01);
+      lane0.tick(0.01);
+      lane1.tick(0.01);
+      lane5.tick(0.01);
+
+      for (std::size_t id = 0; id < Batch::signal_count; ++id) {
+        ASSERT_EQ(lane0.values()[id], batch->row(id)[0]) << id;
+        ASSERT_EQ(lane1.values()[id], batch->row(id)[1]) << id;
+        ASSERT_EQ(lane5.values()[id], batch->row(id)[5]) << id;
+      }
+    }
+  };
+
+  run(500);
+  batch->reset();
+  lane0.reset();
+  lane1.reset();
+  lane5.reset();
+  run(100);
+}
+
+TEST(StaticBatchTest, FloatPoliciesHalveStorageAndTrackFloat64) {
+  using Wide = sg::Batch<Plant<7>, 64, sg::precision::float64>;
+  using Mixed = sg::Batch<Plant<7>, 64, sg::precision::mixed>;
+  using Narrow = sg::Batch<Plant<7>, 64, sg::precision::float32>;
+  static_assert(std::is_same_v<Mixed::storage, float>);
+  static_assert(Wide::value_bytes() == 2 * Mixed::value_bytes());
+  static_assert(Mixed::value_bytes() == Narrow::value_bytes());
+  static_assert(alignof(Mixed::Row) == 64);
+
+  auto wide = std::make_unique<Wide>();
+  auto mixed = std::make_unique<Mixed>();
+  auto narrow = std::make_unique<Narrow>();
+  wide->fill<Ambient>(20.0);
+  mixed->fill<Ambient>(20.0);
+  narrow->fill<Ambient>(20.0);
+  for (int step = 0; step < 2000; ++step) {
+    for (std::size_t lane = 0; lane < 64; ++lane) {
+      wide->write<Cmd>(lane, cmd_at(lane, step));
+      mixed->write<Cmd>(lane, cmd_at(lane, step));
+      narrow->write<Cmd>(lane, cmd_at(lane, step));
+    }
+    wide->tick(0.01);
+    mixed->tick(0.01);
+    narrow->tick(0.01);
+  }
+
+  for (std::size_t lane = 0; lane < 64; ++lane) {
+    const double temp = wide->read<Temp>(lane);
+    EXPECT_NEAR(mixed->read<Temp>(lane), temp, 1e-4 * std::abs(temp));
+    EXPECT_NEAR(narrow->read<Temp>(lane), temp, 1e-3 * std::abs(temp));
+  }
+}
@@ -0,0 +1,193 @@
+#include "fluxgraph/static_graph.hpp"
+#include "fluxgraph/engine.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace fluxgraph;
+namespace sg = fluxgraph::static_graph;
+
+namespace {
+
+using Cmd = sg::SignalSlot<0>;
+using Power = sg::SignalSlot<1>;
+using Ambient = sg::SignalSlot<2>;
+using Temp = sg::SignalSlot<3>;
+using Lagged = sg::SignalSlot<4>;
+using Noisy = sg::SignalSlot<5>;
+using Smoothed = sg::SignalSlot<6>;
+using Delayed = sg::SignalSlot<7>;
+using Error = sg::SignalSlot<8>;
+using ErrorDb = sg::SignalSlot<9>;
+using TempK = sg::SignalSlot<10>;
+using Limited = sg::SignalSlot<11>;
+
+struct Tau {
+  static constexpr double value = 0.7;
+};
+
+// Declared out of execution order on purpose
+using Plant = sg::Graph<
+    sg::Edge<Delayed, Error, sg::Linear<std::ratio<-1>, std::ratio<40>>>,
+    sg::Edge<Error, ErrorDb, sg::Deadband<std::ratio<1, 4>>>,
+    sg::Model<sg::ThermalMass<Temp, Power, Ambient, std::ratio<1000>,
+                              std::ratio<10>, std::ratio<25>>>,
+    sg::Edge<Smoothed, Delayed, sg::Delay<std::ratio<3, 10>, 64>>,
+    sg::Edge<Noisy, Smoothed, sg::MovingAverage<5>>,
+    sg::Edge<Lagged, Noisy, sg::Noise<std::ratio<1, 20>, 7>>,
+    sg::Edge<Temp, Lagged, sg::FirstOrderLag<Tau>>,
+    sg::Edge<Temp, TempK, sg::UnitConvert<units::degC, units::K>>,
+    sg::Edge<Limited, Power, sg::Saturation<std::ratio<0>, std::ratio<750>>>,
+    sg::Edge<Cmd, Limited,
+             sg::Linear<std::ratio<25, 2>, std::ratio<-1, 10>, std::ratio<0>,
+                        std::ratio<800>>>>;
+
+GraphSpec plant_spec() {
+  auto edge = [](std::string source, std::string target, std::string type,
+                 ParamMap params) {
+    EdgeSpec out;
+    out.source_path = std::move(source);
+    out.target_path = std::move(target);
+    out.transform.type = std::move(type);
+    out.transform.params = std::move(params);
+    return out;
+  };
+
+  GraphSpec spec;
+  spec.signals.push_back(SignalSpec{"temp", "degC"});
+  spec.signals.push_back(SignalSpec{"temp_k", "K"});
+
+  ModelSpec thermal;
+  thermal.id = "chamber";
+  thermal.type = "thermal_mass";
+  thermal.params["temp_signal"] = std::string("temp");
+  thermal.params["power_signal"] = std::string("power");
+  thermal.params["ambient_signal"] = std::string("ambient");
+  thermal.params["thermal_mass"] = 1000.0;
+  thermal.params["heat_transfer_coeff"] = 10.0;
+  thermal.params["initial_temp"] = 25.0;
+  spec.models.push_back(thermal);
+
+  spec.edges.push_back(edge("cmd", "limited", "linear",
+                            {{"scale", 12.5},
+                             {"offset", -0.1},
+                             {"clamp_min", 0.0},
+                             {"clamp_max", 800.0}}));
+  spec.edges.push_back(
+      edge("limited", "power", "saturation", {{"min", 0.0}, {"max", 750.0}}));
+  spec.edges.push_back(
+      edge("temp", "lagged", "first_order_lag", {{"tau_s", 0.7}}));
+  spec.edges.push_back(edge("lagged", "noisy", "noise",
+                            {{"amplitude", 0.05}, {"seed", int64_t{7}}}));
+  spec.edges.push_back(edge("noisy", "smoothed", "moving_average",
+                            {{"window_size", int64_t{5}}}));
+  spec.edges.push_back(
+      edge("smoothed", "delayed", "delay", {{"delay_sec", 0.3}}));
+  spec.edges.push_back(edge("delayed", "error", "linear",
+                            {{"scale", -1.0}, {"offset", 40.0}}));
+  spec.edges.push_back(
+      edge("error", "error_db", "deadband", {{"threshold", 0.25}}));
+  spec.edges.push_back(edge("temp", "temp_k", "unit_convert",
+                            {{"to_unit", std::string("K")}}));
+  return spec;
+}
+
+} // namespace
+
+TEST(StaticGraphTest, ScheduleFollowsCompilerOrdering) {
+  static_assert(Plant::signal_count == 12);
+  static_assert(Plant::edge_count == 9);
+  static_assert(Plant::model_count == 1);
+
+  // Delay edge first, then Kahn order with the lowest ready slot first
+  constexpr std::array<std::size_t, 9> expected = {3, 9, 6, 7, 5, 4, 0, 1, 8};
+  EXPECT_EQ(Plant::edge_order, expected);
+}
+
+TEST(StaticGraphTest, CycleCheckHonoursDelayEdges) {
+  using A = sg::SignalSlot<0>;
+  using B = sg::SignalSlot<1>;
+  using C = sg::SignalSlot<2>;
+  using Gain = sg::Linear<std::ratio<1, 2>>;
+
+  static_assert(!sg::is_acyclic_v<sg::Edge<A, B, Gain>, sg::Edge<B, C, Gain>,
+                                  sg::Edge<C, A, Gain>>);
+  static_assert(
+      sg::is_acyclic_v<sg::Edge<A, B, Gain>, sg::Edge<B, C, Gain>,
+                       sg::Edge<C, A, sg::Delay<std::ratio<1, 10>, 8>>>);
+
+  // Feedback through the delay: A(t) = 0.25 * A(t - 1 tick) + input
+  using Loop = sg::Graph<sg::Edge<A, B, Gain>, sg::Edge<B, C, Gain>,
+                         sg::Edge<C, A, sg::Delay<std::ratio<1, 10>, 8>>>;
+  Loop loop;
+  loop.write<C>(8.0);
+  loop.tick(0.1);
+  EXPECT_DOUBLE_EQ(loop.read<A>(), 8.0);
+  EXPECT_DOUBLE_EQ(loop.read<C>(), 2.0);
+  loop.tick(0.1);
+  EXPECT_DOUBLE_EQ(loop.read<A>(), 8.0);
+  EXPECT_DOUBLE_EQ(loop.read<C>(), 2.0);
+  loop.tick(0.1);
+  EXPECT_DOUBLE_EQ(loop.read<A>(), 2.0);
+  EXPECT_DOUBLE_EQ(loop.read<C>(), 0.5);
+}
+
+TEST(StaticGraphTest, SupportsDtChecksStabilityAndDelayCapacity) {
+  // tau = C / h = 100 s; forward Euler is stable up to 200 s
+  static_assert(Plant::supports_dt(0.01));
+  static_assert(Plant::supports_dt(0.3 / 64));
+  // 0.3 s at 1 ms needs 300 samples, the buffer holds 64
+  static_assert(!Plant::supports_dt(0.001));
+  static_assert(!Plant::supports_dt(0.0));
+
+  using Fast = sg::Graph<sg::Model<sg::ThermalMass<
+      Temp, Power, Ambient, std::ratio<10>, std::ratio<10>, std::ratio<0>,
+      ThermalIntegrationMethod::Rk4>>>;
+  static_assert(Fast::supports_dt(2.7));
+  static_assert(!Fast::supports_dt(2.8));
+  SUCCEED();
+}
+
+TEST(StaticGraphTest, MatchesEngineOnEquivalentSpec) {
+  SignalNamespace signal_ns;
+  FunctionNamespace func_ns;
+  GraphCompiler compiler;
+  Engine engine;
+  engine.load(compiler.compile(plant_spec(), signal_ns, func_ns));
+  SignalStore store;
+
+  const std::pair<std::size_t, const char *> slots[] = {
+      {Cmd::id, "cmd"},         {Power::id, "power"},
+      {Ambient::id, "ambient"}, {Temp::id, "temp"},
+      {Lagged::id, "lagged"},   {Noisy::id, "noisy"},
+      {Smoothed::id, "smoothed"}, {Delayed::id, "delayed"},
+      {Error::id, "error"},     {ErrorDb::id, "error_db"},
+      {TempK::id, "temp_k"},    {Limited::id, "limited"}};
+
+  Plant plant;
+  auto run = [&](int steps) {
+    for (int step = 0; step < steps; ++step) {
+      const double t = 0.01 * step;
+      const double cmd = 40.0 * std::sin(0.9 * t) + 20.0 * std::sin(7.0 * t);
+      const double ambient = 20.0 + 3.0 * std::sin(0.05 * t);
+      plant.write<Cmd>(cmd);
+      plant.write<Ambient>(ambient);
+      store.write(signal_ns.resolve("cmd"), cmd, "dimensionless");
+      store.write(signal_ns.resolve("ambient"), ambient, "degC");
+
+      plant.tick(0.01);
+      engine.tick(0.01, store);
+      for (const auto &[slot, path] : slots) {
+        ASSERT_EQ(plant.values()[slot],
+                  store.read_value(signal_ns.resolve(path)))
+            << path << " at step " << step;
+      }
+    }
+  };
+
+  run(1000);
+  plant.reset();
+  engine.reset();
+  run(200);
+}
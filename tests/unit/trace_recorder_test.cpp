@@ -0,0 +1,135 @@
+#include "fluxgraph/trace/reader.hpp"
+#include "fluxgraph/trace/recorder.hpp"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace fluxgraph;
+
+namespace {
+
+std::string temp_trace_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() /
+          ("fluxgraph_" + name + ".fgtrace"))
+      .string();
+}
+
+struct TraceFixture {
+  SignalNamespace ns;
+  SignalStore store;
+  SignalId a;
+  SignalId b;
+
+  TraceFixture() : a(ns.intern("sig.a")), b(ns.intern("sig.b")) {}
+};
+
+} // namespace
+
+TEST(TraceRecorderTest, RoundTripsAcrossPartialBlocks) {
+  for (auto compression :
+       {TraceCompression::none, TraceCompression::xor_delta}) {
+    TraceFixture fx;
+    const std::string path = temp_trace_path(
+        "roundtrip_" + std::to_string(static_cast<int>(compression)));
+
+    TraceRecorderOptions options;
+    options.block_frames = 4;
+    options.ring_blocks = 2;
+    options.compression = compression;
+    {
+      TraceRecorder recorder(path, fx.ns, {"sig.b", "sig.a"}, options);
+      EXPECT_EQ(recorder.signal_count(), 2u);
+      for (int tick = 0; tick < 11; ++tick) {
+        fx.store.write(fx.a, 1.5 * tick);
+        if (tick >= 5) {
+          fx.store.write(fx.b, -0.25); // Unwritten before tick 5 (reads 0)
+        }
+        recorder.capture(fx.store, 0.1 * (tick + 1));
+      }
+      recorder.close();
+      EXPECT_EQ(recorder.frames_captured(), 11u);
+      EXPECT_EQ(recorder.frames_dropped(), 0u);
+      EXPECT_EQ(recorder.blocks_written(), 3u); // 4 + 4 + 3 frames
+    }
+
+    const TraceData data = read_trace(path);
+    EXPECT_EQ(data.compression, compression);
+    ASSERT_EQ(data.signal_paths.size(), 2u);
+    EXPECT_EQ(data.signal_paths[0], "sig.b");
+    EXPECT_EQ(data.signal_ids[1], fx.a);
+    ASSERT_EQ(data.frame_count(), 11u);
+    for (size_t tick = 0; tick < 11; ++tick) {
+      EXPECT_EQ(data.times[tick], 0.1 * static_cast<double>(tick + 1));
+      EXPECT_EQ(data.columns[0][tick], tick >= 5 ? -0.25 : 0.0);
+      EXPECT_EQ(data.columns[1][tick], 1.5 * static_cast<double>(tick));
+    }
+    std::remove(path.c_str());
+  }
+}
+
+TEST(TraceRecorderTest, XorDeltaPreservesBitsAndShrinksSlowSignals) {
+  TraceFixture fx;
+  const std::string raw_path = temp_trace_path("xor_raw");
+  const std::string xor_path = temp_trace_path("xor_packed");
+
+  TraceRecorderOptions options;
+  options.block_frames = 64;
+  {
+    TraceRecorder raw(raw_path, fx.ns, {"sig.a", "sig.b"}, options);
+    options.compression = TraceCompression::xor_delta;
+    TraceRecorder packed(xor_path, fx.ns, {"sig.a", "sig.b"}, options);
+
+    fx.store.write(fx.b, 42.0); // Constant column
+    for (int tick = 0; tick < 256; ++tick) {
+      const double value =
+          tick == 100 ? std::numeric_limits<double>::quiet_NaN()
+                      : (tick == 101 ? -0.0 : std::sin(0.01 * tick));
+      fx.store.write(fx.a, value);
+      raw.capture(fx.store, 0.001 * tick);
+      packed.capture(fx.store, 0.001 * tick);
+    }
+  }
+
+  const TraceData data = read_trace(xor_path);
+  ASSERT_EQ(data.frame_count(), 256u);
+  EXPECT_TRUE(std::isnan(data.columns[0][100]));
+  EXPECT_TRUE(std::signbit(data.columns[0][101]));
+  EXPECT_EQ(data.columns[0][200], std::sin(0.01 * 200));
+  for (double value : data.columns[1]) {
+    EXPECT_EQ(value, 42.0);
+  }
+
+  EXPECT_LT(std::filesystem::file_size(xor_path),
+            std::filesystem::file_size(raw_path));
+  std::remove(raw_path.c_str());
+  std::remove(xor_path.c_str());
+}
+
+TEST(TraceRecorderTest, RejectsUnknownSignalsAndBadOptions) {
+  TraceFixture fx;
+  const std::string path = temp_trace_path("invalid");
+  EXPECT_THROW(TraceRecorder(path, fx.ns, {"sig.missing"}),
+               std::invalid_argument);
+
+  TraceRecorderOptions options;
+  options.ring_blocks = 1;
+  EXPECT_THROW(TraceRecorder(path, fx.ns, {"sig.a"}, options),
+               std::invalid_argument);
+
+  EXPECT_THROW(read_trace(temp_trace_path("does_not_exist")),
+               std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(TraceRecorderTest, RejectsCaptureAfterClose) {
+  TraceFixture fx;
+  const std::string path = temp_trace_path("closed");
+  TraceRecorder recorder(path, fx.ns, {"sig.a"});
+  recorder.close();
+  recorder.close(); // Idempotent
+  EXPECT_THROW(recorder.capture(fx.store, 0.0), std::logic_error);
+  EXPECT_EQ(read_trace(path).frame_count(), 0u);
+  std::remove(path.c_str());
+}
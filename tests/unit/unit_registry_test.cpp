@@ -66,3 +66,151 @@ TEST(UnitRegistryTest, RejectsIncompatibleDimensions) {
   const UnitRegistry &registry = UnitRegistry::instance();
   EXPECT_THROW(registry.resolve_conversion("W", "degC"), std::runtime_error);
 }
+
+TEST(UnitRegistryTest, ConversionTableMatchesResolveConversion) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+  ASSERT_GT(registry.size(), 0u);
+  EXPECT_EQ(registry.index_of("furlong"), INVALID_UNIT_INDEX);
+
+  for (size_t from = 0; from < registry.size(); ++from) {
+    for (size_t to = 0; to < registry.size(); ++to) {
+      const auto from_index = static_cast<UnitIndex>(from);
+      const auto to_index = static_cast<UnitIndex>(to);
+      const std::string &from_symbol = registry.unit(from_index).symbol;
+      const std::string &to_symbol = registry.unit(to_index).symbol;
+      EXPECT_EQ(registry.index_of(from_symbol), from_index);
+
+      const std::optional<UnitConversion> entry =
+          registry.conversion(from_index, to_index);
+      if (!entry) {
+        EXPECT_THROW(registry.resolve_conversion(from_symbol, to_symbol),
+                     std::runtime_error);
+        continue;
+      }
+      const UnitConversion resolved =
+          registry.resolve_conversion(from_symbol, to_symbol);
+      EXPECT_EQ(entry->scale, resolved.scale);
+      EXPECT_EQ(entry->offset, resolved.offset);
+    }
+  }
+  EXPECT_FALSE(registry.conversion(INVALID_UNIT_INDEX, 0).has_value());
+}
+
+TEST(UnitRegistryTest, ParsesPrefixedAndCompoundUnits) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+
+  const UnitDef *kpa = registry.find("kPa");
+  ASSERT_NE(kpa, nullptr);
+  EXPECT_EQ(kpa->dimension, registry.find("Pa")->dimension);
+  EXPECT_DOUBLE_EQ(kpa->scale_to_si, 1e3);
+  EXPECT_DOUBLE_EQ(registry.resolve_conversion("mbar", "kPa").scale, 0.1);
+
+  const UnitConversion lpm = registry.resolve_conversion("L/min", "m^3/s");
+  EXPECT_DOUBLE_EQ(lpm.scale, 1e-3 / 60.0);
+  EXPECT_NEAR(registry.resolve_conversion("rpm", "rad/s").scale,
+              0.10471975511965977, 1e-15);
+
+  const UnitDef *energy = registry.find("kg*m^2/s^2");
+  ASSERT_NE(energy, nullptr);
+  EXPECT_EQ(energy->dimension, registry.find("N*m")->dimension);
+  EXPECT_EQ(energy->dimension, registry.find("J")->dimension);
+  EXPECT_DOUBLE_EQ(registry.resolve_conversion("kg*m^2/s^2", "kJ").scale,
+                   1e-3);
+  EXPECT_EQ(registry.find("m*s^-1")->dimension,
+            registry.find("m/s")->dimension);
+}
+
+TEST(UnitRegistryTest, ParsedUnitsAreCached) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+
+  const UnitIndex first = registry.index_of("mN*m");
+  ASSERT_NE(first, INVALID_UNIT_INDEX);
+  const size_t size = registry.size();
+  EXPECT_EQ(registry.index_of("mN*m"), first);
+  EXPECT_EQ(registry.find("mN*m"), &registry.unit(first));
+  EXPECT_EQ(registry.size(), size);
+}
+
+TEST(UnitRegistryTest, RejectsMalformedExpressions) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+
+  EXPECT_FALSE(registry.contains("furlong/s"));
+  EXPECT_FALSE(registry.contains("m//s"));
+  EXPECT_FALSE(registry.contains("m^"));
+  EXPECT_FALSE(registry.contains("m^2^2"));
+  EXPECT_FALSE(registry.contains("kdegC"));
+  EXPECT_FALSE(registry.contains("degC*s"));
+  EXPECT_FALSE(registry.contains("kN*m/s/rad^"));
+  EXPECT_EQ(registry.index_of("m//s"), INVALID_UNIT_INDEX);
+}
+
+TEST(UnitRegistryTest, PrefixedTemperatureKeepsKind) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+
+  const UnitDef *mk = registry.find("mK");
+  ASSERT_NE(mk, nullptr);
+  EXPECT_EQ(mk->kind, UnitKind::absolute_temp);
+  EXPECT_THROW(registry.resolve_conversion("mK", "delta_K"),
+               std::runtime_error);
+  EXPECT_DOUBLE_EQ(registry.resolve_conversion("mK", "K").scale, 1e-3);
+}
+
+TEST(UnitRegistryTest, RegisterUnitAddsTerm) {
+  UnitRegistry &registry = UnitRegistry::instance();
+
+  UnitDef psi;
+  psi.symbol = "psi";
+  psi.dimension = registry.find("Pa")->dimension;
+  psi.scale_to_si = 6894.757293168361;
+  const UnitIndex index = registry.register_unit(psi);
+  EXPECT_EQ(registry.index_of("psi"), index);
+  EXPECT_EQ(registry.register_unit(psi), index);
+  EXPECT_NEAR(registry.resolve_conversion("psi", "kPa").scale,
+              6.894757293168361, 1e-12);
+  EXPECT_NE(registry.find("kpsi"), nullptr);
+
+  UnitDef conflicting = psi;
+  conflicting.scale_to_si = 1.0;
+  EXPECT_THROW(registry.register_unit(conflicting), std::invalid_argument);
+
+  UnitDef compound = psi;
+  compound.symbol = "psi/s";
+  EXPECT_THROW(registry.register_unit(compound), std::invalid_argument);
+  UnitDef empty = psi;
+  empty.symbol.clear();
+  EXPECT_THROW(registry.register_unit(empty), std::invalid_argument);
+}
+
+TEST(UnitRegistryTest, SymbolConversionDoesNotRegister) {
+  const UnitRegistry &registry = UnitRegistry::instance();
+  const size_t size = registry.size();
+
+  EXPECT_EQ(registry.lookup("kJ/min"), INVALID_UNIT_INDEX);
+  const auto conversion = registry.conversion("kJ/min", "W");
+  ASSERT_TRUE(conversion.has_value());
+  EXPECT_NEAR(conversion->scale, 1000.0 / 60.0, 1e-12);
+  EXPECT_FALSE(registry.conversion("kJ/min", "K").has_value());
+  EXPECT_FALSE(registry.conversion("furlong", "m").has_value());
+  EXPECT_EQ(registry.lookup("kJ/min"), INVALID_UNIT_INDEX);
+  EXPECT_EQ(registry.size(), size);
+}
+
+TEST(UnitRegistryTest, UnitsPastTheTableStillConvert) {
+  UnitRegistry &registry = UnitRegistry::instance();
+
+  UnitDef def;
+  def.dimension = registry.find("Pa")->dimension;
+  UnitIndex last = INVALID_UNIT_INDEX;
+  for (int i = 0; i < 300; ++i) {
+    def.symbol = "table_pa" + std::to_string(i);
+    def.scale_to_si = static_cast<double>(i + 1);
+    last = registry.register_unit(def);
+  }
+  ASSERT_GT(registry.size(), 256u);
+
+  const auto conversion = registry.conversion(last, registry.index_of("kPa"));
+  ASSERT_TRUE(conversion.has_value());
+  EXPECT_NEAR(conversion->scale, 0.3, 1e-12);
+  EXPECT_FALSE(
+      registry.conversion(last, registry.index_of("W")).has_value());
+}
@@ -2,6 +2,7 @@
 
 #include "fluxgraph/loaders/yaml_loader.hpp"
 #include <gtest/gtest.h>
+#include <sstream>
 #include <stdexcept>
 
 using namespace fluxgraph::loaders;
@@ -208,13 +209,11 @@ edges:
   ASSERT_EQ(spec.edges.size(), 1);
 
   const auto &matrix_value = spec.models[0].params.at("matrix");
-  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(matrix_value));
-  const auto &matrix = std::get<fluxgraph::ParamArray>(matrix_value);
-  ASSERT_EQ(matrix.size(), 2u);
-  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(matrix[0]));
-  const auto &row0 = std::get<fluxgraph::ParamArray>(matrix[0]);
-  ASSERT_EQ(row0.size(), 2u);
-  EXPECT_EQ(std::get<int64_t>(row0[0]), 1);
+  ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamNumbers>(matrix_value));
+  const auto &matrix = std::get<fluxgraph::ParamNumbers>(matrix_value);
+  EXPECT_EQ(matrix.columns, 2u);
+  EXPECT_TRUE(matrix.integral);
+  EXPECT_EQ(matrix.values, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
 
   const auto &config_value = spec.models[0].params.at("config");
   ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamObject>(config_value));
@@ -226,6 +225,38 @@ edges:
   ASSERT_TRUE(std::holds_alternative<fluxgraph::ParamObject>(coeff_value));
 }
 
+TEST(YamlLoaderTest, NonNumericArraysStayNested) {
+  std::string yaml = R"yaml(
+models:
+  - id: nested
+    type: test_model
+    params:
+      mixed: [1, 2.5]
+      labels: [1, two]
+      ragged:
+        - [1, 2]
+        - [3]
+      huge: [9007199254740993]
+      cube:
+        - [[1]]
+)yaml";
+
+  auto spec = load_yaml_string(yaml);
+  auto &params = spec.models[0].params;
+
+  const auto &mixed = std::get<fluxgraph::ParamNumbers>(params["mixed"]);
+  EXPECT_FALSE(mixed.integral);
+  EXPECT_EQ(mixed.values, (std::vector<double>{1.0, 2.5}));
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(params["labels"]));
+  const auto &ragged = std::get<fluxgraph::ParamArray>(params["ragged"]);
+  ASSERT_EQ(ragged.size(), 2u);
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamNumbers>(ragged[1]));
+  // Not exactly representable as double
+  const auto &huge = std::get<fluxgraph::ParamArray>(params["huge"]);
+  EXPECT_EQ(std::get<int64_t>(huge[0]), 9007199254740993LL);
+  EXPECT_TRUE(std::holds_alternative<fluxgraph::ParamArray>(params["cube"]));
+}
+
 TEST(YamlLoaderTest, RejectsNestedCommandArgs) {
   std::string yaml = R"yaml(
 rules:
@@ -296,10 +327,198 @@ signals:
   EXPECT_EQ(spec.signals[1].unit, "W");
 }
 
+TEST(YamlLoaderTest, LoadTemplatesAndInstances) {
+  std::string yaml = R"yaml(
+templates:
+  - name: heater_zone
+    params:
+      gain: 1.0
+    signals:
+      - path: ${prefix}.temp
+        unit: degC
+    edges:
+      - source: ${prefix}.command
+        target: ${prefix}.power
+        transform:
+          type: linear
+          params:
+            scale: ${gain}
+            offset: 0.0
+instances:
+  - template: heater_zone
+    prefix: zone0
+  - template: heater_zone
+    prefix: zone1
+    params:
+      gain: 2.5
+)yaml";
+
+  auto spec = load_yaml_string(yaml);
+
+  ASSERT_EQ(spec.templates.size(), 1);
+  EXPECT_EQ(spec.templates[0].name, "heater_zone");
+  EXPECT_EQ(std::get<double>(spec.templates[0].params["gain"]), 1.0);
+  ASSERT_EQ(spec.templates[0].edges.size(), 1);
+  EXPECT_EQ(spec.templates[0].edges[0].source_path, "${prefix}.command");
+  EXPECT_EQ(std::get<std::string>(
+                spec.templates[0].edges[0].transform.params["scale"]),
+            "${gain}");
+  ASSERT_EQ(spec.instances.size(), 2);
+  EXPECT_EQ(spec.instances[1].template_name, "heater_zone");
+  EXPECT_EQ(spec.instances[1].prefix, "zone1");
+  EXPECT_EQ(std::get<double>(spec.instances[1].params["gain"]), 2.5);
+}
+
+TEST(YamlLoaderTest, InstanceRequiresPrefix) {
+  std::string yaml = R"yaml(
+instances:
+  - template: heater_zone
+)yaml";
+
+  EXPECT_THROW(load_yaml_string(yaml), std::runtime_error);
+}
+
 TEST(YamlLoaderTest, InvalidYaml) {
   std::string yaml = "{ invalid: yaml: syntax }";
 
   EXPECT_THROW({ load_yaml_string(yaml); }, std::runtime_error);
 }
 
+namespace {
+
+std::string generate_split_test_yaml(int count) {
+  std::ostringstream oss;
+  oss << "# generated\nsignals:\n";
+  for (int i = 0; i < count; ++i) {
+    oss << "  - path: s" << i << ".value\n    unit: W\n";
+  }
+  oss << "edges:\n"; // Items at the key's indentation
+  for (int i = 0; i < count; ++i) {
+    oss << "- source: s" << i << ".value\n";
+    oss << "  target: t" << i << ".value\n";
+    oss << "  # comment\n";
+    oss << "  transform:\n";
+    oss << "    type: linear\n";
+    oss << "    params:\n";
+    oss << "      scale: " << i << "\n";
+    oss << "      bounds: {lo: -1.5, hi: [1, 2]}\n";
+    oss << "      note: |\n";
+    oss << "        - not an item\n";
+  }
+  oss << "rules:\n";
+  for (int i = 0; i < count; ++i) {
+    oss << "  - id: r" << i << "\n";
+    oss << "    condition: s" << i << ".value > 1.0\n";
+    oss << "    actions:\n";
+    oss << "      - device: d" << i << "\n";
+    oss << "        function: stop\n";
+  }
+  return oss.str();
+}
+
+YamlLoadOptions forced_parallel() {
+  YamlLoadOptions options;
+  options.threads = 4;
+  options.parallel_min_bytes = 0;
+  return options;
+}
+
+} // namespace
+
+TEST(YamlLoaderTest, ParallelLoadMatchesSequential) {
+  // Large enough that the edges list is split into several pieces
+  const std::string yaml = generate_split_test_yaml(400);
+  YamlLoadOptions sequential;
+  sequential.threads = 1;
+
+  auto expected = load_yaml_string(yaml, sequential);
+  auto parallel = load_yaml_string(yaml, forced_parallel());
+
+  ASSERT_EQ(expected.edges.size(), 400);
+  ASSERT_EQ(parallel.signals.size(), expected.signals.size());
+  ASSERT_EQ(parallel.edges.size(), expected.edges.size());
+  ASSERT_EQ(parallel.rules.size(), expected.rules.size());
+  for (size_t i = 0; i < expected.edges.size(); ++i) {
+    EXPECT_EQ(parallel.signals[i].path, expected.signals[i].path);
+    EXPECT_EQ(parallel.edges[i].source_path, expected.edges[i].source_path);
+    EXPECT_EQ(std::get<int64_t>(parallel.edges[i].transform.params["scale"]),
+              static_cast<int64_t>(i));
+    EXPECT_EQ(parallel.rules[i].actions[0].device,
+              expected.rules[i].actions[0].device);
+  }
+
+  auto &params = parallel.edges[7].transform.params;
+  EXPECT_EQ(std::get<std::string>(params["note"]), "- not an item\n");
+  const auto &bounds = std::get<fluxgraph::ParamObject>(params["bounds"]);
+  EXPECT_EQ(std::get<double>(bounds.at("lo")), -1.5);
+  EXPECT_EQ(std::get<fluxgraph::ParamNumbers>(bounds.at("hi")).values.size(),
+            2);
+}
+
+TEST(YamlLoaderTest, ParallelLoadReportsSequentialErrors) {
+  std::string yaml = generate_split_test_yaml(400);
+  const std::string broken = "- source: s350.value\n  target: t350.value\n";
+  yaml.replace(yaml.find(broken), broken.size(), "- source: s350.value\n");
+
+  try {
+    load_yaml_string(yaml, forced_parallel());
+    FAIL() << "expected a missing-field error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_STREQ(e.what(), "YAML parse error at /edges/350: Missing required "
+                           "field 'target'");
+  }
+
+  // Syntax errors keep whole-document line numbers
+  std::string syntax = generate_split_test_yaml(400);
+  syntax.replace(syntax.find("target: t10.value"), 8, "target: [");
+  try {
+    load_yaml_string(syntax, forced_parallel());
+    FAIL() << "expected a syntax error";
+  } catch (const std::runtime_error &e) {
+    YamlLoadOptions sequential;
+    sequential.threads = 1;
+    EXPECT_THROW(
+        {
+          try {
+            load_yaml_string(syntax, sequential);
+          } catch (const std::runtime_error &sequential_error) {
+            EXPECT_STREQ(e.what(), sequential_error.what());
+            throw;
+          }
+        },
+        std::runtime_error);
+  }
+}
+
+TEST(YamlLoaderTest, ParallelLoadFallsBackForUnsplittableLayouts) {
+  // Unknown top-level key: loaded whole
+  std::string yaml = "version: 2\n" + generate_split_test_yaml(50);
+  EXPECT_EQ(load_yaml_string(yaml, forced_parallel()).edges.size(), 50);
+
+  // Anchor defined in one section and used in another
+  yaml = generate_split_test_yaml(50);
+  yaml.replace(yaml.find("path: s0.value"), 14, "path: &first s0.value");
+  yaml.replace(yaml.find("condition: s49.value > 1.0"), 26,
+               "condition: *first");
+  auto spec = load_yaml_string(yaml, forced_parallel());
+  ASSERT_EQ(spec.rules.size(), 50);
+  EXPECT_EQ(spec.rules[49].condition, "s0.value");
+}
+
+TEST(YamlLoaderTest, ParamErrorPathNamesNestedNode) {
+  std::string yaml = "models:\n  - id: m\n    type: t\n    params:\n"
+                     "      x:\n        y: [1, 2, ";
+  yaml += std::string((1 << 20) + 1, 'a');
+  yaml += "]\n";
+
+  try {
+    load_yaml_string(yaml);
+    FAIL() << "expected a string-size error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_NE(std::string(e.what()).find("at /models/0/params/x/y/2:"),
+              std::string::npos)
+        << e.what();
+  }
+}
+
 #endif // FLUXGRAPH_YAML_ENABLED
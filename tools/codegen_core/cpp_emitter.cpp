@@ -0,0 +1,596 @@
+#include "fluxgraph/codegen/cpp_emitter.hpp"
+#include "fluxgraph/generated_program.hpp"
+#include "fluxgraph/model/dc_motor.hpp"
+#include "fluxgraph/model/first_order_process.hpp"
+#include "fluxgraph/model/mass_spring_damper.hpp"
+#include "fluxgraph/model/second_order_process.hpp"
+#include "fluxgraph/model/state_space_siso_discrete.hpp"
+#include "fluxgraph/model/thermal_mass.hpp"
+#include "fluxgraph/model/thermal_rc2.hpp"
+#include "fluxgraph/transform/deadband.hpp"
+#include "fluxgraph/transform/delay.hpp"
+#include "fluxgraph/transform/first_order_lag.hpp"
+#include "fluxgraph/transform/linear.hpp"
+#include "fluxgraph/transform/moving_average.hpp"
+#include "fluxgraph/transform/noise.hpp"
+#include "fluxgraph/transform/rate_limiter.hpp"
+#include "fluxgraph/transform/saturation.hpp"
+#include "fluxgraph/transform/unit_convert.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace fluxgraph::codegen {
+
+namespace {
+
+// Exact built-in type only: a user subclass may override apply()/tick(),
+// so it must stay virtual rather than be folded or called qualified
+template <typename T, typename Base> const T *exact_cast(const Base &object) {
+  return typeid(object) == typeid(T) ? static_cast<const T *>(&object)
+                                     : nullptr;
+}
+
+// Built-in component types called directly (qualified, so not virtually)
+struct Builtin {
+  const char *class_name;
+  const char *header;
+};
+
+const Builtin *stateful_transform(const ITransform &transform) {
+  static const Builtin kLag{"FirstOrderLagTransform",
+                            "fluxgraph/transform/first_order_lag.hpp"};
+  static const Builtin kDelay{"DelayTransform",
+                              "fluxgraph/transform/delay.hpp"};
+  static const Builtin kAverage{"MovingAverageTransform",
+                                "fluxgraph/transform/moving_average.hpp"};
+  static const Builtin kRate{"RateLimiterTransform",
+                             "fluxgraph/transform/rate_limiter.hpp"};
+  static const Builtin kNoise{"NoiseTransform",
+                              "fluxgraph/transform/noise.hpp"};
+  if (exact_cast<FirstOrderLagTransform>(transform) != nullptr) {
+    return &kLag;
+  }
+  if (exact_cast<DelayTransform>(transform) != nullptr) {
+    return &kDelay;
+  }
+  if (exact_cast<MovingAverageTransform>(transform) != nullptr) {
+    return &kAverage;
+  }
+  if (exact_cast<RateLimiterTransform>(transform) != nullptr) {
+    return &kRate;
+  }
+  if (exact_cast<NoiseTransform>(transform) != nullptr) {
+    return &kNoise;
+  }
+  return nullptr;
+}
+
+const Builtin *builtin_model(const IModel &model) {
+  static const Builtin kModels[] = {
+      {"ThermalMassModel", "fluxgraph/model/thermal_mass.hpp"},
+      {"ThermalRc2Model", "fluxgraph/model/thermal_rc2.hpp"},
+      {"FirstOrderProcessModel", "fluxgraph/model/first_order_process.hpp"},
+      {"SecondOrderProcessModel", "fluxgraph/model/second_order_process.hpp"},
+      {"StateSpaceSisoDiscreteModel",
+       "fluxgraph/model/state_space_siso_discrete.hpp"},
+      {"MassSpringDamperModel", "fluxgraph/model/mass_spring_damper.hpp"},
+      {"DcMotorModel", "fluxgraph/model/dc_motor.hpp"},
+  };
+  if (exact_cast<ThermalMassModel>(model) != nullptr) {
+    return &kModels[0];
+  }
+  if (exact_cast<ThermalRc2Model>(model) != nullptr) {
+    return &kModels[1];
+  }
+  if (exact_cast<FirstOrderProcessModel>(model) != nullptr) {
+    return &kModels[2];
+  }
+  if (exact_cast<SecondOrderProcessModel>(model) != nullptr) {
+    return &kModels[3];
+  }
+  if (exact_cast<StateSpaceSisoDiscreteModel>(model) != nullptr) {
+    return &kModels[4];
+  }
+  if (exact_cast<MassSpringDamperModel>(model) != nullptr) {
+    return &kModels[5];
+  }
+  if (exact_cast<DcMotorModel>(model) != nullptr) {
+    return &kModels[6];
+  }
+  return nullptr;
+}
+
+// Exact double literal: %.17g round-trips; infinities use kInf
+std::string literal(double value) {
+  if (std::isinf(value)) {
+    return value < 0.0 ? "-kInf" : "kInf";
+  }
+  if (std::isnan(value)) {
+    return "std::numeric_limits<double>::quiet_NaN()";
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  std::string text = buffer;
+  if (text.find_first_of(".e") == std::string::npos) {
+    text += ".0";
+  }
+  return text;
+}
+
+std::string hex64(uint64_t value) {
+  char buffer[24];
+  std::snprintf(buffer, sizeof(buffer), "%016llx",
+                static_cast<unsigned long long>(value));
+  return buffer;
+}
+
+// "<path with non-identifier bytes as '_'>_<id>": unique, and never a
+// keyword because of the numeric suffix
+std::string field_name(std::string_view path, SignalId id) {
+  std::string name;
+  name.reserve(path.size() + 12);
+  for (const char c : path) {
+    const auto byte = static_cast<unsigned char>(c);
+    name += std::isalnum(byte) != 0 ? c : '_';
+  }
+  if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])) != 0) {
+    name.insert(0, "s_");
+  }
+  return name + "_" + std::to_string(id);
+}
+
+// Keeps comments on one line whatever the signal path contains
+std::string comment_safe(std::string_view text) {
+  std::string out(text);
+  for (char &c : out) {
+    if (c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  return out;
+}
+
+enum class EdgeKind { linear, saturation, deadband, unit_convert, direct,
+                      dynamic };
+
+struct EdgePlan {
+  EdgeKind kind = EdgeKind::dynamic;
+  const Builtin *builtin = nullptr;
+  std::vector<double> constants;
+};
+
+EdgePlan plan_edge(const ITransform &transform) {
+  EdgePlan plan;
+  if (const auto *t = exact_cast<LinearTransform>(transform)) {
+    plan.kind = EdgeKind::linear;
+    plan.constants = {t->scale(), t->offset(), t->clamp_min(), t->clamp_max()};
+  } else if (const auto *t =
+                 exact_cast<SaturationTransform>(transform)) {
+    plan.kind = EdgeKind::saturation;
+    plan.constants = {t->min_value(), t->max_value()};
+  } else if (const auto *t =
+                 exact_cast<DeadbandTransform>(transform)) {
+    plan.kind = EdgeKind::deadband;
+    plan.constants = {t->threshold()};
+  } else if (const auto *t =
+                 exact_cast<UnitConvertTransform>(transform)) {
+    plan.kind = EdgeKind::unit_convert;
+    plan.constants = {t->scale(), t->offset()};
+  } else if (const Builtin *builtin = stateful_transform(transform)) {
+    plan.kind = EdgeKind::direct;
+    plan.builtin = builtin;
+  }
+  return plan;
+}
+
+const char *kind_label(EdgeKind kind) {
+  switch (kind) {
+  case EdgeKind::linear:
+    return "linear, folded";
+  case EdgeKind::saturation:
+    return "saturation, folded";
+  case EdgeKind::deadband:
+    return "deadband, folded";
+  case EdgeKind::unit_convert:
+    return "unit_convert, folded";
+  case EdgeKind::direct:
+    return "direct";
+  case EdgeKind::dynamic:
+    return "virtual";
+  }
+  return "";
+}
+
+// Folded expression for input x (must match the transform's apply())
+std::string folded_expression(const EdgePlan &plan, const std::string &x) {
+  const std::vector<double> &k = plan.constants;
+  switch (plan.kind) {
+  case EdgeKind::linear: {
+    std::string expr = literal(k[0]) + " * " + x + " + " + literal(k[1]);
+    if (std::isinf(k[2]) && k[2] < 0.0 && std::isinf(k[3]) && k[3] > 0.0) {
+      return expr; // std::clamp to (-inf, inf) is the identity, NaN included
+    }
+    return "std::clamp(" + expr + ", " + literal(k[2]) + ", " +
+           literal(k[3]) + ")";
+  }
+  case EdgeKind::saturation:
+    return "std::clamp(" + x + ", " + literal(k[0]) + ", " + literal(k[1]) +
+           ")";
+  case EdgeKind::deadband:
+    return "std::abs(" + x + ") < " + literal(k[0]) + " ? 0.0 : " + x;
+  case EdgeKind::unit_convert:
+    return x + " * " + literal(k[0]) + " + " + literal(k[1]);
+  default:
+    return x;
+  }
+}
+
+const char *folded_check(EdgeKind kind) {
+  switch (kind) {
+  case EdgeKind::linear:
+    return "is_linear";
+  case EdgeKind::saturation:
+    return "is_saturation";
+  case EdgeKind::deadband:
+    return "is_deadband";
+  case EdgeKind::unit_convert:
+    return "is_unit_convert";
+  default:
+    return "";
+  }
+}
+
+void emit_folded_checks(std::ostringstream &out,
+                        const std::set<EdgeKind> &kinds) {
+  if (kinds.count(EdgeKind::linear) > 0) {
+    out << "bool is_linear(const CompiledEdge &edge, double scale, "
+           "double offset,\n"
+           "               double clamp_min, double clamp_max) {\n"
+           "  const auto *t = exact_cast<const LinearTransform>("
+           "edge.transform.get());\n"
+           "  return t != nullptr && same_bits(t->scale(), scale) &&\n"
+           "         same_bits(t->offset(), offset) &&\n"
+           "         same_bits(t->clamp_min(), clamp_min) &&\n"
+           "         same_bits(t->clamp_max(), clamp_max);\n"
+           "}\n\n";
+  }
+  if (kinds.count(EdgeKind::saturation) > 0) {
+    out << "bool is_saturation(const CompiledEdge &edge, double min_value,\n"
+           "                   double max_value) {\n"
+           "  const auto *t = exact_cast<const SaturationTransform>("
+           "edge.transform.get());\n"
+           "  return t != nullptr && same_bits(t->min_value(), min_value) &&\n"
+           "         same_bits(t->max_value(), max_value);\n"
+           "}\n\n";
+  }
+  if (kinds.count(EdgeKind::deadband) > 0) {
+    out << "bool is_deadband(const CompiledEdge &edge, double threshold) {\n"
+           "  const auto *t = exact_cast<const DeadbandTransform>("
+           "edge.transform.get());\n"
+           "  return t != nullptr && same_bits(t->threshold(), threshold);\n"
+           "}\n\n";
+  }
+  if (kinds.count(EdgeKind::unit_convert) > 0) {
+    out << "bool is_unit_convert(const CompiledEdge &edge, double scale, "
+           "double offset) {\n"
+           "  const auto *t = exact_cast<const UnitConvertTransform>("
+           "edge.transform.get());\n"
+           "  return t != nullptr && same_bits(t->scale(), scale) &&\n"
+           "         same_bits(t->offset(), offset);\n"
+           "}\n\n";
+  }
+}
+
+} // namespace
+
+CppEmitResult emit_cpp(const CompiledProgram &program,
+                       const SignalNamespace &signal_ns,
+                       const CppEmitOptions &options) {
+  CppEmitResult result;
+  result.layout_hash = program_layout_hash(program);
+  const size_t chunk = std::max<size_t>(options.components_per_function, 1);
+  const std::string class_name = "GeneratedGraph_" + hex64(result.layout_hash);
+
+  // Plan components and collect headers
+  std::set<std::string> headers = {"fluxgraph/generated_program.hpp"};
+  std::set<EdgeKind> folded_kinds;
+  std::vector<EdgePlan> edge_plans;
+  edge_plans.reserve(program.edges.size());
+  for (const CompiledEdge &edge : program.edges) {
+    EdgePlan plan = plan_edge(*edge.transform);
+    switch (plan.kind) {
+    case EdgeKind::direct:
+      headers.insert(plan.builtin->header);
+      ++result.direct_edges;
+      break;
+    case EdgeKind::dynamic:
+      ++result.virtual_edges;
+      break;
+    default:
+      folded_kinds.insert(plan.kind);
+      ++result.folded_edges;
+      break;
+    }
+    edge_plans.push_back(std::move(plan));
+  }
+  static const std::unordered_map<int, const char *> kFoldedHeaders = {
+      {static_cast<int>(EdgeKind::linear), "fluxgraph/transform/linear.hpp"},
+      {static_cast<int>(EdgeKind::saturation),
+       "fluxgraph/transform/saturation.hpp"},
+      {static_cast<int>(EdgeKind::deadband),
+       "fluxgraph/transform/deadband.hpp"},
+      {static_cast<int>(EdgeKind::unit_convert),
+       "fluxgraph/transform/unit_convert.hpp"},
+  };
+  for (const EdgeKind kind : folded_kinds) {
+    headers.insert(kFoldedHeaders.at(static_cast<int>(kind)));
+  }
+
+  std::vector<const Builtin *> model_plans;
+  model_plans.reserve(program.models.size());
+  for (const auto &model : program.models) {
+    const Builtin *builtin = builtin_model(*model);
+    if (builtin != nullptr) {
+      headers.insert(builtin->header);
+      ++result.direct_models;
+    } else {
+      ++result.virtual_models;
+    }
+    model_plans.push_back(builtin);
+  }
+
+  // Program ids name signals through the compile namespace
+  auto path_of = [&](SignalId id) {
+    return signal_ns.lookup(program.signal_id_map.namespace_id(id));
+  };
+
+  // Signal fields: every edge endpoint, in first-use order
+  std::unordered_map<SignalId, std::string> fields;
+  std::vector<SignalId> field_order;
+  auto field = [&](SignalId id) -> const std::string & {
+    auto it = fields.find(id);
+    if (it == fields.end()) {
+      it = fields.emplace(id, field_name(path_of(id), id)).first;
+      field_order.push_back(id);
+    }
+    return it->second;
+  };
+  for (const CompiledEdge &edge : program.edges) {
+    field(edge.source);
+    field(edge.target);
+  }
+
+  const size_t edge_count = program.edges.size();
+  const size_t model_count = program.models.size();
+  const size_t edge_chunks = (edge_count + chunk - 1) / chunk;
+  const size_t model_chunks = (model_count + chunk - 1) / chunk;
+
+  std::ostringstream out;
+  out << "// Generated by fluxgraph-codegen";
+  if (!options.source_label.empty()) {
+    out << " from " << comment_safe(options.source_label);
+  }
+  out << ". Do not edit.\n"
+      << "// Layout hash 0x" << hex64(result.layout_hash) << ": " << edge_count
+      << " edges (" << result.folded_edges << " folded, "
+      << result.direct_edges << " direct, " << result.virtual_edges
+      << " virtual), " << model_count << " models (" << result.direct_models
+      << " direct, " << result.virtual_models << " virtual).\n"
+      << "// Add this file to the executable's sources (not a static "
+         "library),\n"
+      << "// or its registration may be dropped by the linker.\n\n";
+  for (const std::string &header : headers) {
+    out << "#include \"" << header << "\"\n";
+  }
+  out << "#include <algorithm>\n#include <cmath>\n#include <cstring>\n"
+         "#include <limits>\n#include <memory>\n#include <typeinfo>\n"
+         "#include <vector>\n\n"
+         "namespace {\n\n"
+         "using namespace fluxgraph;\n\n"
+         "[[maybe_unused]] constexpr double kInf =\n"
+         "    std::numeric_limits<double>::infinity();\n\n"
+         "[[maybe_unused]] bool same_bits(double a, double b) {\n"
+         "  return std::memcmp(&a, &b, sizeof(double)) == 0;\n"
+         "}\n\n"
+         "// Exact type: subclasses of built-ins keep their overrides\n"
+         "template <typename T, typename Base> T *exact_cast(Base *object) {\n"
+         "  return object != nullptr && typeid(*object) == typeid(T)\n"
+         "             ? static_cast<T *>(object)\n"
+         "             : nullptr;\n"
+         "}\n\n";
+  emit_folded_checks(out, folded_kinds);
+
+  // Endpoint table checked at bind time
+  out << "constexpr SignalId kEndpoints[][2] = {\n";
+  for (const CompiledEdge &edge : program.edges) {
+    out << "    {" << edge.source << ", " << edge.target << "},\n";
+  }
+  if (edge_count == 0) {
+    out << "    {INVALID_SIGNAL, INVALID_SIGNAL},\n";
+  }
+  out << "};\n\n";
+
+  out << "class " << class_name << " final : public GeneratedProgram {\n"
+      << "public:\n"
+      << "  static std::unique_ptr<GeneratedProgram>\n"
+      << "  bind(std::vector<CompiledEdge> &edges,\n"
+      << "       std::vector<ModelPtr> &models) {\n"
+      << "    if (edges.size() != " << edge_count
+      << "U || models.size() != " << model_count << "U) {\n"
+      << "      return nullptr;\n"
+      << "    }\n"
+      << "    for (size_t i = 0; i < edges.size(); ++i) {\n"
+      << "      if (edges[i].source != kEndpoints[i][0] ||\n"
+      << "          edges[i].target != kEndpoints[i][1]) {\n"
+      << "        return nullptr;\n"
+      << "      }\n"
+      << "    }\n"
+      << "    auto program = std::make_unique<" << class_name << ">();\n";
+  for (size_t c = 0; c < edge_chunks; ++c) {
+    out << "    if (!program->bind_edges_" << c << "(edges)) {\n"
+        << "      return nullptr;\n    }\n";
+  }
+  for (size_t c = 0; c < model_chunks; ++c) {
+    out << "    if (!program->bind_models_" << c << "(models)) {\n"
+        << "      return nullptr;\n    }\n";
+  }
+  out << "    return program;\n  }\n\n";
+
+  out << "  void update_models(double dt, SignalStore &store) override {\n";
+  if (model_count == 0) {
+    out << "    (void)dt;\n    (void)store;\n";
+  }
+  for (size_t c = 0; c < model_chunks; ++c) {
+    out << "    models_" << c << "(dt, store);\n";
+  }
+  out << "  }\n\n";
+
+  out << "  void process_edges(double dt, SignalStore &store) override {\n";
+  if (edge_count == 0) {
+    out << "    (void)dt;\n    (void)store;\n";
+  }
+  for (size_t c = 0; c < edge_chunks; ++c) {
+    out << "    edges_" << c << "(dt, store);\n";
+  }
+  out << "  }\n\nprivate:\n";
+
+  // Bind functions
+  for (size_t c = 0; c < edge_chunks; ++c) {
+    out << "  bool bind_edges_" << c
+        << "(std::vector<CompiledEdge> &edges) {\n";
+    const size_t end = std::min(edge_count, (c + 1) * chunk);
+    for (size_t i = c * chunk; i < end; ++i) {
+      const EdgePlan &plan = edge_plans[i];
+      if (plan.kind == EdgeKind::direct) {
+        out << "    e" << i << "_ = exact_cast<" << plan.builtin->class_name
+            << ">(edges[" << i << "].transform.get());\n"
+            << "    if (e" << i << "_ == nullptr) {\n"
+            << "      return false;\n    }\n";
+      } else if (plan.kind == EdgeKind::dynamic) {
+        out << "    e" << i << "_ = edges[" << i << "].transform.get();\n";
+      } else {
+        out << "    if (!" << folded_check(plan.kind) << "(edges[" << i
+            << "]";
+        for (const double k : plan.constants) {
+          out << ", " << literal(k);
+        }
+        out << ")) {\n      return false;\n    }\n";
+      }
+    }
+    out << "    return true;\n  }\n\n";
+  }
+  for (size_t c = 0; c < model_chunks; ++c) {
+    out << "  bool bind_models_" << c
+        << "(std::vector<ModelPtr> &models) {\n";
+    const size_t end = std::min(model_count, (c + 1) * chunk);
+    for (size_t i = c * chunk; i < end; ++i) {
+      if (model_plans[i] != nullptr) {
+        out << "    m" << i << "_ = exact_cast<"
+            << model_plans[i]->class_name << ">(models[" << i
+            << "].get());\n"
+            << "    if (m" << i << "_ == nullptr) {\n"
+            << "      return false;\n    }\n";
+      } else {
+        out << "    m" << i << "_ = models[" << i << "].get();\n";
+      }
+    }
+    out << "    return true;\n  }\n\n";
+  }
+
+  // Models in program order
+  for (size_t c = 0; c < model_chunks; ++c) {
+    out << "  void models_" << c << "(double dt, SignalStore &store) {\n";
+    const size_t end = std::min(model_count, (c + 1) * chunk);
+    for (size_t i = c * chunk; i < end; ++i) {
+      out << "    // " << comment_safe(program.models[i]->describe()) << "\n";
+      if (model_plans[i] != nullptr) {
+        out << "    m" << i << "_->" << model_plans[i]->class_name
+            << "::tick(dt, store);\n";
+      } else {
+        out << "    m" << i << "_->tick(dt, store);\n";
+      }
+    }
+    out << "  }\n\n";
+  }
+
+  // Edges in execution order. A field is current once this tick has read
+  // or written its signal; later reads use the field instead of the store.
+  std::unordered_map<SignalId, bool> current;
+  for (size_t c = 0; c < edge_chunks; ++c) {
+    const size_t end = std::min(edge_count, (c + 1) * chunk);
+    bool uses_dt = false;
+    for (size_t i = c * chunk; i < end; ++i) {
+      uses_dt = uses_dt || edge_plans[i].kind == EdgeKind::direct ||
+                edge_plans[i].kind == EdgeKind::dynamic;
+    }
+    out << "  void edges_" << c << "(double " << (uses_dt ? "dt" : "")
+        << ", SignalStore &store) {\n";
+    for (size_t i = c * chunk; i < end; ++i) {
+      const CompiledEdge &edge = program.edges[i];
+      const EdgePlan &plan = edge_plans[i];
+      const std::string source = "signals_." + field(edge.source);
+      const std::string target = "signals_." + field(edge.target);
+      out << "    // [" << i << "] "
+          << comment_safe(path_of(edge.source)) << " -> "
+          << comment_safe(path_of(edge.target)) << " ("
+          << kind_label(plan.kind) << (edge.is_delay ? ", delay edge" : "")
+          << ")\n";
+      if (!current[edge.source]) {
+        out << "    " << source << " = store.read_value(" << edge.source
+            << ");\n";
+        current[edge.source] = true;
+      }
+      out << "    " << target << " = ";
+      if (plan.kind == EdgeKind::direct) {
+        out << "e" << i << "_->" << plan.builtin->class_name << "::apply("
+            << source << ", dt);\n";
+      } else if (plan.kind == EdgeKind::dynamic) {
+        out << "e" << i << "_->apply(" << source << ", dt);\n";
+      } else {
+        out << folded_expression(plan, source) << ";\n";
+      }
+      out << "    store.write_with_contract_unit(" << edge.target << ", "
+          << target << ");\n";
+      current[edge.target] = true;
+    }
+    out << "  }\n\n";
+  }
+
+  // Members
+  out << "  struct Signals {\n";
+  for (const SignalId id : field_order) {
+    out << "    double " << fields.at(id) << " = 0.0;\n";
+  }
+  out << "  };\n\n  Signals signals_;\n";
+  for (size_t i = 0; i < edge_count; ++i) {
+    const EdgePlan &plan = edge_plans[i];
+    if (plan.kind == EdgeKind::direct) {
+      out << "  " << plan.builtin->class_name << " *e" << i
+          << "_ = nullptr;\n";
+    } else if (plan.kind == EdgeKind::dynamic) {
+      out << "  ITransform *e" << i << "_ = nullptr;\n";
+    }
+  }
+  for (size_t i = 0; i < model_count; ++i) {
+    out << "  " << (model_plans[i] != nullptr ? model_plans[i]->class_name
+                                               : "IModel")
+        << " *m" << i << "_ = nullptr;\n";
+  }
+  out << "};\n\n"
+      << "[[maybe_unused]] const bool kRegistered =\n"
+      << "    register_generated_program(0x" << hex64(result.layout_hash)
+      << "ULL, &" << class_name << "::bind);\n\n"
+      << "} // namespace\n";
+
+  result.source = out.str();
+  return result;
+}
+
+} // namespace fluxgraph::codegen
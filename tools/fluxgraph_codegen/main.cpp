@@ -0,0 +1,198 @@
+#include "fluxgraph/codegen/cpp_emitter.hpp"
+#include "fluxgraph/core/namespace.hpp"
+#include "fluxgraph/graph/compiler.hpp"
+#include "fluxgraph/graph/spec.hpp"
+
+#ifdef FLUXGRAPH_JSON_ENABLED
+#include "fluxgraph/loaders/json_loader.hpp"
+#endif
+
+#ifdef FLUXGRAPH_YAML_ENABLED
+#include "fluxgraph/loaders/yaml_loader.hpp"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+
+struct CliArgs {
+  std::string input_path;
+  std::string output_path;
+  double expected_dt = -1.0;
+  size_t components_per_function = 512;
+};
+
+std::string to_lower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) {
+                   return static_cast<char>(std::tolower(c));
+                 });
+  return value;
+}
+
+void print_usage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " --in <graph.{json|yaml|yml}> --out <generated.cpp> "
+               "[--dt <seconds>] [--chunk <components per function>]\n";
+}
+
+CliArgs parse_args(int argc, char **argv) {
+  CliArgs args;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string token = argv[i];
+
+    if (token == "--help" || token == "-h") {
+      print_usage(argv[0]);
+      std::exit(0);
+    }
+
+    if (token == "--in" || token == "--out" || token == "--dt" ||
+        token == "--chunk") {
+      if (i + 1 >= argc) {
+        throw std::runtime_error("Missing value for argument: " + token);
+      }
+
+      const std::string value = argv[++i];
+      if (token == "--in") {
+        args.input_path = value;
+      } else if (token == "--out") {
+        args.output_path = value;
+      } else if (token == "--dt") {
+        args.expected_dt = std::stod(value);
+        if (!(args.expected_dt > 0.0)) {
+          throw std::runtime_error("--dt must be positive");
+        }
+      } else {
+        const long long chunk = std::stoll(value);
+        if (chunk <= 0) {
+          throw std::runtime_error("--chunk must be positive");
+        }
+        args.components_per_function = static_cast<size_t>(chunk);
+      }
+      continue;
+    }
+
+    throw std::runtime_error("Unknown argument: " + token);
+  }
+
+  if (args.input_path.empty()) {
+    throw std::runtime_error("Missing required argument: --in");
+  }
+
+  if (args.output_path.empty()) {
+    throw std::runtime_error("Missing required argument: --out");
+  }
+
+  return args;
+}
+
+fluxgraph::GraphSpec load_graph_spec(const std::string &path) {
+  const std::string extension =
+      to_lower(std::filesystem::path(path).extension().string());
+
+  if (extension == ".json") {
+#ifdef FLUXGRAPH_JSON_ENABLED
+    return fluxgraph::loaders::load_json_file(path);
+#else
+    throw std::runtime_error(
+        "JSON input requested, but FLUXGRAPH_JSON_ENABLED is OFF.");
+#endif
+  }
+
+  if (extension == ".yaml" || extension == ".yml") {
+#ifdef FLUXGRAPH_YAML_ENABLED
+    return fluxgraph::loaders::load_yaml_file(path);
+#else
+    throw std::runtime_error(
+        "YAML input requested, but FLUXGRAPH_YAML_ENABLED is OFF.");
+#endif
+  }
+
+  throw std::runtime_error(
+      "Unsupported input extension '" + extension +
+      "'. Use .json, .yaml, or .yml input files.");
+}
+
+void write_text_file(const std::string &path, const std::string &content) {
+  const auto output_path = std::filesystem::path(path);
+  if (output_path.has_parent_path()) {
+    std::error_code ec;
+    std::filesystem::create_directories(output_path.parent_path(), ec);
+    if (ec) {
+      throw std::runtime_error("Failed to create output directory for: " +
+                               path);
+    }
+  }
+
+  std::ofstream stream(path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("Failed to open output path: " + path);
+  }
+
+  stream << content;
+  if (!stream) {
+    throw std::runtime_error("Failed writing output file: " + path);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  CliArgs args;
+  try {
+    args = parse_args(argc, argv);
+  } catch (const std::exception &ex) {
+    std::cerr << "error: " << ex.what() << "\n";
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  try {
+    const fluxgraph::GraphSpec spec = load_graph_spec(args.input_path);
+
+    // Fresh namespaces: the host must intern paths in the same order, which
+    // compiling the same spec into fresh namespaces does
+    fluxgraph::SignalNamespace signal_ns;
+    fluxgraph::FunctionNamespace func_ns;
+    fluxgraph::GraphCompiler compiler;
+    const fluxgraph::CompiledProgram program =
+        compiler.compile(spec, signal_ns, func_ns, args.expected_dt);
+
+    fluxgraph::codegen::CppEmitOptions options;
+    options.source_label =
+        std::filesystem::path(args.input_path).filename().string();
+    options.components_per_function = args.components_per_function;
+    const fluxgraph::codegen::CppEmitResult result =
+        fluxgraph::codegen::emit_cpp(program, signal_ns, options);
+
+    if (result.virtual_edges > 0 || result.virtual_models > 0) {
+      std::cerr << "warning: " << result.virtual_edges << " edge(s) and "
+                << result.virtual_models
+                << " model(s) use extension types and are called through "
+                   "their interfaces.\n";
+    }
+
+    write_text_file(args.output_path, result.source);
+    std::cout << "Wrote generated program to: " << args.output_path << "\n"
+              << "  edges:  " << program.edges.size() << " ("
+              << result.folded_edges << " folded, " << result.direct_edges
+              << " direct, " << result.virtual_edges << " virtual)\n"
+              << "  models: " << program.models.size() << " ("
+              << result.direct_models << " direct, "
+              << result.virtual_models << " virtual)\n";
+    return 0;
+  } catch (const std::exception &ex) {
+    std::cerr << "error: " << ex.what() << "\n";
+    return 1;
+  }
+}
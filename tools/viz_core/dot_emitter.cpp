@@ -115,6 +115,34 @@ std::string param_to_compact_string(const ParamValue &value) {
           }
           rendered += "]";
           return rendered;
+        } else if constexpr (std::is_same_v<T, ParamNumbers>) {
+          auto render_row = [&item](size_t begin, size_t end) {
+            std::string rendered = "[";
+            for (size_t i = begin; i < end; ++i) {
+              if (i != begin) {
+                rendered += ", ";
+              }
+              rendered += item.integral
+                              ? param_to_compact_string(
+                                    static_cast<int64_t>(item.values[i]))
+                              : param_to_compact_string(item.values[i]);
+            }
+            rendered += "]";
+            return rendered;
+          };
+          if (item.columns == 0) {
+            return render_row(0, item.values.size());
+          }
+          std::string rendered = "[";
+          for (size_t row = 0; row < item.rows(); ++row) {
+            if (row > 0) {
+              rendered += ", ";
+            }
+            rendered += render_row(row * item.columns,
+                                   (row + 1) * item.columns);
+          }
+          rendered += "]";
+          return rendered;
         } else {
           static_assert(std::is_same_v<T, ParamObject>,
                         "Unhandled ParamValue variant alternative");